@@ -534,7 +534,6 @@ LOCAL_SRC_FILES :=  ../../../../../../lib/ljpeg/jcapimin.c \
 					../../../../../../source/sim/scriptObject.cc \
 					../../../../../../source/sim/simBase.cc \
 					../../../../../../source/sim/simConsoleEvent.cc \
-					../../../../../../source/sim/simConsoleThreadExecEvent.cc \
 					../../../../../../source/sim/simDatablock.cc \
 					../../../../../../source/sim/simDictionary.cc \
 					../../../../../../source/sim/simFieldDictionary.cc \
@@ -0,0 +1,91 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _ROTATE_BEHAVIOR_H_
+#include "2d/behaviors/RotateBehavior.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//------------------------------------------------------------------------------
+
+IMPLEMENT_CONOBJECT(RotateBehaviorInstance);
+
+//------------------------------------------------------------------------------
+
+RotateBehaviorInstance::RotateBehaviorInstance() :
+    mAngularSpeed( 0.0f ),
+    mpSceneObject( NULL )
+{
+}
+
+//------------------------------------------------------------------------------
+
+void RotateBehaviorInstance::initPersistFields()
+{
+    // Call parent.
+    Parent::initPersistFields();
+
+    addField("AngularSpeed", TypeF32, Offset( mAngularSpeed, RotateBehaviorInstance), "The angular speed to rotate at (degrees/sec).");
+}
+
+//------------------------------------------------------------------------------
+
+void RotateBehaviorInstance::onBehaviorAdd( void )
+{
+    // Cache the scene object owner.
+    mpSceneObject = dynamic_cast<SceneObject*>( getBehaviorOwner() );
+}
+
+//------------------------------------------------------------------------------
+
+void RotateBehaviorInstance::onBehaviorRemove( void )
+{
+    mpSceneObject = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+void RotateBehaviorInstance::updateBatch( NativeBehaviorInstance* const* ppInstances, const U32 instanceCount, const F32 elapsedTime )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(RotateBehaviorInstance_UpdateBatch);
+
+    // Iterate instances.
+    for ( U32 index = 0; index < instanceCount; ++index )
+    {
+        // Fetch instance.
+        RotateBehaviorInstance* pInstance = static_cast<RotateBehaviorInstance*>( ppInstances[index] );
+
+        // Skip if not owned by a scene object.
+        SceneObject* pSceneObject = pInstance->mpSceneObject;
+        if ( pSceneObject == NULL )
+            continue;
+
+        pSceneObject->setAngle( pSceneObject->getAngle() + mDegToRad(pInstance->mAngularSpeed) * elapsedTime );
+    }
+}
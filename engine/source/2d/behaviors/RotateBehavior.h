@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _ROTATE_BEHAVIOR_H_
+#define _ROTATE_BEHAVIOR_H_
+
+#ifndef _NATIVE_BEHAVIORINSTANCE_H_
+#include "component/behaviors/nativeBehaviorInstance.h"
+#endif
+
+//------------------------------------------------------------------------------
+
+class SceneObject;
+
+//------------------------------------------------------------------------------
+
+/// A native behavior that continuously rotates its scene object owner.
+/// Use with a BehaviorTemplate whose "nativeClass" is "RotateBehaviorInstance".
+class RotateBehaviorInstance : public NativeBehaviorInstance
+{
+private:
+    typedef NativeBehaviorInstance Parent;
+
+    F32             mAngularSpeed;
+    SceneObject*    mpSceneObject;
+
+public:
+    RotateBehaviorInstance();
+    virtual ~RotateBehaviorInstance() {}
+
+    static void initPersistFields();
+
+    virtual void onBehaviorAdd( void );
+    virtual void onBehaviorRemove( void );
+    virtual void updateBatch( NativeBehaviorInstance* const* ppInstances, const U32 instanceCount, const F32 elapsedTime );
+
+    inline void setAngularSpeed( const F32 angularSpeed ) { mAngularSpeed = angularSpeed; }
+    inline F32 getAngularSpeed( void ) const { return mAngularSpeed; }
+
+    /// Declare Console Object.
+    DECLARE_CONOBJECT( RotateBehaviorInstance );
+};
+
+#endif // _ROTATE_BEHAVIOR_H_
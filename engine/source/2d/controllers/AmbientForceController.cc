@@ -24,6 +24,10 @@
 #include "2d/controllers/AmbientForceController.h"
 #endif
 
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
 // Script bindings.
 #include "AmbientForceController_ScriptBinding.h"
 
@@ -78,10 +82,28 @@ void AmbientForceController::copyTo(SimObject* object)
 
 void AmbientForceController::integrate( Scene* pScene, const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats )
 {
-    // Process all the scene objects.
+    // Fetch the scene object count.
+    const U32 sceneObjectCount = (U32)size();
+
+    // Finish if nothing to process.
+    if ( sceneObjectCount == 0 )
+        return;
+
+    // Gather the bodies of all the scene objects in the scene.
+    FrameTemp<b2Body*> bodies( sceneObjectCount );
+    U32 bodyCount = 0;
     for( SceneObjectSet::iterator itr = begin(); itr != end(); ++itr )
     {
-        // Apply the force.
-        (*itr)->applyForce( mForce, true );
+        // Fetch the scene object.
+        SceneObject* pSceneObject = *itr;
+
+        // Ignore if not in a scene.
+        if ( pSceneObject->getScene() == NULL )
+            continue;
+
+        bodies[bodyCount++] = pSceneObject->getBody();
     }
+
+    // Apply the force to the bodies in a single batch.
+    pScene->applyUniformForceBatch( ~bodies, mForce, bodyCount, true );
 }
@@ -24,6 +24,10 @@
 #include "2d/controllers/PointForceController.h"
 #endif
 
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
 // Script bindings.
 #include "PointForceController_ScriptBinding.h"
 
@@ -124,12 +128,6 @@ void PointForceController::integrate( Scene* pScene, const F32 totalTime, const
     if ( resultCount == 0 )
         return;
 
-    // Calculate the radius squared.
-    const F32 radiusSqr = mRadius * mRadius;
-
-    // Calculate the force squared in-case we need it.
-    const F32 forceSqr = mForce * mForce * (( mForce < 0.0f ) ? -1.0f : 1.0f);
-
     // Calculate drag coefficients (time-integrated).
     const F32 linearDrag = mClampF( mLinearDrag, 0.0f, 1.0f ) * elapsedTime;
     const F32 angularDrag = mClampF( mAngularDrag, 0.0f, 1.0f ) * elapsedTime;
@@ -137,7 +135,9 @@ void PointForceController::integrate( Scene* pScene, const F32 totalTime, const
     // Fetch the tracked object.
     const SceneObject* pTrackedObject = mTrackedObject;
 
-    // Iterate the results.
+    // Gather the candidate bodies.
+    FrameTemp<b2Body*> bodies( resultCount );
+    U32 bodyCount = 0;
     for ( U32 n = 0; n < resultCount; n++ )
     {
         // Fetch the scene object.
@@ -151,57 +151,11 @@ void PointForceController::integrate( Scene* pScene, const F32 totalTime, const
         if ( pSceneObject->getBodyType() == b2_staticBody )
             continue;
 
-        // Calculate the force distance to the controllers current position.
-        Vector2 distanceForce = currentPosition - pSceneObject->getPosition();
-
-        // Fetch distance squared.
-        const F32 distanceSqr = distanceForce.LengthSquared();
-
-        // Skip if the position is outside the radius or is centered on the controller.
-        if ( distanceSqr > radiusSqr || distanceSqr < FLT_EPSILON )
-            continue;
-
-        // Non-Linear force?
-        if ( mNonLinear )
-        {
-            // Yes, so use an approximation of the inverse-square law.
-            distanceForce *= (1.0f / distanceSqr) * forceSqr;
-        }
-        else
-        {
-            // No, so normalize to the specified force (linear).
-            distanceForce.Normalize( mForce );
-        }
-
-        // Apply the force.
-        pSceneObject->applyForce( distanceForce, true );
-
-        // Linear drag?
-        if ( linearDrag > 0.0f )
-        {
-            // Yes, so fetch linear velocity.
-            Vector2 linearVelocity = pSceneObject->getLinearVelocity();
-
-            // Calculate linear velocity change.
-            const Vector2 linearVelocityDelta = linearVelocity * linearDrag;
-
-            // Set linear velocity.
-            pSceneObject->setLinearVelocity( linearVelocity - linearVelocityDelta );
-        }
-
-        // Angular drag?
-        if ( angularDrag > 0.0f )
-        {
-            // Yes, so fetch angular velocity.
-            F32 angularVelocity = pSceneObject->getAngularVelocity();
-
-            // Calculate angular velocity change.
-            const F32 angularVelocityDelta = angularVelocity * angularDrag;
-
-            // Set angular velocity.
-            pSceneObject->setAngularVelocity( angularVelocity - angularVelocityDelta );
-        }
+        bodies[bodyCount++] = pSceneObject->getBody();
     }
+
+    // Apply the force and drag to the bodies in a single batch.
+    pScene->applyPointForceBatch( ~bodies, bodyCount, currentPosition, mRadius, mForce, mNonLinear, linearDrag, angularDrag );
 }
 
 //------------------------------------------------------------------------------
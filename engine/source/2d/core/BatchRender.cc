@@ -22,6 +22,10 @@
 
 #include "BatchRender.h"
 
+#ifndef _RENDER_SNAPSHOT_H_
+#include "2d/core/RenderSnapshot.h"
+#endif
+
 #ifndef _SCENE_OBJECT_H_
 #include "2d/sceneobject/SceneObject.h"
 #endif
@@ -39,7 +43,10 @@ BatchRender::BatchRender() :
     mColorCount( 0 ),
     NoColor( -1.0f, -1.0f, -1.0f ),
     mStrictOrderMode( false ),
+    mStrictOrderTextureName( 0 ),
+    mpStrictOrderTexture( NULL ),
     mpDebugStats( NULL ),
+    mpRecordTarget( NULL ),
     mBlendMode( true ),
     mSrcBlendFactor( GL_SRC_ALPHA ),
     mDstBlendFactor( GL_ONE_MINUS_SRC_ALPHA ),
@@ -99,6 +106,20 @@ void BatchRender::setAlphaTestMode( const SceneRenderRequest* pSceneRenderReques
 
 //-----------------------------------------------------------------------------
 
+void BatchRender::setRecordTarget( RenderSnapshot* pRecordTarget )
+{
+    // Ignore no change.
+    if ( pRecordTarget == mpRecordTarget )
+        return;
+
+    // Flush anything pending to the current target.
+    flushInternal();
+
+    mpRecordTarget = pRecordTarget;
+}
+
+//-----------------------------------------------------------------------------
+
 void BatchRender::SubmitTriangles(
         const U32 vertexCount,
         const Vector2* pVertexArray,
@@ -145,7 +166,7 @@ void BatchRender::SubmitTriangles(
     if ( mStrictOrderMode )
     {
         // Yes, so is there a texture change?
-        if ( texture != mStrictOrderTextureHandle && mTriangleCount > 0 )
+        if ( texture.getGLName() != mStrictOrderTextureName && mTriangleCount > 0 )
         {
             // Yes, so flush.
             flush( mpDebugStats->batchTextureChangeFlush );
@@ -162,8 +183,9 @@ void BatchRender::SubmitTriangles(
             mIndexBuffer[mIndexCount++] = vertexIndex++;
         }
 
-        // Set strict order mode texture handle.
-        mStrictOrderTextureHandle = texture;
+        // Set strict order mode texture.
+        mStrictOrderTextureName = texture.getGLName();
+        mpStrictOrderTexture = (TextureObject*)texture;
     }
     else
     {
@@ -264,7 +286,7 @@ void BatchRender::SubmitQuad(
     if ( mStrictOrderMode )
     {
         // Yes, so is there a texture change?
-        if ( texture != mStrictOrderTextureHandle && mTriangleCount > 0 )
+        if ( texture.getGLName() != mStrictOrderTextureName && mTriangleCount > 0 )
         {
             // Yes, so flush.
             flush( mpDebugStats->batchTextureChangeFlush );
@@ -278,8 +300,9 @@ void BatchRender::SubmitQuad(
         mIndexBuffer[mIndexCount++] = (U16)mVertexCount--;
         mIndexBuffer[mIndexCount++] = (U16)mVertexCount--;
 
-        // Set strict order mode texture handle.
-        mStrictOrderTextureHandle = texture;
+        // Set strict order mode texture.
+        mStrictOrderTextureName = texture.getGLName();
+        mpStrictOrderTexture = (TextureObject*)texture;
     }
     else
     {
@@ -374,6 +397,14 @@ void BatchRender::flushInternal( void )
     // Stats.
     mpDebugStats->batchFlushes++;
 
+    // Are we recording?
+    if ( mpRecordTarget != NULL )
+    {
+        // Yes, so record rather than render.
+        recordInternal();
+        return;
+    }
+
     if ( mWireframeMode )
     {
         // Disable texturing.    
@@ -438,7 +469,7 @@ void BatchRender::flushInternal( void )
     {
         // Bind the texture if not in wireframe mode.
         if ( !mWireframeMode )
-            glBindTexture( GL_TEXTURE_2D, mStrictOrderTextureHandle.getGLName() );
+            glBindTexture( GL_TEXTURE_2D, mStrictOrderTextureName );
 
         // Draw the triangles
         glDrawElements( GL_TRIANGLES, mIndexCount, GL_UNSIGNED_SHORT, mIndexBuffer );
@@ -460,59 +491,11 @@ void BatchRender::flushInternal( void )
         // No, so iterate texture batch map.
         for( textureBatchType::iterator batchItr = mTextureBatchMap.begin(); batchItr != mTextureBatchMap.end(); ++batchItr )
         {
-            // Reset index count.
-            mIndexCount = 0;
-
             // Fetch index vector.
             indexVectorType* pIndexVector = batchItr->value;
 
-            // Iterate indexes.
-            for( indexVectorType::iterator indexItr = pIndexVector->begin(); indexItr != pIndexVector->end(); ++indexItr )
-            {
-                // Fetch triangle run.
-                const TriangleRun& triangleRun = *indexItr;
-
-                // Fetch primitivecount.
-                const U32 primitiveCount = triangleRun.mPrimitiveCount;
-
-                // Fetch triangle index start.
-                U16 triangleIndex = (U16)triangleRun.mStartIndex;
-
-                // Fetch primitive mode.
-                const TriangleRun::PrimitiveMode& primitiveMode = triangleRun.mPrimitiveMode;
-
-                // Handle primitive mode.
-                if ( primitiveMode == TriangleRun::QUAD )
-                {
-                    // Add triangle run for quad.
-                    for( U32 n = 0; n < primitiveCount; ++n )
-                    {
-                        // Add new indices.
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                        mIndexBuffer[mIndexCount++] = triangleIndex--;
-                        mIndexBuffer[mIndexCount++] = triangleIndex--;
-                        mIndexBuffer[mIndexCount++] = triangleIndex--;
-                    }
-                }
-                else if ( primitiveMode == TriangleRun::TRIANGLE )
-                {
-                    // Add triangle run for triangles.
-                    for( U32 n = 0; n < primitiveCount; ++n )
-                    {
-                        // Add new indices.
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                        mIndexBuffer[mIndexCount++] = triangleIndex++;
-                    }
-                }
-                else
-                {
-                    // Sanity!
-                    AssertFatal( false, "BatchRender::flushInternal() - Unrecognized primitive mode encountered for triangle run." );
-                }
-            }
+            // Build the batch indices.
+            mIndexCount = buildBatchIndices( pIndexVector );
 
             // Sanity!
             AssertFatal( mIndexCount > 0, "No batching indexes are present." );
@@ -564,6 +547,144 @@ void BatchRender::flushInternal( void )
 
 //-----------------------------------------------------------------------------
 
+U32 BatchRender::buildBatchIndices( const indexVectorType* pIndexVector )
+{
+    U32 indexCount = 0;
+
+    // Iterate indexes.
+    for( indexVectorType::const_iterator indexItr = pIndexVector->begin(); indexItr != pIndexVector->end(); ++indexItr )
+    {
+        // Fetch triangle run.
+        const TriangleRun& triangleRun = *indexItr;
+
+        // Fetch primitivecount.
+        const U32 primitiveCount = triangleRun.mPrimitiveCount;
+
+        // Fetch triangle index start.
+        U16 triangleIndex = (U16)triangleRun.mStartIndex;
+
+        // Fetch primitive mode.
+        const TriangleRun::PrimitiveMode& primitiveMode = triangleRun.mPrimitiveMode;
+
+        // Handle primitive mode.
+        if ( primitiveMode == TriangleRun::QUAD )
+        {
+            // Add triangle run for quad.
+            for( U32 n = 0; n < primitiveCount; ++n )
+            {
+                // Add new indices.
+                mIndexBuffer[indexCount++] = triangleIndex++;
+                mIndexBuffer[indexCount++] = triangleIndex++;
+                mIndexBuffer[indexCount++] = triangleIndex++;
+                mIndexBuffer[indexCount++] = triangleIndex--;
+                mIndexBuffer[indexCount++] = triangleIndex--;
+                mIndexBuffer[indexCount++] = triangleIndex--;
+            }
+        }
+        else if ( primitiveMode == TriangleRun::TRIANGLE )
+        {
+            // Add triangle run for triangles.
+            for( U32 n = 0; n < primitiveCount; ++n )
+            {
+                // Add new indices.
+                mIndexBuffer[indexCount++] = triangleIndex++;
+                mIndexBuffer[indexCount++] = triangleIndex++;
+                mIndexBuffer[indexCount++] = triangleIndex++;
+            }
+        }
+        else
+        {
+            // Sanity!
+            AssertFatal( false, "BatchRender::buildBatchIndices() - Unrecognized primitive mode encountered for triangle run." );
+        }
+    }
+
+    return indexCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void BatchRender::recordInternal( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(T2D_BatchRender_record);
+
+    // Sanity!
+    AssertFatal( mpRecordTarget != NULL, "BatchRender::recordInternal() - No record target." );
+
+    // Fetch the render state.
+    RenderSnapshot::BatchState state;
+    state.mBlendMode = mBlendMode;
+    state.mSrcBlendFactor = mSrcBlendFactor;
+    state.mDstBlendFactor = mDstBlendFactor;
+    state.mBlendColor = mBlendColor;
+    state.mAlphaTestMode = mAlphaTestMode;
+    state.mWireframeMode = mWireframeMode;
+
+    // Record the vertices shared by all batches in this flush.
+    const bool hasColors = mColorCount > 0;
+    const U32 vertexStart = mpRecordTarget->addVertices( mVertexBuffer, mTextureBuffer, hasColors ? mColorBuffer : NULL, mVertexCount );
+
+    // Strict order mode?
+    if ( mStrictOrderMode )
+    {
+        // Yes, so record a single batch.
+        mpRecordTarget->addBatch( vertexStart, mIndexBuffer, mIndexCount, mpStrictOrderTexture, hasColors, state );
+
+        // Stats.
+        mpDebugStats->batchDrawCallsStrict++;
+
+        // Stats.
+        const U32 trianglesDrawn = mIndexCount / 3;
+        if ( trianglesDrawn > mpDebugStats->batchMaxTriangleDrawn )
+            mpDebugStats->batchMaxTriangleDrawn = trianglesDrawn;
+    }
+    else
+    {
+        // No, so iterate texture batch map.
+        for( textureBatchType::iterator batchItr = mTextureBatchMap.begin(); batchItr != mTextureBatchMap.end(); ++batchItr )
+        {
+            // Fetch index vector.
+            indexVectorType* pIndexVector = batchItr->value;
+
+            // Build the batch indices.
+            mIndexCount = buildBatchIndices( pIndexVector );
+
+            // Record the batch.
+            mpRecordTarget->addBatch( vertexStart, mIndexBuffer, mIndexCount, mTextureObjectMap[batchItr->key], hasColors, state );
+
+            // Stats.
+            mpDebugStats->batchDrawCallsSorted++;
+
+            // Stats.
+            const U32 trianglesDrawn = mIndexCount / 3;
+            if ( trianglesDrawn > mpDebugStats->batchMaxTriangleDrawn )
+                mpDebugStats->batchMaxTriangleDrawn = trianglesDrawn;
+
+            // Return index vector to pool.
+            pIndexVector->clear();
+            mIndexVectorPool.push_back( pIndexVector );
+        }
+
+        // Clear texture batch map.
+        mTextureBatchMap.clear();
+        mTextureObjectMap.clear();
+    }
+
+    // Stats.
+    if ( mVertexCount > mpDebugStats->batchMaxVertexBuffer )
+        mpDebugStats->batchMaxVertexBuffer = mVertexCount;
+
+    // Reset batch state.
+    mTriangleCount = 0;
+    mVertexCount = 0;
+    mTextureCoordCount = 0;
+    mIndexCount = 0;
+    mColorCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
 BatchRender::indexVectorType* BatchRender::findTextureBatch( TextureHandle& handle )
 {
     // Fetch texture binding.
@@ -595,6 +716,10 @@ BatchRender::indexVectorType* BatchRender::findTextureBatch( TextureHandle& hand
 
         // Insert into texture batch map.
         mTextureBatchMap.insert( textureBinding, pIndexVector );
+
+        // Keep the texture object when recording so the snapshot can reference it.
+        if ( mpRecordTarget != NULL )
+            mTextureObjectMap.insert( textureBinding, (TextureObject*)handle );
     }
     else
     {
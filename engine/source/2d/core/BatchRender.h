@@ -55,6 +55,7 @@
 //-----------------------------------------------------------------------------
 
 class SceneRenderRequest;
+class RenderSnapshot;
 
 //-----------------------------------------------------------------------------
 
@@ -82,9 +83,11 @@ private:
 
     typedef Vector<TriangleRun> indexVectorType;
     typedef HashMap<U32, indexVectorType*> textureBatchType;
+    typedef HashMap<U32, TextureObject*> textureObjectType;
 
     VectorPtr< indexVectorType* > mIndexVectorPool;
     textureBatchType    mTextureBatchMap;
+    textureObjectType   mTextureObjectMap;
 
     const ColorF        NoColor;
 
@@ -106,8 +109,10 @@ private:
     F32                 mAlphaTestMode;
 
     bool                mStrictOrderMode;
-    TextureHandle       mStrictOrderTextureHandle;
+    U32                 mStrictOrderTextureName;
+    TextureObject*      mpStrictOrderTexture;
     DebugStats*         mpDebugStats;
+    RenderSnapshot*     mpRecordTarget;
 
     bool                mWireframeMode;
     bool                mBatchEnabled;
@@ -219,6 +224,13 @@ public:
     /// Sets the debug stats to use.
     inline void setDebugStats( DebugStats* pDebugStats ) { mpDebugStats = pDebugStats; }
 
+    /// Sets a snapshot that flushes are recorded into instead of being rendered.
+    /// No GL calls are made while a record target is set.
+    void setRecordTarget( RenderSnapshot* pRecordTarget );
+
+    /// Gets the current record target, if any.
+    inline RenderSnapshot* getRecordTarget( void ) const { return mpRecordTarget; }
+
     /// Submit triangles for batching.
     /// Vertex and textures are indexed as:
     ///  2        5
@@ -289,6 +301,12 @@ private:
     /// Flush (render) any pending batches.
     void flushInternal( void );
 
+    /// Record any pending batches into the record target.
+    void recordInternal( void );
+
+    /// Build the index buffer for a texture batch, returning the index count.
+    U32 buildBatchIndices( const indexVectorType* pIndexVector );
+
     /// Find texture batch.
     indexVectorType* findTextureBatch( TextureHandle& handle );
 };
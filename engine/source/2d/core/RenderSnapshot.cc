@@ -0,0 +1,293 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "RenderSnapshot.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+RenderSnapshot::RenderSnapshot() :
+    mRenderPosition( Vector2::getZero() ),
+    mRenderAngle( 0.0f ),
+    mValid( false )
+{
+    VECTOR_SET_ASSOCIATION( mVertices );
+    VECTOR_SET_ASSOCIATION( mTextureCoords );
+    VECTOR_SET_ASSOCIATION( mColors );
+    VECTOR_SET_ASSOCIATION( mIndices );
+    VECTOR_SET_ASSOCIATION( mBatches );
+
+    dMemset( mProjectionMatrix, 0, sizeof(mProjectionMatrix) );
+    dMemset( mModelViewMatrix, 0, sizeof(mModelViewMatrix) );
+}
+
+//-----------------------------------------------------------------------------
+
+RenderSnapshot::~RenderSnapshot()
+{
+    // Release the textures.
+    reset();
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::reset( void )
+{
+    // Release the textures.
+    for( Vector<DrawBatch>::iterator batchItr = mBatches.begin(); batchItr != mBatches.end(); ++batchItr )
+    {
+        batchItr->mTexture.clear();
+    }
+
+    // Clear the draw data but keep the allocations for the next capture.
+    mVertices.clear();
+    mTextureCoords.clear();
+    mColors.clear();
+    mIndices.clear();
+    mBatches.clear();
+
+    mRenderStats.reset();
+    mValid = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::setView( const Vector2& renderPosition, const F32 renderAngle )
+{
+    glGetFloatv( GL_PROJECTION_MATRIX, mProjectionMatrix );
+    glGetFloatv( GL_MODELVIEW_MATRIX, mModelViewMatrix );
+
+    mRenderPosition = renderPosition;
+    mRenderAngle = renderAngle;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 RenderSnapshot::addVertices( const Vector2* pVertices, const Vector2* pTextureCoords, const ColorF* pColors, const U32 vertexCount )
+{
+    // Fetch the block start.
+    const U32 vertexStart = mVertices.size();
+
+    // Copy the vertices and texture coordinates.
+    mVertices.setSize( vertexStart + vertexCount );
+    mTextureCoords.setSize( vertexStart + vertexCount );
+    dMemcpy( mVertices.address() + vertexStart, pVertices, vertexCount * sizeof(Vector2) );
+    dMemcpy( mTextureCoords.address() + vertexStart, pTextureCoords, vertexCount * sizeof(Vector2) );
+
+    // Copy the colors, keeping them aligned with the vertices.
+    mColors.setSize( vertexStart + vertexCount );
+    if ( pColors != NULL )
+        dMemcpy( mColors.address() + vertexStart, pColors, vertexCount * sizeof(ColorF) );
+
+    return vertexStart;
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::addBatch( const U32 vertexStart, const U16* pIndices, const U32 indexCount, TextureObject* pTextureObject, const bool hasColors, const BatchState& state )
+{
+    // Sanity!
+    AssertFatal( vertexStart < (U32)mVertices.size(), "RenderSnapshot::addBatch() - Invalid vertex start." );
+
+    // Copy the indices.
+    const U32 indexStart = mIndices.size();
+    mIndices.setSize( indexStart + indexCount );
+    dMemcpy( mIndices.address() + indexStart, pIndices, indexCount * sizeof(U16) );
+
+    // Add the batch.
+    mBatches.increment();
+    DrawBatch& batch = mBatches.last();
+    batch.mVertexStart = vertexStart;
+    batch.mIndexStart = indexStart;
+    batch.mIndexCount = indexCount;
+    batch.mpTextureObject = pTextureObject;
+    batch.mHasColors = hasColors;
+    batch.mState = state;
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::holdTextures( void )
+{
+    for( Vector<DrawBatch>::iterator batchItr = mBatches.begin(); batchItr != mBatches.end(); ++batchItr )
+    {
+        if ( batchItr->mTexture.IsNull() && batchItr->mpTextureObject != NULL )
+            batchItr->mTexture = TextureHandle( batchItr->mpTextureObject );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool RenderSnapshot::getTexturesHeld( void ) const
+{
+    for( Vector<DrawBatch>::const_iterator batchItr = mBatches.begin(); batchItr != mBatches.end(); ++batchItr )
+    {
+        if ( batchItr->mpTextureObject != NULL && batchItr->mTexture.IsNull() )
+            return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::applyRenderStats( DebugStats& debugStats ) const
+{
+    debugStats.renderPicked             = mRenderStats.renderPicked;
+    debugStats.renderRequests           = mRenderStats.renderRequests;
+    debugStats.renderFallbacks          = mRenderStats.renderFallbacks;
+    debugStats.batchTrianglesSubmitted  = mRenderStats.batchTrianglesSubmitted;
+    debugStats.batchDrawCallsStrict     = mRenderStats.batchDrawCallsStrict;
+    debugStats.batchDrawCallsSorted     = mRenderStats.batchDrawCallsSorted;
+    debugStats.batchFlushes             = mRenderStats.batchFlushes;
+    debugStats.batchBlendStateFlush     = mRenderStats.batchBlendStateFlush;
+    debugStats.batchColorStateFlush     = mRenderStats.batchColorStateFlush;
+    debugStats.batchAlphaStateFlush     = mRenderStats.batchAlphaStateFlush;
+    debugStats.batchTextureChangeFlush  = mRenderStats.batchTextureChangeFlush;
+    debugStats.batchBufferFullFlush     = mRenderStats.batchBufferFullFlush;
+    debugStats.batchIsolatedFlush       = mRenderStats.batchIsolatedFlush;
+    debugStats.batchLayerFlush          = mRenderStats.batchLayerFlush;
+    debugStats.batchNoBatchFlush        = mRenderStats.batchNoBatchFlush;
+    debugStats.batchAnonymousFlush      = mRenderStats.batchAnonymousFlush;
+
+    if ( mRenderStats.batchMaxTriangleDrawn > debugStats.batchMaxTriangleDrawn )
+        debugStats.batchMaxTriangleDrawn = mRenderStats.batchMaxTriangleDrawn;
+
+    if ( mRenderStats.batchMaxVertexBuffer > debugStats.batchMaxVertexBuffer )
+        debugStats.batchMaxVertexBuffer = mRenderStats.batchMaxVertexBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+void RenderSnapshot::replay( void ) const
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(RenderSnapshot_Replay);
+
+    // Finish if nothing to draw.
+    if ( mBatches.size() == 0 )
+        return;
+
+    // Use the captured view.
+    glMatrixMode( GL_PROJECTION );
+    glPushMatrix();
+    glLoadMatrixf( mProjectionMatrix );
+    glMatrixMode( GL_MODELVIEW );
+    glPushMatrix();
+    glLoadMatrixf( mModelViewMatrix );
+
+    // Rotate the world matrix by the camera angle.
+    glTranslatef( mRenderPosition.x, mRenderPosition.y, 0.0f );
+    glRotatef( mRadToDeg(mRenderAngle), 0.0f, 0.0f, 1.0f );
+    glTranslatef( -mRenderPosition.x, -mRenderPosition.y, 0.0f );
+
+    glEnableClientState( GL_VERTEX_ARRAY );
+
+    // Iterate batches.
+    for( Vector<DrawBatch>::const_iterator batchItr = mBatches.begin(); batchItr != mBatches.end(); ++batchItr )
+    {
+        const DrawBatch& batch = *batchItr;
+        const BatchState& state = batch.mState;
+
+        if ( state.mWireframeMode )
+        {
+            // Disable texturing.
+            glDisable( GL_TEXTURE_2D );
+
+            // Set the polygon mode to line.
+            glPolygonMode( GL_FRONT_AND_BACK, GL_LINE );
+            glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+        }
+        else
+        {
+            // Enable texturing.
+            glEnable( GL_TEXTURE_2D );
+            glTexEnvi( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE );
+            glBindTexture( GL_TEXTURE_2D, batch.mTexture.getGLName() );
+
+            // Set the polygon mode to fill.
+            glPolygonMode( GL_FRONT_AND_BACK, GL_FILL );
+            glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+        }
+
+        // Set blend mode.
+        if ( state.mBlendMode )
+        {
+            glEnable( GL_BLEND );
+            glBlendFunc( state.mSrcBlendFactor, state.mDstBlendFactor );
+            glColor4f( state.mBlendColor.red, state.mBlendColor.green, state.mBlendColor.blue, state.mBlendColor.alpha );
+        }
+        else
+        {
+            glDisable( GL_BLEND );
+            glColor4f( 1.0f, 1.0f, 1.0f, 1.0f );
+        }
+
+        // Set alpha-test mode.
+        if ( state.mAlphaTestMode >= 0.0f )
+        {
+            glEnable( GL_ALPHA_TEST );
+            glAlphaFunc( GL_GREATER, state.mAlphaTestMode );
+        }
+        else
+        {
+            glDisable( GL_ALPHA_TEST );
+        }
+
+        // Point at the batch's vertex block.
+        glVertexPointer( 2, GL_FLOAT, 0, mVertices.address() + batch.mVertexStart );
+        glTexCoordPointer( 2, GL_FLOAT, 0, mTextureCoords.address() + batch.mVertexStart );
+
+        // Do we have any colors?
+        if ( batch.mHasColors )
+        {
+            // Yes, so enable color array.
+            glEnableClientState( GL_COLOR_ARRAY );
+            glColorPointer( 4, GL_FLOAT, 0, mColors.address() + batch.mVertexStart );
+        }
+        else
+        {
+            glDisableClientState( GL_COLOR_ARRAY );
+        }
+
+        // Draw the triangles.
+        glDrawElements( GL_TRIANGLES, batch.mIndexCount, GL_UNSIGNED_SHORT, mIndices.address() + batch.mIndexStart );
+    }
+
+    // Reset common render state.
+    glDisableClientState( GL_VERTEX_ARRAY );
+    glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+    glDisableClientState( GL_COLOR_ARRAY );
+    glDisable( GL_ALPHA_TEST );
+    glDisable( GL_BLEND );
+    glDisable( GL_TEXTURE_2D );
+    glPolygonMode( GL_FRONT_AND_BACK, GL_FILL );
+
+    // Restore the view.
+    glMatrixMode( GL_MODELVIEW );
+    glPopMatrix();
+    glMatrixMode( GL_PROJECTION );
+    glPopMatrix();
+    glMatrixMode( GL_MODELVIEW );
+}
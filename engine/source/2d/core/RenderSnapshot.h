@@ -0,0 +1,140 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _RENDER_SNAPSHOT_H_
+#define _RENDER_SNAPSHOT_H_
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+#ifndef _DEBUG_STATS_H_
+#include "2d/scene/DebugStats.h"
+#endif
+
+#ifndef _COLOR_H_
+#include "graphics/color.h"
+#endif
+
+#ifndef _PLATFORMGL_H_
+#include "platform/platformGL.h"
+#endif
+
+#ifndef _TEXTURE_MANAGER_H_
+#include "graphics/TextureManager.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// An immutable record of the draw calls a scene render produced.
+/// A BatchRender with a snapshot as its record target stores each flush here
+/// instead of issuing it, which makes it safe to build off the main thread.
+/// The snapshot is later replayed on the thread that owns the GL context.
+/// Apart from the textures, only plain data is held so no engine objects are referenced once captured.
+/// Texture references are taken on the main thread with holdTextures() so a texture freed or
+/// reloaded before the replay cannot leave a batch with a stale texture name.
+class RenderSnapshot
+{
+public:
+    /// Render state a batch was flushed with.
+    struct BatchState
+    {
+        bool        mBlendMode;
+        GLenum      mSrcBlendFactor;
+        GLenum      mDstBlendFactor;
+        ColorF      mBlendColor;
+        F32         mAlphaTestMode;
+        bool        mWireframeMode;
+    };
+
+private:
+    struct DrawBatch
+    {
+        U32         mVertexStart;
+        U32         mIndexStart;
+        U32         mIndexCount;
+        TextureObject*  mpTextureObject;
+        TextureHandle   mTexture;
+        bool        mHasColors;
+        BatchState  mState;
+    };
+
+    Vector<Vector2>     mVertices;
+    Vector<Vector2>     mTextureCoords;
+    Vector<ColorF>      mColors;
+    Vector<U16>         mIndices;
+    Vector<DrawBatch>   mBatches;
+
+    F32                 mProjectionMatrix[16];
+    F32                 mModelViewMatrix[16];
+    Vector2             mRenderPosition;
+    F32                 mRenderAngle;
+
+    DebugStats          mRenderStats;
+    bool                mValid;
+
+public:
+    RenderSnapshot();
+    virtual ~RenderSnapshot();
+
+    /// Clears the snapshot ready for a new capture.
+    void reset( void );
+
+    /// Records the view the capture was made with, reading the current GL matrices.
+    /// Must be called on the thread owning the GL context.
+    void setView( const Vector2& renderPosition, const F32 renderAngle );
+
+    /// Adds a block of vertices and returns its start for use with addBatch().
+    /// Colors are optional and, when present, one is expected per vertex.
+    U32 addVertices( const Vector2* pVertices, const Vector2* pTextureCoords, const ColorF* pColors, const U32 vertexCount );
+
+    /// Adds a draw batch indexing into a vertex block added with addVertices().
+    /// The texture object is only referenced once holdTextures() is called.
+    void addBatch( const U32 vertexStart, const U16* pIndices, const U32 indexCount, TextureObject* pTextureObject, const bool hasColors, const BatchState& state );
+
+    /// Takes a reference to the texture of each batch, keeping them alive until the snapshot is reset.
+    /// Must be called on the main thread as texture references are not thread-safe.
+    void holdTextures( void );
+
+    /// Whether every batch holds a reference to its texture.
+    bool getTexturesHeld( void ) const;
+
+    /// Marks the capture as complete (or failed).
+    inline void setValid( const bool valid )            { mValid = valid; }
+    inline bool isValid( void ) const                   { return mValid; }
+
+    /// Stats gathered while the snapshot was captured.
+    inline DebugStats& getRenderStats( void )           { return mRenderStats; }
+
+    /// Copies the capture's render and batch stats into the specified stats.
+    void applyRenderStats( DebugStats& debugStats ) const;
+
+    inline U32 getBatchCount( void ) const              { return (U32)mBatches.size(); }
+    inline U32 getVertexCount( void ) const             { return (U32)mVertices.size(); }
+    inline U32 getIndexCount( void ) const              { return (U32)mIndices.size(); }
+
+    /// Issues the recorded draw calls using the captured view.
+    /// Must be called on the thread owning the GL context.
+    void replay( void ) const;
+};
+
+#endif // _RENDER_SNAPSHOT_H_
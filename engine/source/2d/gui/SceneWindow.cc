@@ -29,6 +29,8 @@
 #include "2d/sceneobject/SceneObject.h"
 #include "2d/core/Utility.h"
 #include "2d/gui/SceneWindow.h"
+#include "2d/scene/ScenePipeline.h"
+#include "2d/core/RenderSnapshot.h"
 
 #ifndef _ASSET_MANAGER_H_
 #include "assets/assetManager.h"
@@ -100,6 +102,8 @@ SceneWindow::SceneWindow() :    mpScene(NULL),
                                 mRenderGroupMask(MASK_ALL),
                                 mBackgroundColor( "Black" ),
                                 mUseBackgroundColor(false),   
+                                mPipelinedRender(false),
+                                mRenderSnapshotIndex(0),
                                 mCameraInterpolationMode(SIGMOID),
                                 mMaxQueueItems(64),
                                 mCameraTransitionTime(2.0f),
@@ -122,6 +126,10 @@ SceneWindow::SceneWindow() :    mpScene(NULL),
     VECTOR_SET_ASSOCIATION( mInputEventEntering );
     VECTOR_SET_ASSOCIATION( mInputEventLeaving );    
 
+    // No render snapshots until pipelined.
+    mpRenderSnapshots[0] = NULL;
+    mpRenderSnapshots[1] = NULL;
+
     // Turn-on Tick Processing.
     setProcessTicks( true );
 }
@@ -164,6 +172,9 @@ bool SceneWindow::onAdd()
 
 void SceneWindow::onRemove()
 {
+    // Stop pipelined rendering.
+    setPipelinedRender( false );
+
     // Reset Scene.
     resetScene();
 
@@ -190,6 +201,9 @@ void SceneWindow::initPersistFields()
     // Background color.
     addField("UseBackgroundColor", TypeBool, Offset(mUseBackgroundColor, SceneWindow), &writeUseBackgroundColor, "" );
     addField("BackgroundColor", TypeColorF, Offset(mBackgroundColor, SceneWindow), &writeBackgroundColor, "" );
+
+    // Pipelined rendering.
+    addProtectedField("PipelinedRender", TypeBool, Offset(mPipelinedRender, SceneWindow), &setPipelinedRender, &defaultProtectedGetFn, &writePipelinedRender, "Whether the scene is captured on a worker thread and drawn a frame later." );
 }
 
 //-----------------------------------------------------------------------------
@@ -226,10 +240,60 @@ void SceneWindow::resetScene( void )
     // Clear input event watched objects.
     mInputEventWatching.clear();
 
+    // Discard any snapshot of the previous scene.
+    invalidateRenderSnapshots();
+
     // Reset scene.
     mpScene = NULL;
 }
 
+//-----------------------------------------------------------------------------
+
+void SceneWindow::setPipelinedRender( const bool pipelinedRender )
+{
+    // Ignore no change.
+    if ( pipelinedRender == mPipelinedRender )
+        return;
+
+    if ( pipelinedRender )
+    {
+        // Start using the pipeline.
+        ScenePipeline::acquire();
+        mpRenderSnapshots[0] = new RenderSnapshot();
+        mpRenderSnapshots[1] = new RenderSnapshot();
+        mRenderSnapshotIndex = 0;
+    }
+    else
+    {
+        // Wait for any capture into our snapshots.
+        ScenePipeline::synchronize();
+
+        // Stop using the pipeline.
+        delete mpRenderSnapshots[0];
+        delete mpRenderSnapshots[1];
+        mpRenderSnapshots[0] = NULL;
+        mpRenderSnapshots[1] = NULL;
+        ScenePipeline::release();
+    }
+
+    mPipelinedRender = pipelinedRender;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneWindow::invalidateRenderSnapshots( void )
+{
+    // Finish if not pipelined.
+    if ( !mPipelinedRender )
+        return;
+
+    // Wait for any capture into our snapshots.
+    ScenePipeline::synchronize();
+
+    mpRenderSnapshots[0]->setValid( false );
+    mpRenderSnapshots[1]->setValid( false );
+}
+
 
 //-----------------------------------------------------------------------------
 
@@ -1707,7 +1771,17 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
     }
 
     // Render View.
-    pScene->sceneRender( &sceneRenderState );
+    if ( mPipelinedRender && pScene->canCaptureRender() )
+    {
+        renderPipelined( pScene, sceneRenderState );
+    }
+    else
+    {
+        // Wait for any capture that may be reading the scene.
+        ScenePipeline::synchronize();
+
+        pScene->sceneRender( &sceneRenderState );
+    }
 
     // Restore Matrices.
     glMatrixMode(GL_MODELVIEW);
@@ -1728,6 +1802,37 @@ void SceneWindow::onRender( Point2I offset, const RectI& updateRect )
 
 //------------------------------------------------------------------------------
 
+void SceneWindow::renderPipelined( Scene* pScene, const SceneRenderState& sceneRenderState )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneWindow_RenderPipelined);
+
+    // Wait for the previous capture.
+    ScenePipeline::synchronize();
+
+    // Fetch the snapshots.
+    RenderSnapshot* pFrontSnapshot = mpRenderSnapshots[mRenderSnapshotIndex];
+    RenderSnapshot* pBackSnapshot = mpRenderSnapshots[mRenderSnapshotIndex ^ 1];
+
+    // Prepare to capture this frame, taking the view before any rendering changes it.
+    pBackSnapshot->reset();
+    pBackSnapshot->setView( sceneRenderState.mRenderPosition, sceneRenderState.mRenderAngle );
+
+    // Draw the previous frame if it was captured, otherwise render immediately.
+    if ( pFrontSnapshot->isValid() )
+        pScene->sceneRenderSnapshot( &sceneRenderState, *pFrontSnapshot );
+    else
+        pScene->sceneRender( &sceneRenderState );
+
+    // Capture this frame to be drawn next frame.
+    ScenePipeline::queueCapture( pScene, sceneRenderState, pBackSnapshot );
+
+    // Swap the snapshots.
+    mRenderSnapshotIndex ^= 1;
+}
+
+//------------------------------------------------------------------------------
+
 void SceneWindow::renderMetricsOverlay( Point2I offset, const RectI& updateRect )
 {
     // Debug Profiling.
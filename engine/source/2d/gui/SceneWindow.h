@@ -45,6 +45,10 @@
 
 //-----------------------------------------------------------------------------
 
+class RenderSnapshot;
+
+//-----------------------------------------------------------------------------
+
 class SceneWindow : public GuiControl, public virtual Tickable
 {
     typedef GuiControl Parent;
@@ -98,6 +102,11 @@ private:
     ColorF                      mBackgroundColor;
     bool                        mUseBackgroundColor;
 
+    /// Pipelined rendering.
+    bool                        mPipelinedRender;
+    RenderSnapshot*             mpRenderSnapshots[2];
+    U32                         mRenderSnapshotIndex;
+
     /// Camera Attachment.
     bool                mCameraMounted;
     SceneObject*        mpMountedTo;
@@ -195,6 +204,10 @@ public:
     inline void             setUseBackgroundColor( const bool useBackgroundColor ) { mUseBackgroundColor = useBackgroundColor; }
     inline bool             getUseBackgroundColor( void ) const         { return mUseBackgroundColor; }
 
+    /// Pipelined rendering.
+    void                    setPipelinedRender( const bool pipelinedRender );
+    inline bool             getPipelinedRender( void ) const            { return mPipelinedRender; }
+
     /// Input.
     void setObjectInputEventFilter( const U32 groupMask, const U32 layerMask, const bool useInvisible = false );
     void setObjectInputEventGroupFilter( const U32 groupMask );
@@ -320,6 +333,8 @@ public:
     virtual bool onMouseWheelUp( const GuiEvent &event );
 
     void renderMetricsOverlay( Point2I offset, const RectI& updateRect );
+    void renderPipelined( Scene* pScene, const SceneRenderState& sceneRenderState );
+    void invalidateRenderSnapshots( void );
 
     static CameraInterpolationMode getInterpolationModeEnum(const char* label);
 
@@ -332,6 +347,8 @@ protected:
     static bool writeUseObjectInputEvents( void* obj, StringTableEntry pFieldName ) { return static_cast<SceneWindow*>(obj)->mUseObjectInputEvents == true; }
     static bool writeBackgroundColor( void* obj, StringTableEntry pFieldName )      { return static_cast<SceneWindow*>(obj)->mUseBackgroundColor == true; }
     static bool writeUseBackgroundColor( void* obj, StringTableEntry pFieldName )   { return static_cast<SceneWindow*>(obj)->mUseBackgroundColor == true; }
+    static bool setPipelinedRender( void* obj, const char* data )                   { static_cast<SceneWindow*>(obj)->setPipelinedRender( dAtob(data) ); return false; }
+    static bool writePipelinedRender( void* obj, StringTableEntry pFieldName )      { return static_cast<SceneWindow*>(obj)->mPipelinedRender == true; }
 };
 
 #endif // _SCENE_WINDOW_H_
@@ -1078,6 +1078,29 @@ ConsoleMethodWithDocs(SceneWindow, getUseBackgroundColor, ConsoleBool, 2, 2, (..
 
 //-----------------------------------------------------------------------------
 
+/*! Sets whether the scene is rendered pipelined or not.
+    When pipelined, the scene is captured on a worker thread while the rest of the frame renders and is drawn on the following frame.
+    This adds a frame of latency.  Frames containing objects that cannot be captured (such as shape vectors or debug overlays) render immediately.
+    @param pipelinedRender Whether to render the scene pipelined or not.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneWindow, setPipelinedRender, ConsoleVoid, 3, 3, (pipelinedRender))
+{
+    object->setPipelinedRender( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether the scene is rendered pipelined or not.
+    @return Whether the scene is rendered pipelined or not.
+*/
+ConsoleMethodWithDocs(SceneWindow, getPipelinedRender, ConsoleBool, 2, 2, ())
+{
+    return object->getPipelinedRender();
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Sets whether input events are monitored by the window or not.
     @param inputStatus Whether input events are processed by the window or not.
     @return No return value.
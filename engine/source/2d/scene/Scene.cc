@@ -56,6 +56,22 @@
 #include "2d/core/ParticleSystem.h"
 #endif
 
+#ifndef _SCENE_OBJECT_POOL_H_
+#include "2d/scene/SceneObjectPool.h"
+#endif
+
+#ifndef _RENDER_SNAPSHOT_H_
+#include "2d/core/RenderSnapshot.h"
+#endif
+
+#ifndef _SCENE_PIPELINE_H_
+#include "2d/scene/ScenePipeline.h"
+#endif
+
+#ifndef _STRINGUNIT_H_
+#include "string/stringUnit.h"
+#endif
+
 // Script bindings.
 #include "Scene_ScriptBinding.h"
 
@@ -179,6 +195,11 @@ Scene::Scene() :
     VECTOR_SET_ASSOCIATION( mDeleteRequestsTemp );
     VECTOR_SET_ASSOCIATION( mEndContacts );
     VECTOR_SET_ASSOCIATION( mAssetPreloads );
+    VECTOR_SET_ASSOCIATION( mForceBatchPositionX );
+    VECTOR_SET_ASSOCIATION( mForceBatchPositionY );
+    VECTOR_SET_ASSOCIATION( mForceBatchForceX );
+    VECTOR_SET_ASSOCIATION( mForceBatchForceY );
+    VECTOR_SET_ASSOCIATION( mForceBatchActive );
      
     // Initialize layer sort mode.
     for ( U32 n = 0; n < MAX_LAYERS_SUPPORTED; ++n )
@@ -713,6 +734,9 @@ void Scene::processTick( void )
     // Debug Profiling.
     PROFILE_SCOPE(Scene_ProcessTick);
 
+    // Sanity!
+    AssertFatal( ScenePipeline::isIdle(), "Scene::processTick() - The scene cannot change while a capture is reading it." );
+
     // Finish if the Scene is not added to the simulation.
     if ( !isProperlyAdded() )
         return;
@@ -883,6 +907,19 @@ void Scene::processTick( void )
             mTickedSceneObjects[i]->postIntegrate( mSceneTime, Tickable::smTickSec, pDebugStats );
         }
 
+        // ****************************************************
+        // Native Behavior Stage.
+        // ****************************************************
+
+        // Queue native behaviors of ticked scene objects.
+        for ( S32 i = 0; i < tickedSceneObjectCount; ++i )
+        {
+            mNativeBehaviorBatch.queue( mTickedSceneObjects[i] );
+        }
+
+        // Update native behaviors in template batches.
+        mNativeBehaviorBatch.update( Tickable::smTickSec );
+
         // Scene update callback.
         if( mUpdateCallback )
         {
@@ -946,6 +983,9 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     // Debug Profiling.
     PROFILE_SCOPE(Scene_RenderSceneTotal);
 
+    // Sanity!
+    AssertFatal( ScenePipeline::isIdle(), "Scene::sceneRender() - The scene cannot render while a capture is using the world query." );
+
     // Fetch debug stats.
     DebugStats* pDebugStats = pSceneRenderState->mpDebugStats;
 
@@ -970,6 +1010,79 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     // Set batch renderer wireframe mode.
     mBatchRenderer.setWireframeMode( getDebugMask() & SCENE_DEBUG_WIREFRAME_RENDER );
 
+    // Rotate the world matrix by the camera angle.
+    const Vector2& cameraPosition = pSceneRenderState->mRenderPosition;
+    glTranslatef( cameraPosition.x, cameraPosition.y, 0.0f );
+    glRotatef( mRadToDeg(pSceneRenderState->mRenderAngle), 0.0f, 0.0f, 1.0f );
+    glTranslatef( -cameraPosition.x, -cameraPosition.y, 0.0f );
+
+    // Render the visible layers.
+    renderLayers( pSceneRenderState, &mBatchRenderer, false );
+
+    // Draw controllers.
+    if ( getDebugMask() & Scene::SCENE_DEBUG_CONTROLLERS )
+    {
+        // Fetch the controller set.
+        SimSet* pControllerSet = getControllers();
+
+        // Do we have any scene controllers?
+        if ( pControllerSet != NULL )
+        {
+            // Debug Profiling.
+            PROFILE_SCOPE(Scene_RenderControllers);
+
+            // Yes, so fetch scene controller count.
+            const S32 sceneControllerCount = (S32)pControllerSet->size();
+
+            // Iterate scene controllers.
+            for( S32 i = 0; i < sceneControllerCount; i++ )
+            {
+                // Fetch the scene controller.
+                SceneController* pController = dynamic_cast<SceneController*>((*pControllerSet)[i]);
+
+                // Skip if not a controller.
+                if ( pController == NULL )
+                    continue;
+
+                // Render the overlay.
+                pController->renderOverlay( this, pSceneRenderState, &mBatchRenderer );
+            }
+
+            // Flush isolated batch.
+            mBatchRenderer.flush( pDebugStats->batchIsolatedFlush );
+        }
+    }
+
+    // Draw Joints.
+    if ( getDebugMask() & Scene::SCENE_DEBUG_JOINTS )
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_RenderSceneJointOverlays);
+
+        mDebugDraw.DrawJoints( mpWorld );
+    }
+
+    // Update debug stat ranges.
+    mDebugStats.updateRanges();
+
+    // Are we using the render callback?
+    if( mRenderCallback )
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_OnSceneRendertCallback);
+
+        // Yes, so perform callback.
+        Con::executef( this, 1, "onSceneRender" );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool Scene::renderLayers( const SceneRenderState* pSceneRenderState, BatchRender* pBatchRenderer, const bool capture )
+{
+    // Fetch debug stats.
+    DebugStats* pDebugStats = pSceneRenderState->mpDebugStats;
+
     // Debug Profiling.
     PROFILE_START(Scene_RenderSceneVisibleQuery);
 
@@ -977,12 +1090,6 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
     b2AABB cameraAABB;
     CoreMath::mRotateAABB( pSceneRenderState->mRenderAABB, pSceneRenderState->mRenderAngle, cameraAABB );
 
-    // Rotate the world matrix by the camera angle.
-    const Vector2& cameraPosition = pSceneRenderState->mRenderPosition;
-    glTranslatef( cameraPosition.x, cameraPosition.y, 0.0f );
-    glRotatef( mRadToDeg(pSceneRenderState->mRenderAngle), 0.0f, 0.0f, 1.0f );
-    glTranslatef( -cameraPosition.x, -cameraPosition.y, 0.0f );
-
     // Clear world query.
     mpWorldQuery->clearQuery();
 
@@ -1017,6 +1124,23 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
             // Are there any objects to render in this layer?
             if ( layerObjectCount > 0 )
             {
+                // Are we capturing?
+                if ( capture )
+                {
+                    // Yes, so only batch rendered objects without debug overlays can be captured.
+                    for( typeWorldQueryResultVector::iterator worldQueryItr = layerResults.begin(); worldQueryItr != layerResults.end(); ++worldQueryItr )
+                    {
+                        SceneObject* pSceneObject = worldQueryItr->mpSceneObject;
+
+                        if ( pSceneObject->shouldRender() && ( !pSceneObject->isBatchRendered() || pSceneObject->getDebugMask() != 0 ) )
+                        {
+                            // Cache render queue.
+                            SceneRenderQueueFactory.cacheObject( pSceneRenderQueue );
+                            return false;
+                        }
+                    }
+                }
+
                 // Yes, so increase render picked.
                 pDebugStats->renderPicked += layerObjectCount;
 
@@ -1083,7 +1207,7 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                     SceneRenderQueue::RenderSort& mode = mLayerSortModes[layer];
 
                     // Temporarily switch to normal sort if batch sort but batcher disabled.
-                    if ( !mBatchRenderer.getBatchEnabled() && mode == SceneRenderQueue::RENDER_SORT_BATCH )
+                    if ( !pBatchRenderer->getBatchEnabled() && mode == SceneRenderQueue::RENDER_SORT_BATCH )
                         mode = SceneRenderQueue::RENDER_SORT_NEWEST;
 
                     // Set render queue mode.
@@ -1106,29 +1230,29 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                     SceneRenderObject* pSceneRenderObject = pSceneRenderRequest->mpSceneRenderObject;
              
                     // Flush if the object is not render batched and we're in strict order mode.
-                    if ( !pSceneRenderObject->isBatchRendered() && mBatchRenderer.getStrictOrderMode() )
+                    if ( !pSceneRenderObject->isBatchRendered() && pBatchRenderer->getStrictOrderMode() )
                     {
-                        mBatchRenderer.flush( pDebugStats->batchNoBatchFlush );
+                        pBatchRenderer->flush( pDebugStats->batchNoBatchFlush );
                     }
                     // Flush if the object is batch isolated.
                     else if ( pSceneRenderObject->getBatchIsolated() )
                     {
-                        mBatchRenderer.flush( pDebugStats->batchIsolatedFlush );
+                        pBatchRenderer->flush( pDebugStats->batchIsolatedFlush );
                     }
 
                     // Yes, so is the object batch rendered?
                     if ( pSceneRenderObject->isBatchRendered() )
                     {
                         // Yes, so set the blend mode.
-                        mBatchRenderer.setBlendMode( pSceneRenderRequest );
+                        pBatchRenderer->setBlendMode( pSceneRenderRequest );
 
                         // Set the alpha test mode.
-                        mBatchRenderer.setAlphaTestMode( pSceneRenderRequest );
+                        pBatchRenderer->setAlphaTestMode( pSceneRenderRequest );
                     }
 
                     // Set batch strict order mode.
                     // NOTE:    We keep reasserting this because an object is free to change it during rendering.
-                    mBatchRenderer.setStrictOrderMode( pSceneRenderQueue->getStrictOrderMode() );
+                    pBatchRenderer->setStrictOrderMode( pSceneRenderQueue->getStrictOrderMode() );
 
                     // Is the object batch isolated?
                     if ( pSceneRenderObject->getBatchIsolated() )
@@ -1151,7 +1275,7 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                             // Yes, so iterate isolated render requests.
                             for( SceneRenderQueue::typeRenderRequestVector::iterator isolatedRenderRequestItr = isolatedRenderRequests.begin(); isolatedRenderRequestItr != isolatedRenderRequests.end(); ++isolatedRenderRequestItr )
                             {
-                                pSceneRenderObject->sceneRender( pSceneRenderState, *isolatedRenderRequestItr, &mBatchRenderer );
+                                pSceneRenderObject->sceneRender( pSceneRenderState, *isolatedRenderRequestItr, pBatchRenderer );
                             }
                         }
                         else
@@ -1159,7 +1283,7 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                             // No, so iterate isolated render requests.
                             for( SceneRenderQueue::typeRenderRequestVector::iterator isolatedRenderRequestItr = isolatedRenderRequests.begin(); isolatedRenderRequestItr != isolatedRenderRequests.end(); ++isolatedRenderRequestItr )
                             {
-                                pSceneRenderObject->sceneRenderFallback( pSceneRenderState, *isolatedRenderRequestItr, &mBatchRenderer );
+                                pSceneRenderObject->sceneRenderFallback( pSceneRenderState, *isolatedRenderRequestItr, pBatchRenderer );
                             }
 
                             // Increase render fallbacks.
@@ -1167,7 +1291,7 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                         }
 
                         // Flush isolated batch.
-                        mBatchRenderer.flush( pDebugStats->batchIsolatedFlush );
+                        pBatchRenderer->flush( pDebugStats->batchIsolatedFlush );
                     }
                     else
                     {
@@ -1175,12 +1299,12 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
                         if ( pSceneRenderObject->validRender() )
                         {
                             // Yes, so render object.
-                            pSceneRenderObject->sceneRender( pSceneRenderState, pSceneRenderRequest, &mBatchRenderer );
+                            pSceneRenderObject->sceneRender( pSceneRenderState, pSceneRenderRequest, pBatchRenderer );
                         }
                         else
                         {
                             // No, so render using fallback.
-                            pSceneRenderObject->sceneRenderFallback( pSceneRenderState, pSceneRenderRequest, &mBatchRenderer );
+                            pSceneRenderObject->sceneRenderFallback( pSceneRenderState, pSceneRenderRequest, pBatchRenderer );
 
                             // Increase render fallbacks.
                             pDebugStats->renderFallbacks++;
@@ -1190,10 +1314,11 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
                 // Flush.
                 // NOTE:    We cannot batch between layers as we adhere to a strict layer render order.
-                mBatchRenderer.flush( pDebugStats->batchLayerFlush );
+                pBatchRenderer->flush( pDebugStats->batchLayerFlush );
 
                 // Iterate query results.
-                for( typeWorldQueryResultVector::iterator worldQueryItr = layerResults.begin(); worldQueryItr != layerResults.end(); ++worldQueryItr )
+                // NOTE:    Overlays render directly so are never part of a capture.
+                for( typeWorldQueryResultVector::iterator worldQueryItr = layerResults.begin(); !capture && worldQueryItr != layerResults.end(); ++worldQueryItr )
                 {
                     // Debug Profiling.
                     PROFILE_SCOPE(Scene_RenderObjectOverlays);
@@ -1214,48 +1339,47 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
         SceneRenderQueueFactory.cacheObject( pSceneRenderQueue );
     }
 
-    // Draw controllers.
-    if ( getDebugMask() & Scene::SCENE_DEBUG_CONTROLLERS )
-    {
-        // Fetch the controller set.
-        SimSet* pControllerSet = getControllers();
+    return true;
+}
 
-        // Do we have any scene controllers?
-        if ( pControllerSet != NULL )
-        {
-            // Debug Profiling.
-            PROFILE_SCOPE(Scene_RenderControllers);
+//-----------------------------------------------------------------------------
 
-            // Yes, so fetch scene controller count.
-            const S32 sceneControllerCount = (S32)pControllerSet->size();
+bool Scene::canCaptureRender( void ) const
+{
+    // Controller and joint debug overlays render directly so cannot be captured.
+    const U32 captureDebugMask = SCENE_DEBUG_METRICS | SCENE_DEBUG_FPS_METRICS | SCENE_DEBUG_WIREFRAME_RENDER;
 
-            // Iterate scene controllers.
-            for( S32 i = 0; i < sceneControllerCount; i++ )
-            {
-                // Fetch the scene controller.
-                SceneController* pController = dynamic_cast<SceneController*>((*pControllerSet)[i]);
+    return ( getDebugMask() & ~captureDebugMask ) == 0;
+}
 
-                // Skip if not a controller.
-                if ( pController == NULL )
-                    continue;
+//-----------------------------------------------------------------------------
 
-                // Render the overlay.
-                pController->renderOverlay( this, pSceneRenderState, &mBatchRenderer );
-            }
+bool Scene::sceneCapture( const SceneRenderState* pSceneRenderState, BatchRender* pBatchRenderer )
+{
+    // Sanity!
+    AssertFatal( pBatchRenderer->getRecordTarget() != NULL, "Scene::sceneCapture() - The batch renderer must have a record target." );
 
-            // Flush isolated batch.
-            mBatchRenderer.flush( pDebugStats->batchIsolatedFlush );
-        }
-    }
+    // Configure the batch renderer like our own.
+    pBatchRenderer->setDebugStats( pSceneRenderState->mpDebugStats );
+    pBatchRenderer->setWireframeMode( getDebugMask() & SCENE_DEBUG_WIREFRAME_RENDER );
+    pBatchRenderer->setBatchEnabled( mBatchRenderer.getBatchEnabled() );
 
-    // Draw Joints.
-    if ( getDebugMask() & Scene::SCENE_DEBUG_JOINTS )
-    {
-        // Debug Profiling.
-        PROFILE_SCOPE(Scene_RenderSceneJointOverlays);
+    // Capture the visible layers.
+    return renderLayers( pSceneRenderState, pBatchRenderer, true );
+}
 
-        mDebugDraw.DrawJoints( mpWorld );
-    }
+//-----------------------------------------------------------------------------
+
+void Scene::sceneRenderSnapshot( const SceneRenderState* pSceneRenderState, const RenderSnapshot& snapshot )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_RenderSnapshot);
+
+    // Draw the snapshot.
+    snapshot.replay();
+
+    // Update the render stats from the capture.
+    snapshot.applyRenderStats( *pSceneRenderState->mpDebugStats );
 
     // Update debug stat ranges.
     mDebugStats.updateRanges();
@@ -1275,6 +1399,9 @@ void Scene::sceneRender( const SceneRenderState* pSceneRenderState )
 
 void Scene::clearScene( bool deleteObjects )
 {
+    // Clear the object pools.
+    clearObjectPools();
+
     while( mSceneObjects.size() > 0 )
     {
         // Fetch first scene object.
@@ -1295,8 +1422,7 @@ void Scene::clearScene( bool deleteObjects )
     if ( pControllerSet != NULL )
     {
         // Yes, so delete them all.
-        while( pControllerSet->size() > 0 )
-            pControllerSet->at(0)->deleteObject();
+        pControllerSet->deleteObjects();
     }
 
     // Clear asset preloads.
@@ -1333,6 +1459,7 @@ void Scene::addToScene( SceneObject* pSceneObject )
     }
 
     // Add scene object.
+    pSceneObject->mSceneSlot = mSceneObjects.size();
     mSceneObjects.push_back( pSceneObject );
 
     // Register with the scene.
@@ -1383,22 +1510,269 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
     // Unregister from scene.
     pSceneObject->OnUnregisterScene( this );
 
-    // Find scene object and remove it quickly.
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
+    // Fetch the scene object slot.
+    U32 sceneSlot = pSceneObject->mSceneSlot;
+
+    // Sanity!
+    AssertFatal( sceneSlot < (U32)mSceneObjects.size() && mSceneObjects[sceneSlot] == pSceneObject, "Scene::removeFromScene() - Scene object has a stale scene slot." );
+
+    // For when the assert is not used.
+    if ( sceneSlot >= (U32)mSceneObjects.size() || mSceneObjects[sceneSlot] != pSceneObject )
     {
-        if ( mSceneObjects[n] == pSceneObject )
+        for ( sceneSlot = 0; sceneSlot < (U32)mSceneObjects.size(); ++sceneSlot )
         {
-            mSceneObjects.erase_fast( n );
-            break;
+            if ( mSceneObjects[sceneSlot] == pSceneObject )
+                break;
         }
     }
 
+    // Remove the scene object keeping the order of the rest as it is the tick, render-submit and TAML write order.
+    if ( sceneSlot < (U32)mSceneObjects.size() )
+    {
+        mSceneObjects.erase( sceneSlot );
+
+        // Update the slots of the objects that moved.
+        for ( U32 n = sceneSlot; n < (U32)mSceneObjects.size(); ++n )
+            mSceneObjects[n]->mSceneSlot = n;
+    }
+
     // Perform callback.
     Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
 }
 
 //-----------------------------------------------------------------------------
 
+U32 Scene::addToScene( const typeSceneObjectVector& sceneObjects )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_AddToSceneBulk);
+
+    // Fetch the object count.
+    const U32 objectCount = sceneObjects.size();
+
+    // Finish if nothing to add.
+    if ( objectCount == 0 )
+        return 0;
+
+    // Reserve the scene objects.
+    mSceneObjects.reserve( mSceneObjects.size() + objectCount );
+
+    // Reserve the added objects.
+    // These are held by Id as the callbacks below may delete objects.
+    Vector<SimObjectId> addedObjects;
+    addedObjects.reserve( objectCount );
+
+    // Reserve the registered objects.
+    typeSceneObjectVector registeredObjects;
+    registeredObjects.reserve( objectCount );
+
+    U32 addedCount = 0;
+    U32 unregisteredCount = 0;
+
+    // Defer the world proxies so they can be built in bulk.
+    mpWorldQuery->beginBulkAdd();
+
+    // Register the objects with the scene.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_AddToSceneBulkRegister);
+
+        for ( U32 n = 0; n < objectCount; ++n )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = sceneObjects[n];
+
+            if ( pSceneObject == NULL )
+                continue;
+
+            // Fetch current scene.
+            Scene* pCurrentScene = pSceneObject->getScene();
+
+            // Ignore if already in the scene.
+            if ( pCurrentScene == this )
+                continue;
+
+            // Remove from any other scene.
+            if ( pCurrentScene )
+                pCurrentScene->removeFromScene( pSceneObject );
+
+            // Add scene object.
+            pSceneObject->mSceneSlot = mSceneObjects.size();
+            mSceneObjects.push_back( pSceneObject );
+
+            // Register with the scene.
+            pSceneObject->OnRegisterScene( this );
+            registeredObjects.push_back( pSceneObject );
+
+            addedCount++;
+
+            // Callbacks can only be performed if properly added to the simulation.
+            if ( pSceneObject->isProperlyAdded() )
+                addedObjects.push_back( pSceneObject->getId() );
+            else
+                unregisteredCount++;
+        }
+    }
+
+    // Activate the bodies.
+    // They were created inactive so their broad-phase proxies can be built in a single pass.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_AddToSceneBulkActivate);
+
+        Vector<b2Body*> bodies;
+        bodies.reserve( registeredObjects.size() );
+
+        for ( U32 n = 0; n < (U32)registeredObjects.size(); ++n )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = registeredObjects[n];
+
+            // Skip if no longer in this scene.
+            if ( pSceneObject->getScene() != this )
+                continue;
+
+            // Fetch body.
+            b2Body* pBody = pSceneObject->getBody();
+
+            // Skip if the body should stay inactive.
+            if ( !pSceneObject->isEnabled() || !pSceneObject->mBodyDefinition.active || pBody->IsActive() )
+                continue;
+
+            bodies.push_back( pBody );
+        }
+
+        if ( bodies.size() > 0 )
+            mpWorld->ActivateBodies( bodies.address(), bodies.size() );
+    }
+
+    // Build the deferred world proxies.
+    mpWorldQuery->endBulkAdd();
+
+    // Perform the callbacks as a single batch.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_AddToSceneBulkCallbacks);
+
+        for ( U32 n = 0; n < (U32)addedObjects.size(); ++n )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = Sim::findObject<SceneObject>( addedObjects[n] );
+
+            // Skip if deleted or removed by an earlier callback.
+            if ( pSceneObject == NULL || pSceneObject->getScene() != this )
+                continue;
+
+            Con::executef(pSceneObject, 2, "onAddToScene", getIdString());
+        }
+
+        // Warning.
+        if ( unregisteredCount > 0 )
+            Con::warnf("Scene::addToScene() - %d scene object(s) added to scene but not registered with the simulation.  No 'onAddToScene' can be performed!  Use Target scene.", unregisteredCount);
+    }
+
+    return addedCount;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Scene::removeFromScene( const typeSceneObjectVector& sceneObjects )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_RemoveFromSceneBulk);
+
+    // Fetch the object count.
+    const U32 objectCount = sceneObjects.size();
+
+    // Finish if nothing to remove.
+    if ( objectCount == 0 )
+        return 0;
+
+    // Reserve the removed objects.
+    // These are held by Id as the callbacks below may delete objects.
+    Vector<SimObjectId> removedObjects;
+    removedObjects.reserve( objectCount );
+
+    // Unregister the objects from the scene.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_RemoveFromSceneBulkUnregister);
+
+        for ( U32 n = 0; n < objectCount; ++n )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = sceneObjects[n];
+
+            // Skip if not in this scene.
+            if ( pSceneObject == NULL || pSceneObject->getScene() != this )
+                continue;
+
+            // Remove as debug-object if set.
+            if ( pSceneObject == getDebugSceneObject() )
+                setDebugSceneObject( NULL );
+
+            // Process Destroy Notifications.
+            pSceneObject->processDestroyNotifications();
+
+            // Dismount Any Camera.
+            pSceneObject->dismountCamera();
+
+            // Remove from the SceneWindow last pickers
+            for( U32 i = 0; i < (U32)mAttachedSceneWindows.size(); ++i )
+            {
+                (dynamic_cast<SceneWindow*>(mAttachedSceneWindows[i]))->removeFromInputEventPick(pSceneObject);
+            }
+
+            // Unregister from scene.
+            pSceneObject->OnUnregisterScene( this );
+
+            removedObjects.push_back( pSceneObject->getId() );
+        }
+    }
+
+    // Compact the scene objects in a single pass.
+    // Unregistered objects no longer reference this scene.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_RemoveFromSceneBulkCompact);
+
+        U32 writeIndex = 0;
+        for ( U32 n = 0; n < (U32)mSceneObjects.size(); ++n )
+        {
+            SceneObject* pSceneObject = mSceneObjects[n];
+
+            if ( pSceneObject->getScene() == this )
+            {
+                pSceneObject->mSceneSlot = writeIndex;
+                mSceneObjects[writeIndex++] = pSceneObject;
+            }
+        }
+        mSceneObjects.setSize( writeIndex );
+    }
+
+    // Perform the callbacks as a single batch.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(Scene_RemoveFromSceneBulkCallbacks);
+
+        for ( U32 n = 0; n < (U32)removedObjects.size(); ++n )
+        {
+            // Fetch scene object.
+            SceneObject* pSceneObject = Sim::findObject<SceneObject>( removedObjects[n] );
+
+            // Skip if deleted by an earlier callback.
+            if ( pSceneObject == NULL )
+                continue;
+
+            Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
+        }
+    }
+
+    return removedObjects.size();
+}
+
+//-----------------------------------------------------------------------------
+
 SceneObject* Scene::getSceneObject( const U32 objectIndex ) const
 {
     // Sanity!
@@ -1562,6 +1936,158 @@ void Scene::mergeScene( const Scene* pScene )
 
 //-----------------------------------------------------------------------------
 
+void Scene::applyForceBatch( b2Body* const* pBodies, const b2Vec2* pForces, const U32 bodyCount, const bool wake )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_ApplyForceBatch);
+
+    // Sanity!
+    AssertFatal( bodyCount == 0 || (pBodies != NULL && pForces != NULL), "Scene::applyForceBatch() - Invalid body or force array." );
+
+    for ( U32 n = 0; n < bodyCount; ++n )
+    {
+        // Apply the force to the center of mass.
+        pBodies[n]->ApplyForceToCenter( pForces[n], wake );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::applyUniformForceBatch( b2Body* const* pBodies, const b2Vec2& force, const U32 bodyCount, const bool wake )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_ApplyUniformForceBatch);
+
+    // Sanity!
+    AssertFatal( bodyCount == 0 || pBodies != NULL, "Scene::applyUniformForceBatch() - Invalid body array." );
+
+    for ( U32 n = 0; n < bodyCount; ++n )
+    {
+        // Apply the force to the center of mass.
+        pBodies[n]->ApplyForceToCenter( force, wake );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Scene::applyPointForceBatch(
+                                b2Body* const* pBodies, const U32 bodyCount,
+                                const b2Vec2& forcePosition,
+                                const F32 radius,
+                                const F32 force,
+                                const bool nonLinear,
+                                const F32 linearDrag,
+                                const F32 angularDrag )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_ApplyPointForceBatch);
+
+    // Finish if nothing to do.
+    if ( bodyCount == 0 || mIsZero( force ) || mIsZero( radius ) )
+        return 0;
+
+    // Sanity!
+    AssertFatal( pBodies != NULL, "Scene::applyPointForceBatch() - Invalid body array." );
+
+    // Size the scratch arrays.  These are retained between calls so steady-state batches do not allocate.
+    mForceBatchPositionX.setSize( bodyCount );
+    mForceBatchPositionY.setSize( bodyCount );
+    mForceBatchForceX.setSize( bodyCount );
+    mForceBatchForceY.setSize( bodyCount );
+    mForceBatchActive.setSize( bodyCount );
+
+    F32* pPositionX = mForceBatchPositionX.address();
+    F32* pPositionY = mForceBatchPositionY.address();
+    F32* pForceX = mForceBatchForceX.address();
+    F32* pForceY = mForceBatchForceY.address();
+    U8* pActive = mForceBatchActive.address();
+
+    // Gather the body positions into contiguous arrays.
+    for ( U32 n = 0; n < bodyCount; ++n )
+    {
+        const b2Vec2& position = pBodies[n]->GetPosition();
+        pPositionX[n] = position.x;
+        pPositionY[n] = position.y;
+    }
+
+    // Calculate the radius squared.
+    const F32 radiusSqr = radius * radius;
+
+    // Calculate the force squared in-case we need it.
+    const F32 forceSqr = force * force * (( force < 0.0f ) ? -1.0f : 1.0f);
+
+    // Fetch the force position.
+    const F32 centerX = forcePosition.x;
+    const F32 centerY = forcePosition.y;
+
+    // Calculate the falloff.  The loops are branch-free so that the compiler can vectorize them.
+    if ( nonLinear )
+    {
+        // Use an approximation of the inverse-square law.
+        for ( U32 n = 0; n < bodyCount; ++n )
+        {
+            const F32 distanceX = centerX - pPositionX[n];
+            const F32 distanceY = centerY - pPositionY[n];
+            const F32 distanceSqr = distanceX * distanceX + distanceY * distanceY;
+            const bool active = distanceSqr <= radiusSqr && distanceSqr >= FLT_EPSILON;
+            const F32 scale = active ? forceSqr / distanceSqr : 0.0f;
+            pForceX[n] = distanceX * scale;
+            pForceY[n] = distanceY * scale;
+            pActive[n] = active ? 1 : 0;
+        }
+    }
+    else
+    {
+        // Normalize to the specified force (linear).
+        for ( U32 n = 0; n < bodyCount; ++n )
+        {
+            const F32 distanceX = centerX - pPositionX[n];
+            const F32 distanceY = centerY - pPositionY[n];
+            const F32 distanceSqr = distanceX * distanceX + distanceY * distanceY;
+            const bool active = distanceSqr <= radiusSqr && distanceSqr >= FLT_EPSILON;
+            const F32 scale = active ? force / mSqrt( distanceSqr ) : 0.0f;
+            pForceX[n] = distanceX * scale;
+            pForceY[n] = distanceY * scale;
+            pActive[n] = active ? 1 : 0;
+        }
+    }
+
+    // Calculate drag coefficients (time-integrated).
+    const F32 linearDragScale = 1.0f - linearDrag;
+    const F32 angularDragScale = 1.0f - angularDrag;
+
+    // Reset the affected count.
+    U32 affectedCount = 0;
+
+    // Apply the forces.
+    for ( U32 n = 0; n < bodyCount; ++n )
+    {
+        // Skip if outside the radius or centered on the force position.
+        if ( pActive[n] == 0 )
+            continue;
+
+        // Fetch the body.
+        b2Body* pBody = pBodies[n];
+
+        // Apply the force.
+        pBody->ApplyForceToCenter( b2Vec2( pForceX[n], pForceY[n] ), true );
+
+        // Linear drag?
+        if ( linearDrag > 0.0f )
+            pBody->SetLinearVelocity( linearDragScale * pBody->GetLinearVelocity() );
+
+        // Angular drag?
+        if ( angularDrag > 0.0f )
+            pBody->SetAngularVelocity( angularDragScale * pBody->GetAngularVelocity() );
+
+        affectedCount++;
+    }
+
+    return affectedCount;
+}
+
+//-----------------------------------------------------------------------------
+
 b2Joint* Scene::findJoint( const S32 jointId )
 {
     // Find joint.
@@ -3765,6 +4291,88 @@ void Scene::processDeleteRequests( const bool forceImmediate )
 
 //-----------------------------------------------------------------------------
 
+SceneObject* Scene::acquireObject( SceneObject* pTemplate )
+{
+    // Sanity!
+    AssertFatal( pTemplate != NULL, "Scene::acquireObject() - Cannot acquire from a NULL template." );
+
+    // Find the pool for the template.
+    SceneObjectPool* pObjectPool = findObjectPool( pTemplate, true );
+
+    return pObjectPool->acquire( this );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Scene::releaseObject( SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject != NULL, "Scene::releaseObject() - Cannot release a NULL object." );
+
+    // Finish if not a pooled object.
+    if ( !pSceneObject->isPooled() )
+        return false;
+
+    // Find the pool the object came from.
+    typeObjectPoolHash::iterator itr = mObjectPools.find( pSceneObject->getPoolTemplateId() );
+
+    // Finish if the pool no longer exists.
+    if ( itr == mObjectPools.end() )
+        return false;
+
+    return itr->value->release( pSceneObject );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Scene::preallocateObjects( SceneObject* pTemplate, const U32 count )
+{
+    // Sanity!
+    AssertFatal( pTemplate != NULL, "Scene::preallocateObjects() - Cannot preallocate from a NULL template." );
+
+    // Find the pool for the template.
+    SceneObjectPool* pObjectPool = findObjectPool( pTemplate, true );
+
+    return pObjectPool->preallocate( this, count );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectPool* Scene::findObjectPool( const SceneObject* pTemplate, const bool createPool )
+{
+    // Find the pool.
+    typeObjectPoolHash::iterator itr = mObjectPools.find( pTemplate->getId() );
+
+    // Finish if found.
+    if ( itr != mObjectPools.end() )
+        return itr->value;
+
+    // Finish if not creating a pool.
+    if ( !createPool )
+        return NULL;
+
+    // Create the pool.
+    SceneObjectPool* pObjectPool = new SceneObjectPool( const_cast<SceneObject*>( pTemplate ) );
+    mObjectPools.insert( pTemplate->getId(), pObjectPool );
+
+    return pObjectPool;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::clearObjectPools( void )
+{
+    // Delete the pools.  This deletes any idle objects.
+    for( typeObjectPoolHash::iterator itr = mObjectPools.begin(); itr != mObjectPools.end(); ++itr )
+    {
+        delete itr->value;
+    }
+
+    mObjectPools.clear();
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::SayGoodbye( b2Joint* pJoint )
 {
     // Find the joint id.
@@ -71,6 +71,10 @@
 #include "component/behaviors/behaviorComponent.h"
 #endif
 
+#ifndef _NATIVE_BEHAVIORINSTANCE_H_
+#include "component/behaviors/nativeBehaviorInstance.h"
+#endif
+
 #ifndef _ASSET_PTR_H_
 #include "assets/assetPtr.h"
 #endif
@@ -83,6 +87,8 @@ extern EnumTable jointTypeTable;
 
 class SceneObject;
 class SceneWindow;
+class SceneObjectPool;
+class RenderSnapshot;
 
 ///-----------------------------------------------------------------------------
 
@@ -172,6 +178,7 @@ public:
     typedef Vector<TickContact>                 typeContactVector;
     typedef HashMap<b2Contact*, TickContact>    typeContactHash;
     typedef Vector<AssetPtr<AssetBase>*>        typeAssetPtrVector;
+    typedef HashMap<SimObjectId, SceneObjectPool*> typeObjectPoolHash;
 
     /// Scene Debug Options.
     enum DebugOption
@@ -223,6 +230,7 @@ private:
     /// Scene occupancy.
     typeSceneObjectVector       mSceneObjects;
     typeSceneObjectVector       mTickedSceneObjects;
+    NativeBehaviorBatch         mNativeBehaviorBatch;
 
     /// Joint access.
     typeJointHash               mJoints;
@@ -232,6 +240,13 @@ private:
     /// Scene controllers.
     SimObjectPtr<SimSet>	    mControllers;
 
+    /// Batched forces (structure-of-arrays scratch).
+    Vector<F32>                 mForceBatchPositionX;
+    Vector<F32>                 mForceBatchPositionY;
+    Vector<F32>                 mForceBatchForceX;
+    Vector<F32>                 mForceBatchForceY;
+    Vector<U8>                  mForceBatchActive;
+
     /// Asset pre-loads.
     typeAssetPtrVector          mAssetPreloads;
 
@@ -259,6 +274,9 @@ private:
     /// Delete requests.
     typeDeleteVector            mDeleteRequests;
     typeDeleteVector            mDeleteRequestsTemp;
+
+    /// Object pooling.
+    typeObjectPoolHash          mObjectPools;
   
     /// Miscellaneous.
     S32                         mIsEditorScene;
@@ -274,6 +292,9 @@ private:
     void                        dispatchBeginContactCallbacks( void );
     void                        dispatchEndContactCallbacks( void );
 
+    /// Rendering.
+    bool                        renderLayers( const SceneRenderState* pSceneRenderState, BatchRender* pBatchRenderer, const bool capture );
+
     /// Joint definition.
     struct CommonJointDefinition
     {
@@ -327,6 +348,9 @@ public:
 
     /// Render output.
     void                    sceneRender( const SceneRenderState* pSceneRenderState );
+    bool                    canCaptureRender( void ) const;
+    bool                    sceneCapture( const SceneRenderState* pSceneRenderState, BatchRender* pBatchRenderer );
+    void                    sceneRenderSnapshot( const SceneRenderState* pSceneRenderState, const RenderSnapshot& snapshot );
 
     /// World.
     inline b2World*         getWorld( void ) const                      { return mpWorld; }
@@ -345,6 +369,8 @@ public:
     void                    clearScene( bool deleteObjects = true );
     void                    addToScene( SceneObject* pSceneObject );
     void                    removeFromScene( SceneObject* pSceneObject );
+    U32                     addToScene( const typeSceneObjectVector& sceneObjects );
+    U32                     removeFromScene( const typeSceneObjectVector& sceneObjects );
 
     inline typeSceneObjectVectorConstRef getSceneObjects( void ) const  { return mSceneObjects; }
     inline U32              getSceneObjectCount( void ) const           { return mSceneObjects.size(); }
@@ -356,6 +382,18 @@ public:
 
     inline SimSet*			getControllers( void )						{ return mControllers; }
 
+    /// Batched forces.
+    void                    applyForceBatch( b2Body* const* pBodies, const b2Vec2* pForces, const U32 bodyCount, const bool wake = true );
+    void                    applyUniformForceBatch( b2Body* const* pBodies, const b2Vec2& force, const U32 bodyCount, const bool wake = true );
+    U32                     applyPointForceBatch(
+                                b2Body* const* pBodies, const U32 bodyCount,
+                                const b2Vec2& forcePosition,
+                                const F32 radius,
+                                const F32 force,
+                                const bool nonLinear,
+                                const F32 linearDrag = 0.0f,
+                                const F32 angularDrag = 0.0f );
+
     inline S32              getAssetPreloadCount( void ) const          { return mAssetPreloads.size(); }
     const AssetPtr<AssetBase>* getAssetPreload( const S32 index ) const;
     void                    addAssetPreload( const char* pAssetId );
@@ -648,6 +686,14 @@ public:
     void                    addDeleteRequest( SceneObject* pSceneObject );
     void                    processDeleteRequests( const bool forceImmediate );
 
+    /// Object pooling.
+    SceneObject*            acquireObject( SceneObject* pTemplate );
+    bool                    releaseObject( SceneObject* pSceneObject );
+    U32                     preallocateObjects( SceneObject* pTemplate, const U32 count );
+    SceneObjectPool*        findObjectPool( const SceneObject* pTemplate, const bool createPool = false );
+    void                    clearObjectPools( void );
+    inline const typeObjectPoolHash& getObjectPools( void ) const       { return mObjectPools; }
+
     /// Destruction listeners.
     virtual                 void SayGoodbye( b2Joint* pJoint );
     virtual                 void SayGoodbye( b2Fixture* pFixture )      {}
@@ -0,0 +1,313 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_BENCHMARK_H_
+#include "2d/scene/SceneBenchmark.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _ENGINE_VERSION_H_
+#include "game/version.h"
+#endif
+
+/// RapidJson.
+#include "rapidjson/prettywriter.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+// Script bindings.
+#include "SceneBenchmark_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+Vector<SceneBenchmark::ScenarioResult> SceneBenchmark::smScenarios;
+Vector<SceneBenchmark::PhaseResult> SceneBenchmark::smPhases;
+
+//-----------------------------------------------------------------------------
+
+static S32 QSORT_CALLBACK comparePhaseTotalTime( const void* a, const void* b )
+{
+    const F64 totalA = ((const SceneBenchmark::PhaseResult*)a)->mTotalMs;
+    const F64 totalB = ((const SceneBenchmark::PhaseResult*)b)->mTotalMs;
+
+    return totalA < totalB ? 1 : totalA > totalB ? -1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneBenchmark::runScenario( const char* pName, Scene* pScene, const U32 ticks, const RectF* pRenderArea )
+{
+    // Sanity!
+    AssertFatal( pName != NULL, "SceneBenchmark::runScenario() - Cannot use a NULL scenario name." );
+
+    // Finish if the scene is invalid.
+    if ( pScene == NULL || !pScene->isProperlyAdded() )
+    {
+        Con::warnf( "SceneBenchmark::runScenario() - Cannot run scenario '%s' as the scene is invalid.", pName );
+        return false;
+    }
+
+    // Finish if no ticks were requested.
+    if ( ticks == 0 )
+    {
+        Con::warnf( "SceneBenchmark::runScenario() - Cannot run scenario '%s' for zero ticks.", pName );
+        return false;
+    }
+
+    // Warn if the scene won't do anything.
+    if ( pScene->getScenePause() )
+        Con::warnf( "SceneBenchmark::runScenario() - Running scenario '%s' but its scene is paused.", pName );
+
+#ifdef TORQUE_ENABLE_PROFILER
+    bool profiling = false;
+
+    // Start profiling from clean data.
+    if ( gProfiler != NULL )
+    {
+        gProfiler->reset();
+        profiling = gProfiler->enableNow( true );
+
+        if ( !profiling )
+            Con::warnf( "SceneBenchmark::runScenario() - Phase timings are unavailable for scenario '%s' as it is not being run from the top level.", pName );
+    }
+#endif
+
+    const U32 tickMs = Tickable::smTickMs;
+
+    ScenarioResult scenario;
+    scenario.mName            = StringTable->insert( pName );
+    scenario.mTicks           = ticks;
+    scenario.mTickMs          = tickMs;
+    scenario.mRendered        = pRenderArea != NULL;
+    scenario.mRenderRequests  = 0;
+    scenario.mBatchTriangles  = 0;
+    scenario.mBatchDrawCalls  = 0;
+    scenario.mBatchFlushes    = 0;
+
+    // Advance the simulation using fixed-step time.
+    DebugStats renderStats;
+    SimObjectPtr<Scene> scene = pScene;
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 tick = 0; tick < ticks; ++tick )
+    {
+        PROFILE_START(SceneBenchmark_Tick);
+        Platform::advanceTime( tickMs );
+        Sim::advanceTime( tickMs );
+        Tickable::advanceTime( tickMs );
+
+        // Render the scene if requested.
+        if ( pRenderArea != NULL && !scene.isNull() )
+        {
+            SceneRenderState sceneRenderState(
+                *pRenderArea,
+                pRenderArea->centre(),
+                0.0f,
+                MASK_ALL,
+                MASK_ALL,
+                Vector2::getOne(),
+                &renderStats,
+                NULL );
+
+            scene->sceneRender( &sceneRenderState );
+
+            // Accumulate the render stats.
+            scenario.mRenderRequests += renderStats.renderRequests;
+            scenario.mBatchTriangles += renderStats.batchTrianglesSubmitted;
+            scenario.mBatchDrawCalls += renderStats.batchDrawCallsStrict + renderStats.batchDrawCallsSorted;
+            scenario.mBatchFlushes   += renderStats.batchFlushes;
+        }
+        PROFILE_END();
+
+        // Stop if the scene was deleted.
+        if ( scene.isNull() )
+        {
+            Con::warnf( "SceneBenchmark::runScenario() - Scenario '%s' deleted its scene after %d ticks.", pName, tick + 1 );
+            break;
+        }
+    }
+    const U32 wallMs = Platform::getRealMilliseconds() - startTime;
+
+    // Record the scenario.
+    scenario.mObjectCount = scene.isNull() ? 0 : scene->getSceneObjectCount();
+    scenario.mBodyCount   = scene.isNull() ? 0 : (U32)scene->getWorld()->GetBodyCount();
+    scenario.mWallMs      = wallMs;
+    scenario.mPhaseStart  = (U32)smPhases.size();
+    scenario.mPhaseCount  = 0;
+
+#ifdef TORQUE_ENABLE_PROFILER
+    if ( profiling )
+    {
+        // Stop profiling.
+        gProfiler->enableNow( false );
+
+        // Calibrate the profiler units against the real-time clock using the tick marker.
+        F64 tickUnits = 0.0;
+        for ( ProfilerRootData* pRoot = ProfilerRootData::sRootList; pRoot != NULL; pRoot = pRoot->mNextRoot )
+        {
+            if ( dStrcmp( pRoot->mName, "SceneBenchmark_Tick" ) == 0 )
+            {
+                tickUnits = pRoot->mTotalTime;
+                break;
+            }
+        }
+        const F64 msPerUnit = tickUnits > 0.0 ? (F64)wallMs / tickUnits : 0.0;
+
+        // Record all the phases that were invoked.
+        for ( ProfilerRootData* pRoot = ProfilerRootData::sRootList; pRoot != NULL; pRoot = pRoot->mNextRoot )
+        {
+            if ( pRoot->mTotalInvokeCount == 0 )
+                continue;
+
+            PhaseResult phase;
+            phase.mName        = StringTable->insert( pRoot->mName );
+            phase.mInvokeCount = pRoot->mTotalInvokeCount;
+            phase.mTotalMs     = pRoot->mTotalTime * msPerUnit;
+            phase.mExclusiveMs = (pRoot->mTotalTime - pRoot->mSubTime) * msPerUnit;
+            smPhases.push_back( phase );
+        }
+        scenario.mPhaseCount = (U32)smPhases.size() - scenario.mPhaseStart;
+
+        // Order the phases by total time.
+        if ( scenario.mPhaseCount > 1 )
+            dQsort( smPhases.address() + scenario.mPhaseStart, scenario.mPhaseCount, sizeof(PhaseResult), comparePhaseTotalTime );
+
+        // Discard the profiling data.
+        gProfiler->reset();
+    }
+#endif
+
+    smScenarios.push_back( scenario );
+
+    Con::printf( "SceneBenchmark: '%s' ran %d ticks in %dms (%.3fms per tick) with %d objects and %d phases.",
+        pName, ticks, wallMs, (F32)wallMs / (F32)ticks, scenario.mObjectCount, scenario.mPhaseCount );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneBenchmark::writeReport( const char* pFilename )
+{
+    // Sanity!
+    AssertFatal( pFilename != NULL, "SceneBenchmark::writeReport() - Cannot use a NULL filename." );
+
+    // Expand the filename.
+    char filenameBuffer[1024];
+    Con::expandPath( filenameBuffer, sizeof(filenameBuffer), pFilename );
+
+    // Open the report file.
+    FileStream stream;
+    if ( !stream.open( filenameBuffer, FileStream::Write ) )
+    {
+        Con::warnf( "SceneBenchmark::writeReport() - Could not open report file '%s'.", filenameBuffer );
+        return false;
+    }
+
+    rapidjson::PrettyWriter<FileStream> writer( stream );
+
+    // Write the report header.
+    writer.StartObject();
+    writer.String( "version" );
+    writer.String( getVersionString() );
+    writer.String( "tickMs" );
+    writer.Uint( Tickable::smTickMs );
+    writer.String( "scenarios" );
+    writer.StartArray();
+
+    // Write the scenarios.
+    for ( Vector<ScenarioResult>::const_iterator scenarioItr = smScenarios.begin(); scenarioItr != smScenarios.end(); ++scenarioItr )
+    {
+        writer.StartObject();
+        writer.String( "name" );
+        writer.String( scenarioItr->mName );
+        writer.String( "ticks" );
+        writer.Uint( scenarioItr->mTicks );
+        writer.String( "objects" );
+        writer.Uint( scenarioItr->mObjectCount );
+        writer.String( "bodies" );
+        writer.Uint( scenarioItr->mBodyCount );
+        writer.String( "wallMs" );
+        writer.Uint( scenarioItr->mWallMs );
+        writer.String( "msPerTick" );
+        writer.Double( (F64)scenarioItr->mWallMs / (F64)scenarioItr->mTicks );
+
+        // Write the render totals.
+        if ( scenarioItr->mRendered )
+        {
+            writer.String( "render" );
+            writer.StartObject();
+            writer.String( "requests" );
+            writer.Uint( scenarioItr->mRenderRequests );
+            writer.String( "triangles" );
+            writer.Uint( scenarioItr->mBatchTriangles );
+            writer.String( "drawCalls" );
+            writer.Uint( scenarioItr->mBatchDrawCalls );
+            writer.String( "flushes" );
+            writer.Uint( scenarioItr->mBatchFlushes );
+            writer.EndObject();
+        }
+
+        // Write the phases.
+        writer.String( "phases" );
+        writer.StartArray();
+        for ( U32 index = 0; index < scenarioItr->mPhaseCount; ++index )
+        {
+            const PhaseResult& phase = smPhases[scenarioItr->mPhaseStart + index];
+            writer.StartObject();
+            writer.String( "name" );
+            writer.String( phase.mName );
+            writer.String( "invokes" );
+            writer.Uint( phase.mInvokeCount );
+            writer.String( "totalMs" );
+            writer.Double( phase.mTotalMs );
+            writer.String( "exclusiveMs" );
+            writer.Double( phase.mExclusiveMs );
+            writer.String( "msPerTick" );
+            writer.Double( phase.mTotalMs / (F64)scenarioItr->mTicks );
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    stream.close();
+
+    Con::printf( "SceneBenchmark: Wrote %d scenarios to '%s'.", smScenarios.size(), filenameBuffer );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneBenchmark::clearResults( void )
+{
+    smScenarios.clear();
+    smPhases.clear();
+}
@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_BENCHMARK_H_
+#define _SCENE_BENCHMARK_H_
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// Headless scene benchmarking.
+///
+/// A scenario advances a scene by a fixed number of ticks using fixed-step time in the same way
+/// the main loop does with "$timeAdvance" set, but without waiting on real time, processing the
+/// platform or rendering.  All Tickable objects are advanced so a scenario should be the only
+/// active scene.
+///
+/// Per-phase timings are taken from the profiler markers (Scene_ProcessTick, Scene_IntegratePhysicsSystem
+/// etc) so the engine must be built with TORQUE_ENABLE_PROFILER for those, otherwise only the overall
+/// timings are available.  Profiler units are converted to milliseconds by timing each tick both with
+/// the profiler and the real-time clock.  Results accumulate until written out as a JSON report.
+///
+/// A scenario can also render the scene each tick over a render area.  No window is involved so in a
+/// dedicated server this exercises the render path on the CPU only, ideally with a null GL backend bound.
+class SceneBenchmark
+{
+public:
+    struct PhaseResult
+    {
+        StringTableEntry    mName;
+        U32                 mInvokeCount;
+        F64                 mTotalMs;
+        F64                 mExclusiveMs;
+    };
+
+    struct ScenarioResult
+    {
+        StringTableEntry    mName;
+        U32                 mTicks;
+        U32                 mTickMs;
+        U32                 mObjectCount;
+        U32                 mBodyCount;
+        U32                 mWallMs;
+        bool                mRendered;
+        U32                 mRenderRequests;
+        U32                 mBatchTriangles;
+        U32                 mBatchDrawCalls;
+        U32                 mBatchFlushes;
+        U32                 mPhaseStart;
+        U32                 mPhaseCount;
+    };
+
+private:
+    static Vector<ScenarioResult>   smScenarios;
+    static Vector<PhaseResult>      smPhases;
+
+public:
+    /// Run a scenario for the specified number of ticks and record its results.
+    /// The scene is also rendered each tick if a render area is specified.
+    static bool                     runScenario( const char* pName, Scene* pScene, const U32 ticks, const RectF* pRenderArea = NULL );
+
+    /// Write all the recorded results as a JSON report.
+    static bool                     writeReport( const char* pFilename );
+
+    /// Clear all the recorded results.
+    static void                     clearResults( void );
+
+    static inline U32               getScenarioCount( void )                    { return (U32)smScenarios.size(); }
+    static inline const ScenarioResult& getScenario( const U32 index )          { return smScenarios[index]; }
+    static inline const PhaseResult& getPhase( const U32 index )                { return smPhases[index]; }
+};
+
+#endif // _SCENE_BENCHMARK_H_
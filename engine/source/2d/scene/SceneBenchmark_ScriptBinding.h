@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( SceneBenchmark, "Headless scene benchmark functionality.");
+
+/*! @defgroup SceneBenchmarkFunctions Scene Benchmark
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/*! Advances the scene by a fixed number of ticks using fixed-step time and records the timings.
+    The simulation is advanced without rendering or waiting on real time.  Phase timings require a build with TORQUE_ENABLE_PROFILER
+    and the benchmark to be run from the top level i.e. not from a scheduled event.
+    @param scenarioName The name the scenario is reported with.
+    @param scene The scene to advance.  It should be the only active scene.
+    @param ticks The number of ticks to advance.
+    @param renderArea An optional area "x1 y1 x2 y2" of the scene to render each tick.
+    @return Whether the scenario was run or not.
+    @sa writeSceneBenchmarkReport
+*/
+ConsoleFunctionWithDocs( runSceneBenchmark, ConsoleBool, 4, 5, (scenarioName, scene, ticks, [renderArea]) )
+{
+    // Find the scene.
+    Scene* pScene = Sim::findObject<Scene>( argv[2] );
+
+    if ( pScene == NULL )
+    {
+        Con::warnf( "runSceneBenchmark() - Could not find scene '%s'.", argv[2] );
+        return false;
+    }
+
+    const U32 ticks = (U32)getMax( dAtoi( argv[3] ), 0 );
+
+    // Run without rendering if no render area is specified.
+    if ( argc < 5 )
+        return SceneBenchmark::runScenario( argv[1], pScene, ticks );
+
+    // Fetch the render area.
+    if ( Utility::mGetStringElementCount( argv[4] ) != 4 )
+    {
+        Con::warnf( "runSceneBenchmark() - Invalid render area '%s'.", argv[4] );
+        return false;
+    }
+    const Vector2 v1 = Utility::mGetStringElementVector( argv[4] );
+    const Vector2 v2 = Utility::mGetStringElementVector( argv[4], 2 );
+
+    // Calculate Normalised Rectangle.
+    const Vector2 topLeft( (v1.x <= v2.x) ? v1.x : v2.x, (v1.y <= v2.y) ? v1.y : v2.y );
+    const Vector2 bottomRight( (v1.x > v2.x) ? v1.x : v2.x, (v1.y > v2.y) ? v1.y : v2.y );
+    const RectF renderArea( topLeft.x, topLeft.y, bottomRight.x-topLeft.x, bottomRight.y-topLeft.y );
+
+    return SceneBenchmark::runScenario( argv[1], pScene, ticks, &renderArea );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Writes all the recorded scenario results to a JSON report.
+    @param filename The report file to write.
+    @return Whether the report was written or not.
+    @sa runSceneBenchmark
+*/
+ConsoleFunctionWithDocs( writeSceneBenchmarkReport, ConsoleBool, 2, 2, (filename) )
+{
+    return SceneBenchmark::writeReport( argv[1] );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Clears all the recorded scenario results.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( clearSceneBenchmarkResults, ConsoleVoid, 1, 1, () )
+{
+    SceneBenchmark::clearResults();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of recorded scenario results.
+    @return The number of recorded scenarios.
+*/
+ConsoleFunctionWithDocs( getSceneBenchmarkCount, ConsoleInt, 1, 1, () )
+{
+    return SceneBenchmark::getScenarioCount();
+}
+
+ConsoleFunctionGroupEnd( SceneBenchmark );
+
+/*! @} */ // group SceneBenchmarkFunctions
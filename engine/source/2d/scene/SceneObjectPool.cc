@@ -0,0 +1,242 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_OBJECT_POOL_H_
+#include "2d/scene/SceneObjectPool.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+SceneObjectPool::SceneObjectPool( SceneObject* pTemplate ) :
+    mpTemplate( pTemplate ),
+    mCreatedCount( 0 ),
+    mAcquiredCount( 0 ),
+    mReusedCount( 0 ),
+    mReleasedCount( 0 )
+{
+    // Sanity!
+    AssertFatal( pTemplate != NULL, "SceneObjectPool() - Cannot use a NULL template." );
+
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mIdleObjects );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectPool::~SceneObjectPool()
+{
+    // Purge the idle objects.
+    purge();
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObject* SceneObjectPool::acquire( Scene* pScene )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectPool_Acquire);
+
+    // Sanity!
+    AssertFatal( pScene != NULL, "SceneObjectPool::acquire() - Cannot acquire into a NULL scene." );
+
+    // Fetch the template.
+    SceneObject* pTemplate = mpTemplate;
+
+    // Finish if the template has gone.
+    if ( pTemplate == NULL )
+    {
+        Con::warnf( "SceneObjectPool::acquire() - The pool template no longer exists." );
+        return NULL;
+    }
+
+    // Find an idle object.
+    while( mIdleObjects.size() > 0 )
+    {
+        // Fetch the most recently released object.
+        SceneObject* pSceneObject = mIdleObjects.back();
+        mIdleObjects.pop_back();
+
+        // Skip if the object was deleted whilst idle.
+        if ( pSceneObject == NULL || pSceneObject->isBeingDeleted() )
+            continue;
+
+        // Flag as no longer idle.
+        pSceneObject->mPoolIdle = false;
+
+        // Add to the scene if it's been removed from it.
+        if ( pSceneObject->getScene() != pScene )
+            pScene->addToScene( pSceneObject );
+
+        // Reset the object state.
+        pSceneObject->resetState( pTemplate );
+
+        // Re-enable the object (and its body).
+        pSceneObject->setEnabled( pTemplate->isEnabled() );
+
+        mAcquiredCount++;
+        mReusedCount++;
+
+        return pSceneObject;
+    }
+
+    // No idle objects so create a new one.
+    SceneObject* pSceneObject = createObject( pScene );
+
+    // Finish if we could not create the object.
+    if ( pSceneObject == NULL )
+        return NULL;
+
+    mAcquiredCount++;
+
+    return pSceneObject;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneObjectPool::release( SceneObject* pSceneObject )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectPool_Release);
+
+    // Sanity!
+    AssertFatal( pSceneObject != NULL, "SceneObjectPool::release() - Cannot release a NULL object." );
+
+    // Ignore if not from this pool.
+    if ( mpTemplate.isNull() || pSceneObject->getPoolTemplateId() != mpTemplate->getId() )
+        return false;
+
+    // Ignore if already idle.
+    if ( pSceneObject->isPoolIdle() )
+        return true;
+
+    // Detach anything following the object.
+    pSceneObject->processDestroyNotifications();
+    pSceneObject->dismountCamera();
+    pSceneObject->detachAllGuiControls();
+
+    // Stop any lifetime so the object is not released again.
+    pSceneObject->setLifetime( 0.0f );
+
+    // Disable the object.  This also deactivates the body but keeps its fixtures.
+    pSceneObject->setEnabled( false );
+
+    // Flag as idle.
+    pSceneObject->mPoolIdle = true;
+
+    // Store as idle.
+    mIdleObjects.push_back( pSceneObject );
+
+    mReleasedCount++;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneObjectPool::preallocate( Scene* pScene, const U32 count )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectPool_Preallocate);
+
+    // Reserve the idle objects.
+    mIdleObjects.reserve( mIdleObjects.size() + count );
+
+    U32 createdCount = 0;
+    for ( U32 n = 0; n < count; ++n )
+    {
+        // Create an object.
+        SceneObject* pSceneObject = createObject( pScene );
+
+        // Finish if we could not create the object.
+        if ( pSceneObject == NULL )
+            break;
+
+        // Release it immediately.
+        release( pSceneObject );
+
+        createdCount++;
+    }
+
+    return createdCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectPool::purge( void )
+{
+    // Delete all the idle objects.
+    while( mIdleObjects.size() > 0 )
+    {
+        SceneObject* pSceneObject = mIdleObjects.back();
+        mIdleObjects.pop_back();
+
+        // Skip if already gone.
+        if ( pSceneObject == NULL )
+            continue;
+
+        // Stop it being treated as a pooled object.
+        pSceneObject->mPoolTemplateId = 0;
+        pSceneObject->mPoolIdle = false;
+
+        // Delete it.
+        pSceneObject->safeDelete();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObject* SceneObjectPool::createObject( Scene* pScene )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectPool_CreateObject);
+
+    // Fetch the template.
+    SceneObject* pTemplate = mpTemplate;
+
+    // Finish if no template.
+    if ( pTemplate == NULL )
+        return NULL;
+
+    // Clone the template.
+    SceneObject* pSceneObject = dynamic_cast<SceneObject*>( pTemplate->clone( true ) );
+
+    // Finish if the clone failed.
+    if ( pSceneObject == NULL )
+    {
+        Con::warnf( "SceneObjectPool::createObject() - Failed to clone template '%s'.", pTemplate->getIdString() );
+        return NULL;
+    }
+
+    // Tag the object as belonging to this pool.
+    pSceneObject->mPoolTemplateId = pTemplate->getId();
+    pSceneObject->mPoolIdle = false;
+
+    // Add to the scene.
+    pScene->addToScene( pSceneObject );
+
+    mCreatedCount++;
+
+    return pSceneObject;
+}
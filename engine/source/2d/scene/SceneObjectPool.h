@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_OBJECT_POOL_H_
+#define _SCENE_OBJECT_POOL_H_
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A pool of scene objects created from a single template object.
+///
+/// Released objects are not deleted.  They stay registered and in the scene but are
+/// disabled so that their body (along with its fixtures) is inactive and they are
+/// neither ticked, queried nor rendered.  Acquiring an object reuses an idle one when
+/// available and calls its "resetState()" hook, otherwise a new object is cloned from
+/// the template.
+class SceneObjectPool
+{
+public:
+    typedef Vector< SimObjectPtr<SceneObject> > typeSceneObjectPtrVector;
+
+private:
+    SimObjectPtr<SceneObject>   mpTemplate;
+    typeSceneObjectPtrVector    mIdleObjects;
+
+    /// Statistics.
+    U32                         mCreatedCount;
+    U32                         mAcquiredCount;
+    U32                         mReusedCount;
+    U32                         mReleasedCount;
+
+public:
+    SceneObjectPool( SceneObject* pTemplate );
+    virtual ~SceneObjectPool();
+
+    SceneObject*                acquire( Scene* pScene );
+    bool                        release( SceneObject* pSceneObject );
+    U32                         preallocate( Scene* pScene, const U32 count );
+    void                        purge( void );
+
+    inline SceneObject*         getTemplate( void ) const                   { return mpTemplate; }
+    inline U32                  getIdleCount( void ) const                  { return (U32)mIdleObjects.size(); }
+    inline U32                  getCreatedCount( void ) const               { return mCreatedCount; }
+    inline U32                  getAcquiredCount( void ) const              { return mAcquiredCount; }
+    inline U32                  getReusedCount( void ) const                { return mReusedCount; }
+    inline U32                  getReleasedCount( void ) const              { return mReleasedCount; }
+
+private:
+    SceneObject*                createObject( Scene* pScene );
+};
+
+#endif // _SCENE_OBJECT_POOL_H_
@@ -0,0 +1,269 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "2d/scene/ScenePipeline.h"
+
+#ifndef _RENDER_SNAPSHOT_H_
+#include "2d/core/RenderSnapshot.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+ScenePipelineWorker* ScenePipeline::smpWorker = NULL;
+U32 ScenePipeline::smUsers = 0;
+
+//-----------------------------------------------------------------------------
+
+/// Background capture of scene snapshots.
+/// Only records into snapshots; no GL calls are made here.
+class ScenePipelineWorker : public Thread
+{
+private:
+    struct CaptureRequest
+    {
+        CaptureRequest( Scene* pScene, const SceneRenderState& sceneRenderState, RenderSnapshot* pSnapshot ) :
+            mpScene( pScene ),
+            mSceneRenderState( sceneRenderState ),
+            mpSnapshot( pSnapshot )
+        {
+        }
+
+        Scene*              mpScene;
+        SceneRenderState    mSceneRenderState;
+        RenderSnapshot*     mpSnapshot;
+    };
+
+    Mutex                       mLock;
+    Semaphore                   mSignal;
+    Semaphore                   mIdle;
+    Vector<CaptureRequest>      mPending;
+    Vector<RenderSnapshot*>     mCompleted;
+    U32                         mOutstanding;
+    bool                        mWaiting;
+
+    BatchRender                 mBatchRenderer;
+
+public:
+    ScenePipelineWorker() : Thread( 0, NULL, false ), mSignal( 0 ), mIdle( 0 ), mOutstanding( 0 ), mWaiting( false )
+    {
+        VECTOR_SET_ASSOCIATION( mPending );
+        VECTOR_SET_ASSOCIATION( mCompleted );
+    }
+
+    void queueRequest( Scene* pScene, const SceneRenderState& sceneRenderState, RenderSnapshot* pSnapshot )
+    {
+        mLock.lock();
+        mPending.push_back( CaptureRequest( pScene, sceneRenderState, pSnapshot ) );
+        mOutstanding++;
+        mLock.unlock();
+
+        // Wake the worker.
+        mSignal.release();
+    }
+
+    void waitIdle( void )
+    {
+        // Finish if nothing is outstanding.
+        mLock.lock();
+        if ( mOutstanding == 0 )
+        {
+            mLock.unlock();
+            return;
+        }
+        mWaiting = true;
+        mLock.unlock();
+
+        // Wait for the worker to drain.
+        if ( !Con::isMainThread() )
+        {
+            mIdle.acquire();
+            return;
+        }
+
+        // The capture may be blocked on the main thread executing script for it so process that work meanwhile.
+        while ( !mIdle.acquire( false ) )
+        {
+            if ( Sim::processMainThreadQueue( 0 ) == 0 )
+                Platform::sleep( 0 );
+        }
+    }
+
+    bool isIdle( void )
+    {
+        mLock.lock();
+        const bool idle = mOutstanding == 0;
+        mLock.unlock();
+
+        return idle;
+    }
+
+    void holdCompletedTextures( void )
+    {
+        // Fetch the completed snapshots.
+        // The worker is idle so nothing else can touch them.
+        mLock.lock();
+        for( Vector<RenderSnapshot*>::iterator snapshotItr = mCompleted.begin(); snapshotItr != mCompleted.end(); ++snapshotItr )
+        {
+            // Reference the captured textures.
+            (*snapshotItr)->holdTextures();
+        }
+        mCompleted.clear();
+        mLock.unlock();
+    }
+
+    void shutdown( void )
+    {
+        // Drain, then stop and wake the worker.
+        waitIdle();
+        holdCompletedTextures();
+        stop();
+        mSignal.release();
+        join();
+    }
+
+    virtual void run( void* arg = 0 )
+    {
+        while( !checkForStop() )
+        {
+            // Wait for a request.
+            mSignal.acquire();
+
+            // Fetch the next request.
+            mLock.lock();
+            if ( mPending.size() == 0 )
+            {
+                mLock.unlock();
+                continue;
+            }
+            CaptureRequest request = mPending.front();
+            mPending.pop_front();
+            mLock.unlock();
+
+            // Capture into the snapshot, keeping the stats with it.
+            RenderSnapshot* pSnapshot = request.mpSnapshot;
+            request.mSceneRenderState.mpDebugStats = &pSnapshot->getRenderStats();
+            mBatchRenderer.setRecordTarget( pSnapshot );
+            const bool captured = request.mpScene->sceneCapture( &request.mSceneRenderState, &mBatchRenderer );
+            mBatchRenderer.setRecordTarget( NULL );
+            pSnapshot->setValid( captured );
+
+            // Complete the request.
+            mLock.lock();
+            mCompleted.push_back( pSnapshot );
+            mOutstanding--;
+            if ( mOutstanding == 0 && mWaiting )
+            {
+                mWaiting = false;
+                mIdle.release();
+            }
+            mLock.unlock();
+        }
+
+        // Release this thread's frame arena.
+        FrameAllocator::destroyThreadArena();
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+void ScenePipeline::acquire( void )
+{
+    // Create the worker on first use.
+    if ( smUsers++ == 0 )
+    {
+        smpWorker = new ScenePipelineWorker();
+        smpWorker->start();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePipeline::release( void )
+{
+    // Sanity!
+    AssertFatal( smUsers > 0, "ScenePipeline::release() - Pipeline is not in use." );
+
+    // Destroy the worker once unused.
+    if ( --smUsers == 0 )
+    {
+        smpWorker->shutdown();
+        delete smpWorker;
+        smpWorker = NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePipeline::queueCapture( Scene* pScene, const SceneRenderState& sceneRenderState, RenderSnapshot* pSnapshot )
+{
+    // Sanity!
+    AssertFatal( smpWorker != NULL, "ScenePipeline::queueCapture() - Pipeline is not in use." );
+
+    smpWorker->queueRequest( pScene, sceneRenderState, pSnapshot );
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePipeline::synchronize( void )
+{
+    // Finish if not in use.
+    if ( smpWorker == NULL )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePipeline_Synchronize);
+
+    smpWorker->waitIdle();
+
+    // Take the texture references on this thread before anything can free the textures.
+    smpWorker->holdCompletedTextures();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScenePipeline::isIdle( void )
+{
+    return smpWorker == NULL || smpWorker->isIdle();
+}
@@ -0,0 +1,81 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_PIPELINE_H_
+#define _SCENE_PIPELINE_H_
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class RenderSnapshot;
+class ScenePipelineWorker;
+
+//-----------------------------------------------------------------------------
+
+/// Pipelined scene rendering.
+///
+/// A scene window in pipelined mode draws the snapshot captured on the previous frame and then
+/// queues a capture of the current frame.  The capture (world query, render request preparation,
+/// sorting and batching) runs on a worker thread while the main thread carries on rendering the
+/// rest of the GUI and presenting the frame.  GL calls stay on the main thread which owns the context.
+///
+/// The worker reads scene objects so it must be idle before anything can modify them.  Nothing waits for it
+/// until the next submit or the first event the main loop dispatches, as events are where scripts, input and
+/// the simulation run.  Immediate scene renders and asset reloads synchronize first too.
+///
+/// The capture therefore overlaps presenting the frame and polling for the next one but not the simulation.
+/// It also uses the scene world query and the scene render factories which are only safe because nothing
+/// else uses them until the pipeline is synchronized.  Scene ticks and immediate renders assert this.
+///
+/// Captured snapshots record raw texture objects as texture references cannot be taken off the main thread.
+/// Synchronizing takes those references so a texture freed or reloaded before the replay stays valid.
+class ScenePipeline
+{
+private:
+    static ScenePipelineWorker* smpWorker;
+    static U32                  smUsers;
+
+public:
+    /// Start using the pipeline, creating the worker on first use.
+    static void acquire( void );
+
+    /// Stop using the pipeline, destroying the worker once unused.
+    static void release( void );
+
+    /// Whether the pipeline has any users.
+    static inline bool isActive( void )         { return smpWorker != NULL; }
+
+    /// Queue a capture of the scene into the snapshot.
+    /// The snapshot must already be reset and have its view set.
+    static void queueCapture( Scene* pScene, const SceneRenderState& sceneRenderState, RenderSnapshot* pSnapshot );
+
+    /// Block until all queued captures have completed.
+    static void synchronize( void );
+
+    /// Whether no capture is queued or in progress.
+    static bool isIdle( void );
+};
+
+#endif // _SCENE_PIPELINE_H_
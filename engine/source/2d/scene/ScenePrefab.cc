@@ -0,0 +1,657 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_PREFAB_H_
+#include "2d/scene/ScenePrefab.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _STRINGUNIT_H_
+#include "string/stringUnit.h"
+#endif
+
+#ifndef _NATIVE_BEHAVIORINSTANCE_H_
+#include "component/behaviors/nativeBehaviorInstance.h"
+#endif
+
+// Script bindings.
+#include "ScenePrefab_ScriptBinding.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+static StringTableEntry prefabPositionFieldName     = StringTable->insert( "Position" );
+static StringTableEntry prefabSceneFieldName        = StringTable->insert( "scene" );
+static StringTableEntry prefabParentGroupFieldName  = StringTable->insert( "parentGroup" );
+
+//-----------------------------------------------------------------------------
+
+IMPLEMENT_CONOBJECT( ScenePrefab );
+
+//-----------------------------------------------------------------------------
+
+static bool isResolvableFieldType( const S32 fieldType )
+{
+    // These types are plain values so can be copied as their resolved bytes.
+    return  fieldType == TypeBool ||
+            fieldType == TypeS8 ||
+            fieldType == TypeS32 ||
+            fieldType == TypeF32 ||
+            fieldType == TypeEnum ||
+            fieldType == TypeString ||
+            fieldType == TypeCaseString ||
+            fieldType == TypeVector2 ||
+            fieldType == TypeColorI ||
+            fieldType == TypeColorF;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 getShapeSize( const b2Shape::Type shapeType )
+{
+    switch( shapeType )
+    {
+        case b2Shape::e_circle:     return sizeof(b2CircleShape);
+        case b2Shape::e_polygon:    return sizeof(b2PolygonShape);
+        case b2Shape::e_chain:      return sizeof(b2ChainShape);
+        case b2Shape::e_edge:       return sizeof(b2EdgeShape);
+
+        default:
+            AssertFatal( false, "ScenePrefab - Unsupported collision shape type encountered." );
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+ScenePrefab::ScenePrefab() :
+    mpClassRep( NULL ),
+    mSourceFile( StringTable->EmptyString )
+{
+    // Set Vector Associations.
+    VECTOR_SET_ASSOCIATION( mFields );
+    VECTOR_SET_ASSOCIATION( mDynamicFields );
+    VECTOR_SET_ASSOCIATION( mDataBlob );
+    VECTOR_SET_ASSOCIATION( mValueBlob );
+    VECTOR_SET_ASSOCIATION( mCollisionShapes );
+    VECTOR_SET_ASSOCIATION( mBehaviors );
+    VECTOR_SET_ASSOCIATION( mBehaviorConnections );
+
+    dMemset( &mObjectFields, 0, sizeof(mObjectFields) );
+}
+
+//-----------------------------------------------------------------------------
+
+ScenePrefab::~ScenePrefab()
+{
+    // Clear the compiled prefab.
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePrefab::onRemove()
+{
+    // Clear the compiled prefab.
+    clear();
+
+    // Call parent.
+    Parent::onRemove();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScenePrefab::compile( SceneObject* pTemplate )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePrefab_Compile);
+
+    // Sanity!
+    AssertFatal( pTemplate != NULL, "ScenePrefab::compile() - Cannot compile a NULL template." );
+
+    // Clear any existing compilation.
+    clear();
+
+    // Compile the behaviors.
+    if ( !compileBehaviors( pTemplate ) )
+    {
+        // Warn.
+        Con::warnf( "ScenePrefab::compile() - Failed to compile the behaviors of template '%s'.", pTemplate->getIdString() );
+        clear();
+        return false;
+    }
+
+    // Compile the fields.
+    compileFields( pTemplate, NULL, mObjectFields );
+
+    // Compile the collision shapes.
+    compileCollisionShapes( pTemplate );
+
+    // Cache the class representation used to create instances.
+    mpClassRep = pTemplate->getClassRep();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScenePrefab::compileFile( const char* pTamlFile )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePrefab_CompileFile);
+
+    // Sanity!
+    AssertFatal( pTamlFile != NULL, "ScenePrefab::compileFile() - Cannot compile a NULL file." );
+
+    // Clear any existing compilation.
+    clear();
+
+    // Read the file once.
+    Taml taml;
+    SimObject* pSimObject = taml.read( pTamlFile );
+
+    // Finish if nothing was read.
+    if ( pSimObject == NULL )
+    {
+        // Warn.
+        Con::warnf( "ScenePrefab::compileFile() - Failed to read file '%s'.", pTamlFile );
+        return false;
+    }
+
+    // Fetch the scene object.
+    SceneObject* pTemplate = dynamic_cast<SceneObject*>( pSimObject );
+
+    // Is it a scene object?
+    if ( pTemplate == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "ScenePrefab::compileFile() - File '%s' does not contain a SceneObject.", pTamlFile );
+
+        // Delete the object.
+        pSimObject->deleteObject();
+        return false;
+    }
+
+    // Compile the template.
+    const bool compiled = compile( pTemplate );
+
+    // The template is no longer needed.
+    pTemplate->deleteObject();
+
+    // Finish if not compiled.
+    if ( !compiled )
+        return false;
+
+    // Set the source file.
+    mSourceFile = StringTable->insert( pTamlFile );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePrefab::clear( void )
+{
+    // Destroy the collision shapes.
+    for ( S32 index = 0; index < mCollisionShapes.size(); ++index )
+    {
+        b2Shape* pShape = const_cast<b2Shape*>( mCollisionShapes[index].shape );
+        const U32 shapeSize = getShapeSize( pShape->GetType() );
+        pShape->~b2Shape();
+        mShapeAllocator.Free( pShape, shapeSize );
+    }
+
+    mFields.clear();
+    mDynamicFields.clear();
+    mDataBlob.clear();
+    mValueBlob.clear();
+    mCollisionShapes.clear();
+    mBehaviors.clear();
+    mBehaviorConnections.clear();
+    dMemset( &mObjectFields, 0, sizeof(mObjectFields) );
+
+    mpClassRep = NULL;
+    mSourceFile = StringTable->EmptyString;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ScenePrefab::stamp( Scene* pScene, const U32 count, typeSceneObjectVector& objects, const Vector2* pPositions )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePrefab_Stamp);
+
+    // Sanity!
+    AssertFatal( pScene != NULL, "ScenePrefab::stamp() - Cannot stamp into a NULL scene." );
+
+    // Finish if not compiled.
+    if ( !isCompiled() )
+    {
+        Con::warnf( "ScenePrefab::stamp() - Prefab '%s' has not been compiled.", getIdString() );
+        return 0;
+    }
+
+    // Finish if nothing to stamp.
+    if ( count == 0 )
+        return 0;
+
+    // Reserve the objects.
+    const U32 firstIndex = (U32)objects.size();
+    objects.reserve( firstIndex + count );
+
+    // Create the instances and apply the compiled state.
+    typeSceneObjectVector createdObjects;
+    createdObjects.setSize( count );
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(ScenePrefab_StampCreate);
+
+        const U32 collisionShapeCount = (U32)mCollisionShapes.size();
+
+        for ( U32 n = 0; n < count; ++n )
+        {
+            // Create the instance from the cached class representation.
+            SceneObject* pSceneObject = static_cast<SceneObject*>( mpClassRep->create() );
+
+            // Apply the compiled fields.
+            applyFields( pSceneObject, mObjectFields, pPositions != NULL );
+
+            // Set the position if specified.
+            if ( pPositions != NULL )
+                pSceneObject->setPosition( pPositions[n] );
+
+            // Create the collision shapes.
+            for ( U32 shapeIndex = 0; shapeIndex < collisionShapeCount; ++shapeIndex )
+                pSceneObject->createCollisionShape( mCollisionShapes[shapeIndex] );
+
+            createdObjects[n] = pSceneObject;
+        }
+    }
+
+    // Register the instances.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(ScenePrefab_StampRegister);
+
+        for ( U32 n = 0; n < count; ++n )
+        {
+            // Fetch the instance.
+            SceneObject* pSceneObject = createdObjects[n];
+
+            // Register the instance.
+            if ( !pSceneObject->registerObject() )
+            {
+                // Warn.
+                Con::warnf( "ScenePrefab::stamp() - Failed to register instance of '%s'.", mpClassRep->getClassName() );
+                delete pSceneObject;
+                continue;
+            }
+
+            objects.push_back( pSceneObject );
+        }
+    }
+
+    // Fetch the stamped count.
+    const U32 stampedCount = (U32)objects.size() - firstIndex;
+
+    // Add the behaviors.
+    if ( mBehaviors.size() > 0 )
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(ScenePrefab_StampBehaviors);
+
+        const U32 behaviorCount = (U32)mBehaviors.size();
+        const U32 connectionCount = (U32)mBehaviorConnections.size();
+
+        Vector<BehaviorInstance*> behaviorInstances;
+        behaviorInstances.setSize( behaviorCount );
+
+        for ( U32 n = firstIndex; n < (U32)objects.size(); ++n )
+        {
+            // Fetch the instance.
+            SceneObject* pSceneObject = objects[n];
+
+            // Create the behaviors.
+            for ( U32 behaviorIndex = 0; behaviorIndex < behaviorCount; ++behaviorIndex )
+            {
+                // Fetch the compiled behavior.
+                const CompiledBehavior& compiledBehavior = mBehaviors[behaviorIndex];
+
+                // Create the behavior instance.
+                BehaviorInstance* pBehaviorInstance = compiledBehavior.mpTemplate.isNull() ? NULL : compiledBehavior.mpTemplate->createInstance();
+                behaviorInstances[behaviorIndex] = pBehaviorInstance;
+
+                if ( pBehaviorInstance == NULL )
+                    continue;
+
+                // Apply the compiled fields and add the behavior.
+                applyFields( pBehaviorInstance, compiledBehavior.mFields, false );
+                pSceneObject->addBehavior( pBehaviorInstance );
+            }
+
+            // Connect the behaviors.
+            for ( U32 connectionIndex = 0; connectionIndex < connectionCount; ++connectionIndex )
+            {
+                // Fetch the compiled connection.
+                const CompiledBehaviorConnection& connection = mBehaviorConnections[connectionIndex];
+
+                BehaviorInstance* pOutputInstance = behaviorInstances[connection.mOutputBehavior];
+                BehaviorInstance* pInputInstance = behaviorInstances[connection.mInputBehavior];
+
+                if ( pOutputInstance != NULL && pInputInstance != NULL )
+                    pSceneObject->connect( pOutputInstance, pInputInstance, connection.mOutputName, connection.mInputName );
+            }
+        }
+    }
+
+    // Add the instances to the scene in bulk.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(ScenePrefab_StampAddToScene);
+
+        if ( firstIndex == 0 )
+        {
+            pScene->addToScene( objects );
+        }
+        else
+        {
+            typeSceneObjectVector stampedObjects;
+            stampedObjects.setSize( stampedCount );
+            dMemcpy( stampedObjects.address(), objects.address() + firstIndex, stampedCount * sizeof(SceneObject*) );
+            pScene->addToScene( stampedObjects );
+        }
+    }
+
+    return stampedCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePrefab::compileFields( SimObject* pObject, const AbstractClassRep* pExcludeClassRep, CompiledFieldRange& fieldRange )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePrefab_CompileFields);
+
+    // Start the field range.
+    fieldRange.mFieldStart = (U32)mFields.size();
+    fieldRange.mDynamicFieldStart = (U32)mDynamicFields.size();
+
+    // Fetch field list.
+    const AbstractClassRep::FieldList& fieldList = pObject->getFieldList();
+
+    // Iterate fields.
+    for( S32 index = 0; index < fieldList.size(); ++index )
+    {
+        // Fetch field.
+        const AbstractClassRep::Field* pField = &fieldList[index];
+
+        // Ignore if field not appropriate.
+        if( pField->type == AbstractClassRep::DepricatedFieldType ||
+            pField->type == AbstractClassRep::StartGroupFieldType ||
+            pField->type == AbstractClassRep::EndGroupFieldType)
+            continue;
+
+        // Fetch fieldname.
+        StringTableEntry fieldName = StringTable->insert( pField->pFieldname );
+
+        // Ignore the group and scene membership as the instances are added to the scene when stamped.
+        if ( fieldName == prefabSceneFieldName || fieldName == prefabParentGroupFieldName )
+            continue;
+
+        // Ignore fields declared by the excluded class.
+        if ( pExcludeClassRep != NULL && pExcludeClassRep->findField( fieldName ) != NULL )
+            continue;
+
+        // Fetch element count.
+        const U32 elementCount = pField->elementCount;
+
+        // Skip fields at their default value in the same way TAML does.
+        if ( elementCount == 1 &&
+            pField->writeDataFn != NULL &&
+            pField->writeDataFn( pObject, fieldName ) == false )
+            continue;
+
+        // Can the field be copied as its resolved value?
+        // It can if the value is plain data held directly in the object and nothing needs notifying when it is set.
+        const bool resolved =
+            pField->setDataFn == &defaultProtectedSetFn &&
+            pField->validator == NULL &&
+            isResolvableFieldType( pField->type );
+
+        // Fetch the type size.
+        const U32 typeSize = resolved ? (U32)ConsoleBaseType::getType( pField->type )->getTypeSize() : 0;
+
+        // Iterate elements.
+        for( U32 elementIndex = 0; elementIndex < elementCount; ++elementIndex )
+        {
+            CompiledField compiledField;
+            compiledField.mpField = pField;
+            compiledField.mFieldName = fieldName;
+            compiledField.mElementIndex = elementIndex;
+            compiledField.mResolved = resolved;
+
+            if ( resolved )
+            {
+                // Copy the resolved value.
+                compiledField.mValueOffset = (U32)mDataBlob.size();
+                mDataBlob.setSize( compiledField.mValueOffset + typeSize );
+                dMemcpy( mDataBlob.address() + compiledField.mValueOffset, ((const U8*)pObject) + pField->offset + elementIndex * typeSize, typeSize );
+            }
+            else
+            {
+                char indexBuffer[8];
+                dSprintf( indexBuffer, 8, "%d", elementIndex );
+
+                // Fetch the formatted value.
+                const char* pFieldValue = pObject->getPrefixedDataField( fieldName, indexBuffer );
+
+                // Prepare the value once as it would be when set.
+                char prepBuffer[2048];
+                pFieldValue = ConsoleBaseType::getType( pField->type )->prepData( pFieldValue, prepBuffer, sizeof(prepBuffer) );
+
+                compiledField.mValueOffset = addValue( pFieldValue );
+            }
+
+            mFields.push_back( compiledField );
+        }
+    }
+
+    // Fetch the dynamic fields.
+    SimFieldDictionary* pFieldDictionary = pObject->getFieldDictionary();
+
+    // Iterate the dynamic fields.
+    if ( pFieldDictionary != NULL )
+    {
+        for( SimFieldDictionaryIterator itr( pFieldDictionary ); *itr; ++itr )
+        {
+            // Fetch the entry.
+            SimFieldDictionary::Entry* pEntry = *itr;
+
+            CompiledDynamicField compiledField;
+            compiledField.mSlotName = pEntry->slotName;
+            compiledField.mValueOffset = addValue( pEntry->value );
+            mDynamicFields.push_back( compiledField );
+        }
+    }
+
+    // Finish the field range.
+    fieldRange.mFieldCount = (U32)mFields.size() - fieldRange.mFieldStart;
+    fieldRange.mDynamicFieldCount = (U32)mDynamicFields.size() - fieldRange.mDynamicFieldStart;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePrefab::applyFields( SimObject* pObject, const CompiledFieldRange& fieldRange, const bool skipPosition ) const
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(ScenePrefab_ApplyFields);
+
+    // Apply the static fields.
+    const CompiledField* pCompiledField = mFields.address() + fieldRange.mFieldStart;
+    for ( U32 index = 0; index < fieldRange.mFieldCount; ++index, ++pCompiledField )
+    {
+        // Fetch the field.
+        const AbstractClassRep::Field* pField = pCompiledField->mpField;
+
+        // Skip the position if it is being set explicitly.
+        if ( skipPosition && pCompiledField->mFieldName == prefabPositionFieldName )
+            continue;
+
+        // Is the value resolved?
+        if ( pCompiledField->mResolved )
+        {
+            // Yes, so write it directly.
+            const U32 typeSize = (U32)ConsoleBaseType::getType( pField->type )->getTypeSize();
+            dMemcpy( ((U8*)pObject) + pField->offset + pCompiledField->mElementIndex * typeSize, mDataBlob.address() + pCompiledField->mValueOffset, typeSize );
+            continue;
+        }
+
+        // Fetch the formatted value.
+        const char* pFieldValue = mValueBlob.address() + pCompiledField->mValueOffset;
+
+        // Set the value through the setter.
+        // If the setter returns true then the data is set too as it would be by SimObject::setDataField().
+        if( (*pField->setDataFn)( pObject, pFieldValue ) )
+            Con::setData( pField->type, (void *) (((const char *)pObject) + pField->offset), pCompiledField->mElementIndex, 1, &pFieldValue, pField->table );
+    }
+
+    // Apply the dynamic fields.
+    const CompiledDynamicField* pCompiledDynamicField = mDynamicFields.address() + fieldRange.mDynamicFieldStart;
+    for ( U32 index = 0; index < fieldRange.mDynamicFieldCount; ++index, ++pCompiledDynamicField )
+    {
+        pObject->setDataField( pCompiledDynamicField->mSlotName, NULL, mValueBlob.address() + pCompiledDynamicField->mValueOffset );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 ScenePrefab::addValue( const char* pValue )
+{
+    // Append the value to the value blob.
+    const U32 valueOffset = (U32)mValueBlob.size();
+    const U32 valueSize = dStrlen( pValue ) + 1;
+    mValueBlob.setSize( valueOffset + valueSize );
+    dMemcpy( mValueBlob.address() + valueOffset, pValue, valueSize );
+
+    return valueOffset;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScenePrefab::compileCollisionShapes( const SceneObject* pTemplate )
+{
+    // Fetch the collision shape count.
+    const U32 collisionShapeCount = pTemplate->getCollisionShapeCount();
+
+    // Copy each collision shape definition with its own copy of the shape.
+    for ( U32 shapeIndex = 0; shapeIndex < collisionShapeCount; ++shapeIndex )
+    {
+        b2FixtureDef fixtureDef = pTemplate->getCollisionShapeDefinition( shapeIndex );
+        fixtureDef.shape = fixtureDef.shape->Clone( &mShapeAllocator );
+        fixtureDef.userData = NULL;
+        mCollisionShapes.push_back( fixtureDef );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScenePrefab::compileBehaviors( SceneObject* pTemplate )
+{
+    // Fetch the behavior count.
+    const U32 behaviorCount = pTemplate->getBehaviorCount();
+
+    // Finish if no behaviors.
+    if ( behaviorCount == 0 )
+        return true;
+
+    // Fetch the behavior base classes.
+    AbstractClassRep* pNativeBaseRep = NativeBehaviorInstance::getStaticClassRep();
+    AbstractClassRep* pScriptBaseRep = BehaviorInstance::getStaticClassRep();
+
+    // Iterate the behaviors.
+    for ( U32 behaviorIndex = 0; behaviorIndex < behaviorCount; ++behaviorIndex )
+    {
+        // Fetch the behavior instance.
+        BehaviorInstance* pBehaviorInstance = pTemplate->getBehavior( behaviorIndex );
+
+        // Fetch the behavior template.
+        BehaviorTemplate* pBehaviorTemplate = pBehaviorInstance->getTemplate();
+
+        // Finish if there's no template.
+        if ( pBehaviorTemplate == NULL )
+            return false;
+
+        CompiledBehavior compiledBehavior;
+        compiledBehavior.mpTemplate = pBehaviorTemplate;
+        dMemset( &compiledBehavior.mFields, 0, sizeof(compiledBehavior.mFields) );
+
+        // Compile the fields not declared by the base classes i.e. the typed fields of a native behavior.
+        // Script behaviors keep all their fields as dynamic fields.
+        const bool nativeBehavior = dynamic_cast<NativeBehaviorInstance*>( pBehaviorInstance ) != NULL;
+        compileFields( pBehaviorInstance, nativeBehavior ? pNativeBaseRep : pScriptBaseRep, compiledBehavior.mFields );
+
+        mBehaviors.push_back( compiledBehavior );
+    }
+
+    // Iterate the behavior connections.
+    for( BehaviorComponent::typeInstanceConnectionHash::iterator instanceItr = pTemplate->mBehaviorConnections.begin(); instanceItr != pTemplate->mBehaviorConnections.end(); ++instanceItr )
+    {
+        // Iterate output name connections.
+        for( BehaviorComponent::typeOutputNameConnectionHash::iterator outputItr = instanceItr->value->begin(); outputItr != instanceItr->value->end(); ++outputItr )
+        {
+            // Iterate input connections.
+            for( BehaviorComponent::typePortConnectionVector::iterator connectionItr = outputItr->value->begin(); connectionItr != outputItr->value->end(); ++connectionItr )
+            {
+                CompiledBehaviorConnection compiledConnection;
+                compiledConnection.mOutputBehavior = behaviorCount;
+                compiledConnection.mInputBehavior = behaviorCount;
+                compiledConnection.mOutputName = connectionItr->mOutputName;
+                compiledConnection.mInputName = connectionItr->mInputName;
+
+                // Find the connected behaviors by index.
+                for ( U32 behaviorIndex = 0; behaviorIndex < behaviorCount; ++behaviorIndex )
+                {
+                    BehaviorInstance* pBehaviorInstance = pTemplate->getBehavior( behaviorIndex );
+
+                    if ( pBehaviorInstance == connectionItr->mOutputInstance )
+                        compiledConnection.mOutputBehavior = behaviorIndex;
+
+                    if ( pBehaviorInstance == connectionItr->mInputInstance )
+                        compiledConnection.mInputBehavior = behaviorIndex;
+                }
+
+                // Sanity!
+                AssertFatal( compiledConnection.mOutputBehavior < behaviorCount && compiledConnection.mInputBehavior < behaviorCount, "ScenePrefab::compileBehaviors() - Failed to find connected behavior." );
+
+                mBehaviorConnections.push_back( compiledConnection );
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_PREFAB_H_
+#define _SCENE_PREFAB_H_
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _BEHAVIORTEMPLATE_H_
+#include "component/behaviors/behaviorTemplate.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A scene object template compiled once and used to stamp out many instances in bulk.
+///
+/// Compiling reads a template object (or a TAML file, read only once) into a flat representation:
+/// - Static fields whose value is held directly in the object are copied as their resolved bytes
+///   and written straight into each instance.  Fields with a setter keep their formatted value and
+///   are applied through the setter in the same way TAML does.  Fields at their default value are
+///   skipped entirely.
+/// - Dynamic fields are kept as slot/value pairs.
+/// - Collision shapes are kept as fixture definitions with their own copy of each shape.
+/// - Behaviors are kept as their template with their own compiled fields plus their connections.
+///
+/// Stamping creates every instance, applies the compiled fields and collision shapes, registers
+/// them all in one pass, adds the behaviors and finally adds all the instances to the scene with a
+/// single bulk add.  The template is not needed after compiling.
+///
+/// NOTE: State a class only persists through TAML custom nodes, other than its collision shapes and
+/// behaviors, is not compiled e.g. the sprites of a CompositeSprite.
+class ScenePrefab : public SimObject
+{
+    typedef SimObject Parent;
+
+public:
+    /// A compiled static field element.
+    struct CompiledField
+    {
+        const AbstractClassRep::Field*  mpField;
+        StringTableEntry                mFieldName;
+        U32                             mElementIndex;
+
+        /// The offset of the resolved value in the data blob or of the formatted value in the
+        /// value blob when applied through the field setter.
+        U32                             mValueOffset;
+        bool                            mResolved;
+    };
+
+    /// A compiled dynamic field.
+    struct CompiledDynamicField
+    {
+        StringTableEntry                mSlotName;
+        U32                             mValueOffset;
+    };
+
+    /// A range of compiled fields for an object.
+    struct CompiledFieldRange
+    {
+        U32                             mFieldStart;
+        U32                             mFieldCount;
+        U32                             mDynamicFieldStart;
+        U32                             mDynamicFieldCount;
+    };
+
+    /// A compiled behavior.
+    struct CompiledBehavior
+    {
+        SimObjectPtr<BehaviorTemplate>  mpTemplate;
+        CompiledFieldRange              mFields;
+    };
+
+    /// A compiled behavior connection referring to behaviors by their index.
+    struct CompiledBehaviorConnection
+    {
+        U32                             mOutputBehavior;
+        U32                             mInputBehavior;
+        StringTableEntry                mOutputName;
+        StringTableEntry                mInputName;
+    };
+
+private:
+    AbstractClassRep*                   mpClassRep;
+    StringTableEntry                    mSourceFile;
+
+    /// Compiled fields.
+    Vector<CompiledField>               mFields;
+    Vector<CompiledDynamicField>        mDynamicFields;
+    Vector<U8>                          mDataBlob;
+    Vector<char>                        mValueBlob;
+    CompiledFieldRange                  mObjectFields;
+
+    /// Compiled collision shapes.
+    Vector<b2FixtureDef>                mCollisionShapes;
+    b2BlockAllocator                    mShapeAllocator;
+
+    /// Compiled behaviors.
+    Vector<CompiledBehavior>            mBehaviors;
+    Vector<CompiledBehaviorConnection>  mBehaviorConnections;
+
+private:
+    void                        compileFields( SimObject* pObject, const AbstractClassRep* pExcludeClassRep, CompiledFieldRange& fieldRange );
+    void                        applyFields( SimObject* pObject, const CompiledFieldRange& fieldRange, const bool skipPosition ) const;
+    U32                         addValue( const char* pValue );
+    void                        compileCollisionShapes( const SceneObject* pTemplate );
+    bool                        compileBehaviors( SceneObject* pTemplate );
+
+public:
+    ScenePrefab();
+    virtual ~ScenePrefab();
+
+    /// Engine.
+    virtual void                onRemove();
+
+    /// Compilation.
+    bool                        compile( SceneObject* pTemplate );
+    bool                        compileFile( const char* pTamlFile );
+    void                        clear( void );
+    inline bool                 isCompiled( void ) const                    { return mpClassRep != NULL; }
+    inline StringTableEntry     getSourceFile( void ) const                 { return mSourceFile; }
+
+    /// Compiled details.
+    inline U32                  getCompiledFieldCount( void ) const         { return mObjectFields.mFieldCount; }
+    inline U32                  getCompiledDynamicFieldCount( void ) const  { return mObjectFields.mDynamicFieldCount; }
+    inline U32                  getCompiledCollisionShapeCount( void ) const { return (U32)mCollisionShapes.size(); }
+    inline U32                  getCompiledBehaviorCount( void ) const      { return (U32)mBehaviors.size(); }
+
+    /// Instantiation.
+    U32                         stamp( Scene* pScene, const U32 count, typeSceneObjectVector& objects, const Vector2* pPositions = NULL );
+
+    /// Declare Console Object.
+    DECLARE_CONOBJECT( ScenePrefab );
+};
+
+#endif // _SCENE_PREFAB_H_
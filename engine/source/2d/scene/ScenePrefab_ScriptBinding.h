@@ -0,0 +1,149 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+ConsoleMethodGroupBeginWithDocs(ScenePrefab, SimObject)
+
+/*! Compiles the prefab from the specified template object.
+    The template's fields, collision shapes and behaviors are compiled once so the template is not needed afterwards.
+    @param templateObject The SceneObject to use as the template.
+    @return Whether the prefab was compiled or not.
+*/
+ConsoleMethodWithDocs(ScenePrefab, compile, ConsoleBool, 3, 3, (templateObject))
+{
+    // Find the template object.
+    SceneObject* pTemplate = Sim::findObject<SceneObject>( argv[2] );
+
+    // Did we find the template?
+    if ( pTemplate == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "ScenePrefab::compile() - Could not find the specified template object '%s'.", argv[2] );
+        return false;
+    }
+
+    return object->compile( pTemplate );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Compiles the prefab from the specified TAML file.  The file is read only once.
+    @param tamlFile The TAML file containing a SceneObject.
+    @return Whether the prefab was compiled or not.
+*/
+ConsoleMethodWithDocs(ScenePrefab, compileFile, ConsoleBool, 3, 3, (tamlFile))
+{
+    return object->compileFile( argv[2] );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets whether the prefab has been compiled or not.
+    @return Whether the prefab has been compiled or not.
+*/
+ConsoleMethodWithDocs(ScenePrefab, isCompiled, ConsoleBool, 2, 2, ())
+{
+    return object->isCompiled();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Clears the compiled prefab.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(ScenePrefab, clear, ConsoleVoid, 2, 2, ())
+{
+    object->clear();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Stamps instances of the prefab into the specified scene in a single bulk operation.
+    @param scene The scene to add the instances to.
+    @param count The number of instances to stamp.
+    @param positions An optional list of "x y" positions, one for each instance.
+    @return A space-separated list of the stamped object Ids.
+*/
+ConsoleMethodWithDocs(ScenePrefab, stamp, ConsoleString, 4, 5, (scene, count, [positions]))
+{
+    // Find the scene.
+    Scene* pScene = Sim::findObject<Scene>( argv[2] );
+
+    // Did we find the scene?
+    if ( pScene == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "ScenePrefab::stamp() - Could not find the specified scene '%s'.", argv[2] );
+        return StringTable->EmptyString;
+    }
+
+    // Fetch the count.
+    const S32 count = dAtoi( argv[3] );
+
+    // Finish if nothing to stamp.
+    if ( count <= 0 )
+        return StringTable->EmptyString;
+
+    // Parse any positions.
+    Vector<Vector2> positions;
+    if ( argc > 4 )
+    {
+        // Fetch the element count.
+        const U32 elementCount = StringUnit::getUnitCount( argv[4], " \t\n" );
+
+        // Is there a position for each instance?
+        if ( elementCount != (U32)count * 2 )
+        {
+            // No, so warn.
+            Con::warnf( "ScenePrefab::stamp() - Expected %d positions but got %d elements.", count, elementCount );
+            return StringTable->EmptyString;
+        }
+
+        positions.setSize( count );
+        for ( S32 n = 0; n < count; ++n )
+        {
+            positions[n].x = dAtof( StringUnit::getUnit( argv[4], n * 2, " \t\n" ) );
+            positions[n].y = dAtof( StringUnit::getUnit( argv[4], n * 2 + 1, " \t\n" ) );
+        }
+    }
+
+    // Stamp the instances.
+    typeSceneObjectVector objects;
+    const U32 stampedCount = object->stamp( pScene, (U32)count, objects, positions.size() > 0 ? positions.address() : NULL );
+
+    // Finish if nothing stamped.
+    if ( stampedCount == 0 )
+        return StringTable->EmptyString;
+
+    // Format the object Ids.
+    const U32 bufferSize = stampedCount * 12 + 1;
+    char* pBuffer = Con::getReturnBuffer( bufferSize );
+    U32 bufferOffset = 0;
+    pBuffer[0] = 0;
+    for ( U32 n = 0; n < stampedCount; ++n )
+    {
+        bufferOffset += dSprintf( pBuffer + bufferOffset, bufferSize - bufferOffset, n == 0 ? "%d" : " %d", objects[n]->getId() );
+    }
+
+    return pBuffer;
+}
+
+ConsoleMethodGroupEndWithDocs(ScenePrefab)
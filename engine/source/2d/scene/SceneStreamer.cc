@@ -0,0 +1,1148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_STREAMER_H_
+#include "2d/scene/SceneStreamer.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _SCENE_WINDOW_H_
+#include "2d/gui/SceneWindow.h"
+#endif
+
+#ifndef _TAML_H_
+#include "persistence/taml/taml.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+#ifndef _CONSOLETYPES_H_
+#include "console/consoleTypes.h"
+#endif
+
+// Script bindings.
+#include "SceneStreamer_ScriptBinding.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+IMPLEMENT_CONOBJECT( SceneStreamer );
+
+//-----------------------------------------------------------------------------
+
+/// Background reader for chunk files.
+/// Only raw file reads happen here; object creation always happens on the main thread.
+class SceneStreamerReader : public Thread
+{
+private:
+    Mutex                                   mLock;
+    Semaphore                               mSignal;
+    Vector<SceneStreamer::ReadRequest*>     mPending;
+    Vector<SceneStreamer::ReadRequest*>     mCompleted;
+
+public:
+    SceneStreamerReader() : Thread( 0, NULL, false ), mSignal( 0 )
+    {
+        VECTOR_SET_ASSOCIATION( mPending );
+        VECTOR_SET_ASSOCIATION( mCompleted );
+    }
+
+    virtual ~SceneStreamerReader()
+    {
+        // Delete any outstanding requests.
+        for ( S32 n = 0; n < mPending.size(); ++n )
+        {
+            delete [] mPending[n]->mpBuffer;
+            delete mPending[n];
+        }
+        for ( S32 n = 0; n < mCompleted.size(); ++n )
+        {
+            delete [] mCompleted[n]->mpBuffer;
+            delete mCompleted[n];
+        }
+    }
+
+    void queueRequest( SceneStreamer::ReadRequest* pRequest )
+    {
+        mLock.lock();
+        mPending.push_back( pRequest );
+        mLock.unlock();
+
+        // Wake the reader.
+        mSignal.release();
+    }
+
+    void fetchCompleted( Vector<SceneStreamer::ReadRequest*>& completed )
+    {
+        mLock.lock();
+        completed.merge( mCompleted );
+        mCompleted.clear();
+        mLock.unlock();
+    }
+
+    void shutdown( void )
+    {
+        // Stop and wake the reader.
+        stop();
+        mSignal.release();
+        join();
+    }
+
+    virtual void run( void* arg = 0 )
+    {
+        while( !checkForStop() )
+        {
+            // Wait for a request.
+            mSignal.acquire();
+
+            // Fetch the next request.
+            mLock.lock();
+            SceneStreamer::ReadRequest* pRequest = NULL;
+            if ( mPending.size() > 0 )
+            {
+                pRequest = mPending.front();
+                mPending.pop_front();
+            }
+            mLock.unlock();
+
+            if ( pRequest == NULL )
+                continue;
+
+            // Read the file.
+            const U32 startTime = Platform::getRealMilliseconds();
+            pRequest->mSuccess = readFile( pRequest );
+            pRequest->mReadTime = Platform::getRealMilliseconds() - startTime;
+
+            // Complete the request.
+            mLock.lock();
+            mCompleted.push_back( pRequest );
+            mLock.unlock();
+        }
+
+        // Release this thread's frame arena.
+        FrameAllocator::destroyThreadArena();
+    }
+
+    static bool readFile( SceneStreamer::ReadRequest* pRequest )
+    {
+        File file;
+
+        // Open the file.
+        if ( file.open( pRequest->mFilePath, File::Read ) != File::Ok )
+            return false;
+
+        // Fetch the file size.
+        const U32 fileSize = file.getSize();
+        if ( fileSize == 0 )
+            return false;
+
+        // Read the file.
+        pRequest->mpBuffer = new U8[fileSize];
+        pRequest->mBufferSize = fileSize;
+        U32 bytesRead = 0;
+        file.read( fileSize, (char*)pRequest->mpBuffer, &bytesRead );
+        file.close();
+
+        return bytesRead == fileSize;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+struct ChunkLoadCandidate
+{
+    S32 mChunkX;
+    S32 mChunkY;
+    F32 mDistance;
+};
+
+static S32 QSORT_CALLBACK chunkLoadCandidateSort( const void* a, const void* b )
+{
+    const F32 distanceA = static_cast<const ChunkLoadCandidate*>(a)->mDistance;
+    const F32 distanceB = static_cast<const ChunkLoadCandidate*>(b)->mDistance;
+
+    return distanceA < distanceB ? -1 : distanceA > distanceB ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SceneStreamer::getChunkStateDescription( const ChunkState state )
+{
+    switch( state )
+    {
+        case SceneStreamer::ChunkUnloaded:  return "unloaded";
+        case SceneStreamer::ChunkReading:   return "reading";
+        case SceneStreamer::ChunkRead:      return "read";
+        case SceneStreamer::ChunkLoaded:    return "loaded";
+        case SceneStreamer::ChunkMissing:   return "missing";
+    }
+
+    return "unknown";
+}
+
+//-----------------------------------------------------------------------------
+
+SceneStreamer::SceneStreamer() :
+    mChunkSize( 64.0f, 64.0f ),
+    mChunkPath( StringTable->EmptyString ),
+    mLoadDistance( 128.0f ),
+    mUnloadDistance( 192.0f ),
+    mMemoryBudget( 0.0f ),
+    mObjectMemoryEstimate( 1024 ),
+    mMaxLoadsPerTick( 1 ),
+    mpReader( NULL ),
+    mResidentSize( 0 ),
+    mTotalLoads( 0 ),
+    mTotalUnloads( 0 ),
+    mTotalLoadTime( 0 ),
+    mMaxLoadTime( 0 ),
+    mBudgetRejections( 0 )
+{
+    VECTOR_SET_ASSOCIATION( mFocusPoints );
+
+    // Don't tick until added.
+    setProcessTicks( false );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneStreamer::~SceneStreamer()
+{
+    // Delete any chunks created without being added.
+    deleteChunks();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::initPersistFields()
+{
+    // Call parent.
+    Parent::initPersistFields();
+
+    addField( "ChunkSize", TypeVector2, Offset(mChunkSize, SceneStreamer), &writeChunkSize, "The world size of each chunk." );
+    addField( "ChunkPath", TypeString, Offset(mChunkPath, SceneStreamer), "The chunk file path format.  Must contain two '%d' formats for the chunk X and Y coordinates e.g. '^game/world/chunk_%d_%d.baml'." );
+    addField( "LoadDistance", TypeF32, Offset(mLoadDistance, SceneStreamer), &writeLoadDistance, "The distance from a focus point within which chunks are loaded." );
+    addField( "UnloadDistance", TypeF32, Offset(mUnloadDistance, SceneStreamer), &writeUnloadDistance, "The distance from all focus points beyond which chunks are unloaded.  Should be larger than the load distance to provide hysteresis." );
+    addField( "MemoryBudget", TypeF32, Offset(mMemoryBudget, SceneStreamer), &writeMemoryBudget, "The estimated resident memory budget for loaded chunks in megabytes.  Zero is unlimited." );
+    addField( "ObjectMemoryEstimate", TypeS32, Offset(mObjectMemoryEstimate, SceneStreamer), &writeObjectMemoryEstimate, "The estimated resident memory of each loaded object in bytes." );
+    addField( "MaxLoadsPerTick", TypeS32, Offset(mMaxLoadsPerTick, SceneStreamer), &writeMaxLoadsPerTick, "The maximum number of chunks instantiated per tick." );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::onAdd()
+{
+    // Call parent.
+    if ( !Parent::onAdd() )
+        return false;
+
+    // Start the reader.
+    mpReader = new SceneStreamerReader();
+    mpReader->start();
+
+    // Start ticking.
+    setProcessTicks( true );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::onRemove()
+{
+    // Stop ticking.
+    setProcessTicks( false );
+
+    // Stop the reader.
+    if ( mpReader != NULL )
+    {
+        mpReader->shutdown();
+        delete mpReader;
+        mpReader = NULL;
+    }
+
+    // Unload all chunks.
+    unloadAllChunks();
+
+    // Delete the chunks.
+    deleteChunks();
+
+    // Call parent.
+    Parent::onRemove();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::setScene( Scene* pScene )
+{
+    // Finish if no change.
+    if ( pScene == mpScene )
+        return;
+
+    // Unload from any existing scene.
+    unloadAllChunks();
+
+    mpScene = pScene;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneStreamer::addFocusObject( SimObject* pObject )
+{
+    // Sanity!
+    AssertFatal( pObject != NULL, "SceneStreamer::addFocusObject() - Cannot add a NULL focus object." );
+
+    FocusPoint focusPoint;
+    focusPoint.mpObject = pObject;
+    mFocusPoints.push_back( focusPoint );
+
+    // Update the focus position.
+    updateFocusPositions();
+
+    return mFocusPoints.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneStreamer::addFocusPoint( const Vector2& position )
+{
+    FocusPoint focusPoint;
+    focusPoint.mPosition = position;
+    mFocusPoints.push_back( focusPoint );
+
+    return mFocusPoints.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::setFocusPoint( const U32 index, const Vector2& position )
+{
+    // Sanity!
+    if ( index >= (U32)mFocusPoints.size() )
+    {
+        Con::warnf( "SceneStreamer::setFocusPoint() - Invalid focus index '%d'.", index );
+        return;
+    }
+
+    mFocusPoints[index].mpObject = NULL;
+    mFocusPoints[index].mPosition = position;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::removeFocus( const U32 index )
+{
+    // Sanity!
+    if ( index >= (U32)mFocusPoints.size() )
+    {
+        Con::warnf( "SceneStreamer::removeFocus() - Invalid focus index '%d'.", index );
+        return;
+    }
+
+    mFocusPoints.erase( index );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::clearFocus( void )
+{
+    mFocusPoints.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::getChunkCoordinates( const Vector2& position, S32& chunkX, S32& chunkY ) const
+{
+    chunkX = (S32)mFloor( position.x / mChunkSize.x );
+    chunkY = (S32)mFloor( position.y / mChunkSize.y );
+}
+
+//-----------------------------------------------------------------------------
+
+RectF SceneStreamer::getChunkArea( const S32 chunkX, const S32 chunkY ) const
+{
+    return RectF( chunkX * mChunkSize.x, chunkY * mChunkSize.y, mChunkSize.x, mChunkSize.y );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::getChunkFilePath( const S32 chunkX, const S32 chunkY, char* pBuffer, const U32 bufferSize ) const
+{
+    // Format the chunk file.
+    char chunkFileBuffer[1024];
+    dSprintf( chunkFileBuffer, sizeof(chunkFileBuffer), mChunkPath, chunkX, chunkY );
+
+    // Expand the chunk file.
+    Con::expandPath( pBuffer, bufferSize, chunkFileBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+const SceneStreamer::Chunk* SceneStreamer::findChunk( const S32 chunkX, const S32 chunkY ) const
+{
+    typeChunkHash::const_iterator itr = mChunks.find( getChunkKey( chunkX, chunkY ) );
+
+    return itr == mChunks.end() ? NULL : itr->value;
+}
+
+//-----------------------------------------------------------------------------
+
+SceneStreamer::Chunk* SceneStreamer::createChunk( const S32 chunkX, const S32 chunkY )
+{
+    // Fetch the chunk key.
+    const U32 chunkKey = getChunkKey( chunkX, chunkY );
+
+    // Return any existing chunk.
+    typeChunkHash::iterator itr = mChunks.find( chunkKey );
+    if ( itr != mChunks.end() )
+        return itr->value;
+
+    // Create the chunk.
+    Chunk* pChunk = new Chunk( chunkX, chunkY );
+    mChunks.insert( chunkKey, pChunk );
+
+    return pChunk;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::purgeChunks( void )
+{
+    // Gather the unloaded chunks.
+    // Chunks with a pending read are kept so the read can be matched when it completes.
+    Vector<U32> chunkKeys;
+    for ( typeChunkHash::iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+    {
+        if ( itr->value->mState == ChunkUnloaded )
+            chunkKeys.push_back( itr->key );
+    }
+
+    // Delete the unloaded chunks.
+    for ( S32 n = 0; n < chunkKeys.size(); ++n )
+    {
+        typeChunkHash::iterator itr = mChunks.find( chunkKeys[n] );
+        Chunk* pChunk = itr->value;
+        mChunks.erase( itr );
+        delete pChunk;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::deleteChunks( void )
+{
+    for ( typeChunkHash::iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+    {
+        delete [] itr->value->mpBuffer;
+        delete itr->value;
+    }
+    mChunks.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::loadChunk( const S32 chunkX, const S32 chunkY )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_LoadChunk);
+
+    // Finish if no scene.
+    if ( mpScene.isNull() )
+    {
+        Con::warnf( "SceneStreamer::loadChunk() - No scene has been set." );
+        return false;
+    }
+
+    // Fetch the chunk.
+    Chunk* pChunk = createChunk( chunkX, chunkY );
+
+    // Finish if already loaded.
+    if ( pChunk->mState == ChunkLoaded )
+        return true;
+
+    // Discard any pending background read.
+    if ( pChunk->mState == ChunkReading )
+        pChunk->mUnloadRequested = true;
+
+    // Read the file immediately if not already read.
+    if ( pChunk->mState != ChunkRead )
+    {
+        ReadRequest request;
+        getChunkFilePath( chunkX, chunkY, request.mFilePath, sizeof(request.mFilePath) );
+        request.mpBuffer = NULL;
+        request.mBufferSize = 0;
+
+        const U32 startTime = Platform::getRealMilliseconds();
+        const bool success = SceneStreamerReader::readFile( &request );
+        pChunk->mReadTime = Platform::getRealMilliseconds() - startTime;
+
+        if ( !success )
+        {
+            // Warn.
+            Con::warnf( "SceneStreamer::loadChunk() - Could not read chunk file '%s'.", request.mFilePath );
+            delete [] request.mpBuffer;
+            pChunk->mState = ChunkMissing;
+            return false;
+        }
+
+        pChunk->mpBuffer = request.mpBuffer;
+        pChunk->mBufferSize = request.mBufferSize;
+        pChunk->mState = ChunkRead;
+    }
+
+    return instantiateChunk( pChunk );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::unloadChunk( const S32 chunkX, const S32 chunkY )
+{
+    // Find the chunk.
+    typeChunkHash::iterator itr = mChunks.find( getChunkKey( chunkX, chunkY ) );
+
+    // Finish if not found.
+    if ( itr == mChunks.end() )
+        return false;
+
+    // Fetch the chunk.
+    Chunk* pChunk = itr->value;
+
+    // Finish if nothing to unload.
+    if ( pChunk->mState == ChunkUnloaded || pChunk->mState == ChunkMissing )
+        return false;
+
+    releaseChunk( pChunk );
+
+    // Delete the chunk if it was unloaded.
+    if ( pChunk->mState == ChunkUnloaded )
+    {
+        mChunks.erase( itr );
+        delete pChunk;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::unloadAllChunks( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_UnloadAllChunks);
+
+    for ( typeChunkHash::iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+    {
+        releaseChunk( itr->value );
+    }
+
+    // Delete the unloaded chunks.
+    purgeChunks();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::requestChunk( Chunk* pChunk )
+{
+    // Sanity!
+    AssertFatal( pChunk->mState == ChunkUnloaded, "SceneStreamer::requestChunk() - Chunk is not unloaded." );
+
+    // Finish if no reader.
+    if ( mpReader == NULL )
+        return false;
+
+    // Create the read request.
+    ReadRequest* pRequest = new ReadRequest();
+    pRequest->mChunkKey = getChunkKey( pChunk->mChunkX, pChunk->mChunkY );
+    pRequest->mpBuffer = NULL;
+    pRequest->mBufferSize = 0;
+    pRequest->mReadTime = 0;
+    pRequest->mSuccess = false;
+    getChunkFilePath( pChunk->mChunkX, pChunk->mChunkY, pRequest->mFilePath, sizeof(pRequest->mFilePath) );
+
+    // Queue the request.
+    pChunk->mState = ChunkReading;
+    pChunk->mUnloadRequested = false;
+    mpReader->queueRequest( pRequest );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::processReadResults( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_ProcessReadResults);
+
+    // Fetch the completed reads.
+    Vector<ReadRequest*> completed;
+    mpReader->fetchCompleted( completed );
+
+    for ( S32 n = 0; n < completed.size(); ++n )
+    {
+        ReadRequest* pRequest = completed[n];
+
+        // Find the chunk.
+        typeChunkHash::iterator itr = mChunks.find( pRequest->mChunkKey );
+        Chunk* pChunk = itr == mChunks.end() ? NULL : itr->value;
+
+        // Discard the read if no longer required.
+        if ( pChunk == NULL || pChunk->mState != ChunkReading || pChunk->mUnloadRequested )
+        {
+            // Delete the chunk if the read was its only use.
+            if ( pChunk != NULL && pChunk->mState == ChunkReading )
+            {
+                mChunks.erase( itr );
+                delete pChunk;
+            }
+            else if ( pChunk != NULL )
+            {
+                pChunk->mUnloadRequested = false;
+            }
+
+            delete [] pRequest->mpBuffer;
+            delete pRequest;
+            continue;
+        }
+
+        pChunk->mReadTime = pRequest->mReadTime;
+
+        // Did the read succeed?
+        if ( pRequest->mSuccess )
+        {
+            // Yes, so take the buffer.
+            pChunk->mpBuffer = pRequest->mpBuffer;
+            pChunk->mBufferSize = pRequest->mBufferSize;
+            pChunk->mState = ChunkRead;
+        }
+        else
+        {
+            // No, so the chunk has no file.
+            delete [] pRequest->mpBuffer;
+            pChunk->mState = ChunkMissing;
+        }
+
+        delete pRequest;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::instantiateChunk( Chunk* pChunk )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_InstantiateChunk);
+
+    // Sanity!
+    AssertFatal( pChunk->mState == ChunkRead, "SceneStreamer::instantiateChunk() - Chunk has not been read." );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    // Read the chunk objects from the buffer.
+    SimObject* pRootObject = NULL;
+    {
+        MemStream stream( pChunk->mBufferSize, pChunk->mpBuffer, true, false );
+        Taml taml;
+        pRootObject = taml.readBinary( stream );
+    }
+
+    // Release the buffer.
+    pChunk->mFileSize = pChunk->mBufferSize;
+    delete [] pChunk->mpBuffer;
+    pChunk->mpBuffer = NULL;
+    pChunk->mBufferSize = 0;
+
+    // Finish if nothing was read.
+    if ( pRootObject == NULL )
+    {
+        Con::warnf( "SceneStreamer::instantiateChunk() - Failed to read chunk (%d, %d).", pChunk->mChunkX, pChunk->mChunkY );
+        pChunk->mState = ChunkMissing;
+        return false;
+    }
+
+    // Gather the chunk objects.
+    typeSceneObjectVector sceneObjects;
+    SceneObject* pRootSceneObject = dynamic_cast<SceneObject*>( pRootObject );
+    if ( pRootSceneObject != NULL )
+    {
+        sceneObjects.push_back( pRootSceneObject );
+    }
+    else
+    {
+        SimSet* pSet = dynamic_cast<SimSet*>( pRootObject );
+        if ( pSet != NULL )
+        {
+            sceneObjects.reserve( pSet->size() );
+            for ( SimSet::iterator itr = pSet->begin(); itr != pSet->end(); ++itr )
+            {
+                SceneObject* pSceneObject = dynamic_cast<SceneObject*>( *itr );
+                if ( pSceneObject != NULL )
+                    sceneObjects.push_back( pSceneObject );
+            }
+
+            // Detach the objects from the container so they outlive it.
+            for ( S32 n = 0; n < sceneObjects.size(); ++n )
+                pSet->removeObject( sceneObjects[n] );
+        }
+
+        // Delete the container.
+        pRootObject->deleteObject();
+    }
+
+    // Add the objects to the scene in bulk.
+    mpScene->addToScene( sceneObjects );
+
+    // Record the chunk objects.
+    pChunk->mObjects.setSize( sceneObjects.size() );
+    for ( S32 n = 0; n < sceneObjects.size(); ++n )
+        pChunk->mObjects[n] = sceneObjects[n]->getId();
+
+    // Update the metrics.
+    pChunk->mState = ChunkLoaded;
+    pChunk->mBudgetRejected = false;
+    pChunk->mInstantiateTime = Platform::getRealMilliseconds() - startTime;
+    pChunk->mResidentSize = pChunk->mFileSize + sceneObjects.size() * (U32)getMax( mObjectMemoryEstimate, 0 );
+    pChunk->mLoadCount++;
+    mResidentSize += pChunk->mResidentSize;
+
+    const U32 loadTime = pChunk->mReadTime + pChunk->mInstantiateTime;
+    mTotalLoads++;
+    mTotalLoadTime += loadTime;
+    mMaxLoadTime = getMax( mMaxLoadTime, loadTime );
+
+    // Perform callback.
+    if ( isMethod( "onChunkLoaded" ) )
+    {
+        char chunkBuffer[32];
+        dSprintf( chunkBuffer, sizeof(chunkBuffer), "%d %d", pChunk->mChunkX, pChunk->mChunkY );
+        Con::executef( this, 4, "onChunkLoaded", chunkBuffer, Con::getIntArg( sceneObjects.size() ), Con::getIntArg( loadTime ) );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::releaseChunk( Chunk* pChunk )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_ReleaseChunk);
+
+    switch( pChunk->mState )
+    {
+        case ChunkReading:
+        {
+            // Discard the read when it completes.
+            pChunk->mUnloadRequested = true;
+            return;
+        }
+
+        case ChunkRead:
+        {
+            // Release the buffer.
+            delete [] pChunk->mpBuffer;
+            pChunk->mpBuffer = NULL;
+            pChunk->mBufferSize = 0;
+            pChunk->mState = ChunkUnloaded;
+            return;
+        }
+
+        case ChunkLoaded:
+            break;
+
+        default:
+            return;
+    }
+
+    // Gather the chunk objects that still exist.
+    typeSceneObjectVector sceneObjects;
+    sceneObjects.reserve( pChunk->mObjects.size() );
+    for ( S32 n = 0; n < pChunk->mObjects.size(); ++n )
+    {
+        SceneObject* pSceneObject = Sim::findObject<SceneObject>( pChunk->mObjects[n] );
+        if ( pSceneObject != NULL )
+            sceneObjects.push_back( pSceneObject );
+    }
+
+    // Remove the objects from the scene in bulk.
+    if ( mpScene.notNull() )
+        mpScene->removeFromScene( sceneObjects );
+
+    // Delete the objects.
+    // Ids are used as the removal callbacks may have deleted objects.
+    for ( S32 n = 0; n < pChunk->mObjects.size(); ++n )
+    {
+        SimObject* pObject = Sim::findObject( pChunk->mObjects[n] );
+        if ( pObject != NULL )
+            pObject->deleteObject();
+    }
+    pChunk->mObjects.clear();
+
+    // Update the metrics.
+    mResidentSize -= getMin( mResidentSize, pChunk->mResidentSize );
+    mTotalUnloads++;
+    pChunk->mState = ChunkUnloaded;
+
+    // Perform callback.
+    if ( isMethod( "onChunkUnloaded" ) )
+    {
+        char chunkBuffer[32];
+        dSprintf( chunkBuffer, sizeof(chunkBuffer), "%d %d", pChunk->mChunkX, pChunk->mChunkY );
+        Con::executef( this, 2, "onChunkUnloaded", chunkBuffer );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneStreamer::writeChunks( Scene* pScene )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_WriteChunks);
+
+    // Sanity!
+    AssertFatal( pScene != NULL, "SceneStreamer::writeChunks() - Cannot write a NULL scene." );
+
+    // Partition the scene objects into chunks.
+    typedef HashMap<U32, SimSet*> typeChunkSetHash;
+    typeChunkSetHash chunkSets;
+    const typeSceneObjectVector& sceneObjects = pScene->getSceneObjects();
+    for ( S32 n = 0; n < sceneObjects.size(); ++n )
+    {
+        SceneObject* pSceneObject = sceneObjects[n];
+
+        // Fetch the chunk.
+        S32 chunkX, chunkY;
+        getChunkCoordinates( pSceneObject->getPosition(), chunkX, chunkY );
+        const U32 chunkKey = getChunkKey( chunkX, chunkY );
+
+        // Fetch the chunk set.
+        typeChunkSetHash::iterator itr = chunkSets.find( chunkKey );
+        SimSet* pChunkSet;
+        if ( itr == chunkSets.end() )
+        {
+            pChunkSet = new SimSet();
+            pChunkSet->registerObject();
+            pChunkSet->setDataField( StringTable->insert( "ChunkX" ), NULL, Con::getIntArg( chunkX ) );
+            pChunkSet->setDataField( StringTable->insert( "ChunkY" ), NULL, Con::getIntArg( chunkY ) );
+            chunkSets.insert( chunkKey, pChunkSet );
+        }
+        else
+        {
+            pChunkSet = itr->value;
+        }
+
+        pChunkSet->addObject( pSceneObject );
+    }
+
+    // Write the chunks.
+    Taml taml;
+    taml.setFormatMode( Taml::BinaryFormat );
+    taml.setAutoFormat( false );
+
+    U32 writtenCount = 0;
+    for ( typeChunkSetHash::iterator itr = chunkSets.begin(); itr != chunkSets.end(); ++itr )
+    {
+        SimSet* pChunkSet = itr->value;
+
+        // Fetch the chunk file.
+        char filePathBuffer[1024];
+        getChunkFilePath( dAtoi( pChunkSet->getDataField( StringTable->insert( "ChunkX" ), NULL ) ), dAtoi( pChunkSet->getDataField( StringTable->insert( "ChunkY" ), NULL ) ), filePathBuffer, sizeof(filePathBuffer) );
+
+        // Write the chunk.
+        Platform::createPath( filePathBuffer );
+        if ( taml.write( pChunkSet, filePathBuffer ) )
+            writtenCount++;
+        else
+            Con::warnf( "SceneStreamer::writeChunks() - Failed to write chunk file '%s'.", filePathBuffer );
+
+        // Delete the chunk set.
+        pChunkSet->deleteObject();
+    }
+
+    return writtenCount;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::updateFocusPositions( void )
+{
+    for ( S32 n = 0; n < mFocusPoints.size(); ++n )
+    {
+        FocusPoint& focusPoint = mFocusPoints[n];
+
+        // Skip if a fixed position or the focus object was deleted.
+        if ( focusPoint.mpObject.isNull() )
+            continue;
+
+        // Fetch the focus object position.
+        SceneWindow* pSceneWindow = dynamic_cast<SceneWindow*>( (SimObject*)focusPoint.mpObject );
+        if ( pSceneWindow != NULL )
+        {
+            focusPoint.mPosition = pSceneWindow->getCameraPosition();
+            continue;
+        }
+
+        SceneObject* pSceneObject = dynamic_cast<SceneObject*>( (SimObject*)focusPoint.mpObject );
+        if ( pSceneObject != NULL )
+            focusPoint.mPosition = pSceneObject->getPosition();
+    }
+
+    return mFocusPoints.size() > 0;
+}
+
+//-----------------------------------------------------------------------------
+
+F32 SceneStreamer::getFocusDistance( const S32 chunkX, const S32 chunkY ) const
+{
+    // Fetch the chunk area.
+    const RectF chunkArea = getChunkArea( chunkX, chunkY );
+    const Point2F chunkMin = chunkArea.point;
+    const Point2F chunkMax = chunkArea.point + chunkArea.extent;
+
+    // Find the nearest focus point to the chunk area.
+    F32 nearestDistanceSqr = F32_MAX;
+    for ( S32 n = 0; n < mFocusPoints.size(); ++n )
+    {
+        const Vector2& position = mFocusPoints[n].mPosition;
+        const F32 dx = getMax( getMax( chunkMin.x - position.x, position.x - chunkMax.x ), 0.0f );
+        const F32 dy = getMax( getMax( chunkMin.y - position.y, position.y - chunkMax.y ), 0.0f );
+        nearestDistanceSqr = getMin( nearestDistanceSqr, dx*dx + dy*dy );
+    }
+
+    return mSqrt( nearestDistanceSqr );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneStreamer::reserveBudget( const U32 residentSize, const F32 requestDistance )
+{
+    // Finish if unlimited.
+    if ( mMemoryBudget <= 0.0f )
+        return true;
+
+    const U32 budget = (U32)(mMemoryBudget * 1024.0f * 1024.0f);
+
+    // Unload the furthest chunks until the request fits.
+    while( mResidentSize + residentSize > budget )
+    {
+        // Find the furthest loaded chunk that is further than the request.
+        Chunk* pFurthestChunk = NULL;
+        F32 furthestDistance = requestDistance;
+        for ( typeChunkHash::iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+        {
+            Chunk* pChunk = itr->value;
+            if ( pChunk->mState != ChunkLoaded )
+                continue;
+
+            const F32 distance = getFocusDistance( pChunk->mChunkX, pChunk->mChunkY );
+            if ( distance > furthestDistance )
+            {
+                pFurthestChunk = pChunk;
+                furthestDistance = distance;
+            }
+        }
+
+        // Finish if nothing can be unloaded.
+        if ( pFurthestChunk == NULL )
+            return false;
+
+        releaseChunk( pFurthestChunk );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::updateStreaming( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneStreamer_UpdateStreaming);
+
+    // Process any completed reads.
+    if ( mpReader != NULL )
+        processReadResults();
+
+    // Finish if no scene, no chunk path or no focus.
+    if ( mpScene.isNull() || mChunkPath == StringTable->EmptyString || !updateFocusPositions() )
+        return;
+
+    // Sanity!
+    if ( mChunkSize.x <= 0.0f || mChunkSize.y <= 0.0f )
+    {
+        Con::warnf( "SceneStreamer::updateStreaming() - Invalid chunk size." );
+        return;
+    }
+
+    // Fetch the distances.
+    // The unload distance is never less than the load distance otherwise chunks would thrash.
+    const F32 loadDistance = getMax( mLoadDistance, 0.0f );
+    const F32 unloadDistance = getMax( mUnloadDistance, loadDistance );
+
+    // Unload chunks beyond the unload distance.
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(SceneStreamer_UpdateStreamingUnload);
+
+        for ( typeChunkHash::iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+        {
+            Chunk* pChunk = itr->value;
+
+            if ( pChunk->mState == ChunkUnloaded )
+                continue;
+
+            if ( getFocusDistance( pChunk->mChunkX, pChunk->mChunkY ) <= unloadDistance )
+                continue;
+
+            // Forget missing chunks so they are retried when next in range.
+            if ( pChunk->mState == ChunkMissing )
+            {
+                pChunk->mState = ChunkUnloaded;
+                continue;
+            }
+
+            releaseChunk( pChunk );
+        }
+
+        // Delete the unloaded chunks including any released to fit the budget last tick.
+        purgeChunks();
+    }
+
+    // Request chunks within the load distance.
+    Vector<ChunkLoadCandidate> loadCandidates;
+    {
+        // Debug Profiling.
+        PROFILE_SCOPE(SceneStreamer_UpdateStreamingRequest);
+
+        for ( S32 n = 0; n < mFocusPoints.size(); ++n )
+        {
+            const Vector2& position = mFocusPoints[n].mPosition;
+
+            // Fetch the chunk range around the focus.
+            S32 minChunkX, minChunkY, maxChunkX, maxChunkY;
+            getChunkCoordinates( position - Vector2( loadDistance, loadDistance ), minChunkX, minChunkY );
+            getChunkCoordinates( position + Vector2( loadDistance, loadDistance ), maxChunkX, maxChunkY );
+
+            for ( S32 chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY )
+            {
+                for ( S32 chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX )
+                {
+                    const F32 distance = getFocusDistance( chunkX, chunkY );
+                    if ( distance > loadDistance )
+                        continue;
+
+                    Chunk* pChunk = createChunk( chunkX, chunkY );
+
+                    // Request the chunk if unloaded.
+                    if ( pChunk->mState == ChunkUnloaded )
+                    {
+                        requestChunk( pChunk );
+                    }
+                    else if ( pChunk->mState == ChunkReading )
+                    {
+                        // Keep any pending read.
+                        pChunk->mUnloadRequested = false;
+                    }
+
+                    // Queue the chunk for instantiation if read.
+                    if ( pChunk->mState == ChunkRead )
+                    {
+                        ChunkLoadCandidate candidate;
+                        candidate.mChunkX = chunkX;
+                        candidate.mChunkY = chunkY;
+                        candidate.mDistance = distance;
+                        loadCandidates.push_back( candidate );
+                    }
+                }
+            }
+        }
+    }
+
+    // Finish if nothing to instantiate.
+    if ( loadCandidates.size() == 0 )
+        return;
+
+    // Instantiate the nearest chunks first within the per-tick budget.
+    dQsort( loadCandidates.address(), loadCandidates.size(), sizeof(ChunkLoadCandidate), chunkLoadCandidateSort );
+
+    U32 loadCount = 0;
+    const U32 maxLoads = (U32)getMax( mMaxLoadsPerTick, 1 );
+    for ( S32 n = 0; n < loadCandidates.size() && loadCount < maxLoads; ++n )
+    {
+        const ChunkLoadCandidate& candidate = loadCandidates[n];
+
+        // Fetch the chunk.
+        // Overlapping focus points may queue the same chunk more than once.
+        Chunk* pChunk = createChunk( candidate.mChunkX, candidate.mChunkY );
+        if ( pChunk->mState != ChunkRead )
+            continue;
+
+        // Estimate the resident size from the previous load if available.
+        const U32 residentEstimate = pChunk->mLoadCount > 0 ? pChunk->mResidentSize : pChunk->mBufferSize;
+
+        // Reserve the memory budget.
+        if ( !reserveBudget( residentEstimate, candidate.mDistance ) )
+        {
+            if ( !pChunk->mBudgetRejected )
+            {
+                pChunk->mBudgetRejected = true;
+                mBudgetRejections++;
+            }
+            continue;
+        }
+
+        instantiateChunk( pChunk );
+        loadCount++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneStreamer::getChunkCount( const ChunkState state ) const
+{
+    U32 chunkCount = 0;
+    for ( typeChunkHash::const_iterator itr = mChunks.begin(); itr != mChunks.end(); ++itr )
+    {
+        if ( itr->value->mState == state )
+            chunkCount++;
+    }
+
+    return chunkCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneStreamer::processTick( void )
+{
+    updateStreaming();
+}
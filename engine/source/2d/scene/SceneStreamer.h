@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_STREAMER_H_
+#define _SCENE_STREAMER_H_
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _TICKABLE_H_
+#include "platform/Tickable.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class SceneStreamerReader;
+
+//-----------------------------------------------------------------------------
+
+/// Streams a large level into a scene as spatial chunks.
+///
+/// The level is divided into a grid of chunks each stored as a separate binary TAML file.
+/// Chunks are loaded around one or more focus points (scene windows, scene objects or fixed positions)
+/// and unloaded once they fall outside of the unload distance which, being larger than the load distance,
+/// provides hysteresis so chunks on a boundary do not thrash.  File reads happen on a background reader
+/// thread whereas object creation happens on the main thread under a per-tick budget using the bulk scene add.
+/// The resident memory of loaded chunks is estimated and kept within a budget by unloading the furthest chunks first.
+class SceneStreamer : public SimObject, public virtual Tickable
+{
+    typedef SimObject Parent;
+
+public:
+    enum ChunkState
+    {
+        ChunkUnloaded,
+        ChunkReading,
+        ChunkRead,
+        ChunkLoaded,
+        ChunkMissing,
+    };
+
+    struct Chunk
+    {
+        Chunk( const S32 chunkX, const S32 chunkY ) :
+            mChunkX( chunkX ),
+            mChunkY( chunkY ),
+            mState( ChunkUnloaded ),
+            mUnloadRequested( false ),
+            mBudgetRejected( false ),
+            mpBuffer( NULL ),
+            mBufferSize( 0 ),
+            mFileSize( 0 ),
+            mResidentSize( 0 ),
+            mReadTime( 0 ),
+            mInstantiateTime( 0 ),
+            mLoadCount( 0 )
+        {
+            VECTOR_SET_ASSOCIATION( mObjects );
+        }
+
+        S32                 mChunkX;
+        S32                 mChunkY;
+        ChunkState          mState;
+        bool                mUnloadRequested;
+        bool                mBudgetRejected;
+        U8*                 mpBuffer;
+        U32                 mBufferSize;
+        U32                 mFileSize;
+        U32                 mResidentSize;
+        U32                 mReadTime;
+        U32                 mInstantiateTime;
+        U32                 mLoadCount;
+        Vector<SimObjectId> mObjects;
+    };
+
+    struct ReadRequest
+    {
+        U32     mChunkKey;
+        char    mFilePath[1024];
+        U8*     mpBuffer;
+        U32     mBufferSize;
+        U32     mReadTime;
+        bool    mSuccess;
+    };
+
+    struct FocusPoint
+    {
+        FocusPoint() : mPosition( 0.0f, 0.0f ) {}
+
+        SimObjectPtr<SimObject> mpObject;
+        Vector2                 mPosition;
+    };
+
+private:
+    typedef HashMap<U32, Chunk*> typeChunkHash;
+
+    SimObjectPtr<Scene>     mpScene;
+    Vector2                 mChunkSize;
+    StringTableEntry        mChunkPath;
+    F32                     mLoadDistance;
+    F32                     mUnloadDistance;
+    F32                     mMemoryBudget;
+    S32                     mObjectMemoryEstimate;
+    S32                     mMaxLoadsPerTick;
+
+    typeChunkHash           mChunks;
+    Vector<FocusPoint>      mFocusPoints;
+
+    SceneStreamerReader*    mpReader;
+
+    U32                     mResidentSize;
+    U32                     mTotalLoads;
+    U32                     mTotalUnloads;
+    U32                     mTotalLoadTime;
+    U32                     mMaxLoadTime;
+    U32                     mBudgetRejections;
+
+public:
+    SceneStreamer();
+    virtual ~SceneStreamer();
+
+    static void initPersistFields();
+
+    /// Engine.
+    virtual bool onAdd();
+    virtual void onRemove();
+
+    /// Scene.
+    void setScene( Scene* pScene );
+    inline Scene* getScene( void ) const { return mpScene; }
+
+    /// Focus points.
+    U32 addFocusObject( SimObject* pObject );
+    U32 addFocusPoint( const Vector2& position );
+    void setFocusPoint( const U32 index, const Vector2& position );
+    void removeFocus( const U32 index );
+    void clearFocus( void );
+    inline U32 getFocusCount( void ) const { return mFocusPoints.size(); }
+
+    /// Chunks.
+    inline static U32 getChunkKey( const S32 chunkX, const S32 chunkY ) { return ((U32)(chunkX & 0xFFFF) << 16) | (U32)(chunkY & 0xFFFF); }
+    void getChunkCoordinates( const Vector2& position, S32& chunkX, S32& chunkY ) const;
+    RectF getChunkArea( const S32 chunkX, const S32 chunkY ) const;
+    void getChunkFilePath( const S32 chunkX, const S32 chunkY, char* pBuffer, const U32 bufferSize ) const;
+    const Chunk* findChunk( const S32 chunkX, const S32 chunkY ) const;
+    bool loadChunk( const S32 chunkX, const S32 chunkY );
+    bool unloadChunk( const S32 chunkX, const S32 chunkY );
+    void unloadAllChunks( void );
+    U32 writeChunks( Scene* pScene );
+    void updateStreaming( void );
+
+    /// Metrics.
+    inline U32 getResidentSize( void ) const { return mResidentSize; }
+    inline U32 getTotalLoads( void ) const { return mTotalLoads; }
+    inline U32 getTotalUnloads( void ) const { return mTotalUnloads; }
+    inline U32 getMaxLoadTime( void ) const { return mMaxLoadTime; }
+    inline F32 getAverageLoadTime( void ) const { return mTotalLoads > 0 ? (F32)mTotalLoadTime / (F32)mTotalLoads : 0.0f; }
+    inline U32 getBudgetRejections( void ) const { return mBudgetRejections; }
+    U32 getChunkCount( const ChunkState state ) const;
+    static const char* getChunkStateDescription( const ChunkState state );
+
+    /// Declare Console Object.
+    DECLARE_CONOBJECT( SceneStreamer );
+
+protected:
+    /// Tickable.
+    virtual void interpolateTick( F32 delta ) {}
+    virtual void processTick();
+    virtual void advanceTime( F32 timeDelta ) {}
+
+private:
+    Chunk* createChunk( const S32 chunkX, const S32 chunkY );
+    void purgeChunks( void );
+    void deleteChunks( void );
+    bool requestChunk( Chunk* pChunk );
+    bool instantiateChunk( Chunk* pChunk );
+    void releaseChunk( Chunk* pChunk );
+    void processReadResults( void );
+    bool updateFocusPositions( void );
+    F32 getFocusDistance( const S32 chunkX, const S32 chunkY ) const;
+    bool reserveBudget( const U32 residentSize, const F32 requestDistance );
+
+    static bool writeChunkSize( void* obj, StringTableEntry pFieldName ) { return static_cast<SceneStreamer*>(obj)->mChunkSize.notEqual( Vector2( 64.0f, 64.0f ) ); }
+    static bool writeLoadDistance( void* obj, StringTableEntry pFieldName ) { return mNotEqual( static_cast<SceneStreamer*>(obj)->mLoadDistance, 128.0f ); }
+    static bool writeUnloadDistance( void* obj, StringTableEntry pFieldName ) { return mNotEqual( static_cast<SceneStreamer*>(obj)->mUnloadDistance, 192.0f ); }
+    static bool writeMemoryBudget( void* obj, StringTableEntry pFieldName ) { return mNotZero( static_cast<SceneStreamer*>(obj)->mMemoryBudget ); }
+    static bool writeObjectMemoryEstimate( void* obj, StringTableEntry pFieldName ) { return static_cast<SceneStreamer*>(obj)->mObjectMemoryEstimate != 1024; }
+    static bool writeMaxLoadsPerTick( void* obj, StringTableEntry pFieldName ) { return static_cast<SceneStreamer*>(obj)->mMaxLoadsPerTick != 1; }
+};
+
+#endif // _SCENE_STREAMER_H_
@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+ConsoleMethodGroupBeginWithDocs(SceneStreamer, SimObject)
+
+/*! Sets the scene that chunks are streamed into.
+    @param scene The scene to stream into.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, setScene, ConsoleVoid, 3, 3, (scene))
+{
+    // Find the scene.
+    Scene* pScene = Sim::findObject<Scene>( argv[2] );
+
+    // Did we find the scene?
+    if ( pScene == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::setScene() - Could not find the specified scene '%s'.", argv[2] );
+        return;
+    }
+
+    object->setScene( pScene );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the scene that chunks are streamed into.
+    @return The scene or nothing if no scene is set.
+*/
+ConsoleMethodWithDocs(SceneStreamer, getScene, ConsoleString, 2, 2, ())
+{
+    Scene* pScene = object->getScene();
+
+    return pScene == NULL ? StringTable->EmptyString : pScene->getIdString();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Adds a focus object that chunks are streamed around.
+    @param object A SceneWindow (its camera position is used) or a SceneObject (its position is used).
+    @return The focus index.
+*/
+ConsoleMethodWithDocs(SceneStreamer, addFocusObject, ConsoleInt, 3, 3, (object))
+{
+    // Find the object.
+    SimObject* pObject = Sim::findObject( argv[2] );
+
+    // Did we find the object?
+    if ( pObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::addFocusObject() - Could not find the specified object '%s'.", argv[2] );
+        return -1;
+    }
+
+    return object->addFocusObject( pObject );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Adds a fixed focus position that chunks are streamed around.
+    @param x/y The focus position.
+    @return The focus index.
+*/
+ConsoleMethodWithDocs(SceneStreamer, addFocusPoint, ConsoleInt, 3, 4, (float x, float y))
+{
+    Vector2 position;
+
+    // Elements in the first argument.
+    U32 elementCount = Utility::mGetStringElementCount(argv[2]);
+
+    // ("x y")
+    if ( (elementCount == 2) && (argc == 3) )
+    {
+        position = Utility::mGetStringElementVector(argv[2]);
+    }
+    // (x, y)
+    else if ( (elementCount == 1) && (argc == 4) )
+    {
+        position.Set( dAtof(argv[2]), dAtof(argv[3]) );
+    }
+    // Invalid
+    else
+    {
+        Con::warnf("SceneStreamer::addFocusPoint() - Invalid number of parameters!");
+        return -1;
+    }
+
+    return object->addFocusPoint( position );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Sets a focus to a fixed position.
+    @param index The focus index.
+    @param x/y The focus position.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, setFocusPoint, ConsoleVoid, 4, 5, (int index, float x, float y))
+{
+    Vector2 position;
+
+    // Elements in the first argument.
+    U32 elementCount = Utility::mGetStringElementCount(argv[3]);
+
+    // ("x y")
+    if ( (elementCount == 2) && (argc == 4) )
+    {
+        position = Utility::mGetStringElementVector(argv[3]);
+    }
+    // (x, y)
+    else if ( (elementCount == 1) && (argc == 5) )
+    {
+        position.Set( dAtof(argv[3]), dAtof(argv[4]) );
+    }
+    // Invalid
+    else
+    {
+        Con::warnf("SceneStreamer::setFocusPoint() - Invalid number of parameters!");
+        return;
+    }
+
+    object->setFocusPoint( dAtoi(argv[2]), position );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Removes a focus.
+    @param index The focus index.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, removeFocus, ConsoleVoid, 3, 3, (int index))
+{
+    object->removeFocus( dAtoi(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Removes all focus points.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, clearFocus, ConsoleVoid, 2, 2, ())
+{
+    object->clearFocus();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the number of focus points.
+    @return The number of focus points.
+*/
+ConsoleMethodWithDocs(SceneStreamer, getFocusCount, ConsoleInt, 2, 2, ())
+{
+    return object->getFocusCount();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the chunk coordinates containing the specified world position.
+    @param x/y The world position.
+    @return The chunk coordinates "x y".
+*/
+ConsoleMethodWithDocs(SceneStreamer, getChunkAt, ConsoleString, 3, 4, (float x, float y))
+{
+    Vector2 position;
+
+    // Elements in the first argument.
+    U32 elementCount = Utility::mGetStringElementCount(argv[2]);
+
+    // ("x y")
+    if ( (elementCount == 2) && (argc == 3) )
+    {
+        position = Utility::mGetStringElementVector(argv[2]);
+    }
+    // (x, y)
+    else if ( (elementCount == 1) && (argc == 4) )
+    {
+        position.Set( dAtof(argv[2]), dAtof(argv[3]) );
+    }
+    // Invalid
+    else
+    {
+        Con::warnf("SceneStreamer::getChunkAt() - Invalid number of parameters!");
+        return StringTable->EmptyString;
+    }
+
+    S32 chunkX, chunkY;
+    object->getChunkCoordinates( position, chunkX, chunkY );
+
+    char* pBuffer = Con::getReturnBuffer( 32 );
+    dSprintf( pBuffer, 32, "%d %d", chunkX, chunkY );
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Loads the specified chunk immediately, bypassing the background reader.
+    @param chunkX/chunkY The chunk coordinates.
+    @return Whether the chunk was loaded or not.
+*/
+ConsoleMethodWithDocs(SceneStreamer, loadChunk, ConsoleBool, 4, 4, (int chunkX, int chunkY))
+{
+    return object->loadChunk( dAtoi(argv[2]), dAtoi(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Unloads the specified chunk, deleting its objects.
+    @param chunkX/chunkY The chunk coordinates.
+    @return Whether the chunk was unloaded or not.
+*/
+ConsoleMethodWithDocs(SceneStreamer, unloadChunk, ConsoleBool, 4, 4, (int chunkX, int chunkY))
+{
+    return object->unloadChunk( dAtoi(argv[2]), dAtoi(argv[3]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Unloads all chunks, deleting their objects.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, unloadAllChunks, ConsoleVoid, 2, 2, ())
+{
+    object->unloadAllChunks();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Partitions the objects in the specified scene into chunks and writes each chunk as a binary TAML file using the chunk path.
+    @param scene The scene to write.
+    @return The number of chunk files written.
+*/
+ConsoleMethodWithDocs(SceneStreamer, writeChunks, ConsoleInt, 3, 3, (scene))
+{
+    // Find the scene.
+    Scene* pScene = Sim::findObject<Scene>( argv[2] );
+
+    // Did we find the scene?
+    if ( pScene == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "SceneStreamer::writeChunks() - Could not find the specified scene '%s'.", argv[2] );
+        return 0;
+    }
+
+    return object->writeChunks( pScene );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Performs a streaming update immediately rather than waiting for the next tick.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SceneStreamer, update, ConsoleVoid, 2, 2, ())
+{
+    object->updateStreaming();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the metrics for the specified chunk.
+    @param chunkX/chunkY The chunk coordinates.
+    @return "state objectCount residentBytes readMs instantiateMs loadCount" where state is one of unloaded, reading, read, loaded or missing.
+*/
+ConsoleMethodWithDocs(SceneStreamer, getChunkStats, ConsoleString, 4, 4, (int chunkX, int chunkY))
+{
+    const SceneStreamer::Chunk* pChunk = object->findChunk( dAtoi(argv[2]), dAtoi(argv[3]) );
+
+    if ( pChunk == NULL )
+        return "unloaded 0 0 0 0 0";
+
+    char* pBuffer = Con::getReturnBuffer( 128 );
+    dSprintf( pBuffer, 128, "%s %d %d %d %d %d",
+        SceneStreamer::getChunkStateDescription( pChunk->mState ),
+        pChunk->mObjects.size(),
+        pChunk->mState == SceneStreamer::ChunkLoaded ? pChunk->mResidentSize : 0,
+        pChunk->mReadTime,
+        pChunk->mInstantiateTime,
+        pChunk->mLoadCount );
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the overall streaming metrics.
+    @return "loadedChunks readingChunks residentBytes totalLoads totalUnloads averageLoadMs maxLoadMs budgetRejections".
+*/
+ConsoleMethodWithDocs(SceneStreamer, getStreamingStats, ConsoleString, 2, 2, ())
+{
+    char* pBuffer = Con::getReturnBuffer( 256 );
+    dSprintf( pBuffer, 256, "%d %d %d %d %d %g %d %d",
+        object->getChunkCount( SceneStreamer::ChunkLoaded ),
+        object->getChunkCount( SceneStreamer::ChunkReading ),
+        object->getResidentSize(),
+        object->getTotalLoads(),
+        object->getTotalUnloads(),
+        object->getAverageLoadTime(),
+        object->getMaxLoadTime(),
+        object->getBudgetRejections() );
+    return pBuffer;
+}
+
+ConsoleMethodGroupEndWithDocs(SceneStreamer)
@@ -163,6 +163,78 @@ ConsoleMethodWithDocs(Scene, remove, ConsoleVoid, 3, 3, (sceneObject))
 
 //-----------------------------------------------------------------------------
 
+/*! Add many SceneObjects to the scene in a single bulk operation.
+    Physics bodies are created in one pass, the world query proxies are built as a single balanced tree and the 'onAddToScene' callbacks are performed as a batch at the end.
+    @param sceneObjects A space-separated list of the SceneObjects to add to the scene.
+    @return The number of objects added to the scene.
+*/
+ConsoleMethodWithDocs(Scene, addObjects, ConsoleInt, 3, 3, (sceneObjects))
+{
+    // Fetch the object count.
+    const U32 objectCount = StringUnit::getUnitCount( argv[2], " \t\n" );
+
+    // Find the specified objects.
+    typeSceneObjectVector sceneObjects;
+    sceneObjects.reserve( objectCount );
+    for ( U32 n = 0; n < objectCount; ++n )
+    {
+        // Find the specified object.
+        const char* pObjectName = StringUnit::getUnit( argv[2], n, " \t\n" );
+        SceneObject* pSceneObject = Sim::findObject<SceneObject>( pObjectName );
+
+        // Did we find the object?
+        if ( !pSceneObject )
+        {
+            // No, so warn.
+            Con::warnf("Scene::addObjects() - Could not find the specified object '%s'.", pObjectName);
+            continue;
+        }
+
+        sceneObjects.push_back( pSceneObject );
+    }
+
+    // Add to Scene.
+    return object->addToScene( sceneObjects );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Remove many SceneObjects from the scene in a single bulk operation.
+    The 'onRemoveFromScene' callbacks are performed as a batch at the end.
+    @param sceneObjects A space-separated list of the SceneObjects to remove from the scene.
+    @return The number of objects removed from the scene.
+*/
+ConsoleMethodWithDocs(Scene, removeObjects, ConsoleInt, 3, 3, (sceneObjects))
+{
+    // Fetch the object count.
+    const U32 objectCount = StringUnit::getUnitCount( argv[2], " \t\n" );
+
+    // Find the specified objects.
+    typeSceneObjectVector sceneObjects;
+    sceneObjects.reserve( objectCount );
+    for ( U32 n = 0; n < objectCount; ++n )
+    {
+        // Find the specified object.
+        const char* pObjectName = StringUnit::getUnit( argv[2], n, " \t\n" );
+        SceneObject* pSceneObject = Sim::findObject<SceneObject>( pObjectName );
+
+        // Did we find the object?
+        if ( !pSceneObject )
+        {
+            // No, so warn.
+            Con::warnf("Scene::removeObjects() - Could not find the specified object '%s'.", pObjectName);
+            continue;
+        }
+
+        sceneObjects.push_back( pSceneObject );
+    }
+
+    // Remove from Scene.
+    return object->removeFromScene( sceneObjects );
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Clear the scene of all scene objects.
     @param deleteObjects A boolean flag that sets whether to delete the objects as well as remove them from the scene (default is true).
     @return No return value.
@@ -368,6 +440,133 @@ ConsoleMethodWithDocs(Scene, mergeScene, ConsoleVoid, 3, 3, (scene))
 
 //-----------------------------------------------------------------------------
 
+/*! Acquires an object from the pool for the specified template, creating the pool if required.
+    An idle pooled object is reused if available (having its state reset from the template) otherwise a new object is cloned from the template.
+    Pooled objects are returned to the pool when they are safe-deleted (including when their lifetime expires) or explicitly released.
+    @param templateObject The SceneObject used as the pool template.
+    @return The acquired object Id or zero on failure.
+*/
+ConsoleMethodWithDocs(Scene, acquireObject, ConsoleInt, 3, 3, (templateObject))
+{
+    // Find the template object.
+    SceneObject* pTemplate = Sim::findObject<SceneObject>( argv[2] );
+
+    // Did we find the template?
+    if ( pTemplate == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::acquireObject() - Could not find the specified template object '%s'.", argv[2] );
+        return 0;
+    }
+
+    // Acquire the object.
+    SceneObject* pSceneObject = object->acquireObject( pTemplate );
+
+    return pSceneObject == NULL ? 0 : pSceneObject->getId();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Releases a pooled object back to its pool.  The object is disabled rather than deleted.
+    @param sceneObject The pooled SceneObject to release.
+    @return Whether the object was released or not.
+*/
+ConsoleMethodWithDocs(Scene, releaseObject, ConsoleBool, 3, 3, (sceneObject))
+{
+    // Find the scene object.
+    SceneObject* pSceneObject = Sim::findObject<SceneObject>( argv[2] );
+
+    // Did we find the object?
+    if ( pSceneObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::releaseObject() - Could not find the specified object '%s'.", argv[2] );
+        return false;
+    }
+
+    return object->releaseObject( pSceneObject );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Creates idle objects in the pool for the specified template so that later acquisitions do not need to create objects.
+    @param templateObject The SceneObject used as the pool template.
+    @param count The number of objects to create.
+    @return The number of objects created.
+*/
+ConsoleMethodWithDocs(Scene, preallocateObjects, ConsoleInt, 4, 4, (templateObject, count))
+{
+    // Find the template object.
+    SceneObject* pTemplate = Sim::findObject<SceneObject>( argv[2] );
+
+    // Did we find the template?
+    if ( pTemplate == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::preallocateObjects() - Could not find the specified template object '%s'.", argv[2] );
+        return 0;
+    }
+
+    // Fetch the count.
+    const S32 count = dAtoi( argv[3] );
+
+    // Finish if nothing to do.
+    if ( count <= 0 )
+        return 0;
+
+    return object->preallocateObjects( pTemplate, (U32)count );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the statistics for the pool of the specified template.
+    @param templateObject The SceneObject used as the pool template.
+    @return The statistics formatted as "createdCount acquiredCount reusedCount releasedCount idleCount" or an empty string if there is no pool.
+*/
+ConsoleMethodWithDocs(Scene, getObjectPoolStats, ConsoleString, 3, 3, (templateObject))
+{
+    // Find the template object.
+    SceneObject* pTemplate = Sim::findObject<SceneObject>( argv[2] );
+
+    // Did we find the template?
+    if ( pTemplate == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::getObjectPoolStats() - Could not find the specified template object '%s'.", argv[2] );
+        return StringTable->EmptyString;
+    }
+
+    // Find the pool.
+    SceneObjectPool* pObjectPool = object->findObjectPool( pTemplate );
+
+    // Finish if no pool.
+    if ( pObjectPool == NULL )
+        return StringTable->EmptyString;
+
+    // Format the statistics.
+    char* pBuffer = Con::getReturnBuffer( 64 );
+    dSprintf( pBuffer, 64, "%d %d %d %d %d",
+        pObjectPool->getCreatedCount(),
+        pObjectPool->getAcquiredCount(),
+        pObjectPool->getReusedCount(),
+        pObjectPool->getReleasedCount(),
+        pObjectPool->getIdleCount() );
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Deletes all the object pools along with their idle objects.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(Scene, clearObjectPools, ConsoleVoid, 2, 2, ())
+{
+    object->clearObjectPools();
+}
+
+//-----------------------------------------------------------------------------
+
 /*! Gets the Scene Controllers.
     @return Gets the scene controllers.
 */
@@ -30,6 +30,10 @@
 #include "2d/sceneobject/SceneObject.h"
 #endif
 
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
 // Debug Profiling.
 #include "debug/profiler.h"
 
@@ -42,7 +46,8 @@ WorldQuery::WorldQuery( Scene* pScene ) :
         mCheckPoint(false),
         mCheckAABB(false),
         mCheckOOBB(false),
-        mCheckCircle(false)
+        mCheckCircle(false),
+        mBulkAdding(false)
 {
     // Set debug associations.
     for ( U32 n = 0; n < MAX_LAYERS_SUPPORTED; n++ )
@@ -50,6 +55,7 @@ WorldQuery::WorldQuery( Scene* pScene ) :
         VECTOR_SET_ASSOCIATION( mLayeredQueryResults[n] );
     }
     VECTOR_SET_ASSOCIATION( mQueryResults );
+    VECTOR_SET_ASSOCIATION( mBulkAddSet );
 
     // Clear the query.
     clearQuery();
@@ -62,6 +68,13 @@ S32 WorldQuery::add( SceneObject* pSceneObject )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Add);
 
+    // Defer the proxy if bulk adding.
+    if ( mBulkAdding )
+    {
+        mBulkAddSet.push_back( pSceneObject );
+        return -1;
+    }
+
     return CreateProxy( pSceneObject->getAABB(), static_cast<PhysicsProxy*>(pSceneObject) );
 }
 
@@ -72,6 +85,10 @@ void WorldQuery::remove( SceneObject* pSceneObject )
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Remove);
 
+    // Ignore if the proxy is still deferred by a bulk add.
+    if ( pSceneObject->getWorldProxy() < 0 )
+        return;
+
     DestroyProxy( pSceneObject->getWorldProxy() );
 }
 
@@ -82,11 +99,87 @@ bool WorldQuery::update( SceneObject* pSceneObject, const b2AABB& aabb, const b2
     // Debug Profiling.
     PROFILE_SCOPE(WorldQuery_Update);
 
+    // Ignore if the proxy is still deferred by a bulk add.
+    // The deferred proxy is built from the current AABB when the bulk add ends.
+    if ( pSceneObject->getWorldProxy() < 0 )
+        return false;
+
     return MoveProxy( pSceneObject->getWorldProxy(), aabb, displacement );
 }
 
 //-----------------------------------------------------------------------------
 
+void WorldQuery::beginBulkAdd( void )
+{
+    // Sanity!
+    AssertFatal( !mBulkAdding, "WorldQuery::beginBulkAdd() - Bulk add is already in progress." );
+
+    mBulkAdding = true;
+    mBulkAddSet.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 WorldQuery::endBulkAdd( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(WorldQuery_EndBulkAdd);
+
+    // Sanity!
+    AssertFatal( mBulkAdding, "WorldQuery::endBulkAdd() - Bulk add is not in progress." );
+
+    mBulkAdding = false;
+
+    // Finish if nothing was deferred.
+    if ( mBulkAddSet.size() == 0 )
+        return 0;
+
+    // Gather the proxies that are still required.
+    // Objects may have been removed from the scene whilst their proxy was deferred.
+    const U32 deferredCount = mBulkAddSet.size();
+    FrameTemp<b2AABB> aabbs( deferredCount );
+    FrameTemp<void*> userData( deferredCount );
+    FrameTemp<S32> proxyIds( deferredCount );
+    U32 proxyCount = 0;
+    for ( U32 n = 0; n < deferredCount; ++n )
+    {
+        SceneObject* pSceneObject = mBulkAddSet[n];
+
+        // Skip if no longer in this scene, already has a proxy or was deferred more than once.
+        if ( pSceneObject->getScene() != mpScene || pSceneObject->mWorldProxyId != -1 )
+        {
+            mBulkAddSet[n] = NULL;
+            continue;
+        }
+
+        // Flag the proxy as pending so any repeat deferral is skipped.
+        pSceneObject->mWorldProxyId = -2;
+
+        aabbs[proxyCount] = pSceneObject->getAABB();
+        userData[proxyCount] = static_cast<PhysicsProxy*>(pSceneObject);
+        proxyCount++;
+    }
+
+    // Build the proxies as a single balanced sub-tree.
+    CreateProxies( ~aabbs, ~userData, proxyCount, ~proxyIds );
+
+    // Assign the proxies.
+    U32 proxyIndex = 0;
+    for ( U32 n = 0; n < deferredCount; ++n )
+    {
+        SceneObject* pSceneObject = mBulkAddSet[n];
+
+        if ( pSceneObject != NULL )
+            pSceneObject->mWorldProxyId = proxyIds[proxyIndex++];
+    }
+
+    mBulkAddSet.clear();
+
+    return proxyCount;
+}
+
+//-----------------------------------------------------------------------------
+
 void WorldQuery::addAlwaysInScope( SceneObject* pSceneObject )
 {
     // Debug Profiling.
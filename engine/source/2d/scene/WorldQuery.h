@@ -52,6 +52,11 @@ public:
     void            remove( SceneObject* pSceneObject );
     bool            update( SceneObject* pSceneObject, const b2AABB& aabb, const b2Vec2& displacement );
 
+    /// Bulk scope.
+    void            beginBulkAdd( void );
+    U32             endBulkAdd( void );
+    inline bool     getIsBulkAdding( void ) const { return mBulkAdding; }
+
     /// Always in scope.
     void            addAlwaysInScope( SceneObject* pSceneObject );
     void            removeAlwaysInScope( SceneObject* pSceneObject );
@@ -118,6 +123,8 @@ private:
     bool                        mIsRaycastQueryResult;
     typeSceneObjectVector       mAlwaysInScopeSet;
     U32                         mMasterQueryKey;
+    bool                        mBulkAdding;
+    typeSceneObjectVector       mBulkAddSet;
 };
 
 #endif // _WORLD_QUERY_H_
\ No newline at end of file
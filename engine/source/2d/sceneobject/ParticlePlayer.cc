@@ -183,6 +183,18 @@ void ParticlePlayer::safeDelete( void )
 
 //-----------------------------------------------------------------------------
 
+void ParticlePlayer::resetState( const SceneObject* pTemplate )
+{
+    // Call parent.
+    Parent::resetState( pTemplate );
+
+    // Restart the particles if appropriate.
+    if ( getScene() != NULL && mParticleAsset.notNull() && mParticleAsset->getEmitterCount() > 0 )
+        play( true );
+}
+
+//-----------------------------------------------------------------------------
+
 void ParticlePlayer::OnRegisterScene( Scene* pScene )
 {
     // Call parent.
@@ -138,6 +138,7 @@ public:
     static void initPersistFields();
     virtual void copyTo(SimObject* object);
     virtual void safeDelete( void );
+    virtual void resetState( const SceneObject* pTemplate );
 
     virtual void preIntegrate( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
     void integrateObject( const F32 totalTime, const F32 elapsedTime, DebugStats* pDebugStats );
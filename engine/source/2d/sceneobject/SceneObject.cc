@@ -100,6 +100,7 @@ static StringTableEntry edgeTypeName            = StringTable->insert( "Edge" );
 SceneObject::SceneObject() :
     /// Scene.
     mpScene(NULL),
+    mSceneSlot(0),
     mpTargetScene(NULL),
 
     /// Lifetime.
@@ -187,6 +188,10 @@ SceneObject::SceneObject() :
     mBeingSafeDeleted(false),
     mSafeDeleteReady(true),
 
+    /// Object pooling.
+    mPoolTemplateId(0),
+    mPoolIdle(false),
+
     /// Miscellaneous.
     mBatchIsolated(false),
     mSerialiseKey(0),
@@ -407,11 +412,23 @@ void SceneObject::OnRegisterScene( Scene* pScene )
     // Set scene.
     mpScene = pScene;
 
-    // Create the physics body.
-    mpBody = pScene->getWorld()->CreateBody( &mBodyDefinition );
+    // Are we being added as part of a bulk add?
+    if ( pScene->getWorldQuery()->getIsBulkAdding() )
+    {
+        // Yes, so create the body inactive.  The scene activates all the bulk-added bodies
+        // together when the bulk add ends so their broad-phase proxies are built in one pass.
+        b2BodyDef bodyDefinition = mBodyDefinition;
+        bodyDefinition.active = false;
+        mpBody = pScene->getWorld()->CreateBody( &bodyDefinition );
+    }
+    else
+    {
+        // No, so create the physics body.
+        mpBody = pScene->getWorld()->CreateBody( &mBodyDefinition );
 
-    // Set active status.
-    if ( !isEnabled() ) mpBody->SetActive( false );
+        // Set active status.
+        if ( !isEnabled() ) mpBody->SetActive( false );
+    }
 
     // Create fixtures.
     for( typeCollisionFixtureDefVector::iterator itr = mCollisionFixtureDefs.begin(); itr != mCollisionFixtureDefs.end(); itr++ )
@@ -1930,6 +1947,35 @@ b2FixtureDef SceneObject::getCollisionShapeDefinition( const U32 shapeIndex ) co
 
 //-----------------------------------------------------------------------------
 
+S32 SceneObject::createCollisionShape( const b2FixtureDef& fixtureDef )
+{
+    // Sanity!
+    AssertFatal( fixtureDef.shape != NULL, "SceneObject::createCollisionShape() - Cannot create a collision shape with no shape." );
+
+    // Create the appropriate shape type.
+    switch( fixtureDef.shape->GetType() )
+    {
+        case b2Shape::e_circle:
+            return copyCircleCollisionShapeTo( this, fixtureDef );
+
+        case b2Shape::e_polygon:
+            return copyPolygonCollisionShapeTo( this, fixtureDef );
+
+        case b2Shape::e_chain:
+            return copyChainCollisionShapeTo( this, fixtureDef );
+
+        case b2Shape::e_edge:
+            return copyEdgeCollisionShapeTo( this, fixtureDef );
+
+        default:
+            AssertFatal( false, "SceneObject::createCollisionShape() - Unsupported collision shape type encountered." );
+    }
+
+    return INVALID_COLLISION_SHAPE_INDEX;
+}
+
+//-----------------------------------------------------------------------------
+
 const b2CircleShape* SceneObject::getCollisionCircleShape( const U32 shapeIndex ) const
 {
     // Sanity!
@@ -3132,53 +3178,12 @@ S32 SceneObject::copyCollisionShapes( SceneObject* pSceneObject, const bool clea
             fixtureDef = *pFixtureDef;
         }
 
-        S32 newShapeIndex;
-
-        // Fetch shape type.
-        const b2Shape::Type shapeType = fixtureDef.shape->GetType();
-
-        // Copy appropriate shape type.
-        switch( shapeType )
-        {
-            case b2Shape::e_circle:
-                newShapeIndex = copyCircleCollisionShapeTo( pSceneObject, fixtureDef );
-
-                // Return the new shape if we're copying a specific index.
-                if ( shapeIndex >= 0 )
-                    return newShapeIndex;
-
-                continue;
-
-            case b2Shape::e_polygon:
-                newShapeIndex = copyPolygonCollisionShapeTo( pSceneObject, fixtureDef );
-
-                // Return the new shape if we're copying a specific index.
-                if ( shapeIndex >= 0 )
-                    return newShapeIndex;
-
-                continue;
-
-            case b2Shape::e_chain:
-                newShapeIndex = copyChainCollisionShapeTo( pSceneObject, fixtureDef );
-
-                // Return the new shape if we're copying a specific index.
-                if ( shapeIndex >= 0 )
-                    return newShapeIndex;
-
-                continue;
-
-            case b2Shape::e_edge:
-                newShapeIndex = copyEdgeCollisionShapeTo( pSceneObject, fixtureDef );
-
-                // Return the new shape if we're copying a specific index.
-                if ( shapeIndex >= 0 )
-                    return newShapeIndex;
-
-                continue;
+        // Copy the shape.
+        const S32 newShapeIndex = pSceneObject->createCollisionShape( fixtureDef );
 
-            default:
-                AssertFatal( false, "SceneObject::copyCollisionShapes() - Unsupported collision shape type encountered." );
-        }
+        // Return the new shape if we're copying a specific index.
+        if ( shapeIndex >= 0 )
+            return newShapeIndex;
     }
 
     // Return the first index if we're copying all the shapes.
@@ -3339,6 +3344,10 @@ void SceneObject::safeDelete( void )
     // Are we in a scene?
     if ( getScene() )
     {
+        // Yes, so release to the scene object pool if we came from one.
+        if ( isPooled() && getScene()->releaseObject( this ) )
+            return;
+
         // Yes, so add a delete-request to the scene.
         getScene()->addDeleteRequest( this );
     }
@@ -3351,6 +3360,49 @@ void SceneObject::safeDelete( void )
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::resetState( const SceneObject* pTemplate )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObject_ResetState);
+
+    // Cancel any active targets.
+    cancelMoveTo( false );
+    cancelRotateTo( false );
+    cancelFadeTo();
+    cancelGrowTo();
+
+    // Finish if no template to reset from.
+    if ( pTemplate == NULL )
+    {
+        setLifetime( 0.0f );
+        setLinearVelocity( Vector2::getZero() );
+        setAngularVelocity( 0.0f );
+        return;
+    }
+
+    /// Lifetime.
+    setLifetime( pTemplate->getLifetime() );
+
+    /// Position / Angle.
+    setPosition( pTemplate->getPosition() );
+    setAngle( pTemplate->getAngle() );
+
+    /// Body.
+    setAwake( pTemplate->getAwake() );
+
+    /// Velocities.
+    setLinearVelocity( pTemplate->getLinearVelocity() );
+    setAngularVelocity( pTemplate->getAngularVelocity() );
+
+    /// Render visibility.
+    setVisible( pTemplate->getVisible() );
+
+    /// Render blending.
+    setBlendColor( pTemplate->getBlendColor() );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::addDestroyNotification( SceneObject* pSceneObject )
 {
     // Search list to see if we're already in it (finish if we are).
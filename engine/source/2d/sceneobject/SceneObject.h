@@ -119,10 +119,12 @@ public:
     friend class WorldQuery;
     friend class DebugDraw;
     friend class SceneObjectRotateToEvent;
+    friend class SceneObjectPool;
 
 protected:
     /// Scene.
     SimObjectPtr<Scene>  mpScene;
+    U32                  mSceneSlot;        ///< Index of the object in its scene's object list.
 
     /// Target Scene.
     /// NOTE:   Unfortunately this is required as the scene can be set via a field which
@@ -239,6 +241,10 @@ protected:
     /// Destroy notifications.
     typeDestroyNotificationVector mDestroyNotifyList;
 
+    /// Object pooling.
+    SimObjectId             mPoolTemplateId;
+    bool                    mPoolIdle;
+
     /// Miscellaneous.
     bool                    mBatchIsolated;
     U32                     mSerialiseKey;
@@ -462,6 +468,7 @@ public:
     S32                     getCollisionShapeIndex( const b2Fixture* pFixture ) const;
     void                    setCollisionShapeDefinition( const U32 shapeIndex, const b2FixtureDef& fixtureDef );
     b2FixtureDef            getCollisionShapeDefinition( const U32 shapeIndex ) const;
+    S32                     createCollisionShape( const b2FixtureDef& fixtureDef );
     const b2CircleShape*    getCollisionCircleShape( const U32 shapeIndex ) const;
     const b2PolygonShape*   getCollisionPolygonShape( const U32 shapeIndex ) const;
     const b2ChainShape*     getCollisionChainShape( const U32 shapeIndex ) const;
@@ -592,6 +599,12 @@ public:
     inline bool             isBeingDeleted( void ) const                { return mBeingSafeDeleted; }
     virtual void            safeDelete( void );
 
+    /// Object pooling.
+    virtual void            resetState( const SceneObject* pTemplate );
+    inline SimObjectId      getPoolTemplateId( void ) const             { return mPoolTemplateId; }
+    inline bool             isPooled( void ) const                      { return mPoolTemplateId != 0; }
+    inline bool             isPoolIdle( void ) const                    { return mPoolIdle; }
+
     /// Destroy notifications.
     void                    addDestroyNotification( SceneObject* pSceneObject );
     void                    removeDestroyNotification( SceneObject* pSceneObject );
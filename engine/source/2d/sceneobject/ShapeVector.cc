@@ -23,6 +23,8 @@
 #include "graphics/dgl.h"
 #include "console/consoleTypes.h"
 #include "2d/core/Utility.h"
+#include "graphics/gBitmap.h"
+#include "memory/frameAllocator.h"
 #include "ShapeVector.h"
 
 // Script bindings.
@@ -34,6 +36,138 @@ IMPLEMENT_CONOBJECT(ShapeVector);
 
 //----------------------------------------------------------------------------
 
+static const U32 ShapeVectorCircleSegments = 32;
+
+//----------------------------------------------------------------------------
+
+static TextureHandle& getWhiteTexture( void )
+{
+    static TextureHandle whiteTexture;
+    return whiteTexture;
+}
+
+//----------------------------------------------------------------------------
+
+static void createWhiteTexture( void )
+{
+    TextureHandle& whiteTexture = getWhiteTexture();
+
+    // Create the white texel if we've not already done so.
+    // NOTE:-   This creates a GL texture so must only be called on the main thread.
+    if ( whiteTexture.IsNull() )
+    {
+        GBitmap* pBitmap = new GBitmap( 1, 1, false, GBitmap::RGBA );
+        dMemset( pBitmap->getWritableBits(), 0xFF, 4 );
+        whiteTexture = TextureHandle( "ShapeVectorWhiteTexel", pBitmap, TextureHandle::BitmapKeepTexture );
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static bool isPointInTriangle( const Vector2& point, const Vector2& a, const Vector2& b, const Vector2& c )
+{
+    const F32 d1 = (point.x - b.x) * (a.y - b.y) - (a.x - b.x) * (point.y - b.y);
+    const F32 d2 = (point.x - c.x) * (b.y - c.y) - (b.x - c.x) * (point.y - c.y);
+    const F32 d3 = (point.x - a.x) * (c.y - a.y) - (c.x - a.x) * (point.y - a.y);
+
+    const bool hasNegative = (d1 < 0.0f) || (d2 < 0.0f) || (d3 < 0.0f);
+    const bool hasPositive = (d1 > 0.0f) || (d2 > 0.0f) || (d3 > 0.0f);
+
+    return !(hasNegative && hasPositive);
+}
+
+//----------------------------------------------------------------------------
+
+void ShapeVector::triangulatePolygon( const Vector<Vector2>& polygon, Vector<Vector2>& triangles )
+{
+    triangles.clear();
+
+    // Fetch Polygon Vertex Count.
+    const U32 polyVertexCount = polygon.size();
+
+    // Finish if there's no area to fill.
+    if ( polyVertexCount < 3 )
+        return;
+
+    // Calculate the winding so we can tell convex vertices from reflex ones.
+    F32 area = 0.0f;
+    for ( U32 n = 0, previous = polyVertexCount-1; n < polyVertexCount; previous = n++ )
+        area += polygon[previous].x * polygon[n].y - polygon[n].x * polygon[previous].y;
+    const F32 winding = area < 0.0f ? -1.0f : 1.0f;
+
+    // Start with all the vertices remaining.
+    Vector<U32> indices;
+    indices.setSize( polyVertexCount );
+    for ( U32 n = 0; n < polyVertexCount; ++n )
+        indices[n] = n;
+
+    triangles.reserve( (polyVertexCount-2) * 3 );
+
+    // Clip ears until a single triangle remains.
+    U32 current = 0;
+    U32 failedCount = 0;
+    while ( indices.size() > 3 )
+    {
+        const U32 remaining = indices.size();
+        const U32 previous = (current + remaining - 1) % remaining;
+        const U32 next = (current + 1) % remaining;
+
+        const Vector2& a = polygon[indices[previous]];
+        const Vector2& b = polygon[indices[current]];
+        const Vector2& c = polygon[indices[next]];
+
+        const F32 cross = ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * winding;
+
+        // Collinear vertices don't change the shape so simply drop them.
+        if ( mIsZero( cross ) )
+        {
+            indices.erase( current );
+            current = current % indices.size();
+            failedCount = 0;
+            continue;
+        }
+
+        // A convex vertex is an ear if no other vertex lies within its triangle.
+        bool isEar = cross > 0.0f;
+        for ( U32 n = 0; isEar && n < remaining; ++n )
+        {
+            if ( n == previous || n == current || n == next )
+                continue;
+
+            if ( isPointInTriangle( polygon[indices[n]], a, b, c ) )
+                isEar = false;
+        }
+
+        if ( isEar )
+        {
+            triangles.push_back( a );
+            triangles.push_back( b );
+            triangles.push_back( c );
+
+            indices.erase( current );
+            current = current % indices.size();
+            failedCount = 0;
+            continue;
+        }
+
+        // Finish if no ear can be found i.e. the polygon is self-intersecting.
+        if ( ++failedCount >= remaining )
+            break;
+
+        current = next;
+    }
+
+    // Fan whatever remains.
+    for ( U32 n = 1; n + 1 < (U32)indices.size(); ++n )
+    {
+        triangles.push_back( polygon[indices[0]] );
+        triangles.push_back( polygon[indices[n]] );
+        triangles.push_back( polygon[indices[n+1]] );
+    }
+}
+
+//----------------------------------------------------------------------------
+
 ShapeVector::ShapeVector() :
     mLineColor(ColorF(1.0f,1.0f,1.0f,1.0f)),
     mFillColor(ColorF(0.5f,0.5f,0.5f,1.0f)),
@@ -41,11 +175,16 @@ ShapeVector::ShapeVector() :
     mIsCircle(false),
     mCircleRadius(1.0f),
     mFlipX(false),
-    mFlipY(false)
+    mFlipY(false),
+    mShapeCacheDirty(true),
+    mCachedIsCircle(false),
+    mCachedCircleRadius(0.0f)
 {
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mPolygonBasisList );
     VECTOR_SET_ASSOCIATION( mPolygonLocalList );
+    VECTOR_SET_ASSOCIATION( mLocalOutline );
+    VECTOR_SET_ASSOCIATION( mLocalTriangles );
 
    // Use a static body by default.
    mBodyDefinition.type = b2_staticBody;
@@ -101,6 +240,9 @@ bool ShapeVector::onAdd()
    if(!Parent::onAdd())
       return false;
 
+   // Create the fill texture here on the main thread as fills may be captured on a worker thread.
+   createWhiteTexture();
+
    // Return Okay.
    return true;
 }
@@ -117,168 +259,136 @@ void ShapeVector::onRemove()
 
 void ShapeVector::sceneRender( const SceneRenderState* pSceneRenderState, const SceneRenderRequest* pSceneRenderRequest, BatchRender* pBatchRenderer )
 {
-    // Fetch Vertex Count.
-    const U32 vertexCount = mPolygonLocalList.size();
-
     // Finish if not vertices.
-    if ( vertexCount == 0  && !mIsCircle)
+    if ( mPolygonLocalList.size() == 0 && !mIsCircle )
         return;
 
-    // Disable Texturing.
-    glDisable       ( GL_TEXTURE_2D );
-
-    // Save Model-view.
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-
-    // Fetch Position/Rotation.
-    const Vector2 position = getRenderPosition();
+    // Update the cached outline and triangulation if the shape has changed.
+    generateShapeCache();
 
-    // Set Blend Options.
-    setBlendOptions();
-    
-    if (mIsCircle)
-    {
-        glRotatef( mRadToDeg(getRenderAngle()), 0.0f, 0.0f, 1.0f );
+    // Fetch the wireframe mode.
+    const bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
 
-        // Render the shape.
-        bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
-        renderCircleShape(position, mCircleRadius, wireFrame);
-    }
-    else
+    // Batch the fill unless we need a wireframe overlay.
+    // NOTE:-   A recording batch renderer must not issue any GL calls so it always batches.
+    if ( mFillMode && ( !wireFrame || pBatchRenderer->getRecordTarget() != NULL ) )
     {
-        // Move into Vector-Space.
-        glTranslatef( position.x, position.y, 0.0f );
-        glRotatef( mRadToDeg(getRenderAngle()), 0.0f, 0.0f, 1.0f );
-
-        // Render the shape.
-        bool wireFrame = (pBatchRenderer->getWireframeMode() || this->getDebugMask() & Scene::SCENE_DEBUG_WIREFRAME_RENDER) ? true : false;
-        renderPolygonShape(vertexCount, wireFrame);
+        submitFillTriangles( pBatchRenderer );
+        return;
     }
 
-    // Restore color.
-    glColor4f( 1,1,1,1 );
+    // Flush anything batched so far so that it is not drawn over this shape.
+    pBatchRenderer->flush();
 
-    // Restore Matrix.
-    glPopMatrix();
+    // Render the shape immediately.
+    renderShapeImmediate( wireFrame );
 }
 
-void ShapeVector::renderCircleShape(Vector2 position, F32 radius, const bool wireFrame)
+//----------------------------------------------------------------------------
+
+void ShapeVector::submitFillTriangles( BatchRender* pBatchRenderer )
 {
-    if (mFillMode)
-    {
-        // Set the fill color.
-        glColor4f((GLfloat)mFillColor.red, (GLfloat)mFillColor.green, (GLfloat)mFillColor.blue, (GLfloat)mFillColor.alpha);
+    // Debug Profiling.
+    PROFILE_SCOPE(ShapeVector_SubmitFillTriangles);
 
-        // Draw the shape.
-        const U32 k_segments = 32;
-        const F32 k_increment = 2.0f * M_PI_F / k_segments;
-        F32 theta = 0.0f;
+    // Fetch triangle vertex count.
+    const U32 vertexCount = mLocalTriangles.size();
 
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < k_segments; n++)
-        {
-            Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
+    // Finish if there's nothing to fill.
+    if ( vertexCount == 0 )
+        return;
 
-            verts.push_back((GLfloat)v.x);
-            verts.push_back((GLfloat)v.y);
+    // Fetch the white texture.
+    TextureHandle& whiteTexture = getWhiteTexture();
 
-            theta += k_increment;
-        }
+    // Sanity!
+    AssertFatal( !whiteTexture.IsNull(), "ShapeVector::submitFillTriangles() - The fill texture has not been created." );
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, k_segments);
+    // Allocate the render buffers for a single chunk.
+    // NOTE:-   The frame allocator is per-thread so this is safe when capturing on a worker thread.
+    const U32 maxChunkSize = BATCHRENDER_MAXTRIANGLES * 3;
+    const U32 bufferSize = getMin( vertexCount, maxChunkSize );
+    FrameTemp<Vector2> renderVertices( bufferSize );
+    FrameTemp<Vector2> renderTexCoords( bufferSize );
+    for ( U32 n = 0; n < bufferSize; ++n )
+        renderTexCoords[n].Set( 0.5f, 0.5f );
 
-        // If mFillMode is enabled wireframe is also enabled, we'll draw a filled shape with a wire overlay.
-        // Set the line color.
-        if (wireFrame)
-        {
-            glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
-            glDrawArrays(GL_LINE_LOOP, 0, k_segments);
-        }
+    // Fetch Position/Rotation.
+    const Vector2 position = getRenderPosition();
+    const F32 angle = getRenderAngle();
+    const F32 cosAngle = mCos( angle );
+    const F32 sinAngle = mSin( angle );
 
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
-    else
+    // Submit the triangles in whole-triangle chunks that fit the batch.
+    const Vector2* pLocalVertex = mLocalTriangles.address();
+    for ( U32 offset = 0; offset < vertexCount; offset += maxChunkSize )
     {
-        // We emulate wireframe mode here by drawing lines between the verts.
-        // Set the line color.
-        glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
+        const U32 chunkSize = getMin( vertexCount - offset, maxChunkSize );
 
-        // Draw the shape.
-        const U32 k_segments = 32;
-        const F32 k_increment = 2.0f * M_PI_F / k_segments;
-        F32 theta = 0.0f;
-
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < k_segments; n++)
+        // Transform the cached triangles into world-space.
+        Vector2* pRenderVertex = ~renderVertices;
+        for ( U32 n = 0; n < chunkSize; ++n, ++pLocalVertex, ++pRenderVertex )
         {
-            Vector2 v = position + radius * Vector2(mCos(theta), mSin(theta));
-
-            verts.push_back((GLfloat)v.x);
-            verts.push_back((GLfloat)v.y);
-
-            theta += k_increment;
+            pRenderVertex->Set( position.x + pLocalVertex->x * cosAngle - pLocalVertex->y * sinAngle,
+                                position.y + pLocalVertex->x * sinAngle + pLocalVertex->y * cosAngle );
         }
 
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_LINE_LOOP, 0, k_segments);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        pBatchRenderer->SubmitTriangles( chunkSize, ~renderVertices, ~renderTexCoords, whiteTexture, mFillColor );
     }
 }
 
-void ShapeVector::renderPolygonShape(U32 vertexCount, const bool wireFrame)
+//----------------------------------------------------------------------------
+
+void ShapeVector::renderShapeImmediate( const bool wireFrame )
 {
-    // If fill mode is enabled, draw the polygon using GL_TRIANGLE_FAN, otherwise we draw with GL_LINE_LOOP.
-    // We also draw with GL_LINE_LOOP if the scene/object is being rendered with wireframe enabled.
-    if (mFillMode)
+    // Disable Texturing.
+    glDisable       ( GL_TEXTURE_2D );
+
+    // Save Model-view.
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    // Fetch Position/Rotation.
+    const Vector2 position = getRenderPosition();
+
+    // Set Blend Options.
+    setBlendOptions();
+
+    // Move into Vector-Space.
+    glTranslatef( position.x, position.y, 0.0f );
+    glRotatef( mRadToDeg(getRenderAngle()), 0.0f, 0.0f, 1.0f );
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    // If fill mode is enabled, draw the cached triangles.
+    if ( mFillMode && mLocalTriangles.size() > 0 )
     {
         // Set the fill color.
         glColor4f((GLfloat)mFillColor.red, (GLfloat)mFillColor.green, (GLfloat)mFillColor.blue, (GLfloat)mFillColor.alpha);
 
         // Draw the shape.
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < vertexCount; n++)
-        {
-            verts.push_back((GLfloat)mPolygonLocalList[n].x);
-            verts.push_back((GLfloat)mPolygonLocalList[n].y);
-        }
-
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, vertexCount);
-
-        // If mFillMode is enabled wireframe is also enabled, we'll draw a filled shape with a wire overlay.
-        // Set the line color.
-        if (wireFrame)
-        {
-            glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
-            glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
-        }
-
-        glDisableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, mLocalTriangles.address());
+        glDrawArrays(GL_TRIANGLES, 0, mLocalTriangles.size());
     }
-    else
+
+    // We draw the outline if not filling or, when filling, as a wireframe overlay.
+    if ( !mFillMode || wireFrame )
     {
-        // We emulate wireframe mode here by drawing lines between the verts.
         // Set the line color.
         glColor4f((GLfloat)mLineColor.red, (GLfloat)mLineColor.green, (GLfloat)mLineColor.blue, (GLfloat)mLineColor.alpha);
 
-        // Draw the shape.
-        Vector<GLfloat> verts;
-        for (U32 n = 0; n < vertexCount; n++)
-        {
-            verts.push_back((GLfloat)mPolygonLocalList[n].x);
-            verts.push_back((GLfloat)mPolygonLocalList[n].y);
-        }
-
-        glVertexPointer(2, GL_FLOAT, 0, verts.address());
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glDrawArrays(GL_LINE_LOOP, 0, vertexCount);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        // Draw the outline.
+        glVertexPointer(2, GL_FLOAT, 0, mLocalOutline.address());
+        glDrawArrays(GL_LINE_LOOP, 0, mLocalOutline.size());
     }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    // Restore color.
+    glColor4f( 1,1,1,1 );
+
+    // Restore Matrix.
+    glPopMatrix();
 }
 
 //----------------------------------------------------------------------------
@@ -530,6 +640,55 @@ void ShapeVector::generateLocalPoly( void )
             mPolygonLocalList[n] = polyVertex;
         }
     }
+
+    // Flag the shape cache as dirty.
+    mShapeCacheDirty = true;
+}
+
+//----------------------------------------------------------------------------
+
+void ShapeVector::generateShapeCache( void )
+{
+    // Finish if the cache is still valid.
+    if ( !mShapeCacheDirty && mCachedIsCircle == mIsCircle && mCachedCircleRadius == mCircleRadius )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(ShapeVector_GenerateShapeCache);
+
+    mShapeCacheDirty = false;
+    mCachedIsCircle = mIsCircle;
+    mCachedCircleRadius = mCircleRadius;
+
+    if ( mIsCircle )
+    {
+        // Generate the circle outline.
+        const F32 increment = M_2PI_F / ShapeVectorCircleSegments;
+        mLocalOutline.setSize( ShapeVectorCircleSegments );
+        for ( U32 n = 0; n < ShapeVectorCircleSegments; ++n )
+        {
+            const F32 theta = n * increment;
+            mLocalOutline[n].Set( mCircleRadius * mCos(theta), mCircleRadius * mSin(theta) );
+        }
+
+        // Fan the circle from its first outline vertex.
+        mLocalTriangles.clear();
+        mLocalTriangles.reserve( (ShapeVectorCircleSegments-2) * 3 );
+        for ( U32 n = 1; n < ShapeVectorCircleSegments-1; ++n )
+        {
+            mLocalTriangles.push_back( mLocalOutline[0] );
+            mLocalTriangles.push_back( mLocalOutline[n] );
+            mLocalTriangles.push_back( mLocalOutline[n+1] );
+        }
+    }
+    else
+    {
+        // The outline is the local polygon.
+        mLocalOutline = mPolygonLocalList;
+
+        // Ear-clip the polygon so that concave shapes fill correctly.
+        triangulatePolygon( mLocalOutline, mLocalTriangles );
+    }
 }
 
 //----------------------------------------------------------------------------
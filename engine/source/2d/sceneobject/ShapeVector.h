@@ -44,6 +44,12 @@ protected:
     bool                    mFlipX;
     bool                    mFlipY;
 
+    Vector<Vector2>         mLocalOutline;          ///< Cached local-space outline.
+    Vector<Vector2>         mLocalTriangles;        ///< Cached local-space fill triangles.
+    bool                    mShapeCacheDirty;
+    bool                    mCachedIsCircle;
+    F32                     mCachedCircleRadius;
+
 public:
     ShapeVector();
     ~ShapeVector();
@@ -75,9 +81,14 @@ public:
 
     /// Internal Crunchers.
     void generateLocalPoly( void );
+    void generateShapeCache( void );
+
+    /// Triangulate a simple polygon of either winding by ear clipping.
+    /// Collinear vertices are dropped and whatever remains of a self-intersecting polygon is fanned.
+    static void triangulatePolygon( const Vector<Vector2>& polygon, Vector<Vector2>& triangles );
 
-    void renderCircleShape(Vector2 position, F32 radius, const bool wireFrame);
-    void renderPolygonShape(U32 vertexCount, const bool wireFrame);
+    void submitFillTriangles( BatchRender* pBatchRenderer );
+    void renderShapeImmediate( const bool wireFrame );
 
     /// Render flipping.
     inline void setFlip( const bool flipX, const bool flipY )   { mFlipX = flipX; mFlipY = flipY; generateLocalPoly(); }
@@ -95,7 +106,7 @@ public:
     virtual bool shouldRender( void ) const { return true; }
 
     /// Render batching.
-    virtual bool isBatchRendered( void ) { return false; }
+    virtual bool isBatchRendered( void ) { return mFillMode; }
 
     /// Clone support
     void copyTo(SimObject* obj);
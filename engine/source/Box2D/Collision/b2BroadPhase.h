@@ -49,6 +49,11 @@ public:
 	/// UpdatePairs is called.
 	int32 CreateProxy(const b2AABB& aabb, void* userData);
 
+	/// Create many proxies at once as a single balanced sub-tree. Pairs are not
+	/// reported until UpdatePairs is called.
+	/// @param proxyIds receives the proxy id for each of the supplied AABBs.
+	void CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds);
+
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
 
@@ -19,6 +19,7 @@
 #include <Box2D/Collision/b2DynamicTree.h>
 #include <cstring>
 #include <cfloat>
+#include <algorithm>
 using namespace std;
 
 
@@ -121,6 +122,93 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 	return proxyId;
 }
 
+void b2DynamicTree::CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// Allocate the leaves.
+	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	for (int32 i = 0; i < count; ++i)
+	{
+		int32 proxyId = AllocateNode();
+		m_nodes[proxyId].aabb.lowerBound = aabbs[i].lowerBound - r;
+		m_nodes[proxyId].aabb.upperBound = aabbs[i].upperBound + r;
+		m_nodes[proxyId].userData = userData[i];
+		m_nodes[proxyId].height = 0;
+		proxyIds[i] = proxyId;
+	}
+
+	// Build a balanced sub-tree over the leaves.
+	int32* leaves = (int32*)b2Alloc(count * sizeof(int32));
+	memcpy(leaves, proxyIds, count * sizeof(int32));
+	int32 subRoot = BuildBalanced(leaves, count);
+	b2Free(leaves);
+
+	// Insert the sub-tree as a single node.
+	InsertLeaf(subRoot);
+}
+
+struct b2CentroidLess
+{
+	const b2TreeNode* nodes;
+	int32 axis;
+
+	bool operator()(int32 a, int32 b) const
+	{
+		const b2AABB& aabbA = nodes[a].aabb;
+		const b2AABB& aabbB = nodes[b].aabb;
+		if (axis == 0)
+		{
+			return aabbA.lowerBound.x + aabbA.upperBound.x < aabbB.lowerBound.x + aabbB.upperBound.x;
+		}
+		return aabbA.lowerBound.y + aabbA.upperBound.y < aabbB.lowerBound.y + aabbB.upperBound.y;
+	}
+};
+
+int32 b2DynamicTree::BuildBalanced(int32* leaves, int32 count)
+{
+	if (count == 1)
+	{
+		m_nodes[leaves[0]].parent = b2_nullNode;
+		return leaves[0];
+	}
+
+	// Split on the longest axis of the centroid bounds.
+	b2Vec2 lower = m_nodes[leaves[0]].aabb.GetCenter();
+	b2Vec2 upper = lower;
+	for (int32 i = 1; i < count; ++i)
+	{
+		b2Vec2 c = m_nodes[leaves[i]].aabb.GetCenter();
+		lower = b2Min(lower, c);
+		upper = b2Max(upper, c);
+	}
+
+	b2CentroidLess less;
+	less.nodes = m_nodes;
+	less.axis = (upper.x - lower.x) >= (upper.y - lower.y) ? 0 : 1;
+
+	int32 half = count / 2;
+	nth_element(leaves, leaves + half, leaves + count, less);
+
+	int32 child1 = BuildBalanced(leaves, half);
+	int32 child2 = BuildBalanced(leaves + half, count - half);
+
+	// Allocating may relocate the node pool so fetch nodes afterwards.
+	int32 parent = AllocateNode();
+	m_nodes[parent].child1 = child1;
+	m_nodes[parent].child2 = child2;
+	m_nodes[parent].aabb.Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+	m_nodes[parent].height = 1 + b2Max(m_nodes[child1].height, m_nodes[child2].height);
+	m_nodes[parent].parent = b2_nullNode;
+	m_nodes[child1].parent = parent;
+	m_nodes[child2].parent = parent;
+
+	return parent;
+}
+
 void b2DynamicTree::DestroyProxy(int32 proxyId)
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
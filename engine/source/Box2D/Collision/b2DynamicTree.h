@@ -70,6 +70,12 @@ public:
 	/// Create a proxy. Provide a tight fitting AABB and a userData pointer.
 	int32 CreateProxy(const b2AABB& aabb, void* userData);
 
+	/// Create many proxies at once. The new proxies are built into a balanced
+	/// sub-tree which is then inserted into the tree as a single node. This is much
+	/// faster than individual inserts when adding large numbers of proxies.
+	/// @param proxyIds receives the proxy id for each of the supplied AABBs.
+	void CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds);
+
 	/// Destroy a proxy. This asserts if the id is invalid.
 	void DestroyProxy(int32 proxyId);
 
@@ -129,6 +135,7 @@ private:
 	void FreeNode(int32 node);
 
 	void InsertLeaf(int32 node);
+	int32 BuildBalanced(int32* leaves, int32 count);
 	void RemoveLeaf(int32 node);
 
 	int32 Balance(int32 index);
@@ -128,6 +128,82 @@ b2Body* b2World::CreateBody(const b2BodyDef* def)
 	return b;
 }
 
+void b2World::ActivateBodies(b2Body* const* bodies, int32 count)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	// Count the proxies required.
+	int32 proxyCount = 0;
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2Body* b = bodies[i];
+		if (b->IsActive())
+		{
+			continue;
+		}
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			b2Assert(f->m_proxyCount == 0);
+			proxyCount += f->m_shape->GetChildCount();
+		}
+	}
+
+	b2AABB* aabbs = (b2AABB*)b2Alloc(b2Max(proxyCount, 1) * sizeof(b2AABB));
+	void** userData = (void**)b2Alloc(b2Max(proxyCount, 1) * sizeof(void*));
+	int32* proxyIds = (int32*)b2Alloc(b2Max(proxyCount, 1) * sizeof(int32));
+
+	// Gather the fixture proxies.
+	int32 proxyIndex = 0;
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2Body* b = bodies[i];
+		if (b->IsActive())
+		{
+			continue;
+		}
+
+		b->m_flags |= b2Body::e_activeFlag;
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			f->m_proxyCount = f->m_shape->GetChildCount();
+			for (int32 j = 0; j < f->m_proxyCount; ++j)
+			{
+				b2FixtureProxy* proxy = f->m_proxies + j;
+				f->m_shape->ComputeAABB(&proxy->aabb, b->m_xf, j);
+				proxy->fixture = f;
+				proxy->childIndex = j;
+
+				aabbs[proxyIndex] = proxy->aabb;
+				userData[proxyIndex] = proxy;
+				++proxyIndex;
+			}
+		}
+	}
+
+	// Build the proxies.
+	if (proxyIndex > 0)
+	{
+		m_contactManager.m_broadPhase.CreateProxies(aabbs, userData, proxyIndex, proxyIds);
+
+		for (int32 i = 0; i < proxyIndex; ++i)
+		{
+			((b2FixtureProxy*)userData[i])->proxyId = proxyIds[i];
+		}
+	}
+
+	b2Free(proxyIds);
+	b2Free(userData);
+	b2Free(aabbs);
+
+	// Contacts are created the next time step.
+}
+
 void b2World::DestroyBody(b2Body* b)
 {
 	b2Assert(m_bodyCount > 0);
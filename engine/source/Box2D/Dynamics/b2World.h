@@ -71,6 +71,12 @@ public:
 	/// @warning This function is locked during callbacks.
 	b2Body* CreateBody(const b2BodyDef* def);
 
+	/// Activate many inactive bodies at once. The broad-phase proxies of all their
+	/// fixtures are built as a single balanced sub-tree rather than inserted one
+	/// at a time. Bodies that are already active are ignored.
+	/// @warning This function is locked during callbacks.
+	void ActivateBodies(b2Body* const* bodies, int32 count);
+
 	/// Destroy a rigid body given a definition. No reference to the definition
 	/// is retained. This function is locked during callbacks.
 	/// @warning This automatically deletes all associated shapes and joints.
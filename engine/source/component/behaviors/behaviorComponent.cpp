@@ -26,6 +26,7 @@
 
 #include "component/behaviors/behaviorComponent.h"
 #include "component/behaviors/behaviorTemplate.h"
+#include "component/behaviors/nativeBehaviorInstance.h"
 
 #ifndef _ASSET_FIELD_TYPES_H_
 #include "assets/assetFieldTypes.h"
@@ -48,14 +49,17 @@ static StringTableEntry behaviorIdFieldName         = StringTable->insert( "Id"
 static StringTableEntry behaviorNodeName            = StringTable->insert( "Behaviors" );
 static StringTableEntry behaviorConnectionTypeName  = StringTable->insert( "Connection" );
 static StringTableEntry behaviorTemplateAssetName   = StringTable->insert( "Asset" );
+static StringTableEntry behaviorDeleteMethodName    = StringTable->insert( "delete" );
 
 //-----------------------------------------------------------------------------
 
 BehaviorComponent::BehaviorComponent() :
     mMasterBehaviorId( 1 ),
-    mpBehaviorFieldNames( NULL )
+    mpBehaviorFieldNames( NULL ),
+    mBehaviorMethodRouteSequence( 0 )
 {
     SIMSET_SET_ASSOCIATION( mBehaviors );
+    VECTOR_SET_ASSOCIATION( mNativeBehaviors );
 }
 
 //-----------------------------------------------------------------------------
@@ -136,6 +140,11 @@ void BehaviorComponent::copyTo(SimObject* obj)
         BehaviorTemplate* pFromTemplate = pFromInstance->getTemplate();
         BehaviorInstance* pToInstance = pFromTemplate->createInstance();
 
+        // Copy the typed fields of a native behavior instance.
+        NativeBehaviorInstance* pFromNativeInstance = dynamic_cast<NativeBehaviorInstance*>( pFromInstance );
+        if ( pFromNativeInstance != NULL )
+            pFromNativeInstance->copyNativeFieldsTo( static_cast<NativeBehaviorInstance*>( pToInstance ) );
+
         // Assign dynamic fields from behavior instance.
         pToInstance->assignDynamicFieldsFrom( pFromInstance );
 
@@ -193,6 +202,9 @@ bool BehaviorComponent::addBehavior( BehaviorInstance* bi )
     // Store behavior.
     mBehaviors.pushObject( bi );
 
+    // Invalidate the method routing.
+    invalidateBehaviorMethodRoutes();
+
     // Notify if the behavior instance is destroyed.
     deleteNotify( bi );
 
@@ -202,6 +214,15 @@ bool BehaviorComponent::addBehavior( BehaviorInstance* bi )
     // Allocate a behavior Id.
     bi->setBehaviorId( mMasterBehaviorId++ );
 
+    // Is this a native behavior?
+    NativeBehaviorInstance* pNativeBehavior = dynamic_cast<NativeBehaviorInstance*>( bi );
+    if ( pNativeBehavior != NULL )
+    {
+        // Yes, so track it and notify.
+        mNativeBehaviors.push_back( pNativeBehavior );
+        pNativeBehavior->onBehaviorAdd();
+    }
+
     if( bi->isMethod("onBehaviorAdd") )
         Con::executef( bi , 1, "onBehaviorAdd" );
 
@@ -218,10 +239,25 @@ bool BehaviorComponent::removeBehavior( BehaviorInstance *bi, bool deleteBehavio
         {
             mBehaviors.removeObject( *itr );
 
+            // Invalidate the method routing.
+            invalidateBehaviorMethodRoutes();
+
             // Perform callback if allowed.
             if( bi->isProperlyAdded() && bi->isMethod("onBehaviorRemove") )
                 Con::executef( bi , 1, "onBehaviorRemove" );
 
+            // Is this a native behavior?
+            NativeBehaviorInstance* pNativeBehavior = dynamic_cast<NativeBehaviorInstance*>( bi );
+            if ( pNativeBehavior != NULL )
+            {
+                // Yes, so notify and stop tracking it.
+                pNativeBehavior->onBehaviorRemove();
+
+                const S32 nativeIndex = mNativeBehaviors.find_next( pNativeBehavior );
+                if ( nativeIndex != -1 )
+                    mNativeBehaviors.erase( nativeIndex );
+            }
+
             // Destroy any output connections.
             destroyBehaviorOutputConnections( bi );
 
@@ -281,6 +317,9 @@ bool BehaviorComponent::reOrder( BehaviorInstance *obj, U32 desiredIndex /* = 0
     if( desiredIndex > (U32)mBehaviors.size() )
         return false;
 
+    // Invalidate the method routing.
+    invalidateBehaviorMethodRoutes();
+
     SimObject *target = mBehaviors.at( desiredIndex );
     return mBehaviors.reOrder( obj, target );
 }
@@ -914,8 +953,58 @@ void BehaviorComponent::write( Stream &stream, U32 tabStop, U32 flags /* = 0 */
 
 //-----------------------------------------------------------------------------
 
+BehaviorComponent::BehaviorMethodRoute BehaviorComponent::findBehaviorMethodRoute( StringTableEntry methodName )
+{
+    // Flush the routes if any namespace has changed since they were cached.
+    if ( mBehaviorMethodRouteSequence != Namespace::mCacheSequence )
+    {
+        invalidateBehaviorMethodRoutes();
+        mBehaviorMethodRouteSequence = Namespace::mCacheSequence;
+    }
+
+    // Return any cached route.
+    typeBehaviorMethodRouteHash::iterator routeItr = mBehaviorMethodRoutes.find( methodName );
+    if ( routeItr != mBehaviorMethodRoutes.end() )
+        return routeItr->value;
+
+    BehaviorMethodRoute route;
+    route.mpBehaviorInstance = NULL;
+    route.mpNamespaceEntry = NULL;
+
+    // Walk backwards through the list just as with components so the most recent behavior handles the method.
+    if ( !mBehaviors.empty() )
+    {
+        for( SimSet::iterator i = (mBehaviors.end()-1); i >= mBehaviors.begin(); i-- )
+        {
+            BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *i );
+            AssertFatal( pBehavior, "BehaviorComponent::findBehaviorMethodRoute - Bad behavior instance in list." );
+
+            // Use the BehaviorInstance's namespace
+            Namespace *pNamespace = pBehavior->getNamespace();
+            if(!pNamespace)
+                continue;
+
+            Namespace::Entry *pNSEntry = pNamespace->lookup( methodName );
+            if( pNSEntry )
+            {
+                route.mpBehaviorInstance = pBehavior;
+                route.mpNamespaceEntry = pNSEntry;
+                break;
+            }
+        }
+    }
+
+    // Cache the route.
+    mBehaviorMethodRoutes.insert( methodName, route );
+
+    return route;
+}
+
+//-----------------------------------------------------------------------------
+
 bool BehaviorComponent::handlesConsoleMethod( const char *fname, S32 *routingId )
 {
+   StringTableEntry methodName = StringTable->insert( fname );
 
    // CodeReview [6/25/2007 justind]
    // If we're deleting the BehaviorComponent, don't forward the call to the
@@ -923,17 +1012,13 @@ bool BehaviorComponent::handlesConsoleMethod( const char *fname, S32 *routingId
    // This should really be handled better, and is in the Parent implementation
    // but behaviors are a special case because they always want to be called BEFORE
    // the parent to act.
-   if( dStricmp( fname, "delete" ) == 0 )
+   if( methodName == behaviorDeleteMethodName )
       return Parent::handlesConsoleMethod( fname, routingId );
 
-   for( SimSet::iterator nItr = mBehaviors.begin(); nItr != mBehaviors.end(); nItr++ )
+   if( findBehaviorMethodRoute( methodName ).mpBehaviorInstance != NULL )
    {
-      SimObject *pComponent = dynamic_cast<SimObject *>(*nItr);
-      if( pComponent != NULL && pComponent->isMethod( fname ) )
-      {
-         *routingId = -2; // -2 denotes method on component
-         return true;
-      }
+      *routingId = -2; // -2 denotes method on component
+      return true;
    }
 
    // Let parent handle it
@@ -949,60 +1034,33 @@ const char *BehaviorComponent::callOnBehaviors( U32 argc, const char *argv[] )
 {   
     if( mBehaviors.empty() )   
         return Parent::callOnBehaviors( argc, argv );
-      
-    // Copy the arguments to avoid weird clobbery situations.
-    FrameTemp<char *> argPtrs (argc);
-   
-    U32 strdupWatermark = FrameAllocator::getWaterMark();
-    for( U32 i = 0; i < argc; i++ )
-    {
-        argPtrs[i] = reinterpret_cast<char *>( FrameAllocator::alloc( dStrlen( argv[i] ) + 1 ) );
-        dStrcpy( argPtrs[i], argv[i] );
-    }
 
-    // Walk backwards through the list just as with components
-    const char* result = "";
-    bool handled = false;
-    for( SimSet::iterator i = (mBehaviors.end()-1); i >= mBehaviors.begin(); i-- )
-    {
-        BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *i );
-        AssertFatal( pBehavior, "BehaviorComponent::callOnBehaviors - Bad behavior instance in list." );
-        AssertFatal( pBehavior->getId() > 0, "Invalid id for behavior component" );
+    // Find the behavior that handles the method.
+    StringTableEntry methodName = StringTable->insert( argv[0] );
+    const BehaviorMethodRoute route = findBehaviorMethodRoute( methodName );
 
-        // Use the BehaviorInstance's namespace
-        Namespace *pNamespace = pBehavior->getNamespace();
-        if(!pNamespace)
-            continue;
+    // If this isn't handled by a behavior then pass along to the parent DynamicConsoleMethodComponent
+    // to deal with it.  If the parent cannot handle the message it will return an error string.
+    if ( route.mpBehaviorInstance == NULL )
+        return Parent::callOnBehaviors( argc, argv );
 
-        // Lookup the Callback Namespace entry and then splice callback
-        const char *cbName = StringTable->insert(argv[0]);
-        Namespace::Entry *pNSEntry = pNamespace->lookup(cbName);
-        if( pNSEntry )
-        {
-            // Set %this to our BehaviorInstance's Object ID
-            argPtrs[1] = const_cast<char *>( pBehavior->getIdString() );
+    AssertFatal( route.mpBehaviorInstance->getId() > 0, "Invalid id for behavior component" );
 
-            // Change the Current Console object, execute, restore Object
-            SimObject *save = gEvalState.thisObject;
-            gEvalState.thisObject = pBehavior;
+    // Copy the argument pointers only so that %this can be replaced without touching the caller's arguments.
+    FrameTemp<const char *> argPtrs (argc);
+    dMemcpy( ~argPtrs, argv, argc * sizeof(const char*) );
+    argPtrs[0] = methodName;
 
-            result = pNSEntry->execute(argc, const_cast<const char **>( ~argPtrs ), &gEvalState);
+    // Set %this to our BehaviorInstance's Object ID
+    argPtrs[1] = route.mpBehaviorInstance->getIdString();
 
-            gEvalState.thisObject = save;
-            handled = true;
-            break;
-        }
-    }
+    // Change the Current Console object, execute, restore Object
+    SimObject *save = gEvalState.thisObject;
+    gEvalState.thisObject = route.mpBehaviorInstance;
 
-    // If this wasn't handled by a behavior above then pass along to the parent DynamicConsoleMethodComponent
-    // to deal with it.  If the parent cannot handle the message it will return an error string.
-    if (!handled)
-    {
-        result = Parent::callOnBehaviors( argc, argv );
-    }
+    const char* result = route.mpNamespaceEntry->execute(argc, ~argPtrs, &gEvalState);
 
-    // Clean up.
-    FrameAllocator::setWaterMark( strdupWatermark );
+    gEvalState.thisObject = save;
 
     return result;
 }
@@ -1024,6 +1082,9 @@ const char *BehaviorComponent::_callMethod( U32 argc, const char *argv[], bool c
         dStrcpy( argPtrs[i], argv[i] );
     }
 
+    // Fetch the callback name.
+    const char *cbName = StringTable->insert(argv[0]);
+
     for( SimSet::iterator i = mBehaviors.begin(); i != mBehaviors.end(); i++ )
     {
         BehaviorInstance *pBehavior = dynamic_cast<BehaviorInstance *>( *i );
@@ -1036,7 +1097,6 @@ const char *BehaviorComponent::_callMethod( U32 argc, const char *argv[], bool c
             continue;
 
         // Lookup the Callback Namespace entry and then splice callback
-        const char *cbName = StringTable->insert(argv[0]);
         Namespace::Entry *pNSEntry = pNamespace->lookup(cbName);
         if( pNSEntry )
         {
@@ -31,6 +31,14 @@
 #include "behaviorInstance.h"
 #endif
 
+#ifndef _CONSOLE_NAMESPACE_H_
+#include "console/consoleNamespace.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class NativeBehaviorInstance;
+
 //-----------------------------------------------------------------------------
 
 class BehaviorComponent : public DynamicConsoleMethodComponent
@@ -42,11 +50,24 @@ private:
     /// Component Behaviors
     SimSet  mBehaviors;
 
+    /// Native behaviors (a subset of the component behaviors).
+    Vector<NativeBehaviorInstance*> mNativeBehaviors;
+
     /// Master behavior Id.
     U32 mMasterBehaviorId;
 
     Vector<StringTableEntry>* mpBehaviorFieldNames;
 
+    /// Behavior method routing.
+    /// NOTE: A route with no behavior instance records that no behavior handles the method.
+    struct BehaviorMethodRoute
+    {
+        BehaviorInstance*   mpBehaviorInstance;
+        Namespace::Entry*   mpNamespaceEntry;
+    };
+    typedef HashMap<StringTableEntry, BehaviorMethodRoute> typeBehaviorMethodRouteHash;
+    typeBehaviorMethodRouteHash mBehaviorMethodRoutes;
+    U32 mBehaviorMethodRouteSequence;
 
 public:
     /// A behavior port connection.
@@ -87,6 +108,10 @@ protected:
 private:
     void destroyBehaviorOutputConnections( BehaviorInstance* pOutputBehavior );
     void destroyBehaviorInputConnections( BehaviorInstance* pInputBehavior );
+
+    /// Behavior method routing.
+    BehaviorMethodRoute findBehaviorMethodRoute( StringTableEntry methodName );
+    inline void invalidateBehaviorMethodRoutes( void ) { mBehaviorMethodRoutes.clear(); }
     
   
 public:
@@ -109,6 +134,7 @@ public:
     virtual BehaviorInstance *getBehavior( StringTableEntry behaviorTemplateName );
     virtual BehaviorInstance *getBehavior( const U32 index ) { return index < (U32)mBehaviors.size() ? reinterpret_cast<BehaviorInstance *>(mBehaviors[index]) : NULL; }
     virtual bool reOrder( BehaviorInstance *obj, U32 desiredIndex );
+    inline const Vector<NativeBehaviorInstance*>& getNativeBehaviors( void ) const { return mNativeBehaviors; }
 
     /// Behavior connectivity.
     bool connect( BehaviorInstance* pOutputBehavior, BehaviorInstance* pInputBehavior, StringTableEntry pOutputName, StringTableEntry pInputName );
@@ -118,6 +144,9 @@ public:
     const BehaviorPortConnection* getBehaviorConnection( BehaviorInstance* pOutputBehavior, StringTableEntry pOutputName, const U32 connectionIndex );
     const typePortConnectionVector* getBehaviorConnections( BehaviorInstance* pOutputBehavior, StringTableEntry pOutputName );
 
+    /// Behavior method routing.
+    inline U32 getBehaviorMethodRouteCount( void ) const { return mBehaviorMethodRoutes.size(); }
+
     /// DynamicConsoleMethodComponent Overrides
     virtual bool handlesConsoleMethod( const char *fname, S32 *routingId );
     virtual const char* callOnBehaviors( U32 argc, const char *argv[] );
@@ -36,24 +36,34 @@ IMPLEMENT_CONOBJECT(BehaviorInstance);
 //-----------------------------------------------------------------------------
 
 BehaviorInstance::BehaviorInstance( BehaviorTemplate* pTemplate ) :
-    mTemplate( pTemplate ),
+    mTemplate( NULL ),
     mBehaviorOwner( NULL ),
     mBehaviorId( 0 )
 {
     if ( pTemplate != NULL )
-    {
-        // Fetch field prototype count.
-        const U32 fieldCount = pTemplate->getBehaviorFieldCount();
-
-        // Set field prototypes.
-        for( U32 index = 0; index < fieldCount; ++index )
-        {        
-            // Fetch fields.
-            BehaviorTemplate::BehaviorField* pField = pTemplate->getBehaviorField( index );
-
-            // Set cloned field.
-            setDataField( pField->mName, NULL, pField->mDefaultValue );
-        }
+        initializeTemplate( pTemplate );
+}
+
+//-----------------------------------------------------------------------------
+
+void BehaviorInstance::initializeTemplate( BehaviorTemplate* pTemplate )
+{
+    // Sanity!
+    AssertFatal( pTemplate != NULL, "BehaviorInstance::initializeTemplate() - Cannot initialize from a NULL template." );
+
+    mTemplate = pTemplate;
+
+    // Fetch field prototype count.
+    const U32 fieldCount = pTemplate->getBehaviorFieldCount();
+
+    // Set field prototypes.
+    for( U32 index = 0; index < fieldCount; ++index )
+    {        
+        // Fetch fields.
+        BehaviorTemplate::BehaviorField* pField = pTemplate->getBehaviorField( index );
+
+        // Set cloned field.
+        setDataField( pField->mName, NULL, pField->mDefaultValue );
     }
 }
 
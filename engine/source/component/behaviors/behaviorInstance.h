@@ -53,7 +53,8 @@ public:
     virtual void onRemove();
     static void initPersistFields();
 
-    /// Template name.
+    /// Template.
+    void initializeTemplate( BehaviorTemplate* pTemplate );
     inline BehaviorTemplate* getTemplate( void ) { return mTemplate; }
     const char* getTemplateName( void );
 
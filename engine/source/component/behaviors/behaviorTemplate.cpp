@@ -25,6 +25,7 @@
 #include "console/consoleTypes.h"
 #include "component/simComponent.h"
 #include "component/behaviors/behaviorTemplate.h"
+#include "component/behaviors/nativeBehaviorInstance.h"
 #include "memory/safeDelete.h"
 #include "io/resource/resourceManager.h"
 
@@ -40,8 +41,10 @@ IMPLEMENT_CONOBJECT(BehaviorTemplate);
 BehaviorTemplate::BehaviorTemplate() :
     mFriendlyName( StringTable->EmptyString ),
     mDescription( StringTable->EmptyString ),
-    mBehaviorType( StringTable->EmptyString )
+    mBehaviorType( StringTable->EmptyString ),
+    mNativeClass( StringTable->EmptyString )
 {
+    VECTOR_SET_ASSOCIATION( mNativeUpdateBatch );
 }
 
 //-----------------------------------------------------------------------------
@@ -73,6 +76,7 @@ void BehaviorTemplate::initPersistFields()
         addField("friendlyName", TypeCaseString, Offset(mFriendlyName, BehaviorTemplate), "Human friendly name of this behavior");
         addProtectedField("description", TypeCaseString, Offset(mDescription, BehaviorTemplate), &setDescription, &getDescription, "The description of this behavior.\n");
         addField("behaviorType", TypeString, Offset(mBehaviorType, BehaviorTemplate), "?? Organizational keyword ??");
+        addProtectedField("nativeClass", TypeString, Offset(mNativeClass, BehaviorTemplate), &setNativeClass, &defaultProtectedGetFn, &writeNativeClass, "The NativeBehaviorInstance class used to create native instances of this behavior.");
     endGroup("Behavior");
 
     Parent::initPersistFields();
@@ -83,7 +87,26 @@ void BehaviorTemplate::initPersistFields()
 BehaviorInstance* BehaviorTemplate::createInstance( void )
 {
     // Create behavior instance.
-    BehaviorInstance* pBehavior = new BehaviorInstance( this );
+    BehaviorInstance* pBehavior = NULL;
+    
+    // Is this a native behavior?
+    if ( isNative() )
+    {
+        // Yes, so create the native instance.
+        NativeBehaviorInstance* pNativeBehavior = dynamic_cast<NativeBehaviorInstance*>( ConsoleObject::create( mNativeClass ) );
+
+        // Sanity!
+        AssertFatal( pNativeBehavior != NULL, "BehaviorTemplate::createInstance() - Native class is not a NativeBehaviorInstance." );
+
+        // Initialize from this template.
+        pNativeBehavior->initializeTemplate( this );
+
+        pBehavior = pNativeBehavior;
+    }
+    else
+    {
+        pBehavior = new BehaviorInstance( this );
+    }
 
     // Register object.
     if( pBehavior->registerObject() )
@@ -96,6 +119,60 @@ BehaviorInstance* BehaviorTemplate::createInstance( void )
 
 //-----------------------------------------------------------------------------
 
+bool BehaviorTemplate::setNativeClass( const char* pNativeClass )
+{
+    // Clear the native class if none specified.
+    if ( pNativeClass == NULL || *pNativeClass == 0 )
+    {
+        mNativeClass = StringTable->EmptyString;
+        return true;
+    }
+
+    // Find the native class.
+    AbstractClassRep* pClassRep = AbstractClassRep::findClassRep( pNativeClass );
+    AbstractClassRep* pNativeBaseRep = NativeBehaviorInstance::getStaticClassRep();
+
+    // Is the class a native behavior?
+    if ( pClassRep == NULL || !pClassRep->isClass( pNativeBaseRep ) || pClassRep == pNativeBaseRep )
+    {
+        // No, so warn.
+        Con::warnf("Behavior template '%s' cannot use native class '%s' as it is not derived from NativeBehaviorInstance.", mFriendlyName, pNativeClass );
+        return false;
+    }
+
+    mNativeClass = StringTable->insert( pClassRep->getClassName() );
+
+    // Create a prototype to fetch the default field values.
+    NativeBehaviorInstance* pPrototype = dynamic_cast<NativeBehaviorInstance*>( pClassRep->create() );
+
+    // Expose the typed fields declared by the native class as behavior fields.
+    const AbstractClassRep::FieldList& fieldList = pClassRep->mFieldList;
+    for( S32 index = 0; index < fieldList.size(); ++index )
+    {
+        // Fetch field.
+        const AbstractClassRep::Field& field = fieldList[index];
+
+        // Skip groups and fields declared by the base classes.
+        if ( field.type >= AbstractClassRep::StartGroupFieldType || pNativeBaseRep->findField( field.pFieldname ) != NULL )
+            continue;
+
+        // Skip if already defined.
+        if ( hasBehaviorField( field.pFieldname ) )
+            continue;
+
+        // Fetch the field type.
+        ConsoleBaseType* pFieldType = ConsoleBaseType::getType( field.type );
+
+        addBehaviorField( field.pFieldname, field.pFieldDocs, pFieldType != NULL ? pFieldType->getTypeName() : NULL, pPrototype->getDataField( field.pFieldname, NULL ) );
+    }
+
+    delete pPrototype;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
 bool BehaviorTemplate::addBehaviorField( const char* name, const char* description, const char* type, const char* defaultValue, const char* userData )
 {
     // Does the behavior already have the field?
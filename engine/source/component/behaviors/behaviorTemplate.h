@@ -33,9 +33,14 @@
 
 //-----------------------------------------------------------------------------
 
+class NativeBehaviorInstance;
+
+//-----------------------------------------------------------------------------
+
 class BehaviorTemplate : public SimObject
 {
    typedef SimObject Parent;
+   friend class NativeBehaviorBatch;
 
 public:
     struct BehaviorField
@@ -105,6 +110,11 @@ public:
     inline StringTableEntry getDescription( void ) const { return mDescription; }
     inline StringTableEntry getBehaviorType( void ) const { return mBehaviorType; }
 
+    /// Native class.
+    bool setNativeClass( const char* pNativeClass );
+    inline StringTableEntry getNativeClass( void ) const { return mNativeClass; }
+    inline bool isNative( void ) const { return mNativeClass != StringTable->EmptyString; }
+
     /// Fields.
     bool addBehaviorField( const char* fieldName, const char* description, const char* type, const char* defaultValue = NULL, const char* userData = NULL );
     inline U32 getBehaviorFieldCount( void ) const { return mFields.size(); };
@@ -169,6 +179,7 @@ protected:
     StringTableEntry mFriendlyName;
     StringTableEntry mDescription;   
     StringTableEntry mBehaviorType;
+    StringTableEntry mNativeClass;
 
     Vector<BehaviorField> mFields;
     Vector<BehaviorPortInput> mPortInputs;
@@ -177,6 +188,12 @@ protected:
 
     static bool setDescription(void* obj, const char* data) { static_cast<BehaviorTemplate *>(obj)->mDescription = data ? StringTable->insert(data) : StringTable->EmptyString; return false; }
     static const char* getDescription(void* obj, const char* data) { return static_cast<BehaviorTemplate *>(obj)->mDescription; }
+    static bool setNativeClass(void* obj, const char* data) { static_cast<BehaviorTemplate *>(obj)->setNativeClass( data ); return false; }
+    static bool writeNativeClass( void* obj, StringTableEntry pFieldName ) { return static_cast<BehaviorTemplate *>(obj)->isNative(); }
+
+private:
+    /// Native instances queued for a batched update.
+    Vector<NativeBehaviorInstance*> mNativeUpdateBatch;
 };
 
 #endif // _BEHAVIORTEMPLATE_H_
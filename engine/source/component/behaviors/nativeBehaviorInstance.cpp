@@ -0,0 +1,108 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "component/behaviors/nativeBehaviorInstance.h"
+#include "component/behaviors/behaviorTemplate.h"
+#include "component/behaviors/behaviorComponent.h"
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+IMPLEMENT_CONOBJECT(NativeBehaviorInstance);
+
+//-----------------------------------------------------------------------------
+
+void NativeBehaviorInstance::copyNativeFieldsTo( NativeBehaviorInstance* pInstance )
+{
+    // Sanity!
+    AssertFatal( pInstance != NULL && pInstance->getClassRep() == getClassRep(), "NativeBehaviorInstance::copyNativeFieldsTo() - Instance is not the same native class." );
+
+    // Fetch the base class rep.
+    AbstractClassRep* pNativeBaseRep = NativeBehaviorInstance::getStaticClassRep();
+
+    // Iterate the fields.
+    const AbstractClassRep::FieldList& fieldList = getClassRep()->mFieldList;
+    for( S32 index = 0; index < fieldList.size(); ++index )
+    {
+        // Fetch field.
+        const AbstractClassRep::Field& field = fieldList[index];
+
+        // Skip groups and fields declared by the base classes.
+        if ( field.type >= AbstractClassRep::StartGroupFieldType || pNativeBaseRep->findField( field.pFieldname ) != NULL )
+            continue;
+
+        pInstance->setDataField( field.pFieldname, NULL, getDataField( field.pFieldname, NULL ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void NativeBehaviorInstance::updateBatch( NativeBehaviorInstance* const* ppInstances, const U32 instanceCount, const F32 elapsedTime )
+{
+    for ( U32 index = 0; index < instanceCount; ++index )
+    {
+        ppInstances[index]->onUpdate( elapsedTime );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void NativeBehaviorBatch::queue( BehaviorComponent* pComponent )
+{
+    // Fetch the native behaviors.
+    const Vector<NativeBehaviorInstance*>& nativeBehaviors = pComponent->getNativeBehaviors();
+
+    for ( S32 index = 0; index < nativeBehaviors.size(); ++index )
+    {
+        NativeBehaviorInstance* pInstance = nativeBehaviors[index];
+        BehaviorTemplate* pTemplate = pInstance->getTemplate();
+
+        // Track the template the first time it is seen.
+        if ( pTemplate->mNativeUpdateBatch.size() == 0 )
+            mTemplates.push_back( pTemplate );
+
+        pTemplate->mNativeUpdateBatch.push_back( pInstance );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void NativeBehaviorBatch::update( const F32 elapsedTime )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(NativeBehaviorBatch_Update);
+
+    for ( S32 index = 0; index < mTemplates.size(); ++index )
+    {
+        BehaviorTemplate* pTemplate = mTemplates[index];
+        Vector<NativeBehaviorInstance*>& instances = pTemplate->mNativeUpdateBatch;
+
+        // Update the template instances in a single batch.
+        instances.first()->updateBatch( instances.address(), instances.size(), elapsedTime );
+
+        instances.clear();
+    }
+
+    mTemplates.clear();
+}
@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+#ifndef _NATIVE_BEHAVIORINSTANCE_H_
+#define _NATIVE_BEHAVIORINSTANCE_H_
+
+#ifndef _BEHAVIORINSTANCE_H_
+#include "behaviorInstance.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A behavior instance implemented in C++.
+///
+/// Native behaviors are created by a BehaviorTemplate whose "nativeClass" names a class derived from this one.
+/// Their fields are declared as typed persistent fields stored inline in the instance rather than as dynamic
+/// string fields although they are still read and written by name so TAML and script access is unchanged.
+/// Owners batch the update of all native instances of the same template into a single "updateBatch" call.
+///
+/// NOTE: Instances must not be deleted during an update; use deferred deletion instead.
+class NativeBehaviorInstance : public BehaviorInstance
+{
+    typedef BehaviorInstance Parent;
+
+public:
+    NativeBehaviorInstance() {}
+    virtual ~NativeBehaviorInstance() {}
+
+    /// Called when added to or removed from a behavior component.
+    virtual void onBehaviorAdd( void ) {}
+    virtual void onBehaviorRemove( void ) {}
+
+    /// Copy the typed fields declared by the native class to another instance of the same class.
+    void copyNativeFieldsTo( NativeBehaviorInstance* pInstance );
+
+    /// Update a single instance.
+    virtual void onUpdate( const F32 elapsedTime ) {}
+
+    /// Update all the queued instances of this instances template.
+    /// This is called on the first instance only and by default calls "onUpdate" on each instance.
+    virtual void updateBatch( NativeBehaviorInstance* const* ppInstances, const U32 instanceCount, const F32 elapsedTime );
+
+    DECLARE_CONOBJECT(NativeBehaviorInstance);
+};
+
+//-----------------------------------------------------------------------------
+
+/// Gathers native behavior instances by template so that each template is updated in a single batch.
+class NativeBehaviorBatch
+{
+private:
+    Vector<BehaviorTemplate*> mTemplates;
+
+public:
+    NativeBehaviorBatch() { VECTOR_SET_ASSOCIATION( mTemplates ); }
+
+    /// Queue the native behaviors of the specified component.
+    void queue( BehaviorComponent* pComponent );
+
+    /// Update all the queued behaviors then clear the batch.
+    void update( const F32 elapsedTime );
+};
+
+#endif // _NATIVE_BEHAVIORINSTANCE_H_
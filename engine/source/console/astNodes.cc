@@ -68,20 +68,20 @@ using namespace Compiler;
 void StmtNode::addBreakCount()
 {
    #ifndef TORQUE_EXTRA_BREAKLINES      
-   if(CodeBlock::smInFunction)
+   if(getCompilerContext()->inFunction)
    #endif
-      CodeBlock::smBreakLineCount++;
+      getCompilerContext()->breakLineCount++;
 }
 
 void StmtNode::addBreakLine(U32 ip)
 {
    #ifndef TORQUE_EXTRA_BREAKLINES      
-   if(CodeBlock::smInFunction)
+   if(getCompilerContext()->inFunction)
    {
    #endif
 
-      U32 line = CodeBlock::smBreakLineCount * 2;
-      CodeBlock::smBreakLineCount++;
+      U32 line = getCompilerContext()->breakLineCount * 2;
+      getCompilerContext()->breakLineCount++;
 
       if(getBreakCodeBlock()->lineBreakPairs)
       {
@@ -1730,7 +1730,7 @@ U32 FunctionDeclStmtNode::precompileStmt(U32)
    for(VarNode *walk = args; walk; walk = (VarNode *)((StmtNode*)walk)->getNext())
       argc++;
    
-   CodeBlock::smInFunction = true;
+   getCompilerContext()->inFunction = true;
    
    precompileIdent(fnName);
    precompileIdent(nameSpace);
@@ -1742,7 +1742,7 @@ U32 FunctionDeclStmtNode::precompileStmt(U32)
       addBreakCount();   
    #endif
 
-   CodeBlock::smInFunction = false;
+   getCompilerContext()->inFunction = false;
 
    setCurrentStringTable(&getGlobalStringTable());
    setCurrentFloatTable(&getGlobalFloatTable());
@@ -1769,14 +1769,14 @@ U32 FunctionDeclStmtNode::compileStmt(U32 *codeStream, U32 ip, U32, U32)
       STEtoCode(walk->varName, ip, codeStream);
       ip += 2;
    }
-   CodeBlock::smInFunction = true;
+   getCompilerContext()->inFunction = true;
    ip = compileBlock(stmts, codeStream, ip, 0, 0);
 
    #ifdef TORQUE_EXTRA_BREAKLINES      
       addBreakLine(ip);   
    #endif
 
-   CodeBlock::smInFunction = false;
+   getCompilerContext()->inFunction = false;
    codeStream[ip++] = OP_RETURN;
    return ip;
 }
\ No newline at end of file
@@ -33,8 +33,6 @@
 
 using namespace Compiler;
 
-bool           CodeBlock::smInFunction = false;
-U32            CodeBlock::smBreakLineCount = 0;
 CodeBlock *    CodeBlock::smCodeBlockList = NULL;
 CodeBlock *    CodeBlock::smCurrentCodeBlock = NULL;
 ConsoleParser *CodeBlock::smCurrentParser = NULL;
@@ -52,6 +50,7 @@ CodeBlock::CodeBlock()
    breakListSize = 0;
 
    refCount = 0;
+   cached = false;
    code = NULL;
    name = NULL;
    fullPath = NULL;
@@ -475,13 +474,48 @@ bool CodeBlock::read(StringTableEntry fileName, Stream &st)
 }
 
 
+const char *CodeBlock::getCompiledFileName(const char *scriptFile, char *buffer, U32 bufferSize)
+{
+   // If the script file extention is '.ed.cs' then compile it to a different compiled extention
+   bool isEditorScript = false;
+   const char *ext = dStrrchr( scriptFile, '.' );
+   if( ext && ( dStricmp( ext, ".cs" ) == 0 || dStricmp( ext, ".gui" ) == 0 ) )
+   {
+      const char* ext2 = ext - 3;
+      if( ext2 >= scriptFile && ( dStricmp( ext2, ".ed.cs" ) == 0 || dStricmp( ext2, ".ed.gui" ) == 0 ) )
+         isEditorScript = true;
+   }
+
+   dStrcpyl(buffer, bufferSize, scriptFile, isEditorScript ? ".edso" : ".dso", NULL);
+   return buffer;
+}
+
 bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, const char *script)
 {
-   gSyntaxError = false;
+   consoleAllocReset();
+
+   StmtNode *statements;
+   if(!parse(fileName, script, statements))
+   {
+      consoleAllocReset();
+      return false;
+   }   
+
+   FileStream st;
+   if(!ResourceManager->openFileForWrite(st, codeFileName)) 
+      return false;
+
+   compileToStream(st, statements);
 
    consoleAllocReset();
+   st.close();
+
+   return true;
+}
 
-   STEtoCode = compileSTEtoCode;
+bool CodeBlock::parse(StringTableEntry fileName, const char *script, StmtNode *&statements)
+{
+   gSyntaxError = false;
 
    statementList = NULL;
 
@@ -494,31 +528,34 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    smCurrentParser->restart(NULL);
    smCurrentParser->parse();
 
-   if(gSyntaxError)
-   {
-      consoleAllocReset();
-      return false;
-   }   
+   statements = statementList;
+   statementList = NULL;
+
+   return !gSyntaxError;
+}
+
+void CodeBlock::compileToStream(Stream &st, StmtNode *statements)
+{
+   CompilerContext *context = getCompilerContext();
+
+   setSTEtoCode(compileSTEtoCode);
 
-   FileStream st;
-   if(!ResourceManager->openFileForWrite(st, codeFileName)) 
-      return false;
    st.write(DSO_VERSION);
 
    // Reset all our value tables...
    resetTables();
 
-   smInFunction = false;
-   smBreakLineCount = 0;
+   context->inFunction = false;
+   context->breakLineCount = 0;
    setBreakCodeBlock(this);
 
-   if(statementList)
-      codeSize = precompileBlock(statementList, 0) + 1;
+   if(statements)
+      codeSize = precompileBlock(statements, 0) + 1;
    else
       codeSize = 1;
 
-   lineBreakPairCount = smBreakLineCount;
-   code = new U32[codeSize + smBreakLineCount * 2];
+   lineBreakPairCount = context->breakLineCount;
+   code = new U32[codeSize + context->breakLineCount * 2];
    lineBreakPairs = code + codeSize;
 
    // Write string table data...
@@ -529,10 +566,10 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    getGlobalFloatTable().write(st);
    getFunctionFloatTable().write(st);
 
-   smBreakLineCount = 0;
+   context->breakLineCount = 0;
    U32 lastIp;
-   if(statementList)
-      lastIp = compileBlock(statementList, code, 0, 0, 0);
+   if(statements)
+      lastIp = compileBlock(statements, code, 0, 0, 0);
    else
       lastIp = 0;
 
@@ -540,7 +577,7 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
       Con::errorf(ConsoleLogEntry::General, "CodeBlock::compile - precompile size mismatch, a precompile/compile function pair is probably mismatched.");
 
    code[lastIp++] = OP_RETURN;
-   U32 totSize = codeSize + smBreakLineCount * 2;
+   U32 totSize = codeSize + context->breakLineCount * 2;
    st.write(codeSize);
    st.write(lineBreakPairCount);
 
@@ -562,16 +599,22 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
       st.write(code[i]);
 
    getIdentTable().write(st);
+}
 
-   consoleAllocReset();
-   st.close();
+const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string, bool noCalls, int setFrame)
+{
+   if(!compileScript(fileName, string))
+   {
+      delete this;
+      return "";
+   }
 
-   return true;
+   return exec(0, fileName, NULL, 0, 0, noCalls, NULL, setFrame);
 }
 
-const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string, bool noCalls, int setFrame)
+bool CodeBlock::compileScript(StringTableEntry fileName, const char *string)
 {
-   STEtoCode = evalSTEtoCode;
+   setSTEtoCode(evalSTEtoCode);
    consoleAllocReset();
 
    name = fileName;
@@ -615,20 +658,17 @@ const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string
    smCurrentParser->parse();
 
    if(!statementList)
-   {
-      delete this;
-      return "";
-   }
+      return false;
 
    resetTables();
 
-   smInFunction = false;
-   smBreakLineCount = 0;
+   getCompilerContext()->inFunction = false;
+   getCompilerContext()->breakLineCount = 0;
    setBreakCodeBlock(this);
 
    codeSize = precompileBlock(statementList, 0) + 1;
 
-   lineBreakPairCount = smBreakLineCount;
+   lineBreakPairCount = getCompilerContext()->breakLineCount;
 
    globalStrings   = getGlobalStringTable().build();
    functionStrings = getFunctionStringTable().build();
@@ -638,7 +678,7 @@ const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string
    code = new U32[codeSize + lineBreakPairCount * 2];
    lineBreakPairs = code + codeSize;
 
-   smBreakLineCount = 0;
+   getCompilerContext()->breakLineCount = 0;
    U32 lastIp = compileBlock(statementList, code, 0, 0, 0);
    code[lastIp++] = OP_RETURN;
    
@@ -650,7 +690,7 @@ const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string
    if(lastIp != codeSize)
       Con::warnf(ConsoleLogEntry::General, "precompile size mismatch");
 
-   return exec(0, fileName, NULL, 0, 0, noCalls, NULL, setFrame);
+   return true;
 }
 
 //-------------------------------------------------------------------------
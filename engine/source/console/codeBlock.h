@@ -39,8 +39,6 @@ private:
    static CodeBlock* smCurrentCodeBlock;
    
 public:
-   static U32                       smBreakLineCount;
-   static bool                      smInFunction;
    static Compiler::ConsoleParser * smCurrentParser;
 
    static CodeBlock* getCurrentBlock()
@@ -75,6 +73,11 @@ public:
    U32 *code;
 
    U32 refCount;
+
+   /// Set whilst the block is held by the CodeBlockCache so that executing it
+   /// outside of a function keeps the global tables for the next time.
+   bool cached;
+
    U32 lineBreakPairCount;
    U32 *lineBreakPairs;
    U32 breakListSize;
@@ -105,11 +108,41 @@ public:
    const char *getFileLine(U32 ip);
 
    bool read(StringTableEntry fileName, Stream &st);
+
+   /// Returns the name of the DSO a script compiles to: ".edso" for editor
+   /// scripts (".ed.cs" and ".ed.gui") and ".dso" otherwise.
+   static const char *getCompiledFileName(const char *scriptFile, char *buffer, U32 bufferSize);
    bool compile(const char *dsoName, StringTableEntry fileName, const char *script);
 
+   /// Parses a script into the current compiler context.  The parser is not
+   /// reentrant so only one thread may parse at a time.
+   ///
+   /// @param fileName The file name used to pick the parser and report errors.
+   /// @param script The script code to parse.
+   /// @param statements Set to the parsed statements, which live in the
+   /// allocator of the current compiler context.
+   /// @return False if the script has a syntax error.
+   static bool parse(StringTableEntry fileName, const char *script, StmtNode *&statements);
+
+   /// Generates the code for parsed statements and writes it in the DSO
+   /// format.  Uses only the current compiler context so it may run on any
+   /// thread, with each thread compiling into its own context.
+   void compileToStream(Stream &st, StmtNode *statements);
+
    void incRefCount();
    void decRefCount();
 
+   /// Compiles a block of script storing the compiled code in this CodeBlock
+   /// without executing it. If there is no filename breakpoints will not be
+   /// generated and the CodeBlock will not be added to the linked list of
+   /// loaded CodeBlocks.
+   ///
+   /// @param fileName The file name, including path and extension, for the 
+   /// block of code or an empty string.
+   /// @param script The script code to compile.
+   /// @return False if the script contains no executable statements.
+   bool compileScript(StringTableEntry fileName, const char *script);
+
    /// Compiles and executes a block of script storing the compiled code in this
    /// CodeBlock. If there is no filename breakpoints will not be generated and 
    /// the CodeBlock will not be added to the linked list of loaded CodeBlocks. 
@@ -0,0 +1,232 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "console/codeBlockCache.h"
+#include "console/codeBlock.h"
+#include "console/consoleInternal.h"
+#include "string/stringTable.h"
+#include "debug/profiler.h"
+
+// Script bindings.
+#include "codeBlockCache_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+struct CodeBlockCache::Entry
+{
+   U32         mHash;
+   char*       mpScript;
+   CodeBlock*  mpCodeBlock;
+   U32         mPackageSequence;   ///< The package sequence the code was compiled with.
+   Entry*      mpNextInBucket;
+   Entry*      mpMoreRecent;
+   Entry*      mpLessRecent;
+};
+
+CodeBlockCache::Entry* CodeBlockCache::smBuckets[CodeBlockCache::BucketCount];
+CodeBlockCache::Entry* CodeBlockCache::smpMostRecent = NULL;
+CodeBlockCache::Entry* CodeBlockCache::smpLeastRecent = NULL;
+S32 CodeBlockCache::smCapacity = CodeBlockCache::DefaultCapacity;
+U32 CodeBlockCache::smCount = 0;
+U32 CodeBlockCache::smHits = 0;
+U32 CodeBlockCache::smMisses = 0;
+U32 CodeBlockCache::smEvictions = 0;
+
+//-----------------------------------------------------------------------------
+
+const char* CodeBlockCache::exec( const char* script, const bool noCalls, const S32 setFrame )
+{
+   // Compile without caching if disabled or the script is too long to be worth it.
+   const U32 scriptLength = dStrlen( script );
+   if ( smCapacity <= 0 || scriptLength > MaxScriptLength )
+   {
+      CodeBlock* pCodeBlock = new CodeBlock();
+      return pCodeBlock->compileExec( NULL, script, noCalls, setFrame );
+   }
+
+   // Debug Profiling.
+   PROFILE_START(CodeBlockCache_Exec);
+
+   const U32 hash = _StringTable::hashStringn( script, scriptLength );
+
+   // Use the cached code if it was compiled since packages last changed.
+   Entry* pEntry = find( script, hash );
+   if ( pEntry != NULL && pEntry->mPackageSequence != Namespace::mPackageSequence )
+   {
+      remove( pEntry );
+      pEntry = NULL;
+   }
+
+   CodeBlock* pCodeBlock;
+   if ( pEntry != NULL )
+   {
+      smHits++;
+      unlinkRecent( pEntry );
+      linkRecent( pEntry );
+      pCodeBlock = pEntry->mpCodeBlock;
+   }
+   else
+   {
+      smMisses++;
+
+      // Compile the script.
+      pCodeBlock = new CodeBlock();
+      if ( !pCodeBlock->compileScript( NULL, script ) )
+      {
+         delete pCodeBlock;
+         PROFILE_END();
+         return "";
+      }
+
+      insert( script, hash, pCodeBlock );
+   }
+
+   PROFILE_END();
+
+   return pCodeBlock->exec( 0, NULL, NULL, 0, 0, noCalls, NULL, setFrame );
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::clear( void )
+{
+   while ( smpLeastRecent != NULL )
+      remove( smpLeastRecent );
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::setCapacity( const S32 capacity )
+{
+   smCapacity = capacity;
+
+   // Evict down to the new capacity.
+   while ( smpLeastRecent != NULL && (S32)smCount > getMax( smCapacity, 0 ) )
+   {
+      remove( smpLeastRecent );
+      smEvictions++;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::resetStats( void )
+{
+   smHits = 0;
+   smMisses = 0;
+   smEvictions = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+CodeBlockCache::Entry* CodeBlockCache::find( const char* script, const U32 hash )
+{
+   for ( Entry* pEntry = smBuckets[hash & (BucketCount - 1)]; pEntry != NULL; pEntry = pEntry->mpNextInBucket )
+   {
+      if ( pEntry->mHash == hash && dStrcmp( pEntry->mpScript, script ) == 0 )
+         return pEntry;
+   }
+
+   return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::insert( const char* script, const U32 hash, CodeBlock* pCodeBlock )
+{
+   // Make room.
+   while ( smpLeastRecent != NULL && (S32)smCount >= smCapacity )
+   {
+      remove( smpLeastRecent );
+      smEvictions++;
+   }
+
+   // Hold a reference whilst cached.
+   pCodeBlock->cached = true;
+   pCodeBlock->incRefCount();
+
+   Entry* pEntry = new Entry;
+   pEntry->mHash = hash;
+   pEntry->mpScript = new char[dStrlen( script ) + 1];
+   dStrcpy( pEntry->mpScript, script );
+   pEntry->mpCodeBlock = pCodeBlock;
+   pEntry->mPackageSequence = Namespace::mPackageSequence;
+
+   // Add to the bucket.
+   Entry** ppBucket = &smBuckets[hash & (BucketCount - 1)];
+   pEntry->mpNextInBucket = *ppBucket;
+   *ppBucket = pEntry;
+
+   linkRecent( pEntry );
+   smCount++;
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::remove( Entry* pEntry )
+{
+   // Remove from the bucket.
+   Entry** ppWalk = &smBuckets[pEntry->mHash & (BucketCount - 1)];
+   while ( *ppWalk != pEntry )
+      ppWalk = &(*ppWalk)->mpNextInBucket;
+   *ppWalk = pEntry->mpNextInBucket;
+
+   unlinkRecent( pEntry );
+   smCount--;
+
+   // Release the code.  It is only deleted here if it is not executing.
+   pEntry->mpCodeBlock->decRefCount();
+
+   delete [] pEntry->mpScript;
+   delete pEntry;
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::unlinkRecent( Entry* pEntry )
+{
+   if ( pEntry->mpMoreRecent != NULL )
+      pEntry->mpMoreRecent->mpLessRecent = pEntry->mpLessRecent;
+   else
+      smpMostRecent = pEntry->mpLessRecent;
+
+   if ( pEntry->mpLessRecent != NULL )
+      pEntry->mpLessRecent->mpMoreRecent = pEntry->mpMoreRecent;
+   else
+      smpLeastRecent = pEntry->mpMoreRecent;
+}
+
+//-----------------------------------------------------------------------------
+
+void CodeBlockCache::linkRecent( Entry* pEntry )
+{
+   pEntry->mpMoreRecent = NULL;
+   pEntry->mpLessRecent = smpMostRecent;
+
+   if ( smpMostRecent != NULL )
+      smpMostRecent->mpMoreRecent = pEntry;
+   else
+      smpLeastRecent = pEntry;
+
+   smpMostRecent = pEntry;
+}
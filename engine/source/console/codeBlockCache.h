@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CODEBLOCK_CACHE_H_
+#define _CODEBLOCK_CACHE_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+class CodeBlock;
+
+/// Cache of compiled code for evaluated script strings.
+///
+/// Con::evaluate(), Con::evaluatef() and the eval() function would otherwise lex, parse
+/// and compile the same strings every time they are evaluated.  Compiled CodeBlocks are
+/// kept keyed by their source text and the least recently used are released once the
+/// cache is full.  The cache holds a reference to each block so one that is evicted
+/// whilst executing is only deleted when it finishes.
+///
+/// Compiled code caches function lookups.  Activating or deactivating a package moves
+/// functions between namespaces so blocks compiled before that are recompiled when next used.
+class CodeBlockCache
+{
+public:
+   enum
+   {
+      DefaultCapacity = 256,
+      MaxScriptLength = 2048,  ///< Longer scripts are not cached.
+   };
+
+   /// Compile, or find already compiled, and execute a script.
+   /// @param script The script code to execute.
+   /// @param noCalls Skips calling functions from the script.
+   /// @param setFrame A zero based index of the stack frame to execute the code with.
+   /// @return The result of the code executed or an empty string.
+   static const char* exec( const char* script, const bool noCalls, const S32 setFrame );
+
+   /// Release all the cached code.
+   static void clear( void );
+
+   /// The maximum number of scripts cached.  Zero disables caching.
+   static void setCapacity( const S32 capacity );
+   static inline S32 getCapacity( void ) { return smCapacity; }
+
+   static inline U32 getCount( void ) { return smCount; }
+   static inline U32 getHits( void ) { return smHits; }
+   static inline U32 getMisses( void ) { return smMisses; }
+   static inline U32 getEvictions( void ) { return smEvictions; }
+   static void resetStats( void );
+
+private:
+   struct Entry;
+
+   enum
+   {
+      BucketCount = 512,  ///< Must be a power of two.
+   };
+
+   static Entry* smBuckets[BucketCount];
+   static Entry* smpMostRecent;
+   static Entry* smpLeastRecent;
+   static S32 smCapacity;
+   static U32 smCount;
+   static U32 smHits;
+   static U32 smMisses;
+   static U32 smEvictions;
+
+   static Entry* find( const char* script, const U32 hash );
+   static void insert( const char* script, const U32 hash, CodeBlock* pCodeBlock );
+   static void remove( Entry* pEntry );
+   static void unlinkRecent( Entry* pEntry );
+   static void linkRecent( Entry* pEntry );
+};
+
+#endif // _CODEBLOCK_CACHE_H_
@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( CodeBlockCache, "Functions to manage the cache of compiled code for evaluated scripts.");
+
+/*! @addtogroup CodeBlockCache Evaluated Code Cache
+	@ingroup TorqueScriptFunctions
+	@{
+*/
+
+/*! Sets how many compiled scripts eval() and the engine keep for scripts evaluated again.
+    @param size The maximum number of scripts to cache. Zero disables the cache.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(setEvalCacheSize, ConsoleVoid, 2, 2, (size))
+{
+   CodeBlockCache::setCapacity( dAtoi(argv[1]) );
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets how many compiled scripts are kept for scripts evaluated again.
+    @return The maximum number of scripts cached.
+*/
+ConsoleFunctionWithDocs(getEvalCacheSize, ConsoleInt, 1, 1, ())
+{
+   return CodeBlockCache::getCapacity();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Releases all the cached compiled scripts.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(clearEvalCache, ConsoleVoid, 1, 1, ())
+{
+   CodeBlockCache::clear();
+}
+
+//-----------------------------------------------------------------------------
+
+/*! Gets the evaluated code cache statistics and optionally resets them.
+    @param reset Whether to reset the statistics after reading them. Optional: Defaults to false.
+    @return The hits, misses, evictions, cached script count and hit rate percentage separated by spaces.
+*/
+ConsoleFunctionWithDocs(getEvalCacheStats, ConsoleString, 1, 2, ([reset]))
+{
+   const U32 hits = CodeBlockCache::getHits();
+   const U32 misses = CodeBlockCache::getMisses();
+   const F32 hitRate = hits + misses > 0 ? 100.0f * hits / (hits + misses) : 0.0f;
+
+   char* pBuffer = Con::getReturnBuffer(64);
+   dSprintf( pBuffer, 64, "%d %d %d %d %.1f", hits, misses, CodeBlockCache::getEvictions(), CodeBlockCache::getCount(), hitRate );
+
+   if ( argc > 1 && dAtob(argv[1]) )
+      CodeBlockCache::resetStats();
+
+   return pBuffer;
+}
+
+ConsoleFunctionGroupEnd( CodeBlockCache );
+
+/*! @} */ // group CodeBlockCache
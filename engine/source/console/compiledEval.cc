@@ -1232,7 +1232,7 @@ breakContinue:
 
          case OP_LOADFIELD_UINT:
             if(curObject)
-               intStack[UINT+1] = U32(dAtoi(curObject->getDataField(curField, curFieldArray)));
+               intStack[UINT+1] = U32(curObject->getDataFieldInt(curField, curFieldArray));
             else
             {
                // The field is not being retrieved from an object. Maybe it's
@@ -1246,7 +1246,7 @@ breakContinue:
 
          case OP_LOADFIELD_FLT:
             if(curObject)
-               floatStack[FLT+1] = dAtof(curObject->getDataField(curField, curFieldArray));
+               floatStack[FLT+1] = curObject->getDataFieldFloat(curField, curFieldArray);
             else
             {
                // The field is not being retrieved from an object. Maybe it's
@@ -1274,11 +1274,12 @@ breakContinue:
             break;
 
          case OP_SAVEFIELD_UINT:
-            STR.setIntValue((U32)intStack[UINT]);
             if(curObject)
-               curObject->setDataField(curField, curFieldArray, STR.getStringValue());
+               curObject->setDataFieldInt(curField, curFieldArray, (S32)intStack[UINT]);
             else
             {
+               STR.setIntValue((U32)intStack[UINT]);
+
                // The field is not being set on an object. Maybe it's
                // a special accessor?
                setFieldComponent( prevObject, prevField, prevFieldArray, curField );
@@ -1287,11 +1288,12 @@ breakContinue:
             break;
 
          case OP_SAVEFIELD_FLT:
-            STR.setFloatValue(floatStack[FLT]);
             if(curObject)
-               curObject->setDataField(curField, curFieldArray, STR.getStringValue());
+               curObject->setDataFieldFloat(curField, curFieldArray, floatStack[FLT]);
             else
             {
+               STR.setFloatValue(floatStack[FLT]);
+
                // The field is not being set on an object. Maybe it's
                // a special accessor?
                setFieldComponent( prevObject, prevField, prevFieldArray, curField );
@@ -1760,7 +1762,7 @@ execFinished:
          Con::printf("%s", traceBuffer);
       }
    }
-   else
+   else if(!cached)
    {
       delete[] const_cast<char*>(globalStrings);
       delete[] globalFloats;
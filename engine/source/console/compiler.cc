@@ -58,17 +58,39 @@ namespace Compiler
 
    //------------------------------------------------------------
 
-   CompilerStringTable *gCurrentStringTable, gGlobalStringTable, gFunctionStringTable;
-   CompilerFloatTable  *gCurrentFloatTable,  gGlobalFloatTable,  gFunctionFloatTable;
-   DataChunker          gConsoleAllocator;
-   CompilerIdentTable   gIdentTable;
-   CodeBlock           *gCurBreakBlock;
+#if defined(_MSC_VER)
+#define COMPILER_THREAD_LOCAL __declspec(thread)
+#else
+#define COMPILER_THREAD_LOCAL __thread
+#endif
+
+   CompilerContext::CompilerContext()
+   {
+      globalStringTable.reset();
+      functionStringTable.reset();
+      globalFloatTable.reset();
+      functionFloatTable.reset();
+      identTable.reset();
+
+      currentStringTable = &globalStringTable;
+      currentFloatTable  = &globalFloatTable;
+      breakBlock         = NULL;
+      steToCode          = evalSTEtoCode;
+      breakLineCount     = 0;
+      inFunction         = false;
+   }
+
+   static CompilerContext gDefaultContext;
+   static COMPILER_THREAD_LOCAL CompilerContext *gCurrentContext = NULL;
+
+   CompilerContext *getCompilerContext()               { return gCurrentContext ? gCurrentContext : &gDefaultContext; }
+   void setCompilerContext(CompilerContext *context)   { gCurrentContext = context; }
 
    //------------------------------------------------------------
 
 
-   CodeBlock *getBreakCodeBlock()         { return gCurBreakBlock; }
-   void setBreakCodeBlock(CodeBlock *cb)  { gCurBreakBlock = cb;   }
+   CodeBlock *getBreakCodeBlock()         { return getCompilerContext()->breakBlock; }
+   void setBreakCodeBlock(CodeBlock *cb)  { getCompilerContext()->breakBlock = cb;   }
 
    //------------------------------------------------------------
    
@@ -89,38 +111,36 @@ namespace Compiler
       codeStream[ip+1] = 0;
    }
 
-   void (*STEtoCode)(StringTableEntry ste, U32 ip, U32 *codeStream) = evalSTEtoCode;
-
    //------------------------------------------------------------
 
    bool gSyntaxError = false;
 
    //------------------------------------------------------------
 
-   CompilerStringTable *getCurrentStringTable()  { return gCurrentStringTable;  }
-   CompilerStringTable &getGlobalStringTable()   { return gGlobalStringTable;   }
-   CompilerStringTable &getFunctionStringTable() { return gFunctionStringTable; }
+   CompilerStringTable *getCurrentStringTable()  { return getCompilerContext()->currentStringTable;  }
+   CompilerStringTable &getGlobalStringTable()   { return getCompilerContext()->globalStringTable;   }
+   CompilerStringTable &getFunctionStringTable() { return getCompilerContext()->functionStringTable; }
 
-   void setCurrentStringTable (CompilerStringTable* cst) { gCurrentStringTable  = cst; }
+   void setCurrentStringTable (CompilerStringTable* cst) { getCompilerContext()->currentStringTable  = cst; }
 
-   CompilerFloatTable *getCurrentFloatTable()    { return gCurrentFloatTable;   }
-   CompilerFloatTable &getGlobalFloatTable()     { return gGlobalFloatTable;    }
-   CompilerFloatTable &getFunctionFloatTable()   { return gFunctionFloatTable; }
+   CompilerFloatTable *getCurrentFloatTable()    { return getCompilerContext()->currentFloatTable;   }
+   CompilerFloatTable &getGlobalFloatTable()     { return getCompilerContext()->globalFloatTable;    }
+   CompilerFloatTable &getFunctionFloatTable()   { return getCompilerContext()->functionFloatTable; }
 
-   void setCurrentFloatTable (CompilerFloatTable* cst) { gCurrentFloatTable  = cst; }
+   void setCurrentFloatTable (CompilerFloatTable* cst) { getCompilerContext()->currentFloatTable  = cst; }
 
-   CompilerIdentTable &getIdentTable() { return gIdentTable; }
+   CompilerIdentTable &getIdentTable() { return getCompilerContext()->identTable; }
 
    void precompileIdent(StringTableEntry ident)
    {
       if(ident)
-         gGlobalStringTable.add(ident);
+         getGlobalStringTable().add(ident);
    }
 
    void resetTables()
    {
-      setCurrentStringTable(&gGlobalStringTable);
-      setCurrentFloatTable(&gGlobalFloatTable);
+      setCurrentStringTable(&getGlobalStringTable());
+      setCurrentFloatTable(&getGlobalFloatTable());
       getGlobalFloatTable().reset();
       getGlobalStringTable().reset();
       getFunctionFloatTable().reset();
@@ -128,8 +148,8 @@ namespace Compiler
       getIdentTable().reset();
    }
 
-   void *consoleAlloc(U32 size) { return gConsoleAllocator.alloc(size);  }
-   void consoleAllocReset()     { gConsoleAllocator.freeBlocks(); }
+   void *consoleAlloc(U32 size) { return getCompilerContext()->allocator.alloc(size);  }
+   void consoleAllocReset()     { getCompilerContext()->allocator.freeBlocks(); }
 
 }
 
@@ -260,7 +280,7 @@ void CompilerIdentTable::reset()
 
 void CompilerIdentTable::add(StringTableEntry ste, U32 ip)
 {
-   U32 index = gGlobalStringTable.add(ste, false);
+   U32 index = getGlobalStringTable().add(ste, false);
    Entry *newEntry = (Entry *) consoleAlloc(sizeof(Entry));
    newEntry->offset = index;
    newEntry->ip = ip;
@@ -28,6 +28,7 @@ class Stream;
 class DataChunker;
 
 #include "platform/platform.h"
+#include "memory/dataChunker.h"
 #include "console/ast.h"
 #include "console/codeBlock.h"
 
@@ -221,11 +222,38 @@ namespace Compiler
 #endif
    }
    
-   extern void (*STEtoCode)(StringTableEntry ste, U32 ip, U32 *codeStream);
+   typedef void (*STEtoCodeFunction)(StringTableEntry ste, U32 ip, U32 *codeStream);
 
    void evalSTEtoCode(StringTableEntry ste, U32 ip, U32 *codeStream);
    void compileSTEtoCode(StringTableEntry ste, U32 ip, U32 *codeStream);
 
+   //------------------------------------------------------------
+
+   /// Everything a compilation writes to: the AST arena, the string, float
+   /// and ident tables and the state of the code generation passes.
+   ///
+   /// The current context is per thread so that several scripts can be
+   /// compiled at once.  Threads that never set one share a default context.
+   struct CompilerContext
+   {
+      DataChunker          allocator;
+      CompilerStringTable *currentStringTable, globalStringTable, functionStringTable;
+      CompilerFloatTable  *currentFloatTable,  globalFloatTable,  functionFloatTable;
+      CompilerIdentTable   identTable;
+      CodeBlock           *breakBlock;
+      STEtoCodeFunction    steToCode;
+      U32                  breakLineCount;
+      bool                 inFunction;
+
+      CompilerContext();
+   };
+
+   CompilerContext *getCompilerContext();
+   void setCompilerContext(CompilerContext *context);
+
+   inline void STEtoCode(StringTableEntry ste, U32 ip, U32 *codeStream) { getCompilerContext()->steToCode(ste, ip, codeStream); }
+   inline void setSTEtoCode(STEtoCodeFunction function)                 { getCompilerContext()->steToCode = function; }
+
    CompilerStringTable *getCurrentStringTable();
    CompilerStringTable &getGlobalStringTable();
    CompilerStringTable &getFunctionStringTable();
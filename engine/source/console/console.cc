@@ -33,10 +33,13 @@
 #include "console/consoleTypes.h"
 #include "debug/telnetDebugger.h"
 #include "sim/simBase.h"
+#include "sim/simMainThreadQueue.h"
 #include "console/compiler.h"
 #include "string/stringStack.h"
 #include "component/dynamicConsoleMethodComponent.h"
 #include "memory/safeDelete.h"
+#include "console/consoleLogWriter.h"
+#include "console/codeBlockCache.h"
 #include <stdarg.h>
 
 #include "output_ScriptBinding.h"
@@ -193,10 +196,17 @@ namespace Con
 {
 
 static Vector<ConsumerCallback> gConsumers(__FILE__, __LINE__);
-static DataChunker consoleLogChunker;
+static DataChunker consoleLogChunkers[2];
+static U32 consoleLogChunkerIndex = 0;
 static Vector<ConsoleLogEntry> consoleLog(__FILE__, __LINE__);
 static bool consoleLogLocked;
 static bool logBufferEnabled=true;
+static S32 logBufferMaxLines = 10000;
+static S32 logRateLimit = 0;
+static U32 logRateWindowStart = 0;
+static U32 logRateCounts[ConsoleLogEntry::NUM_CLASS][ConsoleLogEntry::NUM_TYPE];
+static U32 logSuppressedLines = 0;
+static U32 logTrimmedLines = 0;
 static S32 printLevel = 10;
 static FileStream consoleLogFile;
 static const char *defLogFileName = "console.log";
@@ -212,9 +222,8 @@ static SimObjectPtr<SimObject> tabObject;
 static U32 completionBaseStart;
 static U32 completionBaseLen;
 
-#ifdef TORQUE_MULTITHREAD
-static ThreadIdent gMainThreadID = -1;
-#endif
+static ThreadIdent gMainThreadID = 0;
+static bool gMainThreadIDSet = false;
 
 /// Current script file name and root, these are registered as
 /// console variables.
@@ -236,10 +245,9 @@ void init()
    gWarnUndefinedScriptVariables = false;
    sLogMutex                     = new Mutex;
 
-#ifdef TORQUE_MULTITHREAD
    // Note the main thread ID.
    gMainThreadID = ThreadManager::getCurrentThreadId();
-#endif
+   gMainThreadIDSet = true;
 
    // Initialize subsystems.
    Namespace::init();
@@ -251,6 +259,8 @@ void init()
    // Variables
    setVariable("Con::prompt", "% ");
    addVariable("Con::logBufferEnabled", TypeBool, &logBufferEnabled);
+   addVariable("Con::logBufferMaxLines", TypeS32, &logBufferMaxLines);
+   addVariable("Con::logRateLimit", TypeS32, &logRateLimit);
    addVariable("Con::printLevel", TypeS32, &printLevel);
    addVariable("Con::warnUndefinedVariables", TypeBool, &gWarnUndefinedScriptVariables);
 
@@ -272,7 +282,9 @@ void shutdown()
    AssertFatal(active == true, "Con::shutdown should only be called once.");
    active = false;
 
+   ConsoleLogWriter::stop();
    consoleLogFile.close();
+   CodeBlockCache::clear();
    Namespace::shutdown();
 
    SAFE_DELETE( sLogMutex );
@@ -285,12 +297,11 @@ bool isActive()
 
 bool isMainThread()
 {
-#ifdef TORQUE_MULTITHREAD
+   // Only the main thread runs before the console is initialized.
+   if(!gMainThreadIDSet)
+      return true;
+
    return ThreadManager::isCurrentThread(gMainThreadID);
-#else
-   // If we're single threaded we're always in the main thread.
-   return true;
-#endif
 }
 
 //--------------------------------------
@@ -433,6 +444,40 @@ static void log(const char *string)
       return;
    }
 
+   // In asynchronous mode, queue everything for the writer thread.
+   if (ConsoleLogWriter::isActive())
+   {
+      if (newLogFile)
+      {
+         // Make a header.
+         Platform::LocalTime lt;
+         Platform::getLocalTime(lt);
+         char buffer[128];
+         dSprintf(buffer, sizeof(buffer), "//-------------------------- %d/%d/%d -- %02d:%02d:%02d -----",
+               lt.month + 1,
+               lt.monthday,
+               lt.year + 1900,
+               lt.hour,
+               lt.min,
+               lt.sec);
+         ConsoleLogWriter::writeLine(buffer);
+         newLogFile = false;
+         if (consoleLogMode & 0x4) 
+         {
+            // Dump anything that has been printed to the console so far.
+            consoleLogMode -= 0x4;
+            U32 size, line;
+            ConsoleLogEntry *log;
+            getLockLog(log, size);
+            for (line = 0; line < size; line++) 
+               ConsoleLogWriter::writeLine(log[line].mString);
+            unlockLog();
+         }
+      }
+      ConsoleLogWriter::writeLine(string);
+      return;
+   }
+
    // In mode 1, we open, append, close on each log write.
    if ((consoleLogMode & 0x3) == 1) 
    {
@@ -491,12 +536,67 @@ void cls( void )
 {
    if(consoleLogLocked)
       return;
-   consoleLogChunker.freeBlocks();
+   consoleLogChunkers[0].freeBlocks();
+   consoleLogChunkers[1].freeBlocks();
    consoleLog.setSize(0);
 };
 
 //------------------------------------------------------------------------------
 
+static void trimLog()
+{
+   PROFILE_SCOPE(Con_TrimLog);
+
+   // Keep the newest half of the history.
+   const S32 keepCount = logBufferMaxLines / 2;
+   const S32 trimCount = consoleLog.size() - keepCount;
+
+   // Copy the kept strings into the other chunker so the old one can be freed whole.
+   DataChunker &oldChunker = consoleLogChunkers[consoleLogChunkerIndex];
+   consoleLogChunkerIndex ^= 1;
+   DataChunker &newChunker = consoleLogChunkers[consoleLogChunkerIndex];
+   newChunker.freeBlocks();
+
+   for (S32 i = 0; i < keepCount; i++)
+   {
+      ConsoleLogEntry &entry = consoleLog[trimCount + i];
+      char *string = (char *)newChunker.alloc(dStrlen(entry.mString) + 1);
+      dStrcpy(string, entry.mString);
+      entry.mString = string;
+      consoleLog[i] = entry;
+   }
+   consoleLog.setSize(keepCount);
+   oldChunker.freeBlocks();
+
+   logTrimmedLines += trimCount;
+}
+
+//------------------------------------------------------------------------------
+
+static bool rateLimitLog(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type)
+{
+   // Finish if not limiting.
+   if (logRateLimit <= 0 || level >= ConsoleLogEntry::NUM_CLASS || type >= ConsoleLogEntry::NUM_TYPE)
+      return false;
+
+   // Start a new window each second.
+   const U32 time = Platform::getRealMilliseconds();
+   if (time - logRateWindowStart >= 1000)
+   {
+      logRateWindowStart = time;
+      dMemset(logRateCounts, 0, sizeof(logRateCounts));
+   }
+
+   // Suppress lines over the limit for their level and type.
+   if (++logRateCounts[level][type] <= (U32)logRateLimit)
+      return false;
+
+   logSuppressedLines++;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
 #if defined( _MSC_VER )  
 #include <windows.h>  
 
@@ -526,6 +626,10 @@ static void _outputDebugString(char* pString)
 
 static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, const char* fmt)
 {
+   // Drop lines over the rate limit before doing any work for them.
+   if (rateLimitLog(level, type))
+      return;
+
    Con::active = false; 
 
    char buffer[4096];
@@ -566,9 +670,13 @@ static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, co
             ConsoleLogEntry entry;
             entry.mLevel  = level;
             entry.mType   = type;
-            entry.mString = (const char *)consoleLogChunker.alloc(dStrlen(pos) + 1);
+            entry.mString = (const char *)consoleLogChunkers[consoleLogChunkerIndex].alloc(dStrlen(pos) + 1);
             dStrcpy(const_cast<char*>(entry.mString), pos);
             consoleLog.push_back(entry);
+
+            // Keep the history bounded.
+            if(logBufferMaxLines > 1 && consoleLog.size() > logBufferMaxLines)
+               trimLog();
          }
          if(!eofPos)
             break;
@@ -585,13 +693,13 @@ static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, co
 
 //------------------------------------------------------------------------------
 
-class ConPrinfThreadedEvent : public SimEvent
+class ConPrintfThreadedWork : public SimMainThreadWork
 {
    ConsoleLogEntry::Level mLevel;
    ConsoleLogEntry::Type mType;
    char *mBuf;
 public:
-   ConPrinfThreadedEvent(ConsoleLogEntry::Level level = ConsoleLogEntry::Normal, ConsoleLogEntry::Type type = ConsoleLogEntry::General, const char *buf = NULL)
+   ConPrintfThreadedWork(ConsoleLogEntry::Level level = ConsoleLogEntry::Normal, ConsoleLogEntry::Type type = ConsoleLogEntry::General, const char *buf = NULL)
    {
       mLevel = level;
       mType = type;
@@ -604,11 +712,11 @@ public:
       else
          mBuf = NULL;
    }
-   ~ConPrinfThreadedEvent()
+   ~ConPrintfThreadedWork()
    {
       SAFE_FREE(mBuf);
    }
-   virtual void process(SimObject *object)
+   virtual const char *execute()
    {
       if(mBuf)
       {
@@ -629,6 +737,8 @@ public:
                  
          }
       }
+
+      return NULL;
    }
 };
 
@@ -639,8 +749,8 @@ void printf(const char* fmt,...)
    va_start(argptr, fmt);
    char buf[8192];
    dVsprintf(buf, sizeof(buf), fmt, argptr);
-   if(!isMainThread())
-      Sim::postEvent(Sim::getRootGroup(), new ConPrinfThreadedEvent(ConsoleLogEntry::Normal, ConsoleLogEntry::General, buf), Sim::getTargetTime());
+   if(!isMainThread() && Sim::isMainThreadQueueRunning())
+      Sim::postMainThreadWork(new ConPrintfThreadedWork(ConsoleLogEntry::Normal, ConsoleLogEntry::General, buf));
    else
       _printf(ConsoleLogEntry::Normal, ConsoleLogEntry::General, buf);
    va_end(argptr);
@@ -652,8 +762,8 @@ void warnf(ConsoleLogEntry::Type type, const char* fmt,...)
    va_start(argptr, fmt);
    char buf[8192];
    dVsprintf(buf, sizeof(buf), fmt, argptr);
-   if(!isMainThread())
-      Sim::postEvent(Sim::getRootGroup(), new ConPrinfThreadedEvent(ConsoleLogEntry::Warning, type, buf), Sim::getTargetTime());
+   if(!isMainThread() && Sim::isMainThreadQueueRunning())
+      Sim::postMainThreadWork(new ConPrintfThreadedWork(ConsoleLogEntry::Warning, type, buf));
    else
       _printf(ConsoleLogEntry::Warning, type, buf);
    va_end(argptr);
@@ -665,8 +775,8 @@ void errorf(ConsoleLogEntry::Type type, const char* fmt,...)
    va_start(argptr, fmt);
    char buf[8192];
    dVsprintf(buf, sizeof(buf), fmt, argptr);
-   if(!isMainThread())
-      Sim::postEvent(Sim::getRootGroup(), new ConPrinfThreadedEvent(ConsoleLogEntry::Error, type, buf), Sim::getTargetTime());
+   if(!isMainThread() && Sim::isMainThreadQueueRunning())
+      Sim::postMainThreadWork(new ConPrintfThreadedWork(ConsoleLogEntry::Error, type, buf));
    else
       _printf(ConsoleLogEntry::Error, type, buf);
    va_end(argptr);
@@ -678,8 +788,8 @@ void warnf(const char* fmt,...)
    va_start(argptr, fmt);
    char buf[8192];
    dVsprintf(buf, sizeof(buf), fmt, argptr);
-   if(!isMainThread())
-      Sim::postEvent(Sim::getRootGroup(), new ConPrinfThreadedEvent(ConsoleLogEntry::Warning, ConsoleLogEntry::General, buf), Sim::getTargetTime());
+   if(!isMainThread() && Sim::isMainThreadQueueRunning())
+      Sim::postMainThreadWork(new ConPrintfThreadedWork(ConsoleLogEntry::Warning, ConsoleLogEntry::General, buf));
    else
       _printf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, buf);
    va_end(argptr);
@@ -691,8 +801,8 @@ void errorf(const char* fmt,...)
    va_start(argptr, fmt);
    char buf[8192];
    dVsprintf(buf, sizeof(buf), fmt, argptr);
-   if(!isMainThread())
-      Sim::postEvent(Sim::getRootGroup(), new ConPrinfThreadedEvent(ConsoleLogEntry::Error, ConsoleLogEntry::General, buf), Sim::getTargetTime());
+   if(!isMainThread() && Sim::isMainThreadQueueRunning())
+      Sim::postMainThreadWork(new ConPrintfThreadedWork(ConsoleLogEntry::Error, ConsoleLogEntry::General, buf));
    else
       _printf(ConsoleLogEntry::Error, ConsoleLogEntry::General, buf);
    va_end(argptr);
@@ -939,11 +1049,14 @@ const char *evaluate(const char* string, bool echo, const char *fileName)
    if (echo)
       Con::printf("%s%s", getVariable( "$Con::Prompt" ), string);
 
-   if(fileName)
-      fileName = StringTable->insert(fileName);
+   // Scripts without a file are usually evaluated repeatedly so use the cached code.
+   if(!fileName)
+      return CodeBlockCache::exec(string, false, 0);
+
+   fileName = StringTable->insert(fileName);
 
    CodeBlock *newCodeBlock = new CodeBlock();
-   return newCodeBlock->compileExec(fileName, string, false, fileName ? -1 : 0);
+   return newCodeBlock->compileExec(fileName, string, false, -1);
 }
 
 //------------------------------------------------------------------------------
@@ -958,8 +1071,7 @@ const char *evaluatef(const char* string, ...)
       dVsprintf(buffer, 4096, string, args);
       va_end (args);
 
-      CodeBlock *newCodeBlock = new CodeBlock();
-      result = newCodeBlock->compileExec(NULL, buffer, false, 0);
+      result = CodeBlockCache::exec(buffer, false, 0);
 
       delete [] buffer;
       buffer = NULL;
@@ -970,10 +1082,8 @@ const char *evaluatef(const char* string, ...)
 
 const char *execute(S32 argc, const char *argv[])
 {
-#ifdef TORQUE_MULTITHREAD
    if(isMainThread())
    {
-#endif
       Namespace::Entry *ent;
       StringTableEntry funcName = StringTable->insert(argv[0]);
       ent = Namespace::global()->lookup(funcName);
@@ -994,18 +1104,12 @@ const char *execute(S32 argc, const char *argv[])
       STR.clearFunctionOffset();
 
       return ret;
-
-#ifdef TORQUE_MULTITHREAD
    }
    else
    {
-      SimConsoleThreadExecCallback cb;
-      SimConsoleThreadExecEvent *evt = new SimConsoleThreadExecEvent(argc, argv, false, &cb);
-      Sim::postEvent(Sim::getRootGroup(), evt, Sim::getCurrentTime());
-      
-      return cb.waitForResult();
+      // Hand the call to the main thread and wait for its result.
+      return Sim::executeOnMainThread(argc, argv);
    }
-#endif
 }
 
 //------------------------------------------------------------------------------
@@ -1107,18 +1211,37 @@ bool isFunction(const char *fn)
 
 void setLogMode(S32 newMode)
 {
-   if ((newMode & 0x3) != (consoleLogMode & 0x3))
+   const bool async = (newMode & 0x3) && (newMode & 0x8);
+
+   if ((newMode & 0x3) != (consoleLogMode & 0x3) || async != ConsoleLogWriter::isActive())
    {
+      // Lock out logging whilst the file changes.
+      MutexHandle mutex;
+      if( sLogMutex )
+         mutex.lock( sLogMutex, true );
+
       if (newMode && !consoleLogMode)
       {
          // Enabling logging when it was previously disabled.
          newLogFile = true;
       }
-      if ((consoleLogMode & 0x3) == 2)
+      if (ConsoleLogWriter::isActive())
+      {
+         // Leaving asynchronous mode, must finish writing.
+         ConsoleLogWriter::stop();
+      }
+      else if ((consoleLogMode & 0x3) == 2)
       {
          // Changing away from mode 2, must close logfile.
          consoleLogFile.close();
       }
+
+      if (async)
+      {
+         // Starting asynchronous mode.  The writer keeps the file open so mode 1
+         // only differs by appending to it.
+         ConsoleLogWriter::start(defLogFileName, (newMode & 0x3) == 1 || !newLogFile);
+      }
       else if ((newMode & 0x3) == 2)
       {
          // Starting mode 2, must open logfile.
@@ -1128,6 +1251,26 @@ void setLogMode(S32 newMode)
    }
 }
 
+void flushLog()
+{
+   ConsoleLogWriter::flush();
+}
+
+void getLogStats(LogStats &stats)
+{
+   stats.queuedLines = ConsoleLogWriter::getQueuedLines();
+   stats.droppedLines = ConsoleLogWriter::getDroppedLines();
+   stats.suppressedLines = logSuppressedLines;
+   stats.trimmedLines = logTrimmedLines;
+}
+
+void resetLogStats()
+{
+   ConsoleLogWriter::resetStats();
+   logSuppressedLines = 0;
+   logTrimmedLines = 0;
+}
+
 Namespace *lookupNamespace(const char *ns)
 {
    if(!ns)
@@ -620,6 +620,21 @@ namespace Con
    void unlockLog(void);
    void setLogMode(S32 mode);
 
+   /// Block until the asynchronous log writer has written everything queued.
+   void flushLog(void);
+
+   /// Counters for the console log.
+   struct LogStats
+   {
+      U32 queuedLines;     ///< Lines queued for the asynchronous log writer.
+      U32 droppedLines;    ///< Lines dropped because the asynchronous log writer fell behind.
+      U32 suppressedLines; ///< Lines suppressed by the rate limit.
+      U32 trimmedLines;    ///< Lines trimmed from the history.
+   };
+
+   void getLogStats(LogStats &stats);
+   void resetLogStats(void);
+
    /// @}
 
    /// @name Dynamic Type System
@@ -0,0 +1,285 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "console/consoleLogWriter.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/semaphore.h"
+#include "io/fileStream.h"
+#include "math/mMathFn.h"
+#include "debug/profiler.h"
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+ConsoleLogWriterThread* ConsoleLogWriter::smpThread = NULL;
+U32 ConsoleLogWriter::smQueuedLines = 0;
+U32 ConsoleLogWriter::smDroppedLines = 0;
+
+//-----------------------------------------------------------------------------
+
+/// Background writer draining the log ring into the file.
+class ConsoleLogWriterThread : public Thread
+{
+public:
+   enum
+   {
+      RingSize = 256 * 1024,              ///< Must be a power of two.
+      RingMask = RingSize - 1,
+      FlushIntervalMS = 500,              ///< How often written text is flushed to disk whilst busy.
+   };
+
+   FileStream        mFile;
+   Semaphore         mWake;
+   Semaphore         mFlushed;
+   char*             mRing;
+
+   /// Positions only ever increase and wrap naturally; the producer owns the head
+   /// and the writer owns the tail.
+   std::atomic<U32>  mHead;
+   std::atomic<U32>  mTail;
+   std::atomic<bool> mFlushRequested;
+
+   /// Set by the writer before it blocks so that the producer only signals it when it needs waking.
+   std::atomic<bool> mWaiting;
+
+   U32               mLastFlushTime;
+   bool              mDirty;
+
+   ConsoleLogWriterThread() : Thread( 0, NULL, false ), mWake( 0 ), mFlushed( 0 ), mHead( 0 ), mTail( 0 ), mFlushRequested( false ), mWaiting( false ), mLastFlushTime( 0 ), mDirty( false )
+   {
+      mRing = new char[RingSize];
+   }
+
+   virtual ~ConsoleLogWriterThread()
+   {
+      delete [] mRing;
+   }
+
+   bool push( const char* pText, const U32 textLength, const char* pTerminator, const U32 terminatorLength )
+   {
+      const U32 length = textLength + terminatorLength;
+      const U32 head = mHead.load( std::memory_order_relaxed );
+      const U32 tail = mTail.load( std::memory_order_acquire );
+
+      // Drop the whole record if it does not fit.
+      if ( length > RingSize - (head - tail) )
+         return false;
+
+      copyIn( head, pText, textLength );
+      copyIn( head + textLength, pTerminator, terminatorLength );
+
+      // Publish the record.
+      mHead.store( head + length );
+
+      // Wake the writer if it is waiting.
+      if ( mWaiting.exchange( false ) )
+         mWake.release();
+
+      return true;
+   }
+
+   void wake( void )
+   {
+      mWake.release();
+   }
+
+   void waitForWork( void )
+   {
+      mWaiting.store( true );
+
+      // Check for a record published before the writer said it was waiting.
+      if ( mHead.load() != mTail.load( std::memory_order_relaxed ) && mWaiting.exchange( false ) )
+         return;
+
+      // Either nothing is queued or the producer has already signalled.
+      mWake.acquire();
+      mWaiting.store( false );
+   }
+
+   void copyIn( const U32 position, const char* pText, const U32 length )
+   {
+      if ( length == 0 )
+         return;
+
+      const U32 offset = position & RingMask;
+      const U32 firstLength = getMin( length, (U32)RingSize - offset );
+      dMemcpy( mRing + offset, pText, firstLength );
+      if ( firstLength < length )
+         dMemcpy( mRing, pText + firstLength, length - firstLength );
+   }
+
+   bool drain( void )
+   {
+      const U32 tail = mTail.load( std::memory_order_relaxed );
+      const U32 head = mHead.load( std::memory_order_acquire );
+      if ( head == tail )
+         return false;
+
+      PROFILE_SCOPE(ConsoleLogWriter_Drain);
+
+      // Write everything available, in two parts if it wraps.
+      const U32 length = head - tail;
+      const U32 offset = tail & RingMask;
+      const U32 firstLength = getMin( length, (U32)RingSize - offset );
+      mFile.write( firstLength, mRing + offset );
+      if ( firstLength < length )
+         mFile.write( length - firstLength, mRing );
+
+      // Release the space.
+      mTail.store( head, std::memory_order_release );
+      mDirty = true;
+      return true;
+   }
+
+   void flushFile( void )
+   {
+      if ( mDirty )
+         mFile.Flush();
+
+      mDirty = false;
+      mLastFlushTime = Platform::getRealMilliseconds();
+   }
+
+   virtual void run( void* arg = 0 )
+   {
+      mLastFlushTime = Platform::getRealMilliseconds();
+
+      while( !checkForStop() )
+      {
+         // Note a flush request before draining so that the drain covers everything queued before it.
+         const bool flushRequested = mFlushRequested.exchange( false );
+
+         const bool wrote = drain();
+
+         // Flush when asked, periodically whilst busy and whenever the writer has caught up.
+         if ( flushRequested || !wrote || Platform::getRealMilliseconds() - mLastFlushTime >= FlushIntervalMS )
+            flushFile();
+
+         if ( flushRequested )
+            mFlushed.release();
+
+         // Wait for more text, a flush request or a stop request when idle.
+         if ( !wrote && !flushRequested )
+            waitForWork();
+      }
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+bool ConsoleLogWriter::start( const char* fileName, const bool append )
+{
+   // Restart if already writing.
+   if ( isActive() )
+      stop();
+
+   ConsoleLogWriterThread* pThread = new ConsoleLogWriterThread();
+
+   // Open the file.
+   if ( !pThread->mFile.open( fileName, append ? FileStream::ReadWrite : FileStream::Write ) )
+   {
+      delete pThread;
+      return false;
+   }
+
+   if ( append )
+      pThread->mFile.setPosition( pThread->mFile.getStreamSize() );
+
+   smpThread = pThread;
+   smpThread->start();
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ConsoleLogWriter::stop( void )
+{
+   // Finish if not writing.
+   if ( !isActive() )
+      return;
+
+   // Stop the thread.
+   smpThread->stop();
+   smpThread->wake();
+   smpThread->join();
+
+   // Write anything left and close the file.
+   smpThread->drain();
+   smpThread->mFile.close();
+
+   delete smpThread;
+   smpThread = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ConsoleLogWriter::writeLine( const char* string )
+{
+   // Sanity!
+   AssertFatal( isActive(), "ConsoleLogWriter::writeLine() - The writer is not active." );
+
+   if ( !smpThread->push( string, dStrlen(string), "\r\n", 2 ) )
+   {
+      smDroppedLines++;
+      return false;
+   }
+
+   smQueuedLines++;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ConsoleLogWriter::writeText( const char* text, const U32 length )
+{
+   // Sanity!
+   AssertFatal( isActive(), "ConsoleLogWriter::writeText() - The writer is not active." );
+
+   return smpThread->push( text, length, NULL, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void ConsoleLogWriter::flush( void )
+{
+   // Finish if not writing.
+   if ( !isActive() )
+      return;
+
+   // Debug Profiling.
+   PROFILE_SCOPE(ConsoleLogWriter_Flush);
+
+   // Wait for the writer to drain and flush.
+   smpThread->mFlushRequested.store( true );
+   smpThread->wake();
+   smpThread->mFlushed.acquire();
+}
+
+//-----------------------------------------------------------------------------
+
+void ConsoleLogWriter::resetStats( void )
+{
+   smQueuedLines = 0;
+   smDroppedLines = 0;
+}
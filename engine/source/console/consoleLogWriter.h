@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONSOLE_LOG_WRITER_H_
+#define _CONSOLE_LOG_WRITER_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+class ConsoleLogWriterThread;
+
+/// Asynchronous writer for the console log file.
+///
+/// Lines are copied into a fixed-size ring buffer and a background thread writes them
+/// to the file in batches, flushing it periodically.  Logging therefore never waits on
+/// file I/O.  If the writer falls behind and the ring fills up then whole lines are
+/// dropped and counted rather than blocking the caller.
+///
+/// The ring has a single producer so calls that queue text must be serialized; the
+/// console does this with its log mutex.  The writer thread sleeps on a semaphore when
+/// it has caught up and the producer only signals it when it is sleeping.
+class ConsoleLogWriter
+{
+private:
+   static ConsoleLogWriterThread* smpThread;
+   static U32 smQueuedLines;
+   static U32 smDroppedLines;
+
+public:
+   /// Open the file and start the writer thread.
+   /// @param fileName The file to write to.
+   /// @param append Whether to append to the file or truncate it.
+   /// @return Whether the file could be opened.
+   static bool start( const char* fileName, const bool append );
+
+   /// Write everything queued, close the file and stop the writer thread.
+   static void stop( void );
+
+   /// Whether the writer thread is running.
+   static inline bool isActive( void ) { return smpThread != NULL; }
+
+   /// Queue a line, appending a line terminator.
+   /// @return Whether the line was queued or dropped because the ring is full.
+   static bool writeLine( const char* string );
+
+   /// Queue text as-is.
+   /// @return Whether the text was queued or dropped because the ring is full.
+   static bool writeText( const char* text, const U32 length );
+
+   /// Block until everything queued so far has been written and flushed.
+   static void flush( void );
+
+   /// Lines queued since the counters were reset.
+   static inline U32 getQueuedLines( void ) { return smQueuedLines; }
+
+   /// Lines dropped since the counters were reset.
+   static inline U32 getDroppedLines( void ) { return smDroppedLines; }
+
+   static void resetStats( void );
+};
+
+#endif // _CONSOLE_LOG_WRITER_H_
@@ -37,6 +37,7 @@
 #include "consoleNamespace_ScriptBinding.h"
 
 U32 Namespace::mCacheSequence = 0;
+U32 Namespace::mPackageSequence = 0;
 DataChunker Namespace::mCacheAllocator;
 DataChunker Namespace::mAllocator;
 Namespace *Namespace::mNamespaceList = NULL;
@@ -548,6 +549,7 @@ void Namespace::activatePackage(StringTableEntry name)
 
    // kill the cache
    trashCache();
+   mPackageSequence++;
 
    // find all the package namespaces...
    for(Namespace *walk = mNamespaceList; walk; walk = walk->mNext)
@@ -585,6 +587,7 @@ void Namespace::deactivatePackage(StringTableEntry name)
       return;
 
    trashCache();
+   mPackageSequence++;
 
    for(j = mNumActivePackages - 1; j >= i; j--)
    {
@@ -136,6 +136,10 @@ public:
     const char *tabComplete(const char *prevText, S32 baseLen, bool fForward);
 
     static U32 mCacheSequence;
+
+    /// Incremented whenever packages are activated or deactivated, which moves
+    /// function entries between namespaces.
+    static U32 mPackageSequence;
     static DataChunker mCacheAllocator;
     static DataChunker mAllocator;
     static void trashCache();
@@ -96,34 +96,7 @@ ConsoleFunctionWithDocs(compile, ConsoleBool, 2, 2, ( fileName ))
    Con::expandPath(pathBuffer, sizeof(pathBuffer), argv[1]);
 
    // Figure out where to put DSOs
-   StringTableEntry dsoPath = getDSOPath(pathBuffer);
-
-   // If the script file extention is '.ed.cs' then compile it to a different compiled extention
-   bool isEditorScript = false;
-   const char *ext = dStrrchr( pathBuffer, '.' );
-   if( ext && ( dStricmp( ext, ".cs" ) == 0 ) )
-   {
-      const char* ext2 = ext - 3;
-      if( dStricmp( ext2, ".ed.cs" ) == 0 )
-         isEditorScript = true;
-   }
-   else if( ext && ( dStricmp( ext, ".gui" ) == 0 ) )
-   {
-      const char* ext2 = ext - 3;
-      if( dStricmp( ext2, ".ed.gui" ) == 0 )
-         isEditorScript = true;
-   }
-
-   const char *filenameOnly = dStrrchr(pathBuffer, '/');
-   if(filenameOnly)
-      ++filenameOnly;
-   else
-      filenameOnly = pathBuffer;
-
-   if( isEditorScript )
-      dStrcpyl(nameBuffer, sizeof(nameBuffer), dsoPath, "/", filenameOnly, ".edso", NULL);
-   else
-      dStrcpyl(nameBuffer, sizeof(nameBuffer), dsoPath, "/", filenameOnly, ".dso", NULL);
+   CodeBlock::getCompiledFileName(pathBuffer, nameBuffer, sizeof(nameBuffer));
    
    ResourceObject *rScr = ResourceManager->find(pathBuffer);
    ResourceObject *rCom = ResourceManager->find(nameBuffer);
@@ -129,7 +129,8 @@ ConsoleFunctionWithDocs(collapseEscape, ConsoleString, 2, 2, ( text ))
 
 /*! Use the setLogMode function to set the logging level based on bits that are set in the mode argument.
     This is a general debug method and should be used in all but release cases and perhaps even then.
-    @param mode A bitmask enabling various types of logging. See 'Logging Modes' table below.
+    @param mode A bitmask enabling various types of logging. 1 appends each line to the log file, 2 keeps the log file open,
+    4 dumps the existing console history when the log starts and 8 writes the log file asynchronously on a background thread.
     @return No return value.
     @sa intputLog
 */
@@ -139,6 +140,36 @@ ConsoleFunctionWithDocs(setLogMode, ConsoleVoid, 2, 2, ( mode ))
    Con::setLogMode(dAtoi(argv[1]));
 }
 
+/*! Waits until the asynchronous log writer has written and flushed all queued lines.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(flushLog, ConsoleVoid, 1, 1, ())
+{
+   Con::flushLog();
+}
+
+/*! Gets the console log counters.
+    @return The lines queued for the asynchronous writer, the lines it dropped, the lines suppressed by $Con::logRateLimit
+    and the lines trimmed from the history by $Con::logBufferMaxLines, separated by spaces.
+*/
+ConsoleFunctionWithDocs(getLogStats, ConsoleString, 1, 1, ())
+{
+   Con::LogStats stats;
+   Con::getLogStats(stats);
+
+   char* pBuffer = Con::getReturnBuffer(64);
+   dSprintf(pBuffer, 64, "%d %d %d %d", stats.queuedLines, stats.droppedLines, stats.suppressedLines, stats.trimmedLines);
+   return pBuffer;
+}
+
+/*! Resets the console log counters.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(resetLogStats, ConsoleVoid, 1, 1, ())
+{
+   Con::resetLogStats();
+}
+
 /*! Use the setEchoFileLoads function to enable/disable echoing of file loads (to console).
     This does not completely disable message, but rather adds additional methods when echoing is set to true. File loads will always echo a compile statement if compiling is required, and an exec statement at all times
     @param enable A boolean value. If this value is true, extra information will be dumped to the console when files are loaded.
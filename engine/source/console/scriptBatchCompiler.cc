@@ -0,0 +1,296 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "console/scriptBatchCompiler.h"
+#include "console/console.h"
+#include "console/compiler.h"
+#include "io/fileStream.h"
+#include "io/resource/resourceManager.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/semaphore.h"
+#include "debug/profiler.h"
+
+#include <atomic>
+#include <thread>
+
+#include "console/scriptBatchCompiler_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+/// One script of a batch.
+struct CompileJob
+{
+   StringTableEntry           mScriptFile;
+   StringTableEntry           mCompiledFile;
+   Compiler::CompilerContext  mContext;
+   StmtNode*                  mStatements;
+   CodeBlock*                 mCodeBlock;
+   bool                       mParsed;
+   bool                       mCompiled;
+
+   CompileJob() : mScriptFile( NULL ), mCompiledFile( NULL ), mStatements( NULL ), mCodeBlock( NULL ), mParsed( false ), mCompiled( false ) {}
+};
+
+//-----------------------------------------------------------------------------
+
+/// The jobs of a batch shared between the parsing thread and the workers.
+struct CompileBatch
+{
+   Vector<CompileJob*>  mJobs;
+
+   /// Released once for each job that is ready for code generation, then
+   /// once more per worker when no more jobs will follow.
+   Semaphore            mReadyJobs;
+   std::atomic<U32>     mNextJob;
+
+   CompileBatch() : mReadyJobs( 0 ), mNextJob( 0 ) {}
+
+   void work( void )
+   {
+      while ( true )
+      {
+         mReadyJobs.acquire();
+
+         // Jobs are released in order so the next index is always ready.
+         const U32 index = mNextJob.fetch_add( 1 );
+         if ( index >= (U32)mJobs.size() )
+            return;
+
+         CompileJob* pJob = mJobs[index];
+         if ( !pJob->mParsed )
+            continue;
+
+         PROFILE_SCOPE(ScriptBatchCompiler_Compile);
+
+         // Generate the code in the job's own context.
+         Compiler::setCompilerContext( &pJob->mContext );
+
+         FileStream stream;
+         if ( stream.open( pJob->mCompiledFile, FileStream::Write ) )
+         {
+            pJob->mCodeBlock->compileToStream( stream, pJob->mStatements );
+            stream.close();
+            pJob->mCompiled = true;
+         }
+
+         // Release the arena straight away.
+         Compiler::consoleAllocReset();
+         Compiler::setCompilerContext( NULL );
+      }
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+class CompileWorkerThread : public Thread
+{
+   CompileBatch* mBatch;
+
+public:
+   CompileWorkerThread( CompileBatch* pBatch ) : Thread( 0, NULL, false ), mBatch( pBatch ) {}
+
+   virtual void run( void* arg = 0 )
+   {
+      mBatch->work();
+   }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Reads and parses a script into the job's context on the calling thread.
+bool parseJob( CompileJob* pJob )
+{
+   PROFILE_SCOPE(ScriptBatchCompiler_Parse);
+
+   // Read the script.
+   Stream* pStream = ResourceManager->openStream( pJob->mScriptFile );
+   if ( pStream == NULL )
+   {
+      Con::errorf( ConsoleLogEntry::Script, "compileScripts: invalid script file %s.", pJob->mScriptFile );
+      return false;
+   }
+
+   const U32 scriptSize = ResourceManager->getSize( pJob->mScriptFile );
+   char* pScript = new char[scriptSize + 1];
+   pStream->read( scriptSize, pScript );
+   ResourceManager->closeStream( pStream );
+   pScript[scriptSize] = 0;
+
+   if ( scriptSize == 0 )
+   {
+      delete [] pScript;
+      Con::errorf( ConsoleLogEntry::Script, "compileScripts: invalid script file %s.", pJob->mScriptFile );
+      return false;
+   }
+
+   // The workers write without the resource manager so the directory must exist.
+   if ( !Platform::createPath( pJob->mCompiledFile ) )
+   {
+      delete [] pScript;
+      Con::errorf( ConsoleLogEntry::Script, "compileScripts: cannot create the path for %s.", pJob->mCompiledFile );
+      return false;
+   }
+
+   // Parse into the job's context.
+   Compiler::setCompilerContext( &pJob->mContext );
+   const bool parsed = CodeBlock::parse( pJob->mScriptFile, pScript, pJob->mStatements );
+   if ( !parsed )
+      Compiler::consoleAllocReset();
+   Compiler::setCompilerContext( NULL );
+
+   // The AST copies everything it needs from the script.
+   delete [] pScript;
+
+   return parsed;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+U32 ScriptBatchCompiler::getDefaultWorkerCount( void )
+{
+   const U32 processorCount = std::thread::hardware_concurrency();
+   return processorCount > 0 ? processorCount : 1;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptBatchCompiler::compileFiles( const Vector<StringTableEntry>& scriptFiles, U32 workerCount, Stats& stats )
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(ScriptBatchCompiler_CompileFiles);
+
+   // Sanity!
+   AssertFatal( Con::isMainThread(), "ScriptBatchCompiler::compileFiles() - Must be called from the main thread." );
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   if ( workerCount == 0 )
+      workerCount = getDefaultWorkerCount();
+
+   // Never start more workers than there are scripts.
+   workerCount = getMax( getMin( workerCount, (U32)scriptFiles.size() ), (U32)1 );
+
+   dMemset( &stats, 0, sizeof(stats) );
+   stats.scriptCount = scriptFiles.size();
+   stats.workerCount = workerCount;
+
+   // Create the jobs.
+   CompileBatch batch;
+   batch.mJobs.reserve( scriptFiles.size() );
+   char compiledFileBuffer[1024];
+   for ( Vector<StringTableEntry>::const_iterator itr = scriptFiles.begin(); itr != scriptFiles.end(); ++itr )
+   {
+      CompileJob* pJob = new CompileJob();
+      pJob->mScriptFile = *itr;
+      pJob->mCompiledFile = StringTable->insert( CodeBlock::getCompiledFileName( *itr, compiledFileBuffer, sizeof(compiledFileBuffer) ) );
+      pJob->mCodeBlock = new CodeBlock();
+      batch.mJobs.push_back( pJob );
+   }
+
+   // Start the workers.
+   Vector<CompileWorkerThread*> workers;
+   for ( U32 index = 0; index < workerCount; ++index )
+   {
+      CompileWorkerThread* pWorker = new CompileWorkerThread( &batch );
+      pWorker->start();
+      workers.push_back( pWorker );
+   }
+
+   // Parse the scripts in order, handing each to the workers once parsed.
+   const U32 parseStartTime = Platform::getRealMilliseconds();
+   for ( Vector<CompileJob*>::iterator itr = batch.mJobs.begin(); itr != batch.mJobs.end(); ++itr )
+   {
+#if defined(TORQUE_DEBUG)
+      Con::printf( "Compiling %s...", (*itr)->mScriptFile );
+#endif
+      (*itr)->mParsed = parseJob( *itr );
+      batch.mReadyJobs.release();
+   }
+   stats.parseMs = Platform::getRealMilliseconds() - parseStartTime;
+
+   // Let the workers finish.
+   for ( U32 index = 0; index < workerCount; ++index )
+      batch.mReadyJobs.release();
+
+   for ( Vector<CompileWorkerThread*>::iterator itr = workers.begin(); itr != workers.end(); ++itr )
+   {
+      (*itr)->join();
+      delete *itr;
+   }
+
+   // Update the resource manager and the results in the order the scripts were given.
+   for ( Vector<CompileJob*>::iterator itr = batch.mJobs.begin(); itr != batch.mJobs.end(); ++itr )
+   {
+      CompileJob* pJob = *itr;
+
+      if ( pJob->mCompiled )
+         ResourceManager->fileChanged( pJob->mCompiledFile );
+      else
+         stats.failedCount++;
+
+      delete pJob->mCodeBlock;
+      delete pJob;
+   }
+
+   stats.totalMs = Platform::getRealMilliseconds() - startTime;
+
+   return stats.failedCount == 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptBatchCompiler::compilePath( const char* pExpressions, U32 workerCount, Stats& stats )
+{
+   // Sanity!
+   AssertFatal( pExpressions != NULL, "ScriptBatchCompiler::compilePath() - Cannot use NULL expressions." );
+
+   // Expand each expression.
+   char expressionBuffer[4096];
+   char pathBuffer[1024];
+   expressionBuffer[0] = 0;
+
+   char* pCopy = dStrdup( pExpressions );
+   for ( char* pToken = dStrtok( pCopy, "\t" ); pToken != NULL; pToken = dStrtok( NULL, "\t" ) )
+   {
+      if ( !Con::expandPath( pathBuffer, sizeof(pathBuffer), pToken ) )
+         continue;
+
+      if ( expressionBuffer[0] != 0 )
+         dStrcatl( expressionBuffer, sizeof(expressionBuffer), "\t", NULL );
+      dStrcatl( expressionBuffer, sizeof(expressionBuffer), pathBuffer, NULL );
+   }
+   dFree( pCopy );
+
+   // Find the scripts.
+   Vector<StringTableEntry> scriptFiles;
+   const char* pFileName = NULL;
+   ResourceObject* pMatch = NULL;
+   while ( (pMatch = ResourceManager->findMatchMultiExprs( expressionBuffer, &pFileName, pMatch )) != NULL )
+      scriptFiles.push_back( StringTable->insert( pFileName ) );
+
+   return compileFiles( scriptFiles, workerCount, stats );
+}
@@ -0,0 +1,68 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCRIPT_BATCH_COMPILER_H_
+#define _SCRIPT_BATCH_COMPILER_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+/// Compiles many scripts to their DSO files at once.
+///
+/// The flex/bison parser is not reentrant so the calling thread parses the
+/// scripts one after another, each into its own compiler context (the AST
+/// arena and the string, float and ident tables).  As soon as a script is
+/// parsed a worker thread takes its context and runs the code generation
+/// passes and writes the DSO, so code generation for several scripts runs
+/// alongside the parsing of the next.  Each DSO only depends on its own
+/// script, so the output is identical to compiling the scripts one by one;
+/// the resource manager is updated afterwards in the order the scripts
+/// were given.
+class ScriptBatchCompiler
+{
+public:
+   struct Stats
+   {
+      U32 scriptCount;     ///< Number of scripts given
+      U32 failedCount;     ///< Number of scripts that could not be read, parsed or written
+      U32 workerCount;     ///< Number of worker threads used
+      U32 parseMs;         ///< Time spent reading and parsing on the calling thread
+      U32 totalMs;         ///< Time for the whole batch
+   };
+
+   /// Compiles the scripts using the given number of worker threads, or one
+   /// per processor if zero.  Must be called from the main thread.
+   /// @return True if every script compiled.
+   static bool compileFiles( const Vector<StringTableEntry>& scriptFiles, U32 workerCount, Stats& stats );
+
+   /// Compiles every script matching the expressions, separated by tabs.
+   static bool compilePath( const char* pExpressions, U32 workerCount, Stats& stats );
+
+   /// Returns the number of worker threads used by default.
+   static U32 getDefaultWorkerCount( void );
+};
+
+#endif // _SCRIPT_BATCH_COMPILER_H_
@@ -36,9 +36,7 @@
 ProfilerRootData *ProfilerRootData::sRootList = NULL;
 Profiler *gProfiler = NULL;
 
-#ifdef TORQUE_MULTITHREAD
 ThreadIdent gMainThread = 0;
-#endif
 
 #if defined(TORQUE_SUPPORTS_VC_INLINE_X86_ASM)
 // platform specific get hires times...
@@ -192,9 +190,7 @@ Profiler::Profiler()
    mDumpToFile      = false;
    mDumpFileName[0] = '\0';
 
-#ifdef TORQUE_MULTITHREAD
    gMainThread = ThreadManager::getCurrentThreadId();
-#endif
 }
 
 Profiler::~Profiler()
@@ -276,11 +272,9 @@ void Profiler::validate()
 
 void Profiler::hashPush(ProfilerRootData *root)
 {
-#ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if(! ThreadManager::isCurrentThread(gMainThread) )
       return;
-#endif
 
    mStackDepth++;
    AssertFatal(mStackDepth <= (S32)mMaxStackDepth,
@@ -355,6 +349,19 @@ void Profiler::enable(bool enabled)
        Con::printf("Profiler is off." );
 }
 
+bool Profiler::enableNow(bool enabled)
+{
+   // can only switch between profiled blocks.
+   if(mStackDepth != 0)
+      return false;
+
+   if(!mEnabled && enabled)
+      startHighResolutionTimer(mCurrentProfilerData->mStartTime);
+   mNextEnable = enabled;
+   mEnabled = enabled;
+   return true;
+}
+
 void Profiler::dumpToConsole()
 {
    mDumpToConsole = true;
@@ -372,11 +379,9 @@ void Profiler::dumpToFile(const char* fileName)
 
 void Profiler::hashPop()
 {
-#ifdef TORQUE_MULTITHREAD
    // Ignore non-main-thread profiler activity.
    if(! ThreadManager::isCurrentThread(gMainThread) )
       return;
-#endif
 
    mStackDepth--;
    AssertFatal(mStackDepth >= 0, "Stack underflow in profiler.  You may have mismatched PROFILE_START and PROFILE_ENDs");
@@ -99,6 +99,12 @@ public:
    void dumpToFile(const char *fileName);
    /// Enable profiling
    void enable(bool enabled);
+   /// Enable profiling immediately rather than at the end of the current frame.
+   /// This is only possible outside of any profiled block.
+   /// @return Whether the change was applied.
+   bool enableNow(bool enabled);
+   /// Whether profiling is currently enabled
+   bool isEnabled() const { return mEnabled; }
    /// Helper function for macro definition PROFILE_START
    void hashPush(ProfilerRootData *data);
    /// Helper function for macro definition PROFILE_END
@@ -81,6 +81,22 @@
 #include "2d/core/ParticleSystem.h"
 #endif
 
+#ifndef _SCENE_PIPELINE_H_
+#include "2d/scene/ScenePipeline.h"
+#endif
+
+#ifndef _EVENT_JOURNAL_H_
+#include "game/eventJournal.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_JOB_SYSTEM_H_
+#include "platform/threads/jobSystem.h"
+#endif
+
 #ifdef TORQUE_OS_IOS
 #include "platformiOS/iOSProfiler.h"
 #endif
@@ -99,6 +115,7 @@ static F32 gTimeScale = 1.0;
 static U32 gTimeAdvance = 0;
 static U32 gFrameSkip = 0;
 static U32 gFrameCount = 0;
+static U32 gMainThreadQueueBudget = 4;
 
 // Reset frames stats.
 static F32 framePeriod = 0.0f;
@@ -162,6 +179,9 @@ bool initializeLibraries()
 
     Platform::init();    // platform specific initialization
 
+    // Start the job system workers.
+    JobSystem::init();
+
     // Initialize the particle system.
     ParticleSystem::Init();
     
@@ -183,6 +203,7 @@ void shutdownLibraries()
     TelnetDebugger::destroy();
     TelnetConsole::destroy();
 
+    JobSystem::shutdown();
     Sim::shutdown();
     Platform::shutdown();
 
@@ -218,6 +239,8 @@ bool initializeGame(int argc, const char **argv)
     Con::addVariable("timeScale", TypeF32, &gTimeScale);
     Con::addVariable("timeAdvance", TypeS32, &gTimeAdvance);
     Con::addVariable("frameSkip", TypeS32, &gFrameSkip);
+    Con::addVariable("Sim::mainThreadQueueBudget", TypeS32, &gMainThreadQueueBudget);
+    Con::addVariable("Input::coalesceEvents", TypeBool, &gCoalesceInputEvents);
 
     initMessageBoxVars();
 
@@ -238,6 +261,9 @@ bool initializeGame(int argc, const char **argv)
     // Let the remote debugger process the command-line.
     RemoteDebuggerBridge::processCommandLine( argc, argv );
 
+    // Let the event journal process the command-line.
+    EventJournal::processCommandLine( argc, argv );
+
     if(argc > 2 && dStricmp(argv[1], "-project") == 0)
     {
         char playerPath[1024];
@@ -323,6 +349,9 @@ bool initializeGame(int argc, const char **argv)
 
 void shutdownGame()
 {
+    // Finish any event journal.
+    EventJournal::stop();
+
     // Perform pre-exit callback.
     if( Con::isFunction("onPreExit") )
         Con::executef(1, "onPreExit");
@@ -450,6 +479,17 @@ void DefaultGame::advanceTime( F32 timeDelta )
 
 //--------------------------------------------------------------------------
 
+void DefaultGame::processEvent(Event *event)
+{
+   // Events are where the scene can change so finish any scene capture first.
+   // The capture otherwise overlaps the rest of the frame and the polling for the next one.
+   ScenePipeline::synchronize();
+
+   GameInterface::processEvent(event);
+}
+
+//--------------------------------------------------------------------------
+
 void DefaultGame::mainLoop( void )
 {	
 #ifdef TORQUE_OS_IOS_PROFILE
@@ -482,6 +522,9 @@ void DefaultGame::mainLoop( void )
          PROFILE_START(GameProcessEvents);
     Game->processEvents(); // process all non-sim posted events.
          PROFILE_END();
+
+   // Roll over the per-thread frame allocation stats.
+   FrameAllocator::endFrame();
          PROFILE_END();
     
 #ifdef TORQUE_OS_IOS_PROFILE
@@ -637,6 +680,12 @@ AndroidProfilerStart("SERVER_PROC");
 #endif
     PROFILE_END();
 
+   // Execute work handed to the main thread by other threads.
+   PROFILE_START(SimMainThreadQueue);
+   Sim::processMainThreadQueue(gMainThreadQueueBudget);
+   JobSystem::processMainThreadJobs();
+   PROFILE_END();
+
    PROFILE_START(ClientProcess);
 #ifdef TORQUE_OS_IOS_PROFILE
     iPhoneProfilerStart("CLIENT_PROC");
@@ -55,6 +55,7 @@ public:
     virtual void interpolateTick( F32 delta ) {};
     virtual void advanceTime( F32 timeDelta );
 
+    virtual void processEvent(Event *event);
     void processQuitEvent();
     void processTimeEvent(TimeEvent *event);
     void processInputEvent(InputEvent *event);
@@ -0,0 +1,400 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "game/eventJournal.h"
+#include "game/gameInterface.h"
+#include "console/console.h"
+#include "math/mRandom.h"
+#include "debug/profiler.h"
+
+// Script binding.
+#include "game/eventJournal_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+#define EVENT_JOURNAL_RECORD_ARG    "-jRecord"
+#define EVENT_JOURNAL_REPLAY_ARG    "-jReplay"
+
+static const U32 JournalMagic = 0x4A453254; // "T2EJ"
+static const U32 JournalVersion = 1;
+
+/// Marks the end of a frame of events.
+static const U8 JournalFrameTag = 0xFF;
+
+/// The input event fields before the (rarely used) finger arrays are stored verbatim.
+static const U32 InputEventFieldsOffset = sizeof(Event);
+static const U32 InputEventFieldsSize = Offset(fingersX, InputEvent) - sizeof(Event);
+
+/// Identifies the event layout so that journals from other builds are rejected.
+static const U32 JournalLayout = (Offset(fingersX, InputEvent) << 16) | sizeof(NetAddress);
+
+/// Holds the event currently being replayed.
+static U64 sReplayEventBuffer[512];
+
+EventJournal::JournalMode EventJournal::smMode = EventJournal::JournalOff;
+FileStream EventJournal::smStream;
+bool EventJournal::smQuitWhenDone = false;
+U32 EventJournal::smFrameCount = 0;
+U32 EventJournal::smEventCount = 0;
+U32 EventJournal::smFrameEventCount = 0;
+U32 EventJournal::smStartTime = 0;
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::processCommandLine( S32 argc, const char **argv )
+{
+   for( S32 argIndex = 0; argIndex < argc - 1; ++argIndex )
+   {
+      // Fetch argument.
+      const char* pArg = argv[argIndex];
+
+      const bool record = dStricmp( pArg, EVENT_JOURNAL_RECORD_ARG ) == 0;
+      const bool replay = dStricmp( pArg, EVENT_JOURNAL_REPLAY_ARG ) == 0;
+
+      // Skip if this is not a journal argument.
+      if ( !record && !replay )
+         continue;
+
+      // Resolve the journal file before the working directory can change.
+      char fileName[1024];
+      Platform::makeFullPathName( argv[argIndex + 1], fileName, sizeof(fileName) );
+
+      if ( record )
+         startRecording( fileName );
+      else
+         startReplay( fileName, true );
+
+      return;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+bool EventJournal::startRecording( const char* pFileName )
+{
+   // Finish any current journal.
+   stop();
+
+   if ( !smStream.open( pFileName, FileStream::Write ) )
+   {
+      Con::warnf( "EventJournal::startRecording() - Could not open '%s' for writing.", pFileName );
+      return false;
+   }
+
+   // Write the header including the random seed so the replay generates the same numbers.
+   smStream.write( JournalMagic );
+   smStream.write( JournalVersion );
+   smStream.write( JournalLayout );
+   smStream.write( gRandGen.getSeed() );
+
+   smMode = JournalRecord;
+   smFrameCount = 0;
+   smEventCount = 0;
+   smFrameEventCount = 0;
+
+   Con::printf( "EventJournal: Recording to '%s'.", pFileName );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool EventJournal::startReplay( const char* pFileName, const bool quitWhenDone )
+{
+   // Finish any current journal.
+   stop();
+
+   if ( !smStream.open( pFileName, FileStream::Read ) )
+   {
+      Con::warnf( "EventJournal::startReplay() - Could not open '%s' for reading.", pFileName );
+      return false;
+   }
+
+   // Check the header.
+   U32 magic = 0;
+   U32 version = 0;
+   U32 layout = 0;
+   S32 seed = 0;
+   smStream.read( &magic );
+   smStream.read( &version );
+   smStream.read( &layout );
+   if ( !smStream.read( &seed ) || magic != JournalMagic || version != JournalVersion || layout != JournalLayout )
+   {
+      Con::warnf( "EventJournal::startReplay() - '%s' is not a journal recorded by this build.", pFileName );
+      smStream.close();
+      return false;
+   }
+
+   // Restore the random seed.
+   RandomLCG::setGlobalRandSeed( seed );
+
+   smMode = JournalReplay;
+   smQuitWhenDone = quitWhenDone;
+   smFrameCount = 0;
+   smEventCount = 0;
+   smStartTime = Platform::getRealMilliseconds();
+
+   Con::printf( "EventJournal: Replaying '%s'.", pFileName );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::stop( void )
+{
+   if ( smMode == JournalOff )
+      return;
+
+   if ( smMode == JournalRecord )
+   {
+      // Finish the current frame.
+      endFrame();
+
+      Con::printf( "EventJournal: Recorded %d frames (%d events, %d bytes).", smFrameCount, smEventCount, smStream.getPosition() );
+   }
+
+   smStream.close();
+   smMode = JournalOff;
+}
+
+//-----------------------------------------------------------------------------
+
+bool EventJournal::isJournaledEvent( const U32 type )
+{
+   switch( type )
+   {
+      case InputEventType:
+      case MouseMoveEventType:
+      case ScreenTouchEventType:
+      case PacketReceiveEventType:
+      case TimeEventType:
+      case ConsoleEventType:
+      case ConnectedReceiveEventType:
+      case ConnectedAcceptEventType:
+      case ConnectedNotifyEventType:
+         return true;
+
+      default:
+         return false;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::writeCount( U32 value )
+{
+   // Seven bits at a time, lowest first, with the top bit flagging that more follow.
+   while ( value >= 0x80 )
+   {
+      smStream.write( U8( (value & 0x7F) | 0x80 ) );
+      value >>= 7;
+   }
+   smStream.write( U8( value ) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool EventJournal::readCount( U32& value )
+{
+   value = 0;
+   for ( U32 shift = 0; shift < 32; shift += 7 )
+   {
+      U8 byte;
+      if ( !smStream.read( &byte ) )
+         return false;
+
+      value |= U32( byte & 0x7F ) << shift;
+      if ( ( byte & 0x80 ) == 0 )
+         return true;
+   }
+
+   return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::endFrame( void )
+{
+   // Frames without events are not stored.
+   if ( smFrameEventCount == 0 )
+      return;
+
+   smStream.write( JournalFrameTag );
+   smFrameCount++;
+   smFrameEventCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::recordEvent( const Event* pEvent )
+{
+   PROFILE_SCOPE(EventJournal_RecordEvent);
+
+   if ( !isJournaledEvent( pEvent->type ) )
+      return;
+
+   smStream.write( U8( pEvent->type ) );
+
+   switch( pEvent->type )
+   {
+      case TimeEventType:
+         writeCount( ((const TimeEvent*)pEvent)->elapsedTime );
+         break;
+
+      case InputEventType:
+      {
+         const InputEvent* pInputEvent = (const InputEvent*)pEvent;
+         smStream.write( InputEventFieldsSize, (const U8*)pInputEvent + InputEventFieldsOffset );
+
+         // The finger arrays are only used by touch devices so only store them when set.
+         const bool hasFingers = pInputEvent->fingersX[0] || pInputEvent->fingersY[0] || pInputEvent->fingersZ[0] || pInputEvent->fingerIDs[0];
+         smStream.write( U8( hasFingers ) );
+         if ( hasFingers )
+         {
+            smStream.writeString( pInputEvent->fingersX );
+            smStream.writeString( pInputEvent->fingersY );
+            smStream.writeString( pInputEvent->fingersZ );
+            smStream.writeString( pInputEvent->fingerIDs );
+         }
+         break;
+      }
+
+      default:
+      {
+         // Variable sized events only store their used payload.
+         const U32 payloadSize = pEvent->size - sizeof(Event);
+         writeCount( payloadSize );
+         smStream.write( payloadSize, (const U8*)pEvent + sizeof(Event) );
+         break;
+      }
+   }
+
+   smEventCount++;
+   smFrameEventCount++;
+}
+
+//-----------------------------------------------------------------------------
+
+bool EventJournal::readEvent( const U8 type, Event* pEvent )
+{
+   pEvent->type = type;
+
+   switch( type )
+   {
+      case TimeEventType:
+      {
+         TimeEvent* pTimeEvent = (TimeEvent*)pEvent;
+         pEvent->size = sizeof(TimeEvent);
+         return readCount( pTimeEvent->elapsedTime );
+      }
+
+      case InputEventType:
+      {
+         InputEvent* pInputEvent = (InputEvent*)pEvent;
+         pEvent->size = sizeof(InputEvent);
+         if ( !smStream.read( InputEventFieldsSize, (U8*)pInputEvent + InputEventFieldsOffset ) )
+            return false;
+
+         bool hasFingers = false;
+         if ( !smStream.read( &hasFingers ) )
+            return false;
+
+         if ( hasFingers )
+         {
+            smStream.readString( pInputEvent->fingersX );
+            smStream.readString( pInputEvent->fingersY );
+            smStream.readString( pInputEvent->fingersZ );
+            smStream.readString( pInputEvent->fingerIDs );
+         }
+         else
+         {
+            pInputEvent->fingersX[0] = 0;
+            pInputEvent->fingersY[0] = 0;
+            pInputEvent->fingersZ[0] = 0;
+            pInputEvent->fingerIDs[0] = 0;
+         }
+         return true;
+      }
+
+      default:
+      {
+         U32 payloadSize;
+         if ( !readCount( payloadSize ) || payloadSize > sizeof(sReplayEventBuffer) - sizeof(Event) )
+            return false;
+
+         pEvent->size = U16( payloadSize + sizeof(Event) );
+         return smStream.read( payloadSize, (U8*)pEvent + sizeof(Event) );
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::replayFrame( void )
+{
+   PROFILE_SCOPE(EventJournal_ReplayFrame);
+
+   Event* pEvent = (Event*)sReplayEventBuffer;
+
+   U8 tag;
+   while ( smStream.read( &tag ) )
+   {
+      // Finished the frame?
+      if ( tag == JournalFrameTag )
+      {
+         smFrameCount++;
+         return;
+      }
+
+      if ( !isJournaledEvent( tag ) || !readEvent( tag, pEvent ) )
+      {
+         Con::warnf( "EventJournal::replayFrame() - The journal is corrupt after %d frames.", smFrameCount );
+         break;
+      }
+
+      smEventCount++;
+      Game->processEvent( pEvent );
+
+      // The event may have stopped the replay.
+      if ( !isReplaying() )
+         return;
+   }
+
+   finishReplay();
+}
+
+//-----------------------------------------------------------------------------
+
+void EventJournal::finishReplay( void )
+{
+   const U32 elapsedTime = Platform::getRealMilliseconds() - smStartTime;
+
+   Con::printf( "EventJournal: Replayed %d frames (%d events) in %d ms, %.3f ms per frame.",
+      smFrameCount, smEventCount, elapsedTime,
+      smFrameCount ? F32(elapsedTime) / F32(smFrameCount) : 0.0f );
+
+   const bool quitWhenDone = smQuitWhenDone;
+   stop();
+
+   if ( quitWhenDone )
+      Platform::postQuitMessage( 0 );
+}
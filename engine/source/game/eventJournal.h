@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _EVENT_JOURNAL_H_
+#define _EVENT_JOURNAL_H_
+
+#ifndef _EVENT_H_
+#include "platform/event.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// The event journal records the platform events dispatched by the game (input,
+/// network packets, time and console events) so that a session can be replayed
+/// deterministically, for example to compare frame-time profiles between builds.
+///
+/// Events are captured as they are dispatched by GameInterface::processEvent and
+/// stored in a compact binary form grouped by frame.  During playback the live
+/// events are ignored and each call to GameInterface::processEvents dispatches the
+/// next recorded frame without waiting for real time so a replay runs as fast as
+/// the engine can process it.
+///
+/// Journals are only valid for the build configuration that recorded them.
+///
+/// Recording and playback can be started from the command-line:
+/// @code
+/// Torque2D -jRecord session.jrn
+/// Torque2D -jReplay session.jrn
+/// @endcode
+class EventJournal
+{
+public:
+   enum JournalMode
+   {
+      JournalOff,
+      JournalRecord,
+      JournalReplay,
+   };
+
+private:
+   static JournalMode   smMode;
+   static FileStream    smStream;
+   static bool          smQuitWhenDone;
+   static U32           smFrameCount;
+   static U32           smEventCount;
+   static U32           smFrameEventCount;
+   static U32           smStartTime;
+
+   static void writeCount( U32 value );
+   static bool readCount( U32& value );
+   static bool readEvent( const U8 type, Event* pEvent );
+   static void finishReplay( void );
+
+public:
+   /// Start recording or replaying from the "-jRecord" or "-jReplay" command-line arguments.
+   static void processCommandLine( S32 argc, const char **argv );
+
+   /// Start recording the dispatched events to the specified file.
+   static bool startRecording( const char* pFileName );
+
+   /// Start replaying the events from the specified file, optionally quitting once it ends.
+   static bool startReplay( const char* pFileName, const bool quitWhenDone );
+
+   /// Stop recording or replaying.
+   static void stop( void );
+
+   static inline JournalMode getMode( void ) { return smMode; }
+   static inline bool isRecording( void ) { return smMode == JournalRecord; }
+   static inline bool isReplaying( void ) { return smMode == JournalReplay; }
+
+   /// Whether the event type is journaled.
+   static bool isJournaledEvent( const U32 type );
+
+   /// Mark the end of the current frame of events when recording.
+   static void endFrame( void );
+
+   /// Record an event about to be dispatched.
+   static void recordEvent( const Event* pEvent );
+
+   /// Dispatch the next recorded frame of events.
+   static void replayFrame( void );
+};
+
+#endif // _EVENT_JOURNAL_H_
@@ -0,0 +1,68 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+/*! Start recording the dispatched input, network, time and console events to a journal file.
+    @param fileName The journal file to write.
+    @return Whether recording started.
+    @sa playEventJournal
+*/
+ConsoleFunctionWithDocs( recordEventJournal, ConsoleBool, 2, 2, ( fileName ))
+{
+   char fileName[1024];
+   Con::expandPath( fileName, sizeof(fileName), argv[1] );
+   return EventJournal::startRecording( fileName );
+}
+
+/*! Replay a journal recorded with recordEventJournal as fast as possible.
+    Live events are ignored until the replay ends.
+    @param fileName The journal file to replay.
+    @param quitWhenDone Whether to quit once the replay ends.  Defaults to false.
+    @return Whether the replay started.
+    @sa recordEventJournal
+*/
+ConsoleFunctionWithDocs( playEventJournal, ConsoleBool, 2, 3, ( fileName, [quitWhenDone] ))
+{
+   char fileName[1024];
+   Con::expandPath( fileName, sizeof(fileName), argv[1] );
+   return EventJournal::startReplay( fileName, argc > 2 ? dAtob(argv[2]) : false );
+}
+
+/*! Stop recording or replaying the event journal.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs( stopEventJournal, ConsoleVoid, 1, 1, ())
+{
+   EventJournal::stop();
+}
+
+/*! Get the current event journal mode.
+    @return "off", "record" or "replay".
+*/
+ConsoleFunctionWithDocs( getEventJournalMode, ConsoleString, 1, 1, ())
+{
+   switch( EventJournal::getMode() )
+   {
+      case EventJournal::JournalRecord: return "record";
+      case EventJournal::JournalReplay: return "replay";
+      default:                          return "off";
+   }
+}
@@ -26,6 +26,8 @@
 #include "io/fileStream.h"
 #include "console/console.h"
 #include "platform/threads/mutex.h"
+#include "debug/profiler.h"
+#include "game/eventJournal.h"
 
 // Script binding.
 #include "game/gameInterface_ScriptBinding.h"
@@ -33,6 +35,7 @@
 GameInterface *Game = NULL;
 void *gGameEventQueueMutex = NULL;
 FileStream gJournalStream;
+bool gCoalesceInputEvents = true;
 
 #ifdef TORQUE_DEBUG
 static U32 sReentrantCount = 0;
@@ -74,6 +77,9 @@ void GameInterface::processEvent(Event *event)
    AssertFatal(sReentrantCount == 1, "Error! ProcessEvent is NOT re-entrant.");
 #endif
 
+   if(EventJournal::isRecording())
+      EventJournal::recordEvent(event);
+
    switch(event->type)
    {
       case PacketReceiveEventType:
@@ -122,6 +128,10 @@ void GameInterface::postEvent(Event &event)
       return;
 #endif //TORQUE_ALLOW_JOURNALING
 
+   // Live events are replaced by the journal while it is replaying.
+   if(EventJournal::isReplaying() && event.type != QuitEventType)
+      return;
+
    // Only one thread can post at a time.
    Mutex::lockMutex(gGameEventQueueMutex);
 
@@ -159,6 +169,10 @@ void GameInterface::processEvents()
          eventQueue = &eventQueue1;
    Mutex::unlockMutex(gGameEventQueueMutex);
 
+   // High-rate analog devices can queue many events per frame so only dispatch the latest.
+   if(gCoalesceInputEvents)
+      coalesceInputEvents(fullEventQueue);
+
    // Walk the event queue in fifo order, processing the events, then clear the queue.
    for(int i=0; i < fullEventQueue.size(); i++)
    {
@@ -167,8 +181,93 @@ void GameInterface::processEvents()
    }
    fullEventQueue.clear();
 
+   // Dispatch the next journaled frame or close the frame being recorded.
+   if(EventJournal::isReplaying())
+      EventJournal::replayFrame();
+   else if(EventJournal::isRecording())
+      EventJournal::endFrame();
+}
+
+//-----------------------------------------------------------------------------
+
+static inline bool isCoalescableInputEvent(const Event *event)
+{
+   if(event->type != InputEventType)
+      return false;
+
+   const InputEvent *inputEvent = (const InputEvent *) event;
+   return inputEvent->action == SI_MOVE &&
+          (inputEvent->deviceType == MouseDeviceType ||
+           inputEvent->deviceType == JoystickDeviceType ||
+           inputEvent->deviceType == GamepadDeviceType);
+}
+
+void GameInterface::coalesceInputEvents(Vector<Event*> &queue)
+{
+   PROFILE_SCOPE(CoalesceInputEvents);
+
+   // Queue indices of the analog events that can still be merged.
+   Vector<S32> pendingEvents;
+   bool coalesced = false;
+
+   for(S32 i = 0; i < queue.size(); i++)
+   {
+      // Any other event is a barrier so that analog values stay ordered with respect to
+      // buttons, keys and time events.
+      if(!isCoalescableInputEvent(queue[i]))
+      {
+         pendingEvents.clear();
+         continue;
+      }
+
+      InputEvent *inputEvent = (InputEvent *) queue[i];
+
+      // Find an earlier event for the same axis.
+      S32 p;
+      for(p = 0; p < pendingEvents.size(); p++)
+      {
+         InputEvent *pendingEvent = (InputEvent *) queue[pendingEvents[p]];
+         if(pendingEvent->deviceType == inputEvent->deviceType &&
+            pendingEvent->deviceInst == inputEvent->deviceInst &&
+            pendingEvent->objType    == inputEvent->objType &&
+            pendingEvent->objInst    == inputEvent->objInst &&
+            pendingEvent->modifier   == inputEvent->modifier)
+            break;
+      }
+
+      if(p == pendingEvents.size())
+      {
+         pendingEvents.push_back(i);
+         continue;
+      }
+
+      // Mouse axes report relative motion so accumulate it whereas other axes
+      // report an absolute value so the latest one wins.
+      InputEvent *pendingEvent = (InputEvent *) queue[pendingEvents[p]];
+      if(inputEvent->deviceType == MouseDeviceType)
+         inputEvent->fValues[0] += pendingEvent->fValues[0];
+
+      dFree(pendingEvent);
+      queue[pendingEvents[p]] = NULL;
+      pendingEvents[p] = i;
+      coalesced = true;
+   }
+
+   if(!coalesced)
+      return;
+
+   // Remove the merged events.
+   S32 count = 0;
+   for(S32 i = 0; i < queue.size(); i++)
+   {
+      if(queue[i] != NULL)
+         queue[count++] = queue[i];
+   }
+   queue.setSize(count);
 }
 
+//-----------------------------------------------------------------------------
+
 void GameInterface::journalProcess()
 {
 #ifdef TORQUE_ALLOW_JOURNALING
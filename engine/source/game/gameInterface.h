@@ -43,6 +43,9 @@ private:
 
    /// Events are stored here by any thread, for processing by the main thread.
    Vector<Event*> eventQueue1, eventQueue2, *eventQueue;
+
+   /// Coalesce consecutive analog input events for the same axis in the queue.
+   void coalesceInputEvents(Vector<Event*> &queue);
    
 public:
    GameInterface();
@@ -158,4 +161,7 @@ public:
 /// Global game instance.
 extern GameInterface* Game;
 
+/// Whether analog input events are coalesced each frame ($Input::coalesceEvents).
+extern bool gCoalesceInputEvents;
+
 #endif
@@ -128,9 +128,9 @@ void GuiGridControl::addObject(SimObject *obj)
 
 void GuiGridControl::removeObject(SimObject *obj)
 {
-	for(int idx =0; idx < objectList.size();idx++)
+	for(int idx =0; idx < size();idx++)
 	{
-		if ( objectList[idx] == obj )
+		if ( at(idx) == obj )
 		{
 			mOrginalControlPos.erase(idx);
 			break;
@@ -618,13 +618,13 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
    // hierarchy.  This can be set as the clip rectangle in most cases.
    RectI clipRect = updateRect;
 
-   S32 size = objectList.size();
+   S32 size = SimSet::size();
    S32 size_cpy = size;
     //-Mat look through our vector all normal-like, trying to use an iterator sometimes gives us
    //bad cast on good objects
-   for( S32 count = 0; count < objectList.size(); count++ )
+   for( S32 count = 0; count < SimSet::size(); count++ )
    {
-      GuiControl *ctrl = (GuiControl *)objectList[count];
+      GuiControl *ctrl = (GuiControl *)at(count);
       if( ctrl == NULL ) {
           Con::errorf( "GuiControl::renderChildControls() object %i is NULL", count );
         continue;
@@ -641,7 +641,7 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
             ctrl->onRender(childPosition, childClip);
          }
       }
-      size_cpy = objectList.size(); //	CHRIS: i know its wierd but the size of the list changes sometimes during execution of this loop
+      size_cpy = SimSet::size(); //	CHRIS: i know its wierd but the size of the list changes sometimes during execution of this loop
       if(size != size_cpy)
       {
           size = size_cpy;
@@ -85,6 +85,43 @@ ActionMap::DeviceMap::~DeviceMap()
    }
 }
 
+//------------------------------------------------------------------------------
+S32 ActionMap::DeviceMap::findNodeIndex(const U32 modifiers, const U32 action)
+{
+   // Rebuild the index if nodes have been removed.  Nodes are indexed in reverse
+   //  so that the first node for any modifiers/action pair is the one indexed.
+   if (nodeIndexDirty)
+   {
+      nodeIndex.clear();
+      for (S32 i = nodeMap.size() - 1; i >= 0; i--)
+         nodeIndex[getNodeKey(nodeMap[i].modifiers, nodeMap[i].action)] = i;
+
+      nodeIndexDirty = false;
+   }
+
+   HashMap<U32, S32>::iterator itr = nodeIndex.find(getNodeKey(modifiers, action));
+   return itr != nodeIndex.end() ? itr->value : -1;
+}
+
+//------------------------------------------------------------------------------
+ActionMap::DeviceMap* ActionMap::findDeviceMap(const U32 inDeviceType, const U32 inDeviceInst)
+{
+   // Use the index for the usual small device instances.
+   if (inDeviceInst <= 0xFFFF)
+   {
+      HashMap<U32, DeviceMap*>::iterator itr = mDeviceMapIndex.find((inDeviceType << 16) | inDeviceInst);
+      return itr != mDeviceMapIndex.end() ? itr->value : NULL;
+   }
+
+   for (U32 i = 0; i < (U32)mDeviceMaps.size(); i++)
+   {
+      if (mDeviceMaps[i]->deviceType == inDeviceType && mDeviceMaps[i]->deviceInst == inDeviceInst)
+         return mDeviceMaps[i];
+   }
+
+   return NULL;
+}
+
 //------------------------------------------------------------------------------
 bool ActionMap::onAdd()
 {
@@ -402,18 +439,7 @@ bool ActionMap::createEventDescriptor(const char* pEventString, EventDescriptor*
 ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceInst,
                    const U32 inModifiers,  const U32 inAction,SimObject* object /*= NULL*/)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
-   U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++) 
-   {
-      if (mDeviceMaps[i]->deviceType == inDeviceType &&
-          mDeviceMaps[i]->deviceInst == inDeviceInst) {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
+   DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
    if (pDeviceMap == NULL) 
    {
       mDeviceMaps.increment();
@@ -422,8 +448,12 @@ ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceIn
 
       pDeviceMap->deviceInst = inDeviceInst;
       pDeviceMap->deviceType = inDeviceType;
+
+      if (inDeviceInst <= 0xFFFF)
+         mDeviceMapIndex.insert((inDeviceType << 16) | inDeviceInst, pDeviceMap);
    }
 
+   U32 i;
    for (i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++) 
    {
       if (pDeviceMap->nodeMap[i].modifiers == inModifiers &&
@@ -453,23 +483,19 @@ ActionMap::Node* ActionMap::getNode(const U32 inDeviceType, const U32 inDeviceIn
    //[neob, 5/7/2007 - #2975]
    pRetNode->object = 0;
 
+   // Index the node if it's the first for its modifiers/action.
+   const U32 nodeKey = DeviceMap::getNodeKey(inModifiers, inAction);
+   if (!pDeviceMap->nodeIndexDirty && !pDeviceMap->nodeIndex.contains(nodeKey))
+      pDeviceMap->nodeIndex.insert(nodeKey, pDeviceMap->nodeMap.size() - 1);
+
    return pRetNode;
 }
 
 //------------------------------------------------------------------------------
 void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const U32 inModifiers, const U32 inAction, SimObject* object /*= NULL*/)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
+   DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
    U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++) {
-      if (mDeviceMaps[i]->deviceType == inDeviceType &&
-          mDeviceMaps[i]->deviceInst == inDeviceInst) {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
 
    if (pDeviceMap == NULL)
       return;
@@ -492,6 +518,9 @@ void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const
           dFree(pDeviceMap->nodeMap[i].makeConsoleCommand);
           dFree(pDeviceMap->nodeMap[i].breakConsoleCommand);
           pDeviceMap->nodeMap.erase(i);
+
+          // The node indices have changed.
+          pDeviceMap->nodeIndexDirty = true;
       }
    }
 }
@@ -500,18 +529,7 @@ void ActionMap::removeNode(const U32 inDeviceType, const U32 inDeviceInst, const
 const ActionMap::Node* ActionMap::findNode(const U32 inDeviceType, const U32 inDeviceInst,
                     const U32 inModifiers,  const U32 inAction)
 {
-   // DMMTODO - Slow INITIAL implementation.  Replace with a faster version...
-   //
-   DeviceMap* pDeviceMap = NULL;
-   U32 i;
-   for (i = 0; i < (U32)mDeviceMaps.size(); i++)
-   {
-      if (mDeviceMaps[i]->deviceType == inDeviceType && mDeviceMaps[i]->deviceInst == inDeviceInst)
-      {
-         pDeviceMap = mDeviceMaps[i];
-         break;
-      }
-   }
+   DeviceMap* pDeviceMap = findDeviceMap(inDeviceType, inDeviceInst);
 
    if (pDeviceMap == NULL)
       return NULL;
@@ -526,15 +544,16 @@ const ActionMap::Node* ActionMap::findNode(const U32 inDeviceType, const U32 inD
    if (realMods & SI_MAC_OPT)
       realMods |= SI_MAC_OPT;
 
-   for (i = 0; i < (U32)pDeviceMap->nodeMap.size(); i++)
+   // Find the first matching node, an "any key" node matches any decent character.
+   S32 nodeIndex = pDeviceMap->findNodeIndex(realMods, inAction);
+   if (inAction != KEY_ANYKEY && dIsDecentChar(inAction))
    {
-      if (pDeviceMap->nodeMap[i].action == KEY_ANYKEY && pDeviceMap->nodeMap[i].modifiers == realMods && dIsDecentChar(inAction))
-         return &pDeviceMap->nodeMap[i];
-      else if (pDeviceMap->nodeMap[i].modifiers == realMods && pDeviceMap->nodeMap[i].action    == inAction)
-         return &pDeviceMap->nodeMap[i];
+      const S32 anyKeyIndex = pDeviceMap->findNodeIndex(realMods, KEY_ANYKEY);
+      if (anyKeyIndex != -1 && (nodeIndex == -1 || anyKeyIndex < nodeIndex))
+         nodeIndex = anyKeyIndex;
    }
 
-   return NULL;
+   return nodeIndex != -1 ? &pDeviceMap->nodeMap[nodeIndex] : NULL;
 }
 
 //------------------------------------------------------------------------------
@@ -33,6 +33,9 @@
 #ifndef _SIMBASE_H_
 #include "sim/simBase.h"
 #endif
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
 
 struct InputEvent;
 
@@ -85,10 +88,20 @@ class ActionMap : public SimObject
       U32 deviceInst;
 
       Vector<Node> nodeMap;
+
+      /// Index of the first node for each modifiers/action pair.
+      /// This is rebuilt on demand when nodes are removed.
+      HashMap<U32, S32> nodeIndex;
+      bool nodeIndexDirty;
+
       DeviceMap() {
          VECTOR_SET_ASSOCIATION(nodeMap);
+         nodeIndexDirty = false;
       }
       ~DeviceMap();
+
+      static inline U32 getNodeKey(const U32 modifiers, const U32 action) { return (modifiers << 16) | (action & 0xFFFF); }
+      S32 findNodeIndex(const U32 modifiers, const U32 action);
    };
    struct BreakEntry
    {
@@ -116,8 +129,12 @@ class ActionMap : public SimObject
 
 
    Vector<DeviceMap*>        mDeviceMaps;
+   HashMap<U32, DeviceMap*>  mDeviceMapIndex;
    static Vector<BreakEntry> smBreakTable;
 
+   /// Find the device map for a device or NULL if the device has no bindings.
+   DeviceMap* findDeviceMap(const U32 inDeviceType, const U32 inDeviceInst);
+
    // Find: return NULL if not found in current map, Get: create if not
    //  found.
    const Node* findNode(const U32 inDeviceType, const U32 inDeviceInst,
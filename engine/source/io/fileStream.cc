@@ -23,6 +23,8 @@
 #include "fileStream.h"
 #include "platform/platform.h"
 #include "math/mMath.h"
+#include "io/resource/resourceManager.h"
+#include "console/console.h"
 
 //-----------------------------------------------------------------------------
 // FileStream methods...
@@ -148,6 +150,11 @@ bool FileStream::open(const char *i_pFilename, AccessMode i_openMode)
          default:
             AssertFatal(false, "FileStream::open: bad access mode");
       }
+
+      // A file may have been created so the resource manager must not keep it
+      // as missing.  Its lookup cache is only used on the main thread.
+      if (i_openMode != Read && ResourceManager && Con::isMainThread())
+         ResourceManager->invalidateFileCacheForFile(i_pFilename);
    }
    else
    {
@@ -38,6 +38,7 @@
 #include "console/consoleTypes.h"
 
 #include "memory/safeDelete.h"
+#include "debug/profiler.h"
 
 #include "resourceManager_ScriptBinding.h"
 
@@ -90,6 +91,10 @@ ResManager::ResManager ()
    registeredList = NULL;
    mLoggingMissingFiles = false;
    usingVFS = false;
+   mFileStatCount = 0;
+   mListingCount = 0;
+   mListingHitCount = 0;
+   mMissingHitCount = 0;
 }
 
 void ResManager::fileIsMissing(const char *fileName)
@@ -183,6 +188,8 @@ ResManager::~ResManager ()
       delete registeredList;
       registeredList = temp;
    }
+
+   invalidateFileCache();
 }
 
 #ifdef TORQUE_DEBUG
@@ -198,6 +205,9 @@ void ResManager::dumpResources (const bool onlyLoaded)
       }
       walk = walk->nextResource;
    }
+
+   Con::errorf ("Resource file lookups: %d file stats, %d directory listings (%d cached), %d listing hits, %d missing file hits",
+       mFileStatCount, mListingCount, mDirectoryListings.size(), mListingHitCount, mMissingHitCount);
 }
 
 #endif
@@ -531,11 +541,14 @@ void ResManager::initExcludedDirectories()
 
 void ResManager::addPath(const char *path, bool ignoreZips )
 {
+   invalidateFileCache();
    searchPath(path, true, ignoreZips );
 }
 
 void ResManager::removePath(const char *path)
 {
+   invalidateFileCache();
+
    ResourceObject *rwalk = resourceList.nextResource, *rtemp;
    while (rwalk != NULL)
    {
@@ -563,6 +576,8 @@ void ResManager::setModPaths (U32 numPaths, const char **paths)
    for(ResourceObject * pwalk = resourceList.nextResource; pwalk; pwalk = pwalk->nextResource)
       pwalk->flags |= ResourceObject::Added;
 
+   invalidateFileCache();
+
    U32 pathLen = 0;
 
    // Set up exclusions.
@@ -989,7 +1004,8 @@ ResourceObject *ResManager::find (const char *fileName)
    {
       // If we couldn't find the file in the resource list (generated
       // by setting the modPaths) then try to load it directly
-      if (Platform::isFile(fileName))
+      S32 fileSize;
+      if (lookupFile(fileName, path, file, fileSize))
       {
          ret = createResource (path, file);
          dictionary.pushBehind (ret, ResourceObject::File);
@@ -997,7 +1013,6 @@ ResourceObject *ResManager::find (const char *fileName)
          ret->flags = ResourceObject::File;
          ret->fileOffset = 0;
 
-         S32 fileSize = Platform::getFileSize(fileName);
          ret->fileSize = fileSize;
          ret->compressedFileSize = fileSize;
 
@@ -1011,6 +1026,162 @@ ResourceObject *ResManager::find (const char *fileName)
 
 //------------------------------------------------------------------------------
 
+bool ResManager::lookupFile(const char *fileName, StringTableEntry path, StringTableEntry file, S32 &fileSize)
+{
+   // Files with a path are found in the listing of their directory.
+   if (path)
+   {
+      const StringTableEntry listingPath = getListingPath(path);
+      DirectoryListing *listing;
+      typeDirectoryListingHash::iterator listingItr = mDirectoryListings.find(listingPath);
+      if (listingItr != mDirectoryListings.end())
+      {
+         listing = listingItr->value;
+         mListingHitCount++;
+      }
+      else
+      {
+         listing = listDirectory(listingPath);
+      }
+
+      HashTable<StringTableEntry, S32>::iterator itr = listing->mFiles.find(file);
+      if (itr == listing->mFiles.end())
+         return false;
+
+      fileSize = itr->value;
+      return true;
+   }
+
+   // Skip files already known to be missing.
+   if (mMissingFiles.find(file) != mMissingFiles.end())
+   {
+      mMissingHitCount++;
+      return false;
+   }
+
+   mFileStatCount++;
+   if (!Platform::isFile(fileName))
+   {
+      mMissingFiles.insertUnique(file, true);
+      return false;
+   }
+
+   mFileStatCount++;
+   fileSize = Platform::getFileSize(fileName);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+StringTableEntry ResManager::getListingPath(const char *path) const
+{
+   // Platform::isFile() resolves a relative path against the current directory
+   // but Platform::dumpPath() may also list other directories for it, such as
+   // the preferences directory on Unix, so list the full path.
+   char fullPath[1024];
+   Platform::makeFullPathName(path, fullPath, sizeof(fullPath));
+   return StringTable->insert(fullPath);
+}
+
+//------------------------------------------------------------------------------
+
+ResManager::DirectoryListing* ResManager::listDirectory(StringTableEntry listingPath)
+{
+   PROFILE_SCOPE(ResManager_ListDirectory);
+
+   // List the files in the directory. A missing directory has an empty listing.
+   DirectoryListing *listing = new DirectoryListing;
+   Vector<Platform::FileInfo> fileInfoVec;
+   Platform::dumpPath(listingPath, fileInfoVec, 0);
+   for (S32 i = 0; i < fileInfoVec.size(); i++)
+      listing->mFiles.insertUnique(fileInfoVec[i].pFileName, fileInfoVec[i].fileSize);
+
+   mDirectoryListings.insertUnique(listingPath, listing);
+   mListingCount++;
+   return listing;
+}
+
+//------------------------------------------------------------------------------
+
+void ResManager::invalidateFileCache(const char *path)
+{
+   if (path)
+   {
+      // Forget the one directory.
+      typeDirectoryListingHash::iterator itr = mDirectoryListings.find(getListingPath(path));
+      if (itr != mDirectoryListings.end())
+      {
+         delete itr->value;
+         mDirectoryListings.erase(itr);
+      }
+   }
+   else
+   {
+      // Forget all the directories.
+      for (typeDirectoryListingHash::iterator itr = mDirectoryListings.begin(); itr != mDirectoryListings.end(); ++itr)
+         delete itr->value;
+      mDirectoryListings.clear();
+   }
+
+   mMissingFiles.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void ResManager::invalidateFileCacheForFile(const char *fileName)
+{
+   // Find the directory the file is in.
+   char filePath[1024];
+   Platform::makeFullPathName(fileName, filePath, sizeof(filePath));
+   char *pSlash = dStrrchr(filePath, '/');
+   if (pSlash)
+      *pSlash = 0;
+
+   invalidateFileCache(filePath);
+}
+
+//------------------------------------------------------------------------------
+
+void ResManager::fileChanged(const char *fileName)
+{
+   if (!fileName)
+      return;
+
+   StringTableEntry path, file;
+   getPaths (fileName, path, file);
+
+   // The listing of the directory no longer matches the disk.
+   if (path)
+      invalidateFileCache(path);
+   else
+      mMissingFiles.clear();
+
+   // Only loose files are tracked on disk.
+   ResourceObject *obj = dictionary.find (path, file);
+   if (!obj || !(obj->flags & ResourceObject::File))
+      return;
+
+   // Drop an unlocked cached instance so it is reloaded on demand.
+   if (obj->mInstance && obj->lockCount == 0)
+      purge (obj);
+
+   const S32 fileSize = Platform::getFileSize(fileName);
+   if (fileSize >= 0)
+   {
+      // The file was modified or recreated.
+      obj->fileSize = fileSize;
+      obj->compressedFileSize = fileSize;
+      obj->crc = InvalidCRC;
+   }
+   else if (!obj->mInstance)
+   {
+      // The file was deleted.
+      freeResource (obj);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 ResourceObject *ResManager::find (const char *fileName, U32 flags)
 {
    if (!fileName)
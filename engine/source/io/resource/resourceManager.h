@@ -32,6 +32,9 @@
 #ifndef _STRINGTABLE_H_
 #include "string/stringTable.h"
 #endif
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
 
 #ifndef _FILESTREAM_H_
 #include "io/fileStream.h"
@@ -388,6 +391,39 @@ private:
 
    RegisteredExtension *registeredList;
 
+   /// @name File Lookup Cache
+   /// Files outside the dictionary are looked up in cached directory listings
+   /// rather than by querying the file system each time.  Directories are listed
+   /// by their full path so that a listing holds exactly the files that
+   /// Platform::isFile() would find.  Files without a path that are missing are
+   /// remembered too.
+   /// @{
+
+   struct DirectoryListing
+   {
+      HashTable<StringTableEntry, S32> mFiles;     ///< File sizes by name.
+   };
+
+   typedef HashTable<StringTableEntry, DirectoryListing*> typeDirectoryListingHash;
+   typeDirectoryListingHash mDirectoryListings;    ///< Directory listings by full path.
+   HashTable<StringTableEntry, bool> mMissingFiles;///< Missing files without a path.
+
+   U32 mFileStatCount;                             ///< File system queries for single files.
+   U32 mListingCount;                              ///< Directory listings made.
+   U32 mListingHitCount;                           ///< Lookups answered by an already cached directory listing.
+   U32 mMissingHitCount;                           ///< Lookups answered by the missing files.
+
+   /// Look a file up on disk, using the cache.
+   bool lookupFile(const char *fileName, StringTableEntry path, StringTableEntry file, S32 &fileSize);
+
+   /// Get the full path that a directory is listed by.
+   StringTableEntry getListingPath(const char *path) const;
+
+   /// List a directory and cache the listing.
+   DirectoryListing* listDirectory(StringTableEntry listingPath);
+
+   /// @}
+
    static const char *smExcludedDirectories;
    ResManager();
 public:
@@ -414,6 +450,25 @@ public:
    void addPath(const char *path, bool ignoreZips=false);///< Add a path
    void removePath(const char *path);                 ///< Remove a path. Only removes resources that are not loaded.
 
+   /// Forget cached file lookups so that the file system is queried again.
+   /// @param path The directory that changed or NULL for all of them.
+   void invalidateFileCache(const char *path = NULL);
+
+   /// Forget the cached listing of the directory a file is in.
+   /// @param fileName The file that was created or written.
+   void invalidateFileCacheForFile(const char *fileName);
+
+   /// Get the file lookup statistics.
+   inline U32 getFileStatCount() const { return mFileStatCount; }
+   inline U32 getListingCount() const { return mListingCount; }
+   inline U32 getListingHitCount() const { return mListingHitCount; }
+   inline U32 getMissingHitCount() const { return mMissingHitCount; }
+
+   /// Brings the dictionary in line with a file that was modified, created or
+   /// deleted on disk.  Unlocked cached instances are purged so that the next
+   /// load reads the new contents.
+   void fileChanged(const char *fileName);
+
    void setMissingFileLogging(bool log);              ///< Should we log missing files?
    bool getMissingFileList(Vector<char *> &list);     ///< Gets which files are missing
    void clearMissingFileList();                       ///< Clears the missing file list
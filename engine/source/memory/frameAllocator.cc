@@ -0,0 +1,295 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "memory/frameAllocator.h"
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+FRAME_ALLOCATOR_THREAD_LOCAL FrameAllocatorArena* FrameAllocator::smpThreadArena = NULL;
+
+static Mutex                gArenaMutex;
+static FrameAllocatorArena* gpArenas = NULL;
+
+//-----------------------------------------------------------------------------
+
+FrameAllocatorArena::FrameAllocatorArena(const U32 size) :
+   mWaterMark(0),
+   mBlockCount(1),
+   mThreadId(ThreadManager::getCurrentThreadId()),
+   mCapacity(0),
+   mGrowCount(0),
+   mPeakWaterMark(0),
+   mFramePeakWaterMark(0),
+   mLastFramePeakWaterMark(0),
+   mpNextArena(NULL)
+{
+   mpFirstBlock = mpCurrentBlock = createBlock(0, size);
+   mCapacity.store(mpFirstBlock->getEnd(), std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocatorArena::~FrameAllocatorArena()
+{
+   AssertFatal(mWaterMark == 0, "FrameAllocatorArena - Destroying an arena with allocations outstanding.");
+
+   while (mpFirstBlock != NULL)
+   {
+      Block* pNext = mpFirstBlock->mpNext;
+      delete [] reinterpret_cast<U8*>(mpFirstBlock);
+      mpFirstBlock = pNext;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocatorArena::Block* FrameAllocatorArena::createBlock(const U32 base, const U32 size)
+{
+   // Keep block sizes aligned so that every block starts on an aligned watermark.
+   const U32 alignedSize = (size + (TORQUE_BYTE_ALIGNMENT - 1)) & (~(TORQUE_BYTE_ALIGNMENT - 1));
+
+   Block* pBlock = reinterpret_cast<Block*>(new U8[sizeof(Block) + alignedSize]);
+   pBlock->mpNext = NULL;
+   pBlock->mBase = base;
+   pBlock->mSize = alignedSize;
+
+   return pBlock;
+}
+
+//-----------------------------------------------------------------------------
+
+void* FrameAllocatorArena::allocBlock(const U32 allocSize)
+{
+   U32 _allocSize = allocSize;
+#ifdef TORQUE_DEBUG
+   _allocSize += 4;
+#endif
+
+   // Move along the chain to the first following block the allocation fits in.
+   Block* pBlock = mpCurrentBlock->mpNext;
+   Block* pLastBlock = mpCurrentBlock;
+   while (pBlock != NULL && pBlock->mSize < _allocSize)
+   {
+      pLastBlock = pBlock;
+      pBlock = pBlock->mpNext;
+   }
+
+   // Grow the chain if none of the blocks fit.
+   if (pBlock == NULL)
+   {
+      while (pLastBlock->mpNext != NULL)
+         pLastBlock = pLastBlock->mpNext;
+
+      AssertFatal(pLastBlock->getEnd() <= U32_MAX - getMax(pLastBlock->mSize * 2, _allocSize), "FrameAllocatorArena - Frame allocations have exhausted the address range.");
+
+      pBlock = createBlock(pLastBlock->getEnd(), getMax(pLastBlock->mSize * 2, _allocSize));
+      pLastBlock->mpNext = pBlock;
+
+      mBlockCount++;
+      mGrowCount.fetch_add(1, std::memory_order_relaxed);
+      mCapacity.store(pBlock->getEnd(), std::memory_order_relaxed);
+   }
+
+   mpCurrentBlock = pBlock;
+   mWaterMark = pBlock->mBase + _allocSize;
+
+   // Track the peak.
+   if (mWaterMark > mFramePeakWaterMark.load(std::memory_order_relaxed))
+   {
+      mFramePeakWaterMark.store(mWaterMark, std::memory_order_relaxed);
+      if (mWaterMark > mPeakWaterMark.load(std::memory_order_relaxed))
+         mPeakWaterMark.store(mWaterMark, std::memory_order_relaxed);
+   }
+
+   U8* p = pBlock->getData();
+
+#ifdef TORQUE_DEBUG
+   U32 *flag = (U32*) (p + _allocSize - 4);
+   *flag = 0xdeadbeef ^ mWaterMark;
+#endif
+
+   return p;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocatorArena::rewind(const U32 waterMark)
+{
+#ifdef TORQUE_FRAME_ALLOCATOR_POISON
+   // Poison the freed range in each block it covers.
+   for (Block* pBlock = mpFirstBlock; pBlock != NULL && pBlock->mBase < mWaterMark; pBlock = pBlock->mpNext)
+   {
+      const U32 start = getMax(waterMark, pBlock->mBase);
+      const U32 end = getMin(mWaterMark, pBlock->getEnd());
+      if (start < end)
+         dMemset(pBlock->getData() + (start - pBlock->mBase), FRAME_ALLOCATOR_POISON_BYTE, end - start);
+   }
+#endif
+
+   mWaterMark = waterMark;
+
+   // Replace the chain with a single block once nothing is allocated.
+   if (waterMark == 0 && mBlockCount > 1)
+   {
+      consolidate();
+      return;
+   }
+
+   // Find the block the watermark is in.
+   if (waterMark < mpCurrentBlock->mBase)
+   {
+      mpCurrentBlock = mpFirstBlock;
+      while (waterMark > mpCurrentBlock->getEnd())
+         mpCurrentBlock = mpCurrentBlock->mpNext;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocatorArena::consolidate()
+{
+   U32 size = 0;
+
+   while (mpFirstBlock != NULL)
+   {
+      Block* pNext = mpFirstBlock->mpNext;
+      size = mpFirstBlock->getEnd();
+      delete [] reinterpret_cast<U8*>(mpFirstBlock);
+      mpFirstBlock = pNext;
+   }
+
+   mpFirstBlock = mpCurrentBlock = createBlock(0, size);
+   mBlockCount = 1;
+}
+
+//-----------------------------------------------------------------------------
+
+FrameAllocatorArena* FrameAllocator::createThreadArena(const U32 size)
+{
+   FrameAllocatorArena* pArena = new FrameAllocatorArena(size);
+
+   gArenaMutex.lock();
+   pArena->mpNextArena = gpArenas;
+   gpArenas = pArena;
+   gArenaMutex.unlock();
+
+   smpThreadArena = pArena;
+
+   return pArena;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::init(const U32 frameSize)
+{
+   AssertFatal(smpThreadArena == NULL, "Error, already initialized");
+   createThreadArena(frameSize);
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::destroy()
+{
+   AssertFatal(smpThreadArena != NULL, "Error, not initialized");
+
+   // Destroy the remaining arenas.  Threads must release their own arena with
+   // destroyThreadArena() before exiting so only the calling thread's arena is left.
+   U32 foreignArenas = 0;
+   gArenaMutex.lock();
+   while (gpArenas != NULL)
+   {
+      if (gpArenas != smpThreadArena)
+         foreignArenas++;
+
+      FrameAllocatorArena* pNext = gpArenas->mpNextArena;
+      delete gpArenas;
+      gpArenas = pNext;
+   }
+   gArenaMutex.unlock();
+
+   AssertFatal(foreignArenas == 0, "FrameAllocator::destroy() - Arenas of other threads remain; threads must call destroyThreadArena() before exiting.");
+
+   smpThreadArena = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::destroyThreadArena()
+{
+   FrameAllocatorArena* pArena = smpThreadArena;
+
+   // Finish if this thread never allocated.
+   if (pArena == NULL)
+      return;
+
+   gArenaMutex.lock();
+   for (FrameAllocatorArena** ppArena = &gpArenas; *ppArena != NULL; ppArena = &(*ppArena)->mpNextArena)
+   {
+      if (*ppArena == pArena)
+      {
+         *ppArena = pArena->mpNextArena;
+         break;
+      }
+   }
+   gArenaMutex.unlock();
+
+   delete pArena;
+   smpThreadArena = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::endFrame()
+{
+   gArenaMutex.lock();
+   for (FrameAllocatorArena* pArena = gpArenas; pArena != NULL; pArena = pArena->mpNextArena)
+      pArena->mLastFramePeakWaterMark.store(pArena->mFramePeakWaterMark.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+   gArenaMutex.unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameAllocator::getArenaStats(Vector<ArenaStats>& stats)
+{
+   stats.clear();
+
+   gArenaMutex.lock();
+   for (FrameAllocatorArena* pArena = gpArenas; pArena != NULL; pArena = pArena->mpNextArena)
+   {
+      ArenaStats arenaStats;
+      arenaStats.mThreadId = pArena->mThreadId;
+      arenaStats.mCapacity = pArena->mCapacity.load(std::memory_order_relaxed);
+      arenaStats.mGrowCount = pArena->mGrowCount.load(std::memory_order_relaxed);
+      arenaStats.mPeakWaterMark = pArena->mPeakWaterMark.load(std::memory_order_relaxed);
+      arenaStats.mLastFramePeakWaterMark = pArena->mLastFramePeakWaterMark.load(std::memory_order_relaxed);
+      stats.push_back(arenaStats);
+   }
+   gArenaMutex.unlock();
+}
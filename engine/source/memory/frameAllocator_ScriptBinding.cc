@@ -23,24 +23,37 @@
 #include "frameAllocator.h"
 #include "console/console.h"
 
-U8*   FrameAllocator::smBuffer = NULL;
-U32   FrameAllocator::smWaterMark = 0;
-U32   FrameAllocator::smHighWaterMark = 0;
-
-#if defined(TORQUE_DEBUG)
-
 /*! @defgroup MemoryFrameAllocation Memory Frames
 	@ingroup TorqueScriptFunctions
 	@{
 */
 
-/*!
+/*! Gets the peak frame allocation of the calling thread.
+
+    @return The most memory, in bytes, that the calling thread has had allocated from its frame allocator arena.
 */
 ConsoleFunctionWithDocs(getMaxFrameAllocation, S32, 1,1, ())
 {
-   return sgMaxFrameAllocation;
+   return FrameAllocator::getPeakWaterMark();
 }
 
-/*! @} */ // end group MemoryFrameAllocation
+/*! Prints the frame allocator arena of each thread.
+
+    Each arena shows its capacity, how often it has grown, its peak allocation and its peak allocation during the last frame.
+    @return No return value.
+*/
+ConsoleFunctionWithDocs(dumpFrameAllocatorStats, ConsoleVoid, 1, 1, ())
+{
+   Vector<FrameAllocator::ArenaStats> stats;
+   FrameAllocator::getArenaStats(stats);
 
-#endif
+   Con::printf("Frame allocator arenas:");
+   for (S32 i = 0; i < stats.size(); i++)
+   {
+      const FrameAllocator::ArenaStats& arenaStats = stats[i];
+      Con::printf("  Thread %u: capacity %d, grown %d, peak %d, last frame peak %d",
+         (U32)arenaStats.mThreadId, arenaStats.mCapacity, arenaStats.mGrowCount, arenaStats.mPeakWaterMark, arenaStats.mLastFramePeakWaterMark);
+   }
+}
+
+/*! @} */ // end group MemoryFrameAllocation
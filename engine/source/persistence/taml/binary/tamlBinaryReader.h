@@ -46,7 +46,7 @@ public:
     virtual ~TamlBinaryReader() {}
 
     /// Read.
-    SimObject* read( FileStream& stream );
+    SimObject* read( Stream& stream );
 
 private:
     Taml* mpTaml;
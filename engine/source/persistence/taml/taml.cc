@@ -307,6 +307,35 @@ SimObject* Taml::read( const char* pFilename )
 
 //-----------------------------------------------------------------------------
 
+SimObject* Taml::readBinary( Stream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Taml_ReadBinary);
+
+    // Reset the compilation.
+    resetCompilation();
+
+    // Create reader.
+    TamlBinaryReader reader( this );
+
+    // Read object.
+    SimObject* pSimObject = reader.read( stream );
+
+    // Reset the compilation.
+    resetCompilation();
+
+    // Did we generate an object?
+    if ( pSimObject == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Taml::readBinary() - Failed to load an object from the stream." );
+    }
+
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
 bool Taml::write( FileStream& stream, SimObject* pSimObject, const TamlFormatMode formatMode )
 {
     // Sanity!
@@ -751,28 +780,28 @@ void Taml::compileDynamicFields( TamlWriteNode* pTamlWriteNode )
     Vector<SimFieldDictionary::Entry*> dynamicFieldList(__FILE__, __LINE__);
 
     // Ensure the dynamic field doesn't conflict with static field.
-    for( U32 hashIndex = 0; hashIndex < SimFieldDictionary::HashTableSize; ++hashIndex )
+    for( SimFieldDictionaryIterator fieldItr( pFieldDictionary ); *fieldItr; ++fieldItr )
     {
-        for( SimFieldDictionary::Entry* pEntry = pFieldDictionary->mHashTable[hashIndex]; pEntry; pEntry = pEntry->next )
+        // Fetch entry.
+        SimFieldDictionary::Entry* pEntry = *fieldItr;
+
+        // Iterate static fields.
+        U32 fieldIndex;
+        for( fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
         {
-            // Iterate static fields.
-            U32 fieldIndex;
-            for( fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex )
-            {
-                if( fieldList[fieldIndex].pFieldname == pEntry->slotName)
-                    break;
-            }
+            if( fieldList[fieldIndex].pFieldname == pEntry->slotName)
+                break;
+        }
 
-            // Skip if found.
-            if( fieldIndex != (U32)fieldList.size() )
-                continue;
+        // Skip if found.
+        if( fieldIndex != (U32)fieldList.size() )
+            continue;
 
-            // Skip if not writing field.
-            if ( !pSimObject->writeField( pEntry->slotName, pEntry->value) )
-                continue;
+        // Skip if not writing field.
+        if ( !pSimObject->writeField( pEntry->slotName, pEntry->value) )
+            continue;
 
-            dynamicFieldList.push_back( pEntry );
-        }
+        dynamicFieldList.push_back( pEntry );
     }
 
     // Sort Entries to prevent version control conflicts
@@ -184,6 +184,9 @@ public:
     }
     SimObject* read( const char* pFilename );
 
+    /// Read a binary format object from any stream such as an in-memory buffer.
+    SimObject* readBinary( Stream& stream );
+
     /// Parse.
     bool parse( const char* pFilename, TamlVisitor& visitor );
 
@@ -144,6 +144,10 @@ public:
    /// @returns True if any ticks were sent
    /// @see clientProcess
    static bool advanceTime( U32 timeDelta );
+
+   /// Returns the number of milliseconds until the next tick boundary or U32_MAX
+   /// if no objects are processing ticks
+   static U32 getTimeToNextTick() { return getProcessList().size() == 0 ? U32_MAX : smLastDelta ? smLastDelta : smTickMs; }
 };
 
 
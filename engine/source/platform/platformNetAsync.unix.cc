@@ -25,6 +25,7 @@
 #include "platform/threads/thread.h"
 #include "platform/platformNetAsync.unix.h"
 #include "console/console.h"
+#include "sim/simBase.h"
 
 #include <netdb.h>
 #include <unistd.h>
@@ -147,6 +148,9 @@ void NetAsync::run()
             lookupRequest->out_h_length = hostent->h_length;
             lookupRequest->complete = true;
          }
+
+         // let the main loop pick up the result if it is waiting
+         Sim::wakeMainLoop();
       }
       else
       {
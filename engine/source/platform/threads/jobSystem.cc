@@ -0,0 +1,601 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/threads/jobSystem.h"
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+#include <thread>
+
+// Script bindings.
+#include "jobSystem_ScriptBinding.h"
+
+//-----------------------------------------------------------------------------
+
+#if defined(_MSC_VER)
+#define JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define JOB_THREAD_LOCAL __thread
+#endif
+
+//-----------------------------------------------------------------------------
+
+struct JobSystem::JobEntry
+{
+    Job         mJob;
+    JobCounter* mpCounter;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A locked double-ended queue of jobs.
+/// The owner takes its newest jobs from the back and thieves take the oldest from the front.
+class JobSystem::JobQueue
+{
+public:
+    JobQueue() : mHead( 0 ), mCount( 0 )
+    {
+        mJobs.setSize( 64 );
+    }
+
+    inline bool isEmpty( void ) const { return mCount.load( std::memory_order_relaxed ) == 0; }
+
+    void pushBack( const JobEntry& entry )
+    {
+        mMutex.lock();
+
+        // Grow if full.
+        const U32 count = mCount.load( std::memory_order_relaxed );
+        if ( count == (U32)mJobs.size() )
+        {
+            Vector<JobEntry> jobs;
+            jobs.setSize( count * 2 );
+            for ( U32 n = 0; n < count; ++n )
+                jobs[n] = mJobs[(mHead + n) % count];
+
+            mJobs = jobs;
+            mHead = 0;
+        }
+
+        mJobs[(mHead + count) % mJobs.size()] = entry;
+        mCount.store( count + 1, std::memory_order_relaxed );
+
+        mMutex.unlock();
+    }
+
+    bool popBack( JobEntry& entry )
+    {
+        // Finish early if empty.
+        if ( isEmpty() )
+            return false;
+
+        mMutex.lock();
+
+        const U32 count = mCount.load( std::memory_order_relaxed );
+        const bool found = count > 0;
+        if ( found )
+        {
+            entry = mJobs[(mHead + count - 1) % mJobs.size()];
+            mCount.store( count - 1, std::memory_order_relaxed );
+        }
+
+        mMutex.unlock();
+
+        return found;
+    }
+
+    bool popFront( JobEntry& entry )
+    {
+        // Finish early if empty.
+        if ( isEmpty() )
+            return false;
+
+        mMutex.lock();
+
+        const U32 count = mCount.load( std::memory_order_relaxed );
+        const bool found = count > 0;
+        if ( found )
+        {
+            entry = mJobs[mHead];
+            mHead = (mHead + 1) % mJobs.size();
+            mCount.store( count - 1, std::memory_order_relaxed );
+        }
+
+        mMutex.unlock();
+
+        return found;
+    }
+
+private:
+    Mutex               mMutex;
+    Vector<JobEntry>    mJobs;
+    U32                 mHead;
+    std::atomic<U32>    mCount;
+};
+
+//-----------------------------------------------------------------------------
+
+struct DeferredJob
+{
+    JobCounter* mpDependency;
+    Job         mJob;
+    JobCounter* mpCounter;
+};
+
+//-----------------------------------------------------------------------------
+
+U32 JobSystem::smWorkerCount = 0;
+Vector<JobSystem::JobWorker*> JobSystem::smWorkers;
+Vector<JobSystem::JobQueue*> JobSystem::smQueues;
+JobSystem::JobQueue* JobSystem::smpMainThreadQueue = NULL;
+
+static Semaphore*                       gJobSemaphore = NULL;
+static std::atomic<bool>                gJobShutdown( false );
+static std::atomic<U32>                 gNextJobQueue( 0 );
+static ThreadIdent                      gJobMainThreadId = 0;
+
+static Mutex                            gDeferredMutex;
+static Vector<DeferredJob>              gDeferredJobs;
+static std::atomic<U32>                 gDeferredCount( 0 );
+
+static std::atomic<U32>                 gJobsExecuted( 0 );
+static std::atomic<U32>                 gJobsStolen( 0 );
+static std::atomic<U32>                 gJobsMainThreadExecuted( 0 );
+static std::atomic<U32>                 gJobsDeferred( 0 );
+
+static JOB_THREAD_LOCAL S32             gJobWorkerIndex = -1;
+
+//-----------------------------------------------------------------------------
+
+class JobSystem::JobWorker : public Thread
+{
+public:
+    JobWorker( const S32 workerIndex ) :
+        Thread( 0, NULL, false ),
+        mWorkerIndex( workerIndex )
+    {}
+
+    virtual void run( void* arg )
+    {
+        gJobWorkerIndex = mWorkerIndex;
+
+        while ( true )
+        {
+            // Execute any job we can find.
+            JobEntry entry;
+            if ( JobSystem::findJob( mWorkerIndex, entry ) )
+            {
+                JobSystem::executeJob( entry );
+                continue;
+            }
+
+            // Sleep until more jobs are submitted.
+            gJobSemaphore->acquire();
+
+            if ( gJobShutdown.load() )
+                break;
+        }
+
+        FrameAllocator::destroyThreadArena();
+    }
+
+private:
+    S32 mWorkerIndex;
+};
+
+//-----------------------------------------------------------------------------
+
+U32 JobSystem::getDefaultWorkerCount( void )
+{
+    // Leave a core for the main thread which also executes jobs while it waits.
+    const U32 coreCount = std::thread::hardware_concurrency();
+    return coreCount > 1 ? coreCount - 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::init( const U32 workerCount )
+{
+    // Sanity!
+    AssertFatal( smQueues.size() == 0, "JobSystem::init() - Already initialized." );
+
+    gJobMainThreadId = ThreadManager::getCurrentThreadId();
+    gJobShutdown.store( false );
+    smpMainThreadQueue = new JobQueue();
+
+    const U32 count = workerCount > 0 ? workerCount : getDefaultWorkerCount();
+
+    // Finish if we're not using workers.
+    if ( count == 0 )
+    {
+        Con::printf( "Job system is executing jobs immediately without workers." );
+        return;
+    }
+
+    gJobSemaphore = new Semaphore( 0 );
+
+    // Create the worker queues before any worker can steal from them.
+    for ( U32 n = 0; n < count; ++n )
+        smQueues.push_back( new JobQueue() );
+
+    smWorkerCount = count;
+
+    // Start the workers.
+    for ( U32 n = 0; n < count; ++n )
+    {
+        JobWorker* pWorker = new JobWorker( (S32)n );
+        smWorkers.push_back( pWorker );
+        pWorker->start();
+    }
+
+    Con::printf( "Job system started with %d workers.", count );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::shutdown( void )
+{
+    // Execute anything left on the main thread.
+    processMainThreadJobs();
+
+    // Stop the workers.
+    if ( smWorkers.size() > 0 )
+    {
+        gJobShutdown.store( true );
+
+        for ( S32 n = 0; n < smWorkers.size(); ++n )
+            gJobSemaphore->release();
+
+        for ( S32 n = 0; n < smWorkers.size(); ++n )
+        {
+            smWorkers[n]->join();
+            delete smWorkers[n];
+        }
+        smWorkers.clear();
+    }
+
+    smWorkerCount = 0;
+
+    // Execute any remaining jobs here so no counter is left waiting.
+    JobEntry entry;
+    for ( S32 n = 0; n < smQueues.size(); ++n )
+    {
+        while ( smQueues[n]->popFront( entry ) )
+            executeJob( entry );
+
+        delete smQueues[n];
+    }
+    smQueues.clear();
+
+    delete smpMainThreadQueue;
+    smpMainThreadQueue = NULL;
+
+    delete gJobSemaphore;
+    gJobSemaphore = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::submit( const Job* pJobs, const U32 jobCount, JobCounter* pCounter, JobCounter* pDependency )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(JobSystem_Submit);
+
+    // Count the jobs before any can complete.
+    if ( pCounter != NULL )
+        pCounter->mCount.fetch_add( jobCount );
+
+    // Defer the jobs if they depend on a counter that isn't done.
+    if ( pDependency != NULL && !pDependency->isDone() )
+    {
+        gDeferredMutex.lock();
+
+        // Announce the deferral before checking again so a completing counter can't miss it.
+        gDeferredCount.fetch_add( jobCount );
+
+        if ( !pDependency->isDone() )
+        {
+            for ( U32 n = 0; n < jobCount; ++n )
+            {
+                DeferredJob deferredJob;
+                deferredJob.mpDependency = pDependency;
+                deferredJob.mJob = pJobs[n];
+                deferredJob.mpCounter = pCounter;
+                gDeferredJobs.push_back( deferredJob );
+            }
+
+            gJobsDeferred.fetch_add( jobCount, std::memory_order_relaxed );
+            gDeferredMutex.unlock();
+            return;
+        }
+
+        // The dependency completed meanwhile.
+        gDeferredCount.fetch_sub( jobCount );
+        gDeferredMutex.unlock();
+    }
+
+    for ( U32 n = 0; n < jobCount; ++n )
+    {
+        JobEntry entry;
+        entry.mJob = pJobs[n];
+        entry.mpCounter = pCounter;
+        enqueueJob( entry );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::wait( JobCounter& counter )
+{
+    // Finish if already done.
+    if ( counter.isDone() )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(JobSystem_Wait);
+
+    const bool mainThread = isMainThread();
+
+    // Execute jobs until the counter is done.
+    while ( !counter.isDone() )
+    {
+        JobEntry entry;
+        if ( (mainThread && smpMainThreadQueue != NULL && smpMainThreadQueue->popFront( entry )) || findJob( gJobWorkerIndex, entry ) )
+        {
+            executeJob( entry );
+            continue;
+        }
+
+        // A job may be blocked on the main thread executing script for it so process that work too.
+        if ( mainThread && Sim::processMainThreadQueue( 0 ) > 0 )
+            continue;
+
+        // Let whoever has the remaining jobs get on with them.
+        Platform::sleep( 0 );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+U32 JobSystem::processMainThreadJobs( void )
+{
+    // Sanity!
+    AssertFatal( isMainThread(), "JobSystem::processMainThreadJobs() - Can only be called on the main thread." );
+
+    // Finish if not initialized.
+    if ( smpMainThreadQueue == NULL || smpMainThreadQueue->isEmpty() )
+        return 0;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(JobSystem_ProcessMainThreadJobs);
+
+    U32 executedCount = 0;
+    JobEntry entry;
+    while ( smpMainThreadQueue->popFront( entry ) )
+    {
+        executeJob( entry );
+        executedCount++;
+    }
+
+    return executedCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::getStats( Stats& stats )
+{
+    stats.mWorkerCount = smWorkerCount;
+    stats.mExecuted = gJobsExecuted.load( std::memory_order_relaxed );
+    stats.mStolen = gJobsStolen.load( std::memory_order_relaxed );
+    stats.mMainThreadExecuted = gJobsMainThreadExecuted.load( std::memory_order_relaxed );
+    stats.mDeferred = gJobsDeferred.load( std::memory_order_relaxed );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::resetStats( void )
+{
+    gJobsExecuted.store( 0 );
+    gJobsStolen.store( 0 );
+    gJobsMainThreadExecuted.store( 0 );
+    gJobsDeferred.store( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+bool JobSystem::findJob( const S32 workerIndex, JobEntry& entry )
+{
+    const S32 queueCount = smQueues.size();
+
+    // Finish if there are no queues.
+    if ( queueCount == 0 )
+        return false;
+
+    // Take our own newest job first.
+    if ( workerIndex >= 0 && smQueues[workerIndex]->popBack( entry ) )
+        return true;
+
+    // Steal the oldest job from another queue.
+    const S32 startIndex = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for ( S32 n = 0; n < queueCount; ++n )
+    {
+        const S32 queueIndex = (startIndex + n) % queueCount;
+        if ( queueIndex == workerIndex )
+            continue;
+
+        if ( smQueues[queueIndex]->popFront( entry ) )
+        {
+            gJobsStolen.fetch_add( 1, std::memory_order_relaxed );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::executeJob( JobEntry& entry )
+{
+    // Release any frame allocations the job leaves behind.
+    FrameAllocatorMarker frameMarker;
+
+    if ( isMainThread() )
+    {
+        gJobsMainThreadExecuted.fetch_add( 1, std::memory_order_relaxed );
+
+#ifdef TORQUE_ENABLE_PROFILER
+        // Profile under the job's own marker if it has one.
+        if ( entry.mJob.mpProfile != NULL )
+        {
+            ScopedProfiler scopedProfiler( entry.mJob.mpProfile );
+            entry.mJob.mFunction( entry.mJob.mpData );
+        }
+        else
+#endif
+        {
+            entry.mJob.mFunction( entry.mJob.mpData );
+        }
+    }
+    else
+    {
+        entry.mJob.mFunction( entry.mJob.mpData );
+    }
+
+    gJobsExecuted.fetch_add( 1, std::memory_order_relaxed );
+
+    // Complete the job and release anything depending on its counter.
+    if ( entry.mpCounter != NULL && entry.mpCounter->mCount.fetch_sub( 1 ) == 1 && gDeferredCount.load() > 0 )
+        releaseDependents( entry.mpCounter );
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::enqueueJob( const JobEntry& entry )
+{
+    // Main thread only?
+    if ( entry.mJob.mMainThreadOnly )
+    {
+        // Execute now if we're on the main thread without a queue, otherwise queue it.
+        if ( smpMainThreadQueue == NULL && isMainThread() )
+        {
+            JobEntry immediateEntry = entry;
+            executeJob( immediateEntry );
+            return;
+        }
+
+        AssertFatal( smpMainThreadQueue != NULL, "JobSystem::enqueueJob() - Main thread jobs require the job system." );
+        smpMainThreadQueue->pushBack( entry );
+
+        // Wake the main loop in case it is waiting.
+        Sim::wakeMainLoop();
+        return;
+    }
+
+    // Execute now if there are no workers.
+    if ( !isActive() )
+    {
+        JobEntry immediateEntry = entry;
+        executeJob( immediateEntry );
+        return;
+    }
+
+    // Queue on our own queue if we're a worker, otherwise spread the jobs across the workers.
+    const U32 queueIndex = gJobWorkerIndex >= 0 ? (U32)gJobWorkerIndex : gNextJobQueue.fetch_add( 1, std::memory_order_relaxed ) % smWorkerCount;
+    smQueues[queueIndex]->pushBack( entry );
+
+    // Wake a worker.
+    gJobSemaphore->release();
+}
+
+//-----------------------------------------------------------------------------
+
+void JobSystem::releaseDependents( JobCounter* pCounter )
+{
+    // Gather the jobs that were waiting on the counter.
+    Vector<JobEntry> entries;
+
+    gDeferredMutex.lock();
+
+    for ( S32 n = 0; n < gDeferredJobs.size(); )
+    {
+        const DeferredJob& deferredJob = gDeferredJobs[n];
+
+        if ( deferredJob.mpDependency == pCounter )
+        {
+            JobEntry entry;
+            entry.mJob = deferredJob.mJob;
+            entry.mpCounter = deferredJob.mpCounter;
+            entries.push_back( entry );
+
+            gDeferredJobs.erase( n );
+        }
+        else
+        {
+            n++;
+        }
+    }
+
+    gDeferredCount.fetch_sub( entries.size() );
+
+    gDeferredMutex.unlock();
+
+    // Queue them.
+    for ( S32 n = 0; n < entries.size(); ++n )
+        enqueueJob( entries[n] );
+}
+
+//-----------------------------------------------------------------------------
+
+bool JobSystem::isMainThread( void )
+{
+    return ThreadManager::isCurrentThread( gJobMainThreadId );
+}
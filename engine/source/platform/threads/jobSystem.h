@@ -0,0 +1,228 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _PLATFORM_THREADS_JOB_SYSTEM_H_
+#define _PLATFORM_THREADS_JOB_SYSTEM_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+struct ProfilerRootData;
+
+typedef void (*JobFunction)( void* pData );
+
+//-----------------------------------------------------------------------------
+
+/// Counts outstanding jobs so they can be waited on or depended upon.
+///
+/// A counter is incremented when jobs are submitted with it and decremented as
+/// each completes.  It can be reused once done but must outlive its jobs.
+class JobCounter
+{
+public:
+    JobCounter() : mCount( 0 ) {}
+
+    inline bool isDone( void ) const { return mCount.load() == 0; }
+    inline U32 getCount( void ) const { return mCount.load(); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<U32> mCount;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A unit of work for the job system.
+struct Job
+{
+    Job( JobFunction function = NULL, void* pData = NULL, const bool mainThreadOnly = false ) :
+        mFunction( function ),
+        mpData( pData ),
+        mpProfile( NULL ),
+        mMainThreadOnly( mainThreadOnly )
+    {}
+
+    JobFunction         mFunction;
+    void*               mpData;
+    ProfilerRootData*   mpProfile;          ///< Optional profiler marker used when the job executes on the main thread.
+    bool                mMainThreadOnly;    ///< Only execute on the main thread e.g. for GL or script work.
+};
+
+//-----------------------------------------------------------------------------
+
+/// A pool of worker threads executing jobs.
+///
+/// Each worker has its own queue that it takes its newest jobs from while idle workers
+/// steal the oldest jobs from the others.  Threads waiting on a counter execute jobs
+/// rather than blocking.  Main thread only jobs are executed when the main thread waits
+/// or when it processes them once per frame.  The main thread also processes the Sim
+/// main thread queue while it waits so jobs calling script on it cannot deadlock.
+///
+/// Without any workers (or before initialization) jobs execute immediately on submission.
+class JobSystem
+{
+public:
+    struct Stats
+    {
+        U32 mWorkerCount;
+        U32 mExecuted;              ///< Jobs executed by any thread.
+        U32 mStolen;                ///< Jobs taken from another worker's queue.
+        U32 mMainThreadExecuted;    ///< Jobs executed on the main thread.
+        U32 mDeferred;              ///< Jobs that waited on a dependency.
+    };
+
+    static void init( const U32 workerCount = 0 );
+    static void shutdown( void );
+
+    static inline bool isActive( void ) { return smWorkerCount > 0; }
+    static inline U32 getWorkerCount( void ) { return smWorkerCount; }
+    static U32 getDefaultWorkerCount( void );
+
+    /// Submit jobs.  If a dependency is given then the jobs won't start until it's done.
+    static void submit( const Job* pJobs, const U32 jobCount, JobCounter* pCounter = NULL, JobCounter* pDependency = NULL );
+    static inline void submit( const Job& job, JobCounter* pCounter = NULL, JobCounter* pDependency = NULL ) { submit( &job, 1, pCounter, pDependency ); }
+
+    /// Wait for a counter to be done, executing jobs meanwhile.
+    static void wait( JobCounter& counter );
+
+    /// Execute pending main thread only jobs.  Returns the number executed.
+    static U32 processMainThreadJobs( void );
+
+    /// Call the function for each index in parallel and wait for them all.
+    /// The function is called as function( index ) and must be safe to call concurrently.
+    template<class F> static void parallelFor( const U32 count, const F& function, U32 grainSize = 0 );
+
+    /// Call the function for each item in parallel and wait for them all.
+    /// The function is called as function( item, index ) and must be safe to call concurrently.
+    template<class T, class F> static void parallelFor( Vector<T>& items, const F& function, const U32 grainSize = 0 );
+
+    static void getStats( Stats& stats );
+    static void resetStats( void );
+
+private:
+    struct JobEntry;
+    class JobQueue;
+    class JobWorker;
+    friend class JobWorker;
+
+    static bool findJob( const S32 workerIndex, JobEntry& entry );
+    static void executeJob( JobEntry& entry );
+    static void enqueueJob( const JobEntry& entry );
+    static void releaseDependents( JobCounter* pCounter );
+    static bool isMainThread( void );
+
+    template<class F> struct ParallelForRange
+    {
+        const F*    mpFunction;
+        U32         mBegin;
+        U32         mEnd;
+
+        static void execute( void* pData )
+        {
+            const ParallelForRange* pRange = static_cast<const ParallelForRange*>( pData );
+            for ( U32 index = pRange->mBegin; index < pRange->mEnd; ++index )
+                (*pRange->mpFunction)( index );
+        }
+    };
+
+    template<class T, class F> struct ParallelForItem
+    {
+        Vector<T>*  mpItems;
+        const F*    mpFunction;
+
+        inline void operator()( const U32 index ) const { (*mpFunction)( (*mpItems)[index], index ); }
+    };
+
+    static U32                  smWorkerCount;
+    static Vector<JobWorker*>   smWorkers;
+    static Vector<JobQueue*>    smQueues;
+    static JobQueue*            smpMainThreadQueue;
+};
+
+//-----------------------------------------------------------------------------
+
+template<class F> void JobSystem::parallelFor( const U32 count, const F& function, U32 grainSize )
+{
+    // Finish if nothing to do.
+    if ( count == 0 )
+        return;
+
+    // Default to a few ranges per thread so stealing can balance uneven work.
+    if ( grainSize == 0 )
+        grainSize = getMax( count / ((smWorkerCount + 1) * 4), (U32)1 );
+
+    const U32 rangeCount = (count + grainSize - 1) / grainSize;
+
+    // Execute here if there's no parallelism to gain.
+    if ( rangeCount == 1 || !isActive() )
+    {
+        for ( U32 index = 0; index < count; ++index )
+            function( index );
+        return;
+    }
+
+    // Create a job per range.
+    Vector<ParallelForRange<F> > ranges;
+    Vector<Job> jobs;
+    ranges.setSize( rangeCount );
+    jobs.setSize( rangeCount );
+
+    for ( U32 n = 0; n < rangeCount; ++n )
+    {
+        ranges[n].mpFunction = &function;
+        ranges[n].mBegin = n * grainSize;
+        ranges[n].mEnd = getMin( ranges[n].mBegin + grainSize, count );
+        jobs[n] = Job( &ParallelForRange<F>::execute, &ranges[n] );
+    }
+
+    // Submit and wait.
+    JobCounter counter;
+    submit( jobs.address(), rangeCount, &counter );
+    wait( counter );
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, class F> void JobSystem::parallelFor( Vector<T>& items, const F& function, const U32 grainSize )
+{
+    ParallelForItem<T, F> itemFunction;
+    itemFunction.mpItems = &items;
+    itemFunction.mpFunction = &function;
+
+    parallelFor( (U32)items.size(), itemFunction, grainSize );
+}
+
+#endif // _PLATFORM_THREADS_JOB_SYSTEM_H_
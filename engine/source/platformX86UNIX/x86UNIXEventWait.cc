@@ -0,0 +1,363 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platformX86UNIX/x86UNIXEventWait.h"
+#include "platformX86UNIX/x86UNIXStdConsole.h"
+#include "console/console.h"
+#include "sim/simBase.h"
+#include "debug/profiler.h"
+#include "math/mMathFn.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
+
+#include "platformX86UNIX/x86UNIXEventWait_ScriptBinding.h"
+
+x86UNIXEventWait *x86UNIXEventWaiter = NULL;
+
+//------------------------------------------------------------------------------
+
+static U64 getMonotonicMicroseconds()
+{
+   timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (U64)ts.tv_sec * 1000000 + (U64)ts.tv_nsec / 1000;
+}
+
+//------------------------------------------------------------------------------
+
+x86UNIXEventWait::x86UNIXEventWait() :
+   mEpollFd( -1 ),
+   mTimerFd( -1 ),
+   mWakeFd( -1 ),
+   mRegisteredGeneration( 0 )
+{
+   resetStats();
+}
+
+//------------------------------------------------------------------------------
+
+x86UNIXEventWait::~x86UNIXEventWait()
+{
+   close();
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXEventWait::open()
+{
+#if defined(__linux__)
+   mEpollFd = epoll_create1( EPOLL_CLOEXEC );
+   if ( mEpollFd == -1 )
+   {
+      Con::errorf( "x86UNIXEventWait: epoll_create1 failed: %s", strerror(errno) );
+      return false;
+   }
+
+   mTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+   if ( mTimerFd == -1 )
+   {
+      Con::errorf( "x86UNIXEventWait: timerfd_create failed: %s", strerror(errno) );
+      close();
+      return false;
+   }
+
+   epoll_event ev;
+   dMemset( &ev, 0, sizeof(ev) );
+   ev.events = EPOLLIN;
+   ev.data.fd = mTimerFd;
+   if ( epoll_ctl( mEpollFd, EPOLL_CTL_ADD, mTimerFd, &ev ) == -1 )
+   {
+      Con::errorf( "x86UNIXEventWait: unable to watch timer: %s", strerror(errno) );
+      close();
+      return false;
+   }
+
+   mWakeFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+   if ( mWakeFd == -1 )
+   {
+      Con::errorf( "x86UNIXEventWait: eventfd failed: %s", strerror(errno) );
+      close();
+      return false;
+   }
+
+   dMemset( &ev, 0, sizeof(ev) );
+   ev.events = EPOLLIN;
+   ev.data.fd = mWakeFd;
+   if ( epoll_ctl( mEpollFd, EPOLL_CTL_ADD, mWakeFd, &ev ) == -1 )
+   {
+      Con::errorf( "x86UNIXEventWait: unable to watch wake event: %s", strerror(errno) );
+      close();
+      return false;
+   }
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::close()
+{
+   if ( mWakeFd != -1 )
+      ::close( mWakeFd );
+   if ( mTimerFd != -1 )
+      ::close( mTimerFd );
+   if ( mEpollFd != -1 )
+      ::close( mEpollFd );
+
+   mWakeFd = -1;
+   mTimerFd = -1;
+   mEpollFd = -1;
+   mRegisteredFds.clear();
+   mRegisteredFlags.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::syncDescriptors( const Vector<int>& fds, const Vector<U32>& flags, U32 generation )
+{
+#if defined(__linux__)
+   // Nothing to do when the socket set is unchanged, which is the common case.
+   if ( generation == mRegisteredGeneration &&
+        fds.size() == mRegisteredFds.size() &&
+        dMemcmp( fds.address(), mRegisteredFds.address(), fds.size() * sizeof(int) ) == 0 &&
+        dMemcmp( flags.address(), mRegisteredFlags.address(), flags.size() * sizeof(U32) ) == 0 )
+      return;
+
+   // Drop the old registration.  Closed descriptors have already left the
+   // epoll set on their own so failures here are expected and ignored.
+   for ( S32 i = 0; i < mRegisteredFds.size(); ++i )
+   {
+      epoll_event ev;
+      dMemset( &ev, 0, sizeof(ev) );
+      epoll_ctl( mEpollFd, EPOLL_CTL_DEL, mRegisteredFds[i], &ev );
+   }
+   mRegisteredFds.clear();
+   mRegisteredFlags.clear();
+
+   // Register the current set.
+   for ( S32 i = 0; i < fds.size(); ++i )
+   {
+      epoll_event ev;
+      dMemset( &ev, 0, sizeof(ev) );
+      if ( flags[i] & WaitRead )
+         ev.events |= EPOLLIN;
+      if ( flags[i] & WaitWrite )
+         ev.events |= EPOLLOUT;
+      ev.data.fd = fds[i];
+
+      if ( epoll_ctl( mEpollFd, EPOLL_CTL_ADD, fds[i], &ev ) == -1 )
+      {
+         Con::warnf( "x86UNIXEventWait: unable to watch descriptor %d: %s", fds[i], strerror(errno) );
+         continue;
+      }
+
+      mRegisteredFds.push_back( fds[i] );
+      mRegisteredFlags.push_back( flags[i] );
+   }
+
+   // A failed registration leaves the lists short, forcing a retry next wait.
+   mRegisteredGeneration = generation;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::wait( U32 timeoutMs )
+{
+#if defined(__linux__)
+   if ( timeoutMs == 0 )
+      return;
+
+   PROFILE_SCOPE(XUX_EventWait);
+
+   // Gather the descriptors that should wake the server.
+   Vector<int> fds;
+   Vector<U32> flags;
+   U32 generation;
+   GetNetWaitDescriptors( fds, flags, generation );
+
+   if ( StdConsole::isEnabled() )
+   {
+      fds.push_back( STDIN_FILENO );
+      flags.push_back( WaitRead );
+   }
+
+   syncDescriptors( fds, flags, generation );
+
+   // Arm the timer for an absolute deadline so the overshoot can be measured.
+   // Re-arming also clears any expiry left over from the previous wait.
+   const U64 targetUs = getMonotonicMicroseconds() + (U64)timeoutMs * 1000;
+
+   itimerspec spec;
+   dMemset( &spec, 0, sizeof(spec) );
+   spec.it_value.tv_sec = (time_t)( targetUs / 1000000 );
+   spec.it_value.tv_nsec = (long)( targetUs % 1000000 ) * 1000;
+   if ( timerfd_settime( mTimerFd, TFD_TIMER_ABSTIME, &spec, NULL ) == -1 )
+      return;
+
+   // Block until the deadline or until a descriptor is ready.
+   const S32 MaxEvents = 16;
+   epoll_event events[MaxEvents];
+   S32 count;
+   do
+   {
+      count = epoll_wait( mEpollFd, events, MaxEvents, -1 );
+   }
+   while ( count == -1 && errno == EINTR );
+
+   if ( count <= 0 )
+      return;
+
+   const U64 wakeUs = getMonotonicMicroseconds();
+
+   bool timerFired = false;
+   bool signalled = false;
+   for ( S32 i = 0; i < count; ++i )
+   {
+      if ( events[i].data.fd == mTimerFd )
+      {
+         U64 expirations;
+         if ( read( mTimerFd, &expirations, sizeof(expirations) ) == sizeof(expirations) )
+            timerFired = true;
+      }
+      else if ( events[i].data.fd == mWakeFd )
+      {
+         // Reading resets the counter so every signal before now is consumed.
+         U64 signals;
+         if ( read( mWakeFd, &signals, sizeof(signals) ) == sizeof(signals) )
+            signalled = true;
+      }
+   }
+
+   // Record the wake-up.
+   ++mStats.wakeCount;
+   if ( !timerFired )
+   {
+      if ( signalled )
+         ++mStats.signalWakeCount;
+      else
+         ++mStats.ioWakeCount;
+      return;
+   }
+
+   ++mStats.timerWakeCount;
+   const U64 overshootUs = wakeUs > targetUs ? wakeUs - targetUs : 0;
+   const U32 jitterUs = overshootUs < U32_MAX ? (U32)overshootUs : U32_MAX;
+   mStats.minJitterUs = getMin( mStats.minJitterUs, jitterUs );
+   mStats.maxJitterUs = getMax( mStats.maxJitterUs, jitterUs );
+   mStats.totalJitterUs += jitterUs;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::signal()
+{
+#if defined(__linux__)
+   // The counter stays readable until the next wait consumes it, so a signal
+   // sent before the wait starts still ends it immediately.
+   const U64 one = 1;
+   if ( write( mWakeFd, &one, sizeof(one) ) != sizeof(one) && errno != EAGAIN )
+      Con::warnf( "x86UNIXEventWait: unable to signal wake event: %s", strerror(errno) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+static void signalEventWait()
+{
+   if ( x86UNIXEventWaiter != NULL )
+      x86UNIXEventWaiter->signal();
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::resetStats()
+{
+   dMemset( &mStats, 0, sizeof(mStats) );
+   mStats.minJitterUs = U32_MAX;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::dumpStats() const
+{
+   const U32 averageUs = mStats.timerWakeCount ? (U32)( mStats.totalJitterUs / mStats.timerWakeCount ) : 0;
+   const U32 minimumUs = mStats.timerWakeCount ? mStats.minJitterUs : 0;
+
+   Con::printf( "Event wait: %u wake-ups (%u timer, %u io, %u signal)", mStats.wakeCount, mStats.timerWakeCount, mStats.ioWakeCount, mStats.signalWakeCount );
+   Con::printf( "   timer jitter: min %uus, avg %uus, max %uus", minimumUs, averageUs, mStats.maxJitterUs );
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXEventWait::create()
+{
+   if ( x86UNIXEventWaiter != NULL )
+      return true;
+
+   x86UNIXEventWait* waiter = new x86UNIXEventWait();
+   if ( !waiter->open() )
+   {
+      delete waiter;
+      return false;
+   }
+
+   x86UNIXEventWaiter = waiter;
+
+   // Let other threads posting main thread work end the wait.
+   Sim::setMainLoopWakeFunction( signalEventWait );
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXEventWait::destroy()
+{
+   if ( x86UNIXEventWaiter == NULL )
+      return;
+
+   Sim::setMainLoopWakeFunction( NULL );
+
+   x86UNIXEventWaiter->dumpStats();
+   delete x86UNIXEventWaiter;
+   x86UNIXEventWaiter = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXEventWait::isEnabled()
+{
+   return x86UNIXEventWaiter != NULL;
+}
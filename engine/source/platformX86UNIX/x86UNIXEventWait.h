@@ -0,0 +1,118 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _X86UNIXEVENTWAIT_H_
+#define _X86UNIXEVENTWAIT_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+/// Event-driven wait used by the dedicated server in place of sleep polling.
+///
+/// Each call to wait() arms a timerfd for the next deadline the main loop
+/// cares about (the next Sim event or tick boundary) and blocks in
+/// epoll_wait on it together with the sockets Net::process() services and
+/// stdin.  The server therefore wakes as soon as a packet arrives or work
+/// becomes due, rather than after a fixed sleep.  Other threads posting work
+/// for the main thread wake it through an eventfd (see Sim::wakeMainLoop()).
+/// Timer wake-ups are measured against their target so the scheduling jitter
+/// can be inspected.
+///
+/// Only available on Linux; create() fails elsewhere and the caller falls
+/// back to the regular sleep.
+class x86UNIXEventWait
+{
+public:
+   enum WaitFlags
+   {
+      WaitRead  = BIT(0),
+      WaitWrite = BIT(1),
+   };
+
+   struct Stats
+   {
+      U32 wakeCount;       ///< Total number of waits that returned
+      U32 timerWakeCount;  ///< Waits ended by the deadline timer
+      U32 ioWakeCount;     ///< Waits ended by socket or stdin readiness
+      U32 signalWakeCount; ///< Waits ended by a wake from another thread
+      U32 minJitterUs;     ///< Smallest timer overshoot in microseconds
+      U32 maxJitterUs;     ///< Largest timer overshoot in microseconds
+      U64 totalJitterUs;   ///< Sum of timer overshoots, for the average
+   };
+
+private:
+   int mEpollFd;
+   int mTimerFd;
+   int mWakeFd;
+
+   /// Descriptors currently registered with the epoll set, other than the timer.
+   Vector<int> mRegisteredFds;
+   Vector<U32> mRegisteredFlags;
+   U32 mRegisteredGeneration;
+
+   Stats mStats;
+
+   x86UNIXEventWait();
+
+   bool open();
+   void close();
+
+   /// Brings the epoll registration in line with the descriptors that
+   /// should currently wake the server.
+   void syncDescriptors( const Vector<int>& fds, const Vector<U32>& flags, U32 generation );
+
+public:
+   ~x86UNIXEventWait();
+
+   /// Blocks for at most timeoutMs milliseconds, returning early when any
+   /// watched descriptor becomes ready or signal() is called.
+   void wait( U32 timeoutMs );
+
+   /// Ends the current or next wait early.  Safe to call from any thread.
+   void signal();
+
+   const Stats& getStats() const { return mStats; }
+   void resetStats();
+
+   /// Prints the wake-up statistics to the console.
+   void dumpStats() const;
+
+   static bool create();
+   static void destroy();
+   static bool isEnabled();
+};
+
+extern x86UNIXEventWait *x86UNIXEventWaiter;
+
+/// Collects the descriptors Net::process() services along with the
+/// x86UNIXEventWait::WaitFlags each should wake on.  Sockets waiting on a
+/// name lookup have nothing to wait on; the lookup thread wakes the main
+/// loop when it completes.  generation changes whenever a socket is closed,
+/// since a reused descriptor number may then refer to a different socket.
+/// Implemented in x86UNIXNet.cc.
+void GetNetWaitDescriptors( Vector<int>& fds, Vector<U32>& flags, U32& generation );
+
+#endif // _X86UNIXEVENTWAIT_H_
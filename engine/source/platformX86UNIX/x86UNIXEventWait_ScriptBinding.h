@@ -0,0 +1,52 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+/*! Returns the dedicated server's event-wait statistics.
+    The event wait is enabled with the -eventwait command line option on Linux.
+    @return A string of the form "wakes timerWakes ioWakes minJitterUs avgJitterUs maxJitterUs signalWakes", or an empty string if the event wait is not active.
+    @sa resetServerWaitStats
+*/
+ConsoleFunctionWithDocs( getServerWaitStats, ConsoleString, 1, 1, () )
+{
+   if ( !x86UNIXEventWait::isEnabled() )
+      return "";
+
+   const x86UNIXEventWait::Stats& stats = x86UNIXEventWaiter->getStats();
+   const U32 averageUs = stats.timerWakeCount ? (U32)( stats.totalJitterUs / stats.timerWakeCount ) : 0;
+   const U32 minimumUs = stats.timerWakeCount ? stats.minJitterUs : 0;
+
+   char* pBuffer = Con::getReturnBuffer( 128 );
+   dSprintf( pBuffer, 128, "%u %u %u %u %u %u %u", stats.wakeCount, stats.timerWakeCount, stats.ioWakeCount, minimumUs, averageUs, stats.maxJitterUs, stats.signalWakeCount );
+   return pBuffer;
+}
+
+//------------------------------------------------------------------------------
+
+/*! Clears the dedicated server's event-wait statistics.
+    @return No return value.
+    @sa getServerWaitStats
+*/
+ConsoleFunctionWithDocs( resetServerWaitStats, ConsoleVoid, 1, 1, () )
+{
+   if ( x86UNIXEventWait::isEnabled() )
+      x86UNIXEventWaiter->resetStats();
+}
@@ -0,0 +1,410 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platformX86UNIX/x86UNIXFileWatcher.h"
+#include "io/resource/resourceManager.h"
+#include "assets/assetManager.h"
+#include "assets/assetQuery.h"
+#include "2d/scene/ScenePipeline.h"
+#include "console/console.h"
+#include "debug/profiler.h"
+#include "math/mMathFn.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+#include "platformX86UNIX/x86UNIXFileWatcher_ScriptBinding.h"
+
+x86UNIXFileWatcher *x86UNIXFileWatcherInstance = NULL;
+
+//------------------------------------------------------------------------------
+
+#if defined(__linux__)
+static const U32 WatchEventMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+#endif
+
+//------------------------------------------------------------------------------
+
+x86UNIXFileWatcher::x86UNIXFileWatcher() :
+   mNotifyFd( -1 ),
+   mFirstPendingTime( 0 ),
+   mLastPendingTime( 0 )
+{
+   resetStats();
+}
+
+//------------------------------------------------------------------------------
+
+x86UNIXFileWatcher::~x86UNIXFileWatcher()
+{
+   close();
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXFileWatcher::open()
+{
+#if defined(__linux__)
+   mNotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+   if ( mNotifyFd == -1 )
+   {
+      Con::errorf( "x86UNIXFileWatcher: inotify_init1 failed: %s", strerror(errno) );
+      return false;
+   }
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::close()
+{
+   // Closing the descriptor removes all of its watches.
+   if ( mNotifyFd != -1 )
+   {
+      ::close( mNotifyFd );
+      mNotifyFd = -1;
+   }
+
+   mWatches.clear();
+   mPendingFiles.clear();
+   mPendingLookup.clear();
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXFileWatcher::watchDirectory( StringTableEntry directory )
+{
+#if defined(__linux__)
+   const int watch = inotify_add_watch( mNotifyFd, directory, WatchEventMask | IN_ONLYDIR );
+   if ( watch == -1 )
+   {
+      Con::warnf( "x86UNIXFileWatcher: Cannot watch '%s': %s", directory, strerror(errno) );
+      return false;
+   }
+
+   // Adding an already watched directory returns its existing descriptor.
+   typeWatchHash::iterator itr = mWatches.find( (U32)watch );
+   if ( itr != mWatches.end() )
+      itr->value = directory;
+   else
+      mWatches.insertUnique( (U32)watch, directory );
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXFileWatcher::addPath( const char* pPath )
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(x86UNIXFileWatcher_AddPath);
+
+   // Sanity!
+   AssertFatal( pPath != NULL, "x86UNIXFileWatcher: Cannot watch a NULL path." );
+
+   // Expand the path so notifications yield the same paths the resource and asset managers use.
+   char pathBuffer[1024];
+   Con::expandPath( pathBuffer, sizeof(pathBuffer), pPath );
+
+   // Remove any trailing slash.
+   const U32 length = dStrlen( pathBuffer );
+   if ( length > 1 && pathBuffer[length-1] == '/' )
+      pathBuffer[length-1] = 0;
+
+   // Fetch the directory tree.
+   Vector<StringTableEntry> directories;
+   if ( !Platform::dumpDirectories( pathBuffer, directories, -1, false ) )
+   {
+      Con::warnf( "x86UNIXFileWatcher: Cannot watch '%s' as it is not a directory.", pathBuffer );
+      return false;
+   }
+
+   // Watch every directory in it.
+   bool watched = false;
+   for ( Vector<StringTableEntry>::iterator itr = directories.begin(); itr != directories.end(); ++itr )
+      watched |= watchDirectory( *itr );
+
+   return watched;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::clearPaths()
+{
+#if defined(__linux__)
+   for ( typeWatchHash::iterator itr = mWatches.begin(); itr != mWatches.end(); ++itr )
+      inotify_rm_watch( mNotifyFd, (int)itr->key );
+#endif
+
+   mWatches.clear();
+   mPendingFiles.clear();
+   mPendingLookup.clear();
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::queueFile( StringTableEntry filePath )
+{
+   // Note when the batch started.
+   const U32 now = Platform::getRealMilliseconds();
+   if ( mPendingFiles.size() == 0 )
+      mFirstPendingTime = now;
+   mLastPendingTime = now;
+
+   // Queue each file once per batch.
+   if ( mPendingLookup.find( filePath ) != mPendingLookup.end() )
+      return;
+
+   mPendingLookup.insertUnique( filePath, true );
+   mPendingFiles.push_back( filePath );
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::readEvents()
+{
+#if defined(__linux__)
+   // Debug Profiling.
+   PROFILE_SCOPE(x86UNIXFileWatcher_ReadEvents);
+
+   char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+   char pathBuffer[1024];
+
+   while ( true )
+   {
+      const ssize_t length = read( mNotifyFd, buffer, sizeof(buffer) );
+      if ( length <= 0 )
+      {
+         if ( length == -1 && errno != EAGAIN && errno != EINTR )
+            Con::errorf( "x86UNIXFileWatcher: read failed: %s", strerror(errno) );
+         return;
+      }
+
+      for ( const char* pCursor = buffer; pCursor < buffer + length; )
+      {
+         const inotify_event* pEvent = (const inotify_event*)pCursor;
+         pCursor += sizeof(inotify_event) + pEvent->len;
+
+         mStats.eventCount++;
+
+         // Were notifications lost?
+         if ( pEvent->mask & IN_Q_OVERFLOW )
+         {
+            // Yes, so nothing cached about the disk can be trusted.
+            Con::warnf( "x86UNIXFileWatcher: Notification queue overflowed; file caches were flushed." );
+            mStats.overflowCount++;
+            ResourceManager->invalidateFileCache();
+            continue;
+         }
+
+         // Forget directories that have gone away.
+         if ( pEvent->mask & IN_IGNORED )
+         {
+            typeWatchHash::iterator itr = mWatches.find( (U32)pEvent->wd );
+            if ( itr != mWatches.end() )
+               mWatches.erase( itr );
+            continue;
+         }
+
+         // Skip events without a name or for unknown directories.
+         if ( pEvent->len == 0 )
+            continue;
+
+         typeWatchHash::iterator itr = mWatches.find( (U32)pEvent->wd );
+         if ( itr == mWatches.end() )
+            continue;
+
+         dSprintf( pathBuffer, sizeof(pathBuffer), "%s/%s", itr->value, pEvent->name );
+
+         if ( pEvent->mask & IN_ISDIR )
+         {
+            // Watch new directories so files written into them are seen.
+            if ( pEvent->mask & ( IN_CREATE | IN_MOVED_TO ) )
+               addPath( pathBuffer );
+            continue;
+         }
+
+         // A file being created is only reloaded once it has been written and closed.
+         if ( ( pEvent->mask & ( IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO ) ) == 0 )
+            continue;
+
+         queueFile( StringTable->insert( pathBuffer ) );
+      }
+   }
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::reload()
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(x86UNIXFileWatcher_Reload);
+
+   // Take the batch so that reloading may queue further changes.
+   Vector<StringTableEntry> files( mPendingFiles );
+   mPendingFiles.clear();
+   mPendingLookup.clear();
+
+   // Update the resource dictionary.
+   for ( Vector<StringTableEntry>::iterator itr = files.begin(); itr != files.end(); ++itr )
+      ResourceManager->fileChanged( *itr );
+
+   // Find the loaded assets using the files.
+   AssetQuery changedAssets;
+   for ( Vector<StringTableEntry>::iterator itr = files.begin(); itr != files.end(); ++itr )
+   {
+      AssetQuery looseFileAssets;
+      AssetDatabase.findAssetLooseFile( &looseFileAssets, *itr );
+
+      for ( Vector<StringTableEntry>::iterator assetItr = looseFileAssets.begin(); assetItr != looseFileAssets.end(); ++assetItr )
+      {
+         if ( AssetDatabase.isAssetLoaded( *assetItr ) && !changedAssets.contains( *assetItr ) )
+            changedAssets.push_back( *assetItr );
+      }
+   }
+
+   // A scene capture may be reading the assets so wait for it before refreshing them.
+   if ( changedAssets.size() > 0 )
+      ScenePipeline::synchronize();
+
+   // Refresh the assets.
+   for ( Vector<StringTableEntry>::iterator itr = changedAssets.begin(); itr != changedAssets.end(); ++itr )
+   {
+      // Skip assets that depend on another changed asset as refreshing that one refreshes them too.
+      bool dependent = false;
+      for ( Vector<StringTableEntry>::iterator otherItr = changedAssets.begin(); otherItr != changedAssets.end(); ++otherItr )
+      {
+         if ( *otherItr != *itr && AssetDatabase.doesAssetDependOn( *itr, *otherItr ) )
+         {
+            dependent = true;
+            break;
+         }
+      }
+
+      if ( dependent )
+         continue;
+
+      // Count the dependents refreshed through the asset.
+      AssetQuery dependentAssets;
+      mStats.dependentCount += AssetDatabase.findAssetIsDependedOn( &dependentAssets, *itr );
+
+      AssetDatabase.refreshAsset( *itr );
+      mStats.assetCount++;
+   }
+
+   // Record the latency.
+   const U32 latency = Platform::getRealMilliseconds() - mFirstPendingTime;
+   mStats.batchCount++;
+   mStats.fileCount += files.size();
+   mStats.lastLatencyMs = latency;
+   mStats.maxLatencyMs = getMax( mStats.maxLatencyMs, latency );
+   mStats.totalLatencyMs += latency;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::process()
+{
+   // Debug Profiling.
+   PROFILE_SCOPE(x86UNIXFileWatcher_Process);
+
+   readEvents();
+
+   // Finish when nothing is waiting.
+   if ( mPendingFiles.size() == 0 )
+      return;
+
+   // Wait for the changes to settle.
+   const U32 coalesceMs = (U32)getMax( Con::getIntVariable( "$pref::FileWatcher::coalesceMs", 100 ), 0 );
+   if ( Platform::getRealMilliseconds() - mLastPendingTime < coalesceMs )
+      return;
+
+   reload();
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::resetStats()
+{
+   dMemset( &mStats, 0, sizeof(mStats) );
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::dumpStats() const
+{
+   const U32 averageMs = mStats.batchCount ? (U32)( mStats.totalLatencyMs / mStats.batchCount ) : 0;
+
+   Con::printf( "File watcher: %u directories, %u events, %u reloads, %u files, %u assets (%u dependents), %u overflows.",
+      mWatches.size(), mStats.eventCount, mStats.batchCount, mStats.fileCount, mStats.assetCount, mStats.dependentCount, mStats.overflowCount );
+   Con::printf( "File watcher: reload latency last %ums, average %ums, max %ums.",
+      mStats.lastLatencyMs, averageMs, mStats.maxLatencyMs );
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXFileWatcher::create()
+{
+   if ( x86UNIXFileWatcherInstance != NULL )
+      return true;
+
+   x86UNIXFileWatcher* watcher = new x86UNIXFileWatcher();
+   if ( !watcher->open() )
+   {
+      delete watcher;
+      return false;
+   }
+
+   x86UNIXFileWatcherInstance = watcher;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXFileWatcher::destroy()
+{
+   if ( x86UNIXFileWatcherInstance == NULL )
+      return;
+
+   delete x86UNIXFileWatcherInstance;
+   x86UNIXFileWatcherInstance = NULL;
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXFileWatcher::isEnabled()
+{
+   return x86UNIXFileWatcherInstance != NULL;
+}
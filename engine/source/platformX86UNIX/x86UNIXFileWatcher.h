@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _X86UNIXFILEWATCHER_H_
+#define _X86UNIXFILEWATCHER_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+/// Hot-reloads files as they are edited on disk.
+///
+/// Directory trees are watched with inotify.  Platform::process() drains the
+/// notifications without blocking and collects the changed files until no
+/// new change has arrived for the coalesce window ($pref::FileWatcher::coalesceMs),
+/// so that an editor writing a file in several steps only causes a single
+/// reload.  Each changed file is then handed to the resource manager and any
+/// loaded asset using it as a loose file is refreshed; the asset manager
+/// refreshes the assets that depend on it in turn.  The time from the first
+/// notification of a batch to the end of its reload is recorded.
+///
+/// Only available on Linux; create() fails elsewhere.
+class x86UNIXFileWatcher
+{
+public:
+   struct Stats
+   {
+      U32 batchCount;         ///< Number of coalesced reloads performed
+      U32 eventCount;         ///< Number of inotify notifications read
+      U32 fileCount;          ///< Number of distinct files reloaded
+      U32 assetCount;         ///< Number of assets refreshed directly
+      U32 dependentCount;     ///< Number of direct dependents refreshed through them
+      U32 overflowCount;      ///< Number of times the notification queue overflowed
+      U32 lastLatencyMs;      ///< First notification to end of reload for the last batch
+      U32 maxLatencyMs;       ///< Largest latency of any batch
+      U64 totalLatencyMs;     ///< Sum of batch latencies, for the average
+   };
+
+private:
+   typedef HashTable<U32, StringTableEntry> typeWatchHash;
+   typedef HashTable<StringTableEntry, bool> typePendingHash;
+
+   int mNotifyFd;
+
+   /// Watched directories keyed by their watch descriptor.
+   typeWatchHash mWatches;
+
+   /// Files changed since the last reload, in the order they first changed.
+   Vector<StringTableEntry> mPendingFiles;
+   typePendingHash mPendingLookup;
+   U32 mFirstPendingTime;
+   U32 mLastPendingTime;
+
+   Stats mStats;
+
+   x86UNIXFileWatcher();
+
+   bool open();
+   void close();
+
+   /// Adds a watch for a single directory.
+   bool watchDirectory( StringTableEntry directory );
+
+   /// Reads every queued notification without blocking.
+   void readEvents();
+
+   /// Records a changed file for the next reload.
+   void queueFile( StringTableEntry filePath );
+
+   /// Reloads the queued files.
+   void reload();
+
+public:
+   ~x86UNIXFileWatcher();
+
+   /// Watches a directory and all of its sub-directories.
+   bool addPath( const char* pPath );
+
+   /// Stops watching every directory.
+   void clearPaths();
+
+   U32 getWatchCount() const { return mWatches.size(); }
+
+   /// Drains notifications and performs a reload once the changes have settled.
+   void process();
+
+   const Stats& getStats() const { return mStats; }
+   void resetStats();
+
+   /// Prints the reload statistics to the console.
+   void dumpStats() const;
+
+   static bool create();
+   static void destroy();
+   static bool isEnabled();
+};
+
+extern x86UNIXFileWatcher *x86UNIXFileWatcherInstance;
+
+#endif // _X86UNIXFILEWATCHER_H_
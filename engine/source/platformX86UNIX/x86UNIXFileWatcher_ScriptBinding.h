@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+/*! Starts hot-reloading the files in a directory and all of its sub-directories.
+    Changed files are reloaded once no further change has arrived for $pref::FileWatcher::coalesceMs milliseconds (100 by default).
+    Only available on Linux.
+    @param path The directory to watch.
+    @return True if the directory is being watched, false otherwise.
+    @sa stopFileWatcher
+*/
+ConsoleFunctionWithDocs( addFileWatchPath, ConsoleBool, 2, 2, (path) )
+{
+   if ( !x86UNIXFileWatcher::create() )
+      return false;
+
+   return x86UNIXFileWatcherInstance->addPath( argv[1] );
+}
+
+//------------------------------------------------------------------------------
+
+/*! Stops watching all directories for changes.
+    @return No return value.
+    @sa addFileWatchPath
+*/
+ConsoleFunctionWithDocs( stopFileWatcher, ConsoleVoid, 1, 1, () )
+{
+   if ( x86UNIXFileWatcher::isEnabled() )
+      x86UNIXFileWatcherInstance->clearPaths();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Returns the file watcher's reload statistics.
+    @return A string of the form "directories events reloads files assets dependents overflows lastLatencyMs avgLatencyMs maxLatencyMs", or an empty string if the file watcher is not active.
+    @sa resetFileWatchStats
+*/
+ConsoleFunctionWithDocs( getFileWatchStats, ConsoleString, 1, 1, () )
+{
+   if ( !x86UNIXFileWatcher::isEnabled() )
+      return "";
+
+   const x86UNIXFileWatcher::Stats& stats = x86UNIXFileWatcherInstance->getStats();
+   const U32 averageMs = stats.batchCount ? (U32)( stats.totalLatencyMs / stats.batchCount ) : 0;
+
+   char* pBuffer = Con::getReturnBuffer( 128 );
+   dSprintf( pBuffer, 128, "%u %u %u %u %u %u %u %u %u %u", x86UNIXFileWatcherInstance->getWatchCount(), stats.eventCount, stats.batchCount, stats.fileCount,
+      stats.assetCount, stats.dependentCount, stats.overflowCount, stats.lastLatencyMs, averageMs, stats.maxLatencyMs );
+   return pBuffer;
+}
+
+//------------------------------------------------------------------------------
+
+/*! Clears the file watcher's reload statistics.
+    @return No return value.
+    @sa getFileWatchStats
+*/
+ConsoleFunctionWithDocs( resetFileWatchStats, ConsoleVoid, 1, 1, () )
+{
+   if ( x86UNIXFileWatcher::isEnabled() )
+      x86UNIXFileWatcherInstance->resetStats();
+}
@@ -21,6 +21,7 @@
 //-----------------------------------------------------------------------------
 
 #include "platformX86UNIX/platformX86UNIX.h"
+#include "platformX86UNIX/x86UNIXEventWait.h"
 #include "platform/platform.h"
 #include "platform/event.h"
 #include "platform/platformNetAsync.unix.h"
@@ -58,6 +59,16 @@ static S32 netPort = 0;
 static int ipxSocket = InvalidSocket;
 static int udpSocket = InvalidSocket;
 
+// bumped whenever a descriptor is closed so the dedicated server's event
+// wait knows a reused descriptor number may refer to a different socket
+static U32 socketGeneration = 0;
+
+static inline int closeNetSocket(int fd)
+{
+   ++socketGeneration;
+   return ::close(fd);
+}
+
 // local enum for socket states for polled sockets
 enum SocketState
 {
@@ -122,6 +133,45 @@ S32 Poll(NetSocket fd, S32 eventMask, S32 timeoutMs)
       return pfd.revents;
 }
 
+//-----------------------------------------------------------------------------
+void GetNetWaitDescriptors(Vector<int>& fds, Vector<U32>& flags, U32& generation)
+{
+   generation = socketGeneration;
+
+   if (udpSocket != InvalidSocket)
+   {
+      fds.push_back(udpSocket);
+      flags.push_back(x86UNIXEventWait::WaitRead);
+   }
+   if (ipxSocket != InvalidSocket)
+   {
+      fds.push_back(ipxSocket);
+      flags.push_back(x86UNIXEventWait::WaitRead);
+   }
+
+   for (S32 i = 0; i < gPolledSockets.size(); ++i)
+   {
+      const Socket* sock = gPolledSockets[i];
+      switch (sock->state)
+      {
+         case ConnectionPending:
+            // connect completion is signalled by writability
+            fds.push_back(sock->fd);
+            flags.push_back(x86UNIXEventWait::WaitWrite);
+            break;
+         case Connected:
+         case Listening:
+            fds.push_back(sock->fd);
+            flags.push_back(x86UNIXEventWait::WaitRead);
+            break;
+         default:
+            // a pending name lookup has no descriptor yet; the lookup
+            // thread wakes the main loop once it completes
+            break;
+      }
+   }
+}
+
 bool Net::init()
 {
    NetAsync::startAsync();
@@ -220,13 +270,13 @@ NetSocket Net::openListenPort(U16 port)
    if (bind(sock, port) != NoError)
    {
       Con::errorf("Unable to bind port %d: %s", port, strerror(errno));
-      ::close(sock);
+      closeNetSocket(sock);
       return InvalidSocket;
    }
    if (listen(sock, 4) != NoError)
    {
       Con::errorf("Unable to listen on port %d: %s", port, strerror(errno));
-      ::close(sock);
+      closeNetSocket(sock);
       return InvalidSocket;
    }
 
@@ -285,7 +335,7 @@ NetSocket Net::openConnectTo(const char *addressString)
       {
          Con::errorf("Error connecting %s: %s", 
 		     addressString, strerror(errno));
-         ::close(sock);
+         closeNetSocket(sock);
          sock = InvalidSocket;
       }
       if(sock != InvalidSocket) {
@@ -351,9 +401,9 @@ Net::Error Net::sendtoSocket(NetSocket socket, const U8 *buffer, int bufferSize)
 bool Net::openPort(S32 port)
 {
    if(udpSocket != InvalidSocket)
-      close(udpSocket);
+      closeNetSocket(udpSocket);
    if(ipxSocket != InvalidSocket)
-      close(ipxSocket);
+      closeNetSocket(ipxSocket);
       
    udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
    ipxSocket = socket(AF_IPX, SOCK_DGRAM, 0);
@@ -372,7 +422,7 @@ bool Net::openPort(S32 port)
          Con::printf("UDP initialized on port %d", port);
       else
       {
-         close(udpSocket);
+         closeNetSocket(udpSocket);
          udpSocket = InvalidSocket;
          Con::printf("Unable to initialize UDP - error %d", error);
       }
@@ -397,7 +447,7 @@ bool Net::openPort(S32 port)
          Con::printf("IPX initialized on port %d", port);
       else
       {
-         close(ipxSocket);
+         closeNetSocket(ipxSocket);
          ipxSocket = InvalidSocket;
          Con::printf("Unable to initialize IPX - error %d", error);
       }
@@ -409,9 +459,9 @@ bool Net::openPort(S32 port)
 void Net::closePort()
 {
    if(ipxSocket != InvalidSocket)
-      close(ipxSocket);
+      closeNetSocket(ipxSocket);
    if(udpSocket != InvalidSocket)
-      close(udpSocket);
+      closeNetSocket(udpSocket);
 }
 
 Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32 bufferSize)
@@ -669,7 +719,7 @@ Net::Error Net::closeSocket(NetSocket socket)
 {
    if(socket != InvalidSocket)
    {
-      if(!close(socket))
+      if(!closeNetSocket(socket))
          return NoError;
       else
          return getLastError();
@@ -0,0 +1,295 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platformX86UNIX/platformGL.h"
+#include "platformX86UNIX/x86UNIXNullGL.h"
+#include "console/console.h"
+#include "io/fileStream.h"
+#include "memory/safeDelete.h"
+
+#include <stdarg.h>
+
+#include "platformX86UNIX/x86UNIXNullGL_ScriptBinding.h"
+
+bool x86UNIXNullGL::smBound = false;
+x86UNIXNullGL::Stats x86UNIXNullGL::smStats;
+FileStream* x86UNIXNullGL::smpTraceStream = NULL;
+U32 x86UNIXNullGL::smNextTextureName = 1;
+
+//------------------------------------------------------------------------------
+
+// declare null functions, each classifies itself on first use
+#define GL_FUNCTION(fn_return, fn_name, fn_args, fn_value) \
+   static fn_return null_##fn_name fn_args \
+   { \
+      static const x86UNIXNullGL::CallType callType = x86UNIXNullGL::getCallType(#fn_name); \
+      x86UNIXNullGL::recordCall(#fn_name, callType); \
+      fn_value \
+   }
+#include "platform/GLCoreFunc.h"
+#include "platform/GLExtFunc.h"
+#undef GL_FUNCTION
+
+// the function table as it was before binding
+#define GL_FUNCTION(fn_return, fn_name, fn_args, fn_value) static fn_return (*saved_##fn_name)fn_args = NULL;
+#include "platform/GLCoreFunc.h"
+#include "platform/GLExtFunc.h"
+#undef GL_FUNCTION
+
+//------------------------------------------------------------------------------
+// null functions that need their arguments
+//------------------------------------------------------------------------------
+
+static void countDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+   x86UNIXNullGL::recordDraw("glDrawArrays", count > 0 ? (U32)count : 0);
+}
+
+static void countDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices)
+{
+   x86UNIXNullGL::recordDraw("glDrawElements", count > 0 ? (U32)count : 0);
+}
+
+static void countBegin(GLenum mode)
+{
+   // immediate mode vertices are counted as they are submitted
+   x86UNIXNullGL::recordDraw("glBegin", 0);
+}
+
+static void countBindTexture(GLenum target, GLuint texture)
+{
+   x86UNIXNullGL::recordTextureBind(texture);
+}
+
+static void nameGenTextures(GLsizei n, GLuint *textures)
+{
+   x86UNIXNullGL::recordCall("glGenTextures", x86UNIXNullGL::CallOther);
+   for (GLsizei i = 0; i < n; i++)
+      textures[i] = x86UNIXNullGL::generateTextureName();
+}
+
+// number of values a query writes, so it can be answered with zeros
+static U32 getQueryValueCount(GLenum pname)
+{
+   switch (pname)
+   {
+      case GL_MODELVIEW_MATRIX:
+      case GL_PROJECTION_MATRIX:
+      case GL_TEXTURE_MATRIX:
+         return 16;
+      case GL_VIEWPORT:
+      case GL_SCISSOR_BOX:
+      case GL_COLOR_CLEAR_VALUE:
+      case GL_CURRENT_COLOR:
+         return 4;
+      case GL_DEPTH_RANGE:
+      case GL_MAX_VIEWPORT_DIMS:
+         return 2;
+      default:
+         return 1;
+   }
+}
+
+static void zeroGetBooleanv(GLenum pname, GLboolean *params)
+{
+   x86UNIXNullGL::recordCall("glGetBooleanv", x86UNIXNullGL::CallOther);
+   dMemset(params, 0, sizeof(GLboolean) * getQueryValueCount(pname));
+}
+
+static void zeroGetFloatv(GLenum pname, GLfloat *params)
+{
+   x86UNIXNullGL::recordCall("glGetFloatv", x86UNIXNullGL::CallOther);
+   dMemset(params, 0, sizeof(GLfloat) * getQueryValueCount(pname));
+}
+
+static void zeroGetIntegerv(GLenum pname, GLint *params)
+{
+   x86UNIXNullGL::recordCall("glGetIntegerv", x86UNIXNullGL::CallOther);
+   dMemset(params, 0, sizeof(GLint) * getQueryValueCount(pname));
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::bind()
+{
+   if (smBound)
+      return;
+
+   // save the current function table and point it at the null functions
+#define GL_FUNCTION(fn_return, fn_name, fn_args, fn_value) saved_##fn_name = fn_name; fn_name = null_##fn_name;
+#include "platform/GLCoreFunc.h"
+#include "platform/GLExtFunc.h"
+#undef GL_FUNCTION
+
+   glDrawArrays = countDrawArrays;
+   glDrawElements = countDrawElements;
+   glBegin = countBegin;
+   glBindTexture = countBindTexture;
+   glGenTextures = nameGenTextures;
+   glGetBooleanv = zeroGetBooleanv;
+   glGetFloatv = zeroGetFloatv;
+   glGetIntegerv = zeroGetIntegerv;
+
+   smBound = true;
+   Con::printf("Null GL backend bound");
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::unbind()
+{
+   if (!smBound)
+      return;
+
+   // restore the saved function table
+#define GL_FUNCTION(fn_return, fn_name, fn_args, fn_value) fn_name = saved_##fn_name;
+#include "platform/GLCoreFunc.h"
+#include "platform/GLExtFunc.h"
+#undef GL_FUNCTION
+
+   stopTrace();
+
+   smBound = false;
+   Con::printf("Null GL backend unbound");
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::resetStats()
+{
+   dMemset(&smStats, 0, sizeof(smStats));
+}
+
+//------------------------------------------------------------------------------
+
+bool x86UNIXNullGL::startTrace(const char* pFilename)
+{
+   stopTrace();
+
+   char pathBuffer[1024];
+   Con::expandPath(pathBuffer, sizeof(pathBuffer), pFilename);
+
+   FileStream* pStream = new FileStream();
+   if (!pStream->open(pathBuffer, FileStream::Write))
+   {
+      Con::warnf("x86UNIXNullGL::startTrace() - Could not open trace file '%s'.", pathBuffer);
+      delete pStream;
+      return false;
+   }
+
+   smpTraceStream = pStream;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::stopTrace()
+{
+   if (smpTraceStream == NULL)
+      return;
+
+   smpTraceStream->close();
+   SAFE_DELETE(smpTraceStream);
+}
+
+//------------------------------------------------------------------------------
+
+x86UNIXNullGL::CallType x86UNIXNullGL::getCallType(const char* pName)
+{
+   // immediate mode vertices
+   if (dStrncmp(pName, "glVertex", 8) == 0 || dStrncmp(pName, "glArrayElement", 14) == 0)
+      return CallVertex;
+
+   // render state that would cost the driver a state change
+   static const char* stateNames[] =
+   {
+      "glEnable", "glDisable", "glEnableClientState", "glDisableClientState",
+      "glBlendFunc", "glAlphaFunc", "glPolygonMode", "glShadeModel",
+      "glDepthFunc", "glDepthMask", "glColorMask", "glScissor", "glViewport",
+      "glTexEnvf", "glTexEnvi", "glTexEnvfv", "glTexEnviv",
+      "glTexParameterf", "glTexParameteri", "glActiveTextureARB", "glClientActiveTextureARB",
+   };
+
+   for (U32 i = 0; i < sizeof(stateNames) / sizeof(stateNames[0]); i++)
+   {
+      if (dStrcmp(pName, stateNames[i]) == 0)
+         return CallState;
+   }
+
+   return CallOther;
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::recordCall(const char* pName, const CallType type)
+{
+   smStats.callCount++;
+
+   if (type == CallVertex)
+      smStats.vertexCount++;
+   else if (type == CallState)
+      smStats.stateChangeCount++;
+
+   if (smpTraceStream != NULL)
+      trace("%s", pName);
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::recordDraw(const char* pName, const U32 vertexCount)
+{
+   smStats.callCount++;
+   smStats.drawCallCount++;
+   smStats.vertexCount += vertexCount;
+
+   if (smpTraceStream != NULL)
+      trace("%s %u", pName, vertexCount);
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::recordTextureBind(const U32 texture)
+{
+   smStats.callCount++;
+   smStats.textureBindCount++;
+
+   if (smpTraceStream != NULL)
+      trace("glBindTexture %u", texture);
+}
+
+//------------------------------------------------------------------------------
+
+void x86UNIXNullGL::trace(const char* pFormat, ...)
+{
+   char buffer[256];
+
+   va_list args;
+   va_start(args, pFormat);
+   S32 length = dVsprintf(buffer, sizeof(buffer) - 1, pFormat, args);
+   va_end(args);
+
+   if (length < 0 || length > (S32)sizeof(buffer) - 2)
+      length = sizeof(buffer) - 2;
+
+   buffer[length++] = '\n';
+   smpTraceStream->write(length, buffer);
+}
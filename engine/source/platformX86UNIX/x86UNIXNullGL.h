@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _X86UNIXNULLGL_H_
+#define _X86UNIXNULLGL_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+class FileStream;
+
+/// Null (recording) GL backend.
+///
+/// Points the GL function table at functions that accept every submission
+/// without needing a context and count what they are given: draw calls,
+/// vertices, state changes and texture binds.  Optionally every call is also
+/// written to a command trace file.  This lets the render path (BatchRender,
+/// sprite batches, scrollers etc) run headless, typically in a dedicated
+/// server, so its CPU cost can be profiled and regression tested.
+///
+/// Queries are answered with zeros and texture names are generated so that
+/// code creating textures carries on as normal.
+class x86UNIXNullGL
+{
+public:
+   struct Stats
+   {
+      U32 callCount;          ///< All GL calls
+      U32 drawCallCount;      ///< glDrawArrays, glDrawElements and glBegin
+      U32 vertexCount;        ///< Vertices drawn, including immediate mode
+      U32 stateChangeCount;   ///< Enables, blend/alpha/texture state etc
+      U32 textureBindCount;   ///< glBindTexture
+   };
+
+   enum CallType
+   {
+      CallOther,
+      CallVertex,
+      CallState,
+   };
+
+private:
+   static bool smBound;
+   static Stats smStats;
+   static FileStream* smpTraceStream;
+   static U32 smNextTextureName;
+
+public:
+   /// Point the GL function table at the null backend.
+   static void bind();
+
+   /// Restore the GL function table as it was before binding.
+   static void unbind();
+
+   static inline bool isBound() { return smBound; }
+
+   static inline const Stats& getStats() { return smStats; }
+   static void resetStats();
+
+   /// Write every GL call to a trace file.
+   static bool startTrace(const char* pFilename);
+   static void stopTrace();
+   static inline bool isTracing() { return smpTraceStream != NULL; }
+
+   /// Record a call.  Used by the null GL functions.
+   static CallType getCallType(const char* pName);
+   static void recordCall(const char* pName, const CallType type);
+   static void recordDraw(const char* pName, const U32 vertexCount);
+   static void recordTextureBind(const U32 texture);
+   static U32 generateTextureName() { return smNextTextureName++; }
+   static void trace(const char* pFormat, ...);
+};
+
+#endif // _X86UNIXNULLGL_H_
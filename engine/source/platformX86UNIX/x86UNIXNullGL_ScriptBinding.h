@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+/*! Binds or unbinds the null GL backend.
+    While bound, GL calls are counted (and optionally traced) but nothing is drawn and no GL context is needed.
+    @param enabled Whether the null GL backend is bound.
+    @return No return value.
+    @sa getNullGLStats
+*/
+ConsoleFunctionWithDocs( setNullGLEnabled, ConsoleVoid, 2, 2, (bool enabled) )
+{
+   if ( dAtob(argv[1]) )
+      x86UNIXNullGL::bind();
+   else
+      x86UNIXNullGL::unbind();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Gets whether the null GL backend is bound.
+    @return Whether the null GL backend is bound.
+*/
+ConsoleFunctionWithDocs( getNullGLEnabled, ConsoleBool, 1, 1, () )
+{
+   return x86UNIXNullGL::isBound();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Returns the calls counted by the null GL backend.
+    @return A string of the form "calls drawCalls vertices stateChanges textureBinds".
+    @sa resetNullGLStats
+*/
+ConsoleFunctionWithDocs( getNullGLStats, ConsoleString, 1, 1, () )
+{
+   const x86UNIXNullGL::Stats& stats = x86UNIXNullGL::getStats();
+
+   char* pBuffer = Con::getReturnBuffer( 128 );
+   dSprintf( pBuffer, 128, "%u %u %u %u %u", stats.callCount, stats.drawCallCount, stats.vertexCount, stats.stateChangeCount, stats.textureBindCount );
+   return pBuffer;
+}
+
+//------------------------------------------------------------------------------
+
+/*! Clears the calls counted by the null GL backend.
+    @return No return value.
+    @sa getNullGLStats
+*/
+ConsoleFunctionWithDocs( resetNullGLStats, ConsoleVoid, 1, 1, () )
+{
+   x86UNIXNullGL::resetStats();
+}
+
+//------------------------------------------------------------------------------
+
+/*! Starts writing every GL call made through the null GL backend to a trace file.
+    @param filename The trace file to write.
+    @return Whether the trace was started or not.
+    @sa stopNullGLTrace
+*/
+ConsoleFunctionWithDocs( startNullGLTrace, ConsoleBool, 2, 2, (filename) )
+{
+   return x86UNIXNullGL::startTrace( argv[1] );
+}
+
+//------------------------------------------------------------------------------
+
+/*! Stops writing the null GL backend's trace file.
+    @return No return value.
+    @sa startNullGLTrace
+*/
+ConsoleFunctionWithDocs( stopNullGLTrace, ConsoleVoid, 1, 1, () )
+{
+   x86UNIXNullGL::stopTrace();
+}
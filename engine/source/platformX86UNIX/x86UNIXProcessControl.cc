@@ -25,6 +25,8 @@
 #include "platformX86UNIX/platformX86UNIX.h"
 #include "platformX86UNIX/x86UNIXState.h"
 #include "platformX86UNIX/x86UNIXStdConsole.h"
+#include "platformX86UNIX/x86UNIXEventWait.h"
+#include "platformX86UNIX/x86UNIXFileWatcher.h"
 #include "platformX86UNIX/x86UNIXMutex.h"
 #include "game/gameInterface.h"
 #include "platform/platformAudio.h"
@@ -93,6 +95,8 @@ void Cleanup(bool minimal)
    }
 
    StdConsole::destroy();
+   x86UNIXEventWait::destroy();
+   x86UNIXFileWatcher::destroy();
 #ifndef DEDICATED
    GLLoader::OpenGLShutdown();
    SDL_Quit();
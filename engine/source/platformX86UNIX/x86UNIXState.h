@@ -59,6 +59,7 @@ class x86UNIXPlatformState
       bool                 mXWindowsRunning;
       bool                 mDedicated;
       bool                 mDSleep;
+      bool                 mEventWait;
       bool                 mUseRedirect;
 
       // Access to the display* needs to be controlled because the SDL event
@@ -145,6 +146,9 @@ class x86UNIXPlatformState
       bool getDSleep() { return mDSleep; }
       void setDSleep(bool enabled) { mDSleep = enabled; }
 
+      bool getEventWait() { return mEventWait; }
+      void setEventWait(bool enabled) { mEventWait = enabled; }
+
       bool getUseRedirect() { return mUseRedirect; }
       void setUseRedirect(bool enabled) { mUseRedirect = enabled; }
       
@@ -160,6 +164,7 @@ class x86UNIXPlatformState
          mXWindowsRunning = false;
          mDedicated = false;
          mDSleep = false;
+         mEventWait = false;
 #ifdef USE_FILE_REDIRECT
          mUseRedirect = true;
 #else
@@ -34,9 +34,14 @@
 #include "platform/platformInput.h"
 #include "platform/platformVideo.h"
 #include "debug/profiler.h"
+#include "sim/simBase.h"
+#include "platform/Tickable.h"
 #include "platformX86UNIX/platformGL.h"
 #include "platformX86UNIX/x86UNIXOGLVideo.h"
 #include "platformX86UNIX/x86UNIXState.h"
+#include "platformX86UNIX/x86UNIXEventWait.h"
+#include "platformX86UNIX/x86UNIXFileWatcher.h"
+#include "game/eventJournal.h"
 
 #ifndef DEDICATED
 #include "platformX86UNIX/x86UNIXMessageBox.h"
@@ -97,6 +102,11 @@ static S32 ParseCommandLine(S32 argc, const char **argv,
          x86UNIXState->setDSleep(true);
          continue;
       }
+      if (dStrcmp(argv[i], "-eventwait") == 0)
+      {
+         x86UNIXState->setEventWait(true);
+         continue;
+      }
       if (dStrcmp(argv[i], "-nohomedir") == 0)
       {
          x86UNIXState->setUseRedirect(false);
@@ -570,12 +580,30 @@ void Platform::restoreWindow()
 {
 }
 
+//------------------------------------------------------------------------------
+// Returns how long the dedicated server may block before the main loop has
+// work to do: the next scheduled Sim event or Tickable tick, whichever comes
+// first.  Both are measured from the last TimeEvent, which TimeManager only
+// posts once more than sgTimeManagerProcessInterval ms have elapsed.
+static U32 getEventWaitTimeout()
+{
+   U32 delta = getMin(Sim::getTimeToNextEvent(), Tickable::getTimeToNextTick());
+   delta = getMax(delta, U32(sgTimeManagerProcessInterval + 1));
+
+   const U32 elapsed = Platform::getRealMilliseconds() - lastTimeTick;
+   return elapsed < delta ? delta - elapsed : 0;
+}
+
 //------------------------------------------------------------------------------
 void Platform::process()
 {
    PROFILE_START(XUX_PlatformProcess);
    stdConsole->process();
 
+   // reload any files edited on disk
+   if (x86UNIXFileWatcher::isEnabled())
+      x86UNIXFileWatcherInstance->process();
+
    if (x86UNIXState->windowCreated())
    {
 #ifndef DEDICATED
@@ -597,13 +625,13 @@ void Platform::process()
       PROFILE_END();
 
       // if we're not the foreground window, sleep for 1 ms
-      if (!x86UNIXState->windowActive())
+      if (!x86UNIXState->windowActive() && !EventJournal::isReplaying())
          Sleep(0, getBackgroundSleepTime() * 1000000);
 #endif
    }
-   else
+   else if (!EventJournal::isReplaying())
    {
-      // no window
+      // no window and not replaying an event journal as fast as possible
       // if we're not in journal mode, sleep for 1 ms
       // JMQ: since linux's minimum sleep latency seems to be 20ms, this can
       // increase player pings by 10-20ms in the dedicated server.  So 
@@ -611,7 +639,14 @@ void Platform::process()
       // there are no players connected.
       // JMQ: recent kernels (such as RH 8.0 2.4.18) reduce the latency
       // to 2-4 ms on average.
-      if (!Game->isJournalReading() && (x86UNIXState->getDSleep() || 
+      // with -eventwait the server instead blocks until the next Sim event
+      // or tick is due, or until a socket or stdin becomes readable.
+      if (x86UNIXEventWait::isEnabled())
+      {
+         if (!Game->isJournalReading())
+            x86UNIXEventWaiter->wait(getEventWaitTimeout());
+      }
+      else if (!Game->isJournalReading() && (x86UNIXState->getDSleep() || 
              Con::getIntVariable("Server::PlayerCount") - 
              Con::getIntVariable("Server::BotCount") <= 0))
       {
@@ -717,7 +752,14 @@ void Platform::init()
    }
 #endif
    // if we are dedicated, do sleep timing and display results
-   if (x86UNIXState->isDedicated())
+   if (x86UNIXState->isDedicated() && x86UNIXState->getEventWait())
+   {
+      if (x86UNIXEventWait::create())
+         Con::printf("Event wait enabled for dedicated server");
+      else
+         Con::warnf("Event wait unavailable, falling back to sleep polling");
+   }
+   if (x86UNIXState->isDedicated() && !x86UNIXEventWait::isEnabled())
    {
       const S32 MaxSleepIter = 10;
       U32 totalSleepTime = 0;
@@ -71,10 +71,6 @@
 #include "simConsoleEvent.h"
 #endif
 
-#ifndef _SIM_CONSOLE_THREAD_EXEC_EVENT_H_
-#include "simConsoleThreadExecEvent.h"
-#endif
-
 #ifndef _SIM_OBJECT_PTR_H_
 #include "simObjectPtr.h"
 #endif
@@ -119,6 +115,7 @@ enum SimObjectsConstants
 
 class SimEvent;
 class SimObject;
+class SimTimerWheel;
 class SimGroup;
 class SimManager;
 class Namespace;
@@ -160,6 +157,11 @@ namespace Sim
    SimDataBlockGroup *getDataBlockGroup();
    SimGroup* getRootGroup();
 
+   /// The shared timer wheel for native periodic timers.
+   void initTimerWheel();
+   void shutdownTimerWheel();
+   SimTimerWheel* getTimerWheel();
+
    SimObject* findObject(SimObjectId);
    SimObject* findObject(const char* name);
    template<class T> inline bool findObject(SimObjectId id,T*&t)
@@ -213,9 +215,17 @@ namespace Sim
    void cancelEvent(U32 eventId);
    bool isEventPending(U32 eventId);
    U32  getEventTimeLeft(U32 eventId);
+   U32  getTimeToNextEvent();
    U32  getTimeSinceStart(U32 eventId);
    U32  getScheduleDuration(U32 eventId);
 
+   /// Wakes the main loop if the platform is blocked waiting for work.
+   /// Called when work is posted for the main thread from another thread.
+   typedef void (*MainLoopWakeFunction)();
+   void setMainLoopWakeFunction(MainLoopWakeFunction wakeFunction);
+   MainLoopWakeFunction getMainLoopWakeFunction();
+   void wakeMainLoop();
+
    bool saveObject(SimObject *obj, Stream *stream);
    SimObject *loadObjectStream(Stream *stream);
 
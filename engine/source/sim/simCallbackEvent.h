@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIM_CALLBACK_EVENT_H_
+#define _SIM_CALLBACK_EVENT_H_
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef FASTDELEGATE_H
+#include "delegates/FastDelegate.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A scheduled event that calls a native delegate with a POD payload.
+///
+/// Unlike SimConsoleEvent there's no argument copying or lookup by name, and
+/// a repeating event re-posts itself rather than being reallocated each period.
+///
+/// @code
+///     SimCallbackEvent<U32>* pEvent = new SimCallbackEvent<U32>( fastdelegate::MakeDelegate( this, &MyObject::onThink ), 0 );
+///     pEvent->setRepeat( 250 );
+///     Sim::postEvent( this, pEvent, Sim::getCurrentTime() + 250 );
+/// @endcode
+template<class T> class SimCallbackEvent : public SimEvent
+{
+public:
+    typedef fastdelegate::FastDelegate2<SimObject*, const T&> Callback;
+
+    SimCallbackEvent( const Callback& callback, const T& payload ) :
+        mCallback( callback ),
+        mPayload( payload ),
+        mPeriod( 0 ),
+        mRepeat( 1 )
+    {}
+    virtual ~SimCallbackEvent() {}
+
+    /// Repeat the event every period.  A repeat count of zero repeats until cancelled.
+    inline void setRepeat( const U32 period, const U32 repeat = 0 )
+    {
+        // Sanity!
+        AssertFatal( period > 0, "SimCallbackEvent::setRepeat() - The period must be greater than zero." );
+
+        mPeriod = period;
+        mRepeat = repeat;
+    }
+
+    inline T& getPayload( void ) { return mPayload; }
+    inline const T& getPayload( void ) const { return mPayload; }
+
+    virtual bool repost( SimTime& time )
+    {
+        // Finish if this is the last repeat.
+        if ( mRepeat == 1 )
+            return false;
+
+        // Calculate the remaining repeats.
+        if ( mRepeat > 1 )
+            mRepeat--;
+
+        time = this->time + mPeriod;
+        return true;
+    }
+
+    virtual void process( SimObject* object )
+    {
+        mCallback( object, mPayload );
+    }
+
+private:
+    Callback mCallback;
+    T mPayload;
+    U32 mPeriod;
+    U32 mRepeat;
+};
+
+#endif // _SIM_CALLBACK_EVENT_H_
@@ -79,6 +79,16 @@ class SimEvent
    ///
    /// @param   object  Object stored in destObject.
    virtual void process(SimObject *object)=0;
+
+   /// Function called just before process() to see if the event repeats.
+   ///
+   /// Returning true re-posts this same event at the returned time once it
+   /// has been processed rather than deleting it, so repeating events don't
+   /// reallocate every period. The event keeps its sequence count, so its ID
+   /// stays valid until it stops repeating or is cancelled.
+   ///
+   /// @param   time    Set to the time the event should next occur.
+   virtual bool repost(SimTime &time) { return false; }
 };
 
 #endif // _SIM_EVENT_H_
\ No newline at end of file
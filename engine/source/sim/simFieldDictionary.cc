@@ -45,91 +45,265 @@ SimFieldDictionary::Entry *SimFieldDictionary::allocEntry()
 
 void SimFieldDictionary::freeEntry(SimFieldDictionary::Entry *ent)
 {
+   dFree(ent->value);
+   ent->value = NULL;
+
    ent->next = mFreeList;
    mFreeList = ent;
 }
 
 SimFieldDictionary::SimFieldDictionary()
 {
-   for(U32 i = 0; i < HashTableSize; i++)
-      mHashTable[i] = 0;
+   mEntries = mInlineEntries;
+   mEntryFlags = mInlineEntryFlags;
+   mEntryCount = 0;
+   mEntryCapacity = InlineEntryCount;
 
    mVersion = 0;
 }
 
 SimFieldDictionary::~SimFieldDictionary()
 {
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(U32 i = 0; i < mEntryCount; i++)
+      freeEntry(mEntries[i]);
+
+   if(mEntries != mInlineEntries)
+      dFree(mEntries);
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SimFieldDictionary::findEntryIndex(StringTableEntry slotName) const
+{
+   // Binary search for the first entry not ordered before the slot name.
+   U32 lower = 0;
+   U32 upper = mEntryCount;
+   while(lower < upper)
    {
-      for(Entry *walk = mHashTable[i]; walk;)
-      {
-         Entry *temp = walk;
-         walk = temp->next;
-
-         dFree(temp->value);
-         freeEntry(temp);
-      }
+      const U32 middle = (lower + upper) >> 1;
+      if(mEntries[middle]->slotName < slotName)
+         lower = middle + 1;
+      else
+         upper = middle;
    }
+
+   return lower;
 }
 
-void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *value)
+S32 SimFieldDictionary::findEntry(StringTableEntry slotName) const
 {
-   U32 bucket = HashPointer(slotName) % HashTableSize;
-   Entry **walk = &mHashTable[bucket];
-   while(*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
+   const U32 index = findEntryIndex(slotName);
+   return index < mEntryCount && mEntries[index]->slotName == slotName ? (S32)index : -1;
+}
 
-   Entry *field = *walk;
-   if(!*value)
+U32 SimFieldDictionary::findOrInsertEntry(StringTableEntry slotName)
+{
+   const U32 index = findEntryIndex(slotName);
+   if(index < mEntryCount && mEntries[index]->slotName == slotName)
+      return index;
+
+   mVersion++;
+
+   // Grow the entries, moving them to the heap if they no longer fit inline.
+   // The entries and their flags share a single allocation.
+   if(mEntryCount == mEntryCapacity)
    {
-      if(field)
-      {
-         mVersion++;
-
-         dFree(field->value);
-         *walk = field->next;
-         freeEntry(field);
-      }
+      const U32 newCapacity = mEntryCapacity * 2;
+      Entry **newEntries = (Entry **) dMalloc(newCapacity * (sizeof(Entry *) + sizeof(U8)));
+      U8 *newEntryFlags = (U8 *) (newEntries + newCapacity);
+      dMemcpy(newEntries, mEntries, mEntryCount * sizeof(Entry *));
+      dMemcpy(newEntryFlags, mEntryFlags, mEntryCount * sizeof(U8));
+
+      if(mEntries != mInlineEntries)
+         dFree(mEntries);
+
+      mEntries = newEntries;
+      mEntryFlags = newEntryFlags;
+      mEntryCapacity = newCapacity;
    }
+
+   // Insert in order.
+   dMemmove(mEntries + index + 1, mEntries + index, (mEntryCount - index) * sizeof(Entry *));
+   dMemmove(mEntryFlags + index + 1, mEntryFlags + index, (mEntryCount - index) * sizeof(U8));
+   mEntryCount++;
+
+   Entry *field = allocEntry();
+   field->slotName = slotName;
+   field->value = NULL;
+   field->floatValue = 0.0;
+   mEntries[index] = field;
+   mEntryFlags[index] = 0;
+
+   return index;
+}
+
+void SimFieldDictionary::removeEntry(U32 index)
+{
+   mVersion++;
+
+   freeEntry(mEntries[index]);
+
+   mEntryCount--;
+   dMemmove(mEntries + index, mEntries + index + 1, (mEntryCount - index) * sizeof(Entry *));
+   dMemmove(mEntryFlags + index, mEntryFlags + index + 1, (mEntryCount - index) * sizeof(U8));
+}
+
+//-----------------------------------------------------------------------------
+
+void SimFieldDictionary::copyEntryText(Entry *entry, const char *value)
+{
+   // Ignore if the value is the entries own buffer.
+   if(value == entry->value)
+      return;
+
+   // Reuse the existing buffer if the new text fits in it.
+   const U32 newLen = dStrlen(value) + 1;
+   if(entry->value == NULL)
+      entry->value = (char *) dMalloc(newLen);
+   else if(newLen > dStrlen(entry->value) + 1)
+      entry->value = (char *) dRealloc(entry->value, newLen);
+
+   // The value may be part of the existing text.
+   dMemmove(entry->value, value, newLen);
+}
+
+void SimFieldDictionary::formatEntryText(U32 index)
+{
+   if(mEntryFlags[index] & TextValid)
+      return;
+
+   Entry *entry = mEntries[index];
+
+   // Format the same as the string stack does for script values.
+   char buffer[32];
+   if(mEntryFlags[index] & IntValid)
+      dSprintf(buffer, sizeof(buffer), "%d", (S32)entry->floatValue);
    else
+      dSprintf(buffer, sizeof(buffer), "%.9g", entry->floatValue);
+
+   copyEntryText(entry, buffer);
+   mEntryFlags[index] |= TextValid;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *value)
+{
+   // An empty value removes the field.
+   if(!*value)
    {
-      if(field)
-      {
-         dFree(field->value);
-         field->value = dStrdup(value);
-      }
-      else
-      {
-         mVersion++;
-
-         field = allocEntry();
-         field->value = dStrdup(value);
-         field->slotName = slotName;
-         field->next = NULL;
-         *walk = field;
-      }
+      const S32 index = findEntry(slotName);
+      if(index >= 0)
+         removeEntry((U32)index);
+
+      return;
    }
+
+   const U32 index = findOrInsertEntry(slotName);
+   copyEntryText(mEntries[index], value);
+   mEntryFlags[index] = TextValid;
 }
 
 const char *SimFieldDictionary::getFieldValue(StringTableEntry slotName)
 {
-   U32 bucket = HashPointer(slotName) % HashTableSize;
+   const S32 index = findEntry(slotName);
+   if(index < 0)
+      return NULL;
+
+   formatEntryText((U32)index);
+   return mEntries[index]->value;
+}
+
+void SimFieldDictionary::setFieldFloat(StringTableEntry slotName, const F64 value)
+{
+   const U32 index = findOrInsertEntry(slotName);
+   mEntries[index]->floatValue = value;
+   mEntryFlags[index] = FloatValid;
+}
+
+void SimFieldDictionary::setFieldInt(StringTableEntry slotName, const S32 value)
+{
+   const U32 index = findOrInsertEntry(slotName);
+   mEntries[index]->floatValue = (F64)value;
+   mEntryFlags[index] = IntValid | FloatValid;
+}
+
+bool SimFieldDictionary::getFieldFloat(StringTableEntry slotName, F64& value)
+{
+   const S32 index = findEntry(slotName);
+   if(index < 0)
+      return false;
+
+   Entry *field = mEntries[index];
+
+   // Parse and cache the text value.
+   if(!(mEntryFlags[index] & FloatValid))
+   {
+      field->floatValue = dAtof(field->value);
+      mEntryFlags[index] |= FloatValid;
+   }
+
+   value = field->floatValue;
+   return true;
+}
+
+bool SimFieldDictionary::getFieldInt(StringTableEntry slotName, S32& value)
+{
+   const S32 index = findEntry(slotName);
+   if(index < 0)
+      return false;
+
+   // Integers are held exactly in the float value.
+   if(mEntryFlags[index] & IntValid)
+   {
+      value = (S32)mEntries[index]->floatValue;
+      return true;
+   }
+
+   // Otherwise parse the text the same as the console does.
+   formatEntryText((U32)index);
+   value = dAtoi(mEntries[index]->value);
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SimFieldDictionary::getMemoryUsage() const
+{
+   U32 bytes = sizeof(SimFieldDictionary);
 
-   for(Entry *walk = mHashTable[bucket];walk;walk = walk->next)
-      if(walk->slotName == slotName)
-         return walk->value;
+   if(mEntries != mInlineEntries)
+      bytes += mEntryCapacity * (sizeof(Entry *) + sizeof(U8));
 
-   return NULL;
+   for(U32 i = 0; i < mEntryCount; i++)
+   {
+      bytes += sizeof(Entry);
+      if(mEntries[i]->value != NULL)
+         bytes += dStrlen(mEntries[i]->value) + 1;
+   }
+
+   return bytes;
 }
 
+//-----------------------------------------------------------------------------
 
 void SimFieldDictionary::assignFrom(SimFieldDictionary *dict)
 {
    mVersion++;
 
-   for(U32 i = 0; i < HashTableSize; i++)
-      for(Entry *walk = dict->mHashTable[i];walk; walk = walk->next)
+   // Copy the values in whichever form they are currently held.
+   for(U32 i = 0; i < dict->mEntryCount; i++)
+   {
+      Entry *walk = dict->mEntries[i];
+      const U8 flags = dict->mEntryFlags[i];
+
+      if(flags & TextValid)
          setFieldValue(walk->slotName, walk->value);
+      else if(flags & IntValid)
+         setFieldInt(walk->slotName, (S32)walk->floatValue);
+      else
+         setFieldFloat(walk->slotName, walk->floatValue);
+   }
 }
 
 static S32 QSORT_CALLBACK compareEntries(const void* a,const void* b)
@@ -145,25 +319,25 @@ void SimFieldDictionary::writeFields(SimObject *obj, Stream &stream, U32 tabStop
    const AbstractClassRep::FieldList &list = obj->getFieldList();
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(U32 e = 0; e < mEntryCount; e++)
    {
-      for(Entry *walk = mHashTable[i];walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 i;
-         for(i = 0; i < (U32)list.size(); i++)
-            if(list[i].pFieldname == walk->slotName)
-               break;
+      Entry *walk = mEntries[e];
 
-         if(i != list.size())
-            continue;
+      // make sure we haven't written this out yet:
+      U32 i;
+      for(i = 0; i < (U32)list.size(); i++)
+         if(list[i].pFieldname == walk->slotName)
+            break;
 
+      if(i != list.size())
+         continue;
 
-         if (!obj->writeField(walk->slotName, walk->value))
-            continue;
+      formatEntryText(e);
 
-         flist.push_back(walk);
-      }
+      if (!obj->writeField(walk->slotName, walk->value))
+         continue;
+
+      flist.push_back(walk);
    }
 
    // Sort Entries to prevent version control conflicts
@@ -191,21 +365,22 @@ void SimFieldDictionary::printFields(SimObject *obj)
    char expandedBuffer[4096];
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for(U32 i = 0; i < HashTableSize; i++)
+   for(U32 e = 0; e < mEntryCount; e++)
    {
-      for(Entry *walk = mHashTable[i];walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 i;
-         for(i = 0; i < (U32)list.size(); i++)
-            if(list[i].pFieldname == walk->slotName)
-               break;
-
-         if(i != list.size())
-            continue;
-
-         flist.push_back(walk);
-      }
+      Entry *walk = mEntries[e];
+
+      // make sure we haven't written this out yet:
+      U32 i;
+      for(i = 0; i < (U32)list.size(); i++)
+         if(list[i].pFieldname == walk->slotName)
+            break;
+
+      if(i != list.size())
+         continue;
+
+      formatEntryText(e);
+
+      flist.push_back(walk);
    }
    dQsort(flist.address(),flist.size(),sizeof(Entry *),compareEntries);
 
@@ -222,7 +397,7 @@ void SimFieldDictionary::printFields(SimObject *obj)
 SimFieldDictionaryIterator::SimFieldDictionaryIterator(SimFieldDictionary * dictionary)
 {
    mDictionary = dictionary;
-   mHashIndex = -1;
+   mIndex = -1;
    mEntry = 0;
    operator++();
 }
@@ -232,11 +407,15 @@ SimFieldDictionary::Entry* SimFieldDictionaryIterator::operator++()
    if(!mDictionary)
       return(mEntry);
 
-   if(mEntry)
-      mEntry = mEntry->next;
+   if(++mIndex < (S32)mDictionary->mEntryCount)
+   {
+      mEntry = mDictionary->mEntries[mIndex];
 
-   while(!mEntry && (mHashIndex < (SimFieldDictionary::HashTableSize-1)))
-      mEntry = mDictionary->mHashTable[++mHashIndex];
+      // Ensure the text is available to the caller.
+      mDictionary->formatEntryText(mIndex);
+   }
+   else
+      mEntry = 0;
 
    return(mEntry);
 }
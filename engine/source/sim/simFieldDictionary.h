@@ -34,6 +34,13 @@ class SimObject;
 //-----------------------------------------------------------------------------
 
 /// Dictionary to keep track of dynamic fields on SimObject.
+///
+/// Entries are kept in an array sorted by their (interned) slot name so lookups are a binary search.  The
+/// array is held inline in the dictionary for the typical number of fields and only moves to the heap when it
+/// grows beyond that.  Values can be stored as text or as a number.  Numeric values are only formatted as text
+/// when the text is actually requested and text values cache their float conversion once it has been requested.
+/// Each entry's flags are kept in a byte array alongside the sorted entries so the entries stay as small as a
+/// name, a value and a number.
 
 class SimFieldDictionary
 {
@@ -43,25 +50,50 @@ class SimFieldDictionary
    struct Entry
    {
       StringTableEntry slotName;
-      char *value;
-      Entry *next;
+      char *value;          ///< Text value.  Use SimFieldDictionary::getFieldValue() or an iterator to ensure it is formatted.
+      union
+      {
+         F64 floatValue;    ///< Cached float value (valid with FloatValid).
+         Entry *next;       ///< Free-list link.
+      };
    };
    enum
    {
-      HashTableSize = 19
+      InlineEntryCount = 16
+   };
+   enum EntryFlags
+   {
+      TextValid   = BIT(0),
+      FloatValid  = BIT(1),
+      IntValid    = BIT(2),   ///< The float value holds an integer.
    };
-   Entry *mHashTable[HashTableSize];
   private:
 
    static Entry *mFreeList;
    static void freeEntry(Entry *entry);
    static Entry *allocEntry();
 
+   /// Entries sorted by slot name and their flags.
+   /// These either refer to the inline arrays or to a single heap allocation once there are too many fields.
+   Entry **mEntries;
+   U8 *mEntryFlags;
+   U32 mEntryCount;
+   U32 mEntryCapacity;
+   Entry *mInlineEntries[InlineEntryCount];
+   U8 mInlineEntryFlags[InlineEntryCount];
+
    /// In order to efficiently detect when a dynamic field has been
    /// added or deleted, we increment this every time we add or
    /// remove a field.
    U32 mVersion;
 
+   U32 findEntryIndex(StringTableEntry slotName) const;
+   S32 findEntry(StringTableEntry slotName) const;
+   U32 findOrInsertEntry(StringTableEntry slotName);
+   void removeEntry(U32 index);
+   void formatEntryText(U32 index);
+   static void copyEntryText(Entry *entry, const char *value);
+
 public:
    const U32 getVersion() const { return mVersion; }
 
@@ -69,6 +101,18 @@ public:
    ~SimFieldDictionary();
    void setFieldValue(StringTableEntry slotName, const char *value);
    const char *getFieldValue(StringTableEntry slotName);
+
+   /// Numeric access which avoids formatting and parsing text where possible.
+   void setFieldFloat(StringTableEntry slotName, const F64 value);
+   void setFieldInt(StringTableEntry slotName, const S32 value);
+   bool getFieldFloat(StringTableEntry slotName, F64& value);
+   bool getFieldInt(StringTableEntry slotName, S32& value);
+
+   inline U32 getFieldCount() const { return mEntryCount; }
+
+   /// The approximate number of bytes used by the dictionary, its entries and their values.
+   U32 getMemoryUsage() const;
+
    void writeFields(SimObject *obj, Stream &strem, U32 tabStop);
    void printFields(SimObject *obj);
    void assignFrom(SimFieldDictionary *dict);
@@ -76,10 +120,12 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/// Iterates the entries in a SimFieldDictionary.
+/// Any entry returned has its text value formatted.
 class SimFieldDictionaryIterator
 {
    SimFieldDictionary *          mDictionary;
-   S32                           mHashIndex;
+   S32                           mIndex;
    SimFieldDictionary::Entry *   mEntry;
 
   public:
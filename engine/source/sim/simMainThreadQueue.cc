@@ -0,0 +1,492 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "sim/simMainThreadQueue.h"
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+#if defined(_MSC_VER)
+#define SIM_THREAD_LOCAL __declspec(thread)
+#else
+#define SIM_THREAD_LOCAL __thread
+#endif
+
+//-----------------------------------------------------------------------------
+
+class SimMainThreadPromise
+{
+public:
+    SimMainThreadPromise() :
+        mRefCount( 1 ),
+        mReady( false ),
+        mpResult( NULL ),
+        mSemaphore( 0 )
+    {}
+
+    ~SimMainThreadPromise()
+    {
+        if ( mpResult != NULL )
+            dFree( mpResult );
+    }
+
+    inline void addReference( void ) { mRefCount.fetch_add( 1, std::memory_order_relaxed ); }
+
+    inline void removeReference( void )
+    {
+        if ( mRefCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+            delete this;
+    }
+
+    void fulfil( const char* pResult )
+    {
+        // Copy the result as it may live in a transient buffer.
+        if ( pResult == NULL )
+            pResult = "";
+        const U32 length = dStrlen( pResult );
+        mpResult = (char*)dMalloc( length + 1 );
+        dMemcpy( mpResult, pResult, length + 1 );
+
+        // Publish the result and wake any waiter.
+        mReady.store( true, std::memory_order_release );
+        mSemaphore.release();
+    }
+
+    inline bool isReady( void ) const { return mReady.load( std::memory_order_acquire ); }
+    inline const char* getResult( void ) const { return isReady() ? mpResult : NULL; }
+
+    void waitForResult( void )
+    {
+        // Finish if already ready.
+        if ( isReady() )
+            return;
+
+        // The main thread must process the queue itself or it would never be ready.
+        if ( Con::isMainThread() )
+        {
+            while ( !isReady() )
+            {
+                if ( Sim::processMainThreadQueue( 0 ) == 0 && !isReady() )
+                    Platform::sleep( 0 );
+            }
+            return;
+        }
+
+        // Wait and then release again for any later wait.
+        mSemaphore.acquire();
+        mSemaphore.release();
+    }
+
+private:
+    std::atomic<U32>    mRefCount;
+    std::atomic<bool>   mReady;
+    char*               mpResult;
+    Semaphore           mSemaphore;
+};
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture::SimMainThreadFuture( SimMainThreadPromise* pPromise ) :
+    mpPromise( pPromise )
+{
+    if ( mpPromise != NULL )
+        mpPromise->addReference();
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture::SimMainThreadFuture( const SimMainThreadFuture& future ) :
+    mpPromise( future.mpPromise )
+{
+    if ( mpPromise != NULL )
+        mpPromise->addReference();
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture::~SimMainThreadFuture()
+{
+    if ( mpPromise != NULL )
+        mpPromise->removeReference();
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture& SimMainThreadFuture::operator=( const SimMainThreadFuture& future )
+{
+    if ( future.mpPromise != NULL )
+        future.mpPromise->addReference();
+
+    if ( mpPromise != NULL )
+        mpPromise->removeReference();
+
+    mpPromise = future.mpPromise;
+
+    return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SimMainThreadFuture::isReady( void ) const
+{
+    return mpPromise != NULL && mpPromise->isReady();
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SimMainThreadFuture::getResult( void ) const
+{
+    return mpPromise != NULL ? mpPromise->getResult() : NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SimMainThreadFuture::waitForResult( void )
+{
+    // Finish if there's nothing to wait for.
+    if ( mpPromise == NULL )
+        return NULL;
+
+    mpPromise->waitForResult();
+
+    return mpPromise->getResult();
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadWork::SimMainThreadWork() :
+    mpNextWork( NULL ),
+    mpPromise( NULL )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadWork::~SimMainThreadWork()
+{
+    // Never leave a future waiting.
+    if ( mpPromise != NULL )
+        complete( NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture SimMainThreadWork::getFuture( void )
+{
+    // Create the promise on demand.
+    if ( mpPromise == NULL )
+        mpPromise = new SimMainThreadPromise();
+
+    return SimMainThreadFuture( mpPromise );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimMainThreadWork::complete( const char* pResult )
+{
+    // Finish if nobody is interested in the result.
+    if ( mpPromise == NULL )
+        return;
+
+    mpPromise->fulfil( pResult );
+    mpPromise->removeReference();
+    mpPromise = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadScriptWork::SimMainThreadScriptWork( S32 argc, const char** argv, SimObject* pObject ) :
+    mArgc( argc ),
+    mObjectId( pObject != NULL ? pObject->getId() : 0 )
+{
+    // Copy the arguments into a single allocation.
+    U32 totalSize = sizeof(char*) * argc;
+    for ( S32 n = 0; n < argc; ++n )
+        totalSize += dStrlen( argv[n] ) + 1;
+
+    mArgv = (char**)dMalloc( totalSize );
+    char* pArgBase = (char*)&mArgv[argc];
+
+    for ( S32 n = 0; n < argc; ++n )
+    {
+        const U32 length = dStrlen( argv[n] ) + 1;
+        mArgv[n] = pArgBase;
+        dMemcpy( pArgBase, argv[n], length );
+        pArgBase += length;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadScriptWork::~SimMainThreadScriptWork()
+{
+    dFree( mArgv );
+}
+
+//-----------------------------------------------------------------------------
+
+const char* SimMainThreadScriptWork::execute( void )
+{
+    // Global function?
+    if ( mObjectId == 0 )
+        return Con::execute( mArgc, const_cast<const char**>( mArgv ) );
+
+    // Finish if the object has gone.
+    SimObject* pObject = Sim::findObject( mObjectId );
+    if ( pObject == NULL )
+        return NULL;
+
+    return Con::execute( pObject, mArgc, const_cast<const char**>( mArgv ) );
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadQueue::SimMainThreadQueue() :
+    mpHead( &mStub ),
+    mpTail( &mStub ),
+    mPendingCount( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadQueue::~SimMainThreadQueue()
+{
+    cancelAll();
+}
+
+//-----------------------------------------------------------------------------
+
+void SimMainThreadQueue::post( SimMainThreadWork* pWork )
+{
+    // Sanity!
+    AssertFatal( pWork != NULL, "SimMainThreadQueue::post() - Cannot post NULL work." );
+
+    mPendingCount.fetch_add( 1, std::memory_order_relaxed );
+    push( pWork );
+
+    // Wake the main loop in case it is waiting.
+    Sim::wakeMainLoop();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SimMainThreadQueue::process( const U32 budgetMs )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SimMainThreadQueue_Process);
+
+    // Sanity!
+    AssertFatal( Con::isMainThread(), "SimMainThreadQueue::process() - Can only be processed on the main thread." );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+    U32 processedCount = 0;
+
+    SimMainThreadWork* pWork;
+    while ( (pWork = pop()) != NULL )
+    {
+        mPendingCount.fetch_sub( 1, std::memory_order_relaxed );
+
+        // Execute the work and hand any result to its future.
+        pWork->complete( pWork->execute() );
+        delete pWork;
+
+        processedCount++;
+
+        // Stop if we've spent our budget.
+        if ( budgetMs > 0 && (Platform::getRealMilliseconds() - startTime) >= budgetMs )
+            break;
+    }
+
+    return processedCount;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimMainThreadQueue::cancelAll( void )
+{
+    // Delete the work without executing it.
+    // NOTE:-   Deleting the work completes any future with an empty result.
+    SimMainThreadWork* pWork;
+    while ( (pWork = pop()) != NULL )
+    {
+        mPendingCount.fetch_sub( 1, std::memory_order_relaxed );
+        delete pWork;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SimMainThreadQueue::push( SimMainThreadWork* pWork )
+{
+    // Swap in the new head then link the previous head to it.
+    // NOTE:-   Until the link is made the consumer simply sees the queue end early.
+    pWork->mpNextWork.store( NULL, std::memory_order_relaxed );
+    SimMainThreadWork* pPrevious = mpHead.exchange( pWork, std::memory_order_acq_rel );
+    pPrevious->mpNextWork.store( pWork, std::memory_order_release );
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadWork* SimMainThreadQueue::pop( void )
+{
+    SimMainThreadWork* pTail = mpTail;
+    SimMainThreadWork* pNext = pTail->mpNextWork.load( std::memory_order_acquire );
+
+    // Skip the stub.
+    if ( pTail == &mStub )
+    {
+        if ( pNext == NULL )
+            return NULL;
+
+        mpTail = pNext;
+        pTail = pNext;
+        pNext = pNext->mpNextWork.load( std::memory_order_acquire );
+    }
+
+    // Take the tail if it's not the last.
+    if ( pNext != NULL )
+    {
+        mpTail = pNext;
+        return pTail;
+    }
+
+    // Finish if a producer is part way through a push.
+    if ( pTail != mpHead.load( std::memory_order_acquire ) )
+        return NULL;
+
+    // The tail is the last so push the stub behind it before taking it.
+    push( &mStub );
+
+    pNext = pTail->mpNextWork.load( std::memory_order_acquire );
+    if ( pNext != NULL )
+    {
+        mpTail = pNext;
+        return pTail;
+    }
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace Sim
+{
+
+static SimMainThreadQueue* gMainThreadQueue = NULL;
+
+//-----------------------------------------------------------------------------
+
+void initMainThreadQueue()
+{
+   gMainThreadQueue = new SimMainThreadQueue();
+}
+
+//-----------------------------------------------------------------------------
+
+void shutdownMainThreadQueue()
+{
+   delete gMainThreadQueue;
+   gMainThreadQueue = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+bool isMainThreadQueueRunning()
+{
+   return gMainThreadQueue != NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void postMainThreadWork( SimMainThreadWork* pWork )
+{
+   // Discard the work if the queue isn't running.
+   // NOTE: Deleting the work completes any future with an empty result.
+   if ( gMainThreadQueue == NULL )
+   {
+      delete pWork;
+      return;
+   }
+
+   gMainThreadQueue->post( pWork );
+}
+
+//-----------------------------------------------------------------------------
+
+SimMainThreadFuture postMainThreadScript( S32 argc, const char** argv, SimObject* pObject )
+{
+   SimMainThreadScriptWork* pWork = new SimMainThreadScriptWork( argc, argv, pObject );
+   SimMainThreadFuture future = pWork->getFuture();
+
+   postMainThreadWork( pWork );
+
+   return future;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* executeOnMainThread( S32 argc, const char** argv, SimObject* pObject )
+{
+   static SIM_THREAD_LOCAL char* sResultBuffer = NULL;
+   static SIM_THREAD_LOCAL U32 sResultBufferSize = 0;
+
+   SimMainThreadFuture future = postMainThreadScript( argc, argv, pObject );
+   const char* pResult = future.waitForResult();
+
+   // Copy the result to the calling thread as the future is about to go.
+   const U32 length = dStrlen( pResult ) + 1;
+   if ( length > sResultBufferSize )
+   {
+      sResultBuffer = (char*)dRealloc( sResultBuffer, length );
+      sResultBufferSize = length;
+   }
+   dMemcpy( sResultBuffer, pResult, length );
+
+   return sResultBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 processMainThreadQueue( const U32 budgetMs )
+{
+   return gMainThreadQueue != NULL ? gMainThreadQueue->process( budgetMs ) : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 getMainThreadQueuePending()
+{
+   return gMainThreadQueue != NULL ? gMainThreadQueue->getPendingCount() : 0;
+}
+
+} // Sim Namespace.
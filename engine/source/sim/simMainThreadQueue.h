@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#define _SIM_MAIN_THREAD_QUEUE_H_
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+class SimMainThreadPromise;
+
+//-----------------------------------------------------------------------------
+
+/// A handle to the result of work executed on the main thread.
+///
+/// Futures are reference counted so they can be copied freely and outlive
+/// the work that produced them.  The result is a copy owned by the future.
+class SimMainThreadFuture
+{
+public:
+    SimMainThreadFuture() : mpPromise( NULL ) {}
+    SimMainThreadFuture( const SimMainThreadFuture& future );
+    ~SimMainThreadFuture();
+
+    SimMainThreadFuture& operator=( const SimMainThreadFuture& future );
+
+    inline bool isValid( void ) const { return mpPromise != NULL; }
+
+    /// Whether the work has been executed (or cancelled).
+    bool isReady( void ) const;
+
+    /// The result if ready, otherwise NULL.
+    const char* getResult( void ) const;
+
+    /// Block until the result is ready.
+    /// On the main thread this processes the queue rather than blocking.
+    const char* waitForResult( void );
+
+private:
+    friend class SimMainThreadWork;
+    explicit SimMainThreadFuture( SimMainThreadPromise* pPromise );
+
+    SimMainThreadPromise* mpPromise;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Work posted from any thread to be executed on the main thread.
+///
+/// The work is deleted by the queue once it has been executed.
+class SimMainThreadWork
+{
+public:
+    SimMainThreadWork();
+    virtual ~SimMainThreadWork();
+
+    /// Called on the main thread.  The returned string is copied into any future.
+    virtual const char* execute( void ) = 0;
+
+    /// Get a future for the result.  This must be called before the work is posted.
+    SimMainThreadFuture getFuture( void );
+
+private:
+    friend class SimMainThreadQueue;
+
+    void complete( const char* pResult );
+
+    std::atomic<SimMainThreadWork*> mpNextWork;
+    SimMainThreadPromise*           mpPromise;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Executes a script function, optionally on an object, on the main thread.
+class SimMainThreadScriptWork : public SimMainThreadWork
+{
+public:
+    SimMainThreadScriptWork( S32 argc, const char** argv, SimObject* pObject = NULL );
+    virtual ~SimMainThreadScriptWork();
+
+    virtual const char* execute( void );
+
+private:
+    S32 mArgc;
+    char** mArgv;
+    SimObjectId mObjectId;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A multi-producer, single-consumer queue of work for the main thread.
+///
+/// Posting is lock-free from any thread.  Only the main thread processes the
+/// queue, which it does once per frame within a time budget.  Work posted by
+/// one thread is executed in the order it was posted.
+class SimMainThreadQueue
+{
+public:
+    SimMainThreadQueue();
+    ~SimMainThreadQueue();
+
+    /// Post work from any thread.
+    void post( SimMainThreadWork* pWork );
+
+    /// Execute work on the main thread until the queue is empty or the budget is spent.
+    /// A budget of zero processes everything.  At least one piece of work is always executed.
+    U32 process( const U32 budgetMs );
+
+    /// Delete all queued work without executing it, completing any futures with an empty result.
+    void cancelAll( void );
+
+    inline U32 getPendingCount( void ) const { return mPendingCount.load( std::memory_order_relaxed ); }
+
+private:
+    class StubWork : public SimMainThreadWork
+    {
+    public:
+        virtual const char* execute( void ) { return NULL; }
+    };
+
+    void push( SimMainThreadWork* pWork );
+    SimMainThreadWork* pop( void );
+
+    std::atomic<SimMainThreadWork*> mpHead;
+    SimMainThreadWork*              mpTail;
+    StubWork                        mStub;
+    std::atomic<U32>                mPendingCount;
+};
+
+//-----------------------------------------------------------------------------
+
+namespace Sim
+{
+   void initMainThreadQueue();
+   void shutdownMainThreadQueue();
+
+   /// Whether the main thread queue is running.  Work posted when it isn't is discarded.
+   bool isMainThreadQueueRunning();
+
+   /// Post work to the main thread queue from any thread.
+   void postMainThreadWork( SimMainThreadWork* pWork );
+
+   /// Post a script call to the main thread queue from any thread.
+   SimMainThreadFuture postMainThreadScript( S32 argc, const char** argv, SimObject* pObject = NULL );
+
+   /// Post a script call and wait for its result.
+   /// The result is valid on the calling thread until its next call.
+   const char* executeOnMainThread( S32 argc, const char** argv, SimObject* pObject = NULL );
+
+   /// Process the main thread queue within a budget.
+   U32 processMainThreadQueue( const U32 budgetMs );
+
+   /// Count the work waiting in the main thread queue.
+   U32 getMainThreadQueuePending();
+}
+
+#endif // _SIM_MAIN_THREAD_QUEUE_H_
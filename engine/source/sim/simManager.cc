@@ -23,6 +23,7 @@
 #include "platform/platform.h"
 #include "platform/threads/mutex.h"
 #include "sim/simBase.h"
+#include "sim/simMainThreadQueue.h"
 #include "string/stringTable.h"
 #include "console/console.h"
 #include "io/fileStream.h"
@@ -47,6 +48,10 @@ void *gEventQueueMutex;
 SimEvent *gEventQueue;
 U32 gEventSequence;
 
+// The event currently being processed and whether it will be re-posted.
+SimEvent *gProcessingEvent;
+bool gProcessingEventRepost;
+
 //---------------------------------------------------------------------------
 // event queue init/shutdown
 
@@ -56,6 +61,8 @@ void initEventQueue()
    gTargetTime = 0;
    gEventSequence = 1;
    gEventQueue = NULL;
+   gProcessingEvent = NULL;
+   gProcessingEventRepost = false;
    gEventQueueMutex = Mutex::createMutex();
 }
 
@@ -77,6 +84,42 @@ void shutdownEventQueue()
 //---------------------------------------------------------------------------
 // event post
 
+static void insertEvent(SimEvent* event)
+{
+   SimEvent **walk = &gEventQueue;
+   SimEvent *current;
+   
+   while((current = *walk) != NULL && (current->time < event->time))
+      walk = &(current->nextEvent);
+   
+   // [tom, 6/24/2005] This ensures that SimEvents are dispatched in the same order that they are posted.
+   // This is needed to ensure Con::threadSafeExecute() executes script code in the correct order.
+   while((current = *walk) != NULL && (current->time == event->time))
+      walk = &(current->nextEvent);
+   
+   event->nextEvent = current;
+   *walk = event;
+}
+
+static MainLoopWakeFunction gMainLoopWakeFunction = NULL;
+
+void setMainLoopWakeFunction(MainLoopWakeFunction wakeFunction)
+{
+   gMainLoopWakeFunction = wakeFunction;
+}
+
+MainLoopWakeFunction getMainLoopWakeFunction()
+{
+   return gMainLoopWakeFunction;
+}
+
+void wakeMainLoop()
+{
+   MainLoopWakeFunction wakeFunction = gMainLoopWakeFunction;
+   if(wakeFunction)
+      wakeFunction();
+}
+
 U32 postEvent(SimObject *destObject, SimEvent* event,U32 time)
 {
     AssertFatal(time == -1 || time >= getCurrentTime(),
@@ -101,24 +144,16 @@ U32 postEvent(SimObject *destObject, SimEvent* event,U32 time)
       return InvalidEventId;
    }
    event->sequenceCount = gEventSequence++;
-   SimEvent **walk = &gEventQueue;
-   SimEvent *current;
-   
-   while((current = *walk) != NULL && (current->time < event->time))
-      walk = &(current->nextEvent);
-   
-   // [tom, 6/24/2005] This ensures that SimEvents are dispatched in the same order that they are posted.
-   // This is needed to ensure Con::threadSafeExecute() executes script code in the correct order.
-   while((current = *walk) != NULL && (current->time == event->time))
-      walk = &(current->nextEvent);
-   
-   event->nextEvent = current;
-   *walk = event;
+   insertEvent(event);
 
    U32 seqCount = event->sequenceCount;
 
    Mutex::unlockMutex(gEventQueueMutex);
 
+   // The main thread works out how long it can wait itself, other threads have to wake it.
+   if(!Con::isMainThread())
+      wakeMainLoop();
+
    return seqCount;
 }
 
@@ -134,6 +169,14 @@ void cancelEvent(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
+   // Stop the event being processed from being re-posted.
+   if(gProcessingEvent && gProcessingEvent->sequenceCount == eventSequence)
+   {
+      gProcessingEventRepost = false;
+      Mutex::unlockMutex(gEventQueueMutex);
+      return;
+   }
+
    SimEvent **walk = &gEventQueue;
    SimEvent *current;
    
@@ -157,6 +200,10 @@ void cancelPendingEvents(SimObject *obj)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
+   // Stop the event being processed from being re-posted.
+   if(gProcessingEvent && gProcessingEvent->destObject == obj)
+      gProcessingEventRepost = false;
+
    SimEvent **walk = &gEventQueue;
    SimEvent *current;
    
@@ -188,6 +235,13 @@ bool isEventPending(U32 eventSequence)
 {
    Mutex::lockMutex(gEventQueueMutex);
 
+   // A repeating event is still pending while it is being processed.
+   if(gProcessingEvent && gProcessingEventRepost && gProcessingEvent->sequenceCount == eventSequence)
+   {
+      Mutex::unlockMutex(gEventQueueMutex);
+      return true;
+   }
+
    for(SimEvent *walk = gEventQueue; walk; walk = walk->nextEvent)
       if(walk->sequenceCount == eventSequence)
       {
@@ -222,6 +276,25 @@ U32 getEventTimeLeft(U32 eventSequence)
    return 0;   
 }
 
+/*!
+	determines how much time remains until the next event in the queue occurs.
+
+    @return the milliseconds until the earliest pending event, zero if it is already due, or U32_MAX if the queue is empty.
+    @sa getEventTimeLeft
+*/
+U32 getTimeToNextEvent()
+{
+   Mutex::lockMutex(gEventQueueMutex);
+
+   U32 t = U32_MAX;
+   if(gEventQueue)
+      t = gEventQueue->time > getCurrentTime() ? gEventQueue->time - getCurrentTime() : 0;
+
+   Mutex::unlockMutex(gEventQueueMutex);
+
+   return t;
+}
+
 /*!
 	Determines how long the event associated with eventID was scheduled for.
 
@@ -270,9 +343,32 @@ void advanceToTime(SimTime targetTime)
       gCurrentTime = event->time;
       SimObject *obj = event->destObject;
 
-      if(!obj->isDeleted())
+      // Ask a live event if it repeats before processing it as processing may cancel it.
+      SimTime repostTime = 0;
+      const bool live = !obj->isDeleted();
+      gProcessingEvent = event;
+      gProcessingEventRepost = live && event->repost(repostTime);
+
+      if(live)
          event->process(obj);
-      delete event;
+
+      // Re-post the same event if it's still repeating.
+      // NOTE: The destination object may have been deleted by processing but that cancels the repost.
+      const bool repost = gProcessingEventRepost;
+      gProcessingEvent = NULL;
+      gProcessingEventRepost = false;
+
+      if(repost)
+      {
+         AssertFatal(repostTime >= gCurrentTime, "Sim::advanceToTime: Cannot re-post an event into the past.");
+         event->startTime = gCurrentTime;
+         event->time = repostTime;
+         insertEvent(event);
+      }
+      else
+      {
+         delete event;
+      }
    }
     gCurrentTime = targetTime;
    Mutex::unlockMutex(gEventQueueMutex);
@@ -407,6 +503,7 @@ SimDataBlockGroup *getDataBlockGroup()
 void init()
 {
    initEventQueue();
+   initMainThreadQueue();
    initRoot();
 
    InstantiateNamedSet(ActiveActionMapSet);
@@ -425,10 +522,14 @@ void init()
    gDataBlockGroup = new SimDataBlockGroup();
    gDataBlockGroup->registerObject("DataBlockGroup");
    gRootGroup->addObject(gDataBlockGroup);
+
+   initTimerWheel();
 }
 
 void shutdown()
 {
+   shutdownTimerWheel();
+   shutdownMainThreadQueue();
    shutdownRoot();
    shutdownEventQueue();
 }
@@ -57,6 +57,7 @@ SimObject::SimObject()
     mId                      = 0;
     mIdString                = StringTable->EmptyString;
     mGroup                   = 0;
+    mGroupSlot               = 0;
     mNameSpace               = NULL;
     mNotifyList              = NULL;
     mTypeMask                = 0;
@@ -614,6 +615,94 @@ const char *SimObject::getDataField(StringTableEntry slotName, const char *array
 
 //-----------------------------------------------------------------------------
 
+StringTableEntry SimObject::getDynamicFieldSlot(StringTableEntry slotName, const char *array)
+{
+   // Ignore if the field is static or dynamic fields are not available.
+   if(mFlags.test(ModStaticFields) && findField(slotName))
+      return NULL;
+
+   if(!mFlags.test(ModDynamicFields))
+      return NULL;
+
+   if(!array)
+      return slotName;
+
+   char buf[256];
+   dStrcpy(buf, slotName);
+   dStrcat(buf, array);
+   return StringTable->insert(buf);
+}
+
+//-----------------------------------------------------------------------------
+
+F64 SimObject::getDataFieldFloat(StringTableEntry slotName, const char *array)
+{
+   StringTableEntry dynamicSlotName = getDynamicFieldSlot(slotName, array);
+   if(!dynamicSlotName)
+      return dAtof(getDataField(slotName, array));
+
+   F64 value;
+   if(!mFieldDictionary || !mFieldDictionary->getFieldFloat(dynamicSlotName, value))
+      return 0.0;
+
+   return value;
+}
+
+//-----------------------------------------------------------------------------
+
+S32 SimObject::getDataFieldInt(StringTableEntry slotName, const char *array)
+{
+   StringTableEntry dynamicSlotName = getDynamicFieldSlot(slotName, array);
+   if(!dynamicSlotName)
+      return dAtoi(getDataField(slotName, array));
+
+   S32 value;
+   if(!mFieldDictionary || !mFieldDictionary->getFieldInt(dynamicSlotName, value))
+      return 0;
+
+   return value;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObject::setDataFieldFloat(StringTableEntry slotName, const char *array, const F64 value)
+{
+   StringTableEntry dynamicSlotName = getDynamicFieldSlot(slotName, array);
+   if(!dynamicSlotName)
+   {
+      char buf[32];
+      dSprintf(buf, sizeof(buf), "%.9g", value);
+      setDataField(slotName, array, buf);
+      return;
+   }
+
+   if(!mFieldDictionary)
+      mFieldDictionary = new SimFieldDictionary;
+
+   mFieldDictionary->setFieldFloat(dynamicSlotName, value);
+}
+
+//-----------------------------------------------------------------------------
+
+void SimObject::setDataFieldInt(StringTableEntry slotName, const char *array, const S32 value)
+{
+   StringTableEntry dynamicSlotName = getDynamicFieldSlot(slotName, array);
+   if(!dynamicSlotName)
+   {
+      char buf[32];
+      dSprintf(buf, sizeof(buf), "%d", value);
+      setDataField(slotName, array, buf);
+      return;
+   }
+
+   if(!mFieldDictionary)
+      mFieldDictionary = new SimFieldDictionary;
+
+   mFieldDictionary->setFieldInt(dynamicSlotName, value);
+}
+
+//-----------------------------------------------------------------------------
+
 const char *SimObject::getPrefixedDataField(StringTableEntry fieldName, const char *array)
 {
     // Sanity!
@@ -968,6 +1057,16 @@ void SimObject::freeNotify(SimObject::Notify* note)
 
 //------------------------------------------------------------------------------
 
+SimObject::Notify* SimObject::findNotify(void *ptr, SimObject::Notify::Type type)
+{
+   for(Notify *note = mNotifyList; note; note = note->next)
+   {
+      if(note->ptr == ptr && note->type == type)
+         return note;
+   }
+   return NULL;
+}
+
 SimObject::Notify* SimObject::removeNotify(void *ptr, SimObject::Notify::Type type)
 {
    Notify **list = &mNotifyList;
@@ -1039,6 +1138,20 @@ void SimObject::processDeleteNotifies()
    while(mNotifyList)
    {
       Notify *note = mNotifyList;
+
+      // Sets find the object using its membership note so leave it in place
+      // whilst the set removes the object.
+      if(note->type == Notify::SetMember)
+      {
+         SimObject *set = (SimObject *) note->ptr;
+         set->onDeleteNotify(this);
+
+         note = removeNotify((void *) set, Notify::SetMember);
+         if(note)
+            freeNotify(note);
+         continue;
+      }
+
       mNotifyList = note->next;
 
       AssertFatal(note->type != Notify::ClearNotify, "Clear notes should be all gone.");
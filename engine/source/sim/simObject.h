@@ -233,6 +233,7 @@ class SimObject: public ConsoleObject, public TamlCallbacks
 
     friend class SimManager;
     friend class SimGroup;
+    friend class SimSet;
     friend class SimNameDictionary;
     friend class SimManagerNameDictionary;
     friend class SimIdDictionary;
@@ -259,8 +260,10 @@ public:
             ClearNotify,   ///< Notified when the object is cleared.
             DeleteNotify,  ///< Notified when the object is deleted.
             ObjectRef,     ///< Cleverness to allow tracking of references.
+            SetMember,     ///< Membership of a SimSet, which is notified when the object is deleted.
             Invalid        ///< Mark this notification as unused (used in freeNotify).
         } type;
+        U32 slot;         ///< Index hint of the object within the SimSet for SetMember notifications.
         void *ptr;        ///< Data (typically referencing or interested object).
         Notify *next;     ///< Next notification in the linked list.
     };
@@ -280,6 +283,7 @@ private:
     SimObject*       nextIdObject;
 
     SimGroup*   mGroup;  ///< SimGroup we're contained in, if any.
+    U32         mGroupSlot; ///< Index hint of the object within its SimGroup.
     BitSet32    mFlags;
 
     StringTableEntry    mProgenitorFile;
@@ -359,6 +363,9 @@ protected:
     void linkNamespaces();
     void unlinkNamespaces();
 
+    /// Fetch the dynamic field slot name for a field or NULL if it is not a dynamic field.
+    StringTableEntry getDynamicFieldSlot(StringTableEntry slotName, const char *array);
+
 public:
     /// @name Accessors
     /// @{
@@ -383,6 +390,20 @@ public:
     /// @param   value       Value to store.
     void setDataField(StringTableEntry slotName, const char *array, const char *value);
 
+    /// Get the numeric value of a field on the object.
+    ///
+    /// Dynamic fields cache their numeric value so repeated reads avoid parsing text.
+    /// Static fields are accessed as text via getDataField().
+    F64 getDataFieldFloat(StringTableEntry slotName, const char *array);
+    S32 getDataFieldInt(StringTableEntry slotName, const char *array);
+
+    /// Set the numeric value of a field on the object.
+    ///
+    /// Dynamic fields store the number and only format it as text if the text is requested.
+    /// Static fields are set as text via setDataField().
+    void setDataFieldFloat(StringTableEntry slotName, const char *array, const F64 value);
+    void setDataFieldInt(StringTableEntry slotName, const char *array, const S32 value);
+
     const char *getPrefixedDataField(StringTableEntry fieldName, const char *array);
 
     void setPrefixedDataField(StringTableEntry fieldName, const char *array, const char *value);
@@ -493,6 +514,7 @@ public:
 
     /// @name Notification
     /// @{
+    Notify *findNotify(void *ptr, Notify::Type);     ///< Find a notification in the list.
     Notify *removeNotify(void *ptr, Notify::Type);   ///< Remove a notification from the list.
     void deleteNotify(SimObject* obj);               ///< Notify an object when we are deleted.
     void clearNotify(SimObject* obj);                ///< Notify an object when we are cleared.
@@ -39,23 +39,26 @@ public:
     {}
     virtual ~SimObjectTimerEvent() {}
 
-    virtual void process(SimObject *object)
+    virtual bool repost( SimTime& time )
     {
-        // Do we have a repeat count?
-        if ( mRepeat == 0 || mRepeat > 1 )
-        {
-            // Calculate the remaining repeats.
-            const U32 repeat = mRepeat == 0 ? 0 : mRepeat-1;
+        // Finish if this is the last repeat.
+        if ( mRepeat == 1 )
+            return false;
 
-            // Create new timer event.
-            SimObjectTimerEvent* pEvent = new SimObjectTimerEvent( mCallbackFunction, mPeriod, repeat );
+        // Calculate the remaining repeats.
+        if ( mRepeat > 1 )
+            mRepeat--;
 
-            // Post the event.
-            object->setPeriodicTimerID( Sim::postEvent( object, pEvent, Sim::getCurrentTime() + mPeriod ) );
-        }
+        // Repeat after the period.
+        // NOTE:-   This event is re-posted rather than recreated so the timer ID remains valid.
+        time = this->time + mPeriod;
+        return true;
+    }
 
+    virtual void process(SimObject *object)
+    {
         // Script callback.
-        // This *must* be done here in-case the user turns off the timer which would be the one above!
+        // Turning the timer off here cancels the repost.
         Con::executef( object, 1, mCallbackFunction );
     }
 
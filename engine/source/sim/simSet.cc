@@ -39,27 +39,118 @@
 // Sim Set
 //////////////////////////////////////////////////////////////////////////
 
+U32* SimSet::getSlotHint( SimObject* pObject )
+{
+   // Members hold a membership note which stores their index hint.
+   Notify* note = pObject->findNotify( (void *)(SimObject*)this, Notify::SetMember );
+   return note ? &note->slot : NULL;
+}
+
+S32 SimSet::findSlot( SimObject* pObject )
+{
+   U32* pSlotHint = getSlotHint( pObject );
+   if ( pSlotHint == NULL )
+      return -1;
+
+   const S32 count = objectList.size();
+
+   // The hint is exact unless earlier members were removed from an ordered set, which
+   // only moves members towards the front, or the set was reordered.
+   S32 slot;
+   for ( slot = getMin( (S32)*pSlotHint, count - 1 ); slot >= 0; --slot )
+   {
+      if ( objectList[slot] == pObject )
+         break;
+   }
+
+   if ( slot < 0 )
+   {
+      for ( slot = (S32)*pSlotHint + 1; slot < count; ++slot )
+      {
+         if ( objectList[slot] == pObject )
+            break;
+      }
+
+      AssertFatal( slot < count, "SimSet::findSlot() - Member is not in the object list." );
+      if ( slot >= count )
+         return -1;
+   }
+
+   *pSlotHint = slot;
+   return slot;
+}
+
+void SimSet::removeSlot( const S32 slot )
+{
+   // Removing the last entry moves nothing.
+   const S32 lastSlot = objectList.size() - 1;
+   if ( slot == lastSlot )
+   {
+      objectList.decrement();
+      return;
+   }
+
+   if ( mOrdered )
+   {
+      // The members that move keep their hints which findSlot corrects when they are next removed.
+      objectList.erase( objectList.begin() + slot );
+      return;
+   }
+
+   // Move the last member into the slot.
+   SimObject* pMovedObject = objectList[lastSlot];
+   objectList[slot] = pMovedObject;
+   *getSlotHint( pMovedObject ) = slot;
+   objectList.decrement();
+}
+
 void SimSet::addObject(SimObject* obj)
 {
    lock();
-   objectList.pushBack(obj);
-   deleteNotify(obj);
+   if ( !isMember( obj ) )
+   {
+      objectList.push_back( obj );
+
+      // Note the membership on the object so the set is notified when it is deleted.
+      Notify *note = allocNotify();
+      note->type = Notify::SetMember;
+      note->slot = objectList.size() - 1;
+      note->ptr = (void *)(SimObject*)this;
+      note->next = obj->mNotifyList;
+      obj->mNotifyList = note;
+   }
    unlock();
 }
 
 void SimSet::removeObject(SimObject* obj)
 {
    lock();
-   objectList.remove(obj);
-   clearNotify(obj);
+   const S32 slot = findSlot( obj );
+   if ( slot >= 0 )
+   {
+      removeSlot( slot );
+
+      Notify *note = obj->removeNotify( (void *)(SimObject*)this, Notify::SetMember );
+      freeNotify( note );
+   }
    unlock();
 }
 
 void SimSet::pushObject(SimObject* pObj)
 {
    lock();
-   objectList.pushBackForce(pObj);
-   deleteNotify(pObj);
+   const S32 slot = findSlot( pObj );
+   if ( slot < 0 )
+   {
+      addObject( pObj );
+   }
+   else if ( slot != objectList.size() - 1 )
+   {
+      // Move it to the back.
+      removeSlot( slot );
+      objectList.push_back( pObj );
+      *getSlotHint( pObj ) = objectList.size() - 1;
+   }
    unlock();
 }
 
@@ -68,16 +159,13 @@ void SimSet::popObject()
    MutexHandle handle;
    handle.lock(mMutex);
 
-   if (objectList.size() == 0) 
+   if (empty()) 
    {
       AssertWarn(false, "Stack underflow in SimSet::popObject");
       return;
    }
 
-   SimObject* pObject = objectList[objectList.size() - 1];
-
-   objectList.removeStable(pObject);
-   clearNotify(pObject);
+   removeObject( last() );
 }
 
 //-----------------------------------------------------------------------------
@@ -91,16 +179,26 @@ void SimSet::callOnChildren( const char * method, S32 argc, const char *argv[],
    for (S32 i = 0; i < argc; i++)
       args[i + 2] = argv[i];
 
+   // The methods may add, remove or delete members so call them by id.
+   Vector<SimObjectId> memberIds;
+   memberIds.reserve( size() );
    for( iterator i = begin(); i != end(); i++ )
+      memberIds.push_back( (*i)->getId() );
+
+   for( Vector<SimObjectId>::iterator idItr = memberIds.begin(); idItr != memberIds.end(); ++idItr )
    {
-      SimObject *childObj = static_cast<SimObject*>(*i);
+      // Skip members an earlier method removed.
+      SimObject *childObj = Sim::findObject( *idItr );
+      if( childObj == NULL || !isMember( childObj ) )
+         continue;
 
       if( childObj->isMethod( method ) )
          Con::execute(childObj, argc + 2, args);
 
       if( executeOnChildGroups )
       {
-         SimSet* childSet = dynamic_cast<SimSet*>(*i);
+         // The method may have deleted the object.
+         SimSet* childSet = dynamic_cast<SimSet*>( Sim::findObject( *idItr ) );
          if ( childSet )
             childSet->callOnChildren( method, argc, argv, executeOnChildGroups );
       }
@@ -157,16 +255,12 @@ void SimSet::onRemove()
    MutexHandle handle;
    handle.lock(mMutex);
 
-   objectList.sortId();
-   if (objectList.size())
+   // Remove the membership notes from the objects.
+   for (S32 n = objectList.size() - 1; n >= 0; n--)
    {
-      // This backwards iterator loop doesn't work if the
-      // list is empty, check the size first.
-      for (SimObjectList::iterator ptr = objectList.end() - 1;
-         ptr >= objectList.begin(); ptr--)
-      {
-         clearNotify(*ptr);
-      }
+      Notify *note = objectList[n]->removeNotify((void *)(SimObject*)this, Notify::SetMember);
+      if (note)
+         freeNotify(note);
    }
 
    handle.unlock();
@@ -208,19 +302,30 @@ void SimSet::write(Stream &stream, U32 tabStop, U32 flags)
 
 void SimSet::deleteObjects( void )
 {
+    PROFILE_SCOPE(SimSet_DeleteObjects);
+
     lock();
-        while(size() > 0 )
-        {
-            objectList[0]->deleteObject();
-        }
+
+    // Delete from the back so that the remaining objects do not move.
+    // A deletion may also remove other objects so re-check the size each time.
+    for ( S32 n = objectList.size() - 1; n >= 0; n = getMin( n - 1, objectList.size() - 1 ) )
+    {
+        objectList[n]->deleteObject();
+    }
+
     unlock();
 }
 
 void SimSet::clear()
 {
    lock();
-   while (size() > 0)
-      removeObject(objectList.last());
+
+   // Remove from the back so that the remaining objects do not move.
+   for (S32 n = objectList.size() - 1; n >= 0; n = getMin(n - 1, objectList.size() - 1))
+   {
+      removeObject(objectList[n]);
+   }
+
    unlock();
 }
 
@@ -322,6 +427,7 @@ SimObject* SimGroupIterator::operator++()
 SimGroup::~SimGroup()
 {
    lock();
+
    for (iterator itr = begin(); itr != end(); itr++)
       nameDictionary.remove(*itr);
 
@@ -361,6 +467,7 @@ void SimGroup::addObject(SimObject* obj)
          obj->mGroup->removeObject(obj);
       nameDictionary.insert(obj);
       obj->mGroup = this;
+      obj->mGroupSlot = objectList.size();
       objectList.push_back(obj); // force it into the object list
       // doesn't get a delete notify
       obj->onGroupAdd();
@@ -375,12 +482,19 @@ void SimGroup::removeObject(SimObject* obj)
    {
       obj->onGroupRemove();
       nameDictionary.remove(obj);
-      objectList.remove(obj);
+      const S32 slot = findSlot(obj);
+      if (slot >= 0)
+         removeSlot(slot);
       obj->mGroup = 0;
    }
    unlock();
 }
 
+U32* SimGroup::getSlotHint( SimObject* pObject )
+{
+   return pObject->mGroup == this ? &pObject->mGroupSlot : NULL;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 void SimGroup::onRemove()
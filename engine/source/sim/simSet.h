@@ -97,6 +97,12 @@
 ///         }
 /// @endcode
 ///
+/// Each member keeps a hint of its index within the set so that finding and
+/// removing a member does not search the whole set.  Sets are ordered by
+/// default, where removal erases the member and preserves the order of the
+/// remaining members.  Sets that do not need an order can use setOrdered(false)
+/// so that removal moves the last member into the empty slot instead.
+///
 
 class SimSet: public SimObject, public TamlChildren
 {
@@ -106,12 +112,23 @@ class SimSet: public SimObject, public TamlChildren
 protected:
    SimObjectList objectList;
    void *mMutex;
+   bool mOrdered;            ///< Whether removal preserves the order of the remaining members.
+
+   /// Fetch the index hint of a member or NULL if the object is not a member.
+   virtual U32* getSlotHint( SimObject* pObject );
+
+   /// Find the index of a member or -1 if the object is not a member.
+   S32 findSlot( SimObject* pObject );
+
+   /// Remove the member at an index.
+   void removeSlot( const S32 slot );
 
 public:
    SimSet() {
       VECTOR_SET_ASSOCIATION(objectList);
 
       mMutex = Mutex::createMutex();
+      mOrdered = true;
    }
 
    ~SimSet()
@@ -159,6 +176,18 @@ public:
    void clear();
    /// @}
 
+   /// @name Membership
+   /// @{
+
+   /// Whether the object is a member of the set.
+   inline bool isMember( SimObject* pObject ) { return getSlotHint( pObject ) != NULL; }
+
+   /// Set whether removal preserves the order of the remaining members.
+   inline void setOrdered( const bool ordered ) { mOrdered = ordered; }
+   inline bool getOrdered( void ) const { return mOrdered; }
+
+   /// @}
+
    virtual void onRemove();
    virtual void onDeleteNotify(SimObject *object);
 
@@ -297,6 +326,9 @@ private:
    typedef SimSet Parent;
    SimNameDictionary nameDictionary;
 
+protected:
+   virtual U32* getSlotHint( SimObject* pObject );
+
 public:
    ~SimGroup();
 
@@ -241,7 +241,7 @@ ConsoleMethodWithDocs(SimSet, remove, ConsoleVoid, 3, 0, (obj1, [obj2]*))
    {
       SimObject *obj = Sim::findObject(argv[i]);
       object->lock();
-      if(obj && object->find(object->begin(),object->end(),obj) != object->end())
+      if(obj && object->isMember(obj))
          object->removeObject(obj);
       else
          Con::printf("Set::remove: Object \"%s\" does not exist in set", argv[i]);
@@ -336,18 +336,24 @@ ConsoleMethodWithDocs(SimSet, isMember, ConsoleBool, 3, 3, (object))
       return false;
    }
 
-   object->lock();
-   for(SimSet::iterator i = object->begin(); i != object->end(); i++)
-   {
-      if(*i == testObject)
-      {
-         object->unlock();
-         return true;
-      }
-   }
-   object->unlock();
+   return object->isMember(testObject);
+}
+
+/*! Sets whether removing an object preserves the order of the remaining objects.
+    Unordered sets remove objects faster by moving the last object into the empty place.
+    @param ordered Whether the set is ordered.  Sets are ordered by default.
+    @return No return value.
+*/
+ConsoleMethodWithDocs(SimSet, setOrdered, ConsoleVoid, 3, 3, (bool ordered))
+{
+   object->setOrdered(dAtob(argv[2]));
+}
 
-   return false;
+/*! @return Returns whether removing an object preserves the order of the remaining objects.
+*/
+ConsoleMethodWithDocs(SimSet, getOrdered, ConsoleBool, 2, 2, ())
+{
+   return object->getOrdered();
 }
 
 /*! Returns the object with given internal name
@@ -0,0 +1,345 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "sim/simTimerWheel.h"
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+class SimTimerWheel::TickEvent : public SimEvent
+{
+public:
+    TickEvent( SimTimerWheel* pWheel ) : mpWheel( pWheel ) {}
+    virtual ~TickEvent() {}
+
+    virtual bool repost( SimTime& time )
+    {
+        // Stop ticking once the wheel is empty.
+        if ( mpWheel->getTimerCount() == 0 )
+        {
+            mpWheel->mTickEventId = 0;
+            return false;
+        }
+
+        time = (this->time / mpWheel->mTickPeriod + 1) * mpWheel->mTickPeriod;
+        return true;
+    }
+
+    virtual void process( SimObject* object )
+    {
+        mpWheel->advance( this->time );
+    }
+
+private:
+    SimTimerWheel* mpWheel;
+};
+
+//-----------------------------------------------------------------------------
+
+SimTimerWheel::SimTimerWheel( const U32 tickPeriod, const U32 slotCount ) :
+    mTickPeriod( getMax( tickPeriod, (U32)1 ) ),
+    mNextTimerId( 1 ),
+    mNextTick( 0 ),
+    mTickEventId( 0 )
+{
+    // Sanity!
+    AssertFatal( slotCount > 0, "SimTimerWheel() - The slot count must be greater than zero." );
+
+    mSlots.setSize( slotCount );
+    for ( U32 n = 0; n < slotCount; ++n )
+        mSlots[n] = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+SimTimerWheel::~SimTimerWheel()
+{
+    clear();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SimTimerWheel::addTimer( SimObject* pObject, const Callback& callback, const U32 period, const U32 repeat, const U32 userData )
+{
+    // Sanity!
+    AssertFatal( Con::isMainThread(), "SimTimerWheel::addTimer() - Timers can only be added on the main thread." );
+
+    if ( pObject == NULL || period == 0 )
+    {
+        // Warn.
+        Con::warnf( "SimTimerWheel::addTimer() - A timer needs an object and a period greater than zero." );
+        return 0;
+    }
+
+    // Create the timer.
+    Timer* pTimer = constructInPlace( mTimerAllocator.alloc() );
+    pTimer->mId = mNextTimerId++;
+    pTimer->mObject = pObject;
+    pTimer->mCallback = callback;
+    pTimer->mPeriod = period;
+    pTimer->mRepeat = repeat;
+    pTimer->mUserData = userData;
+    pTimer->mDueTime = Sim::getCurrentTime() + period;
+    pTimer->mpNext = NULL;
+    pTimer->mppPrev = NULL;
+
+    // Skip the invalid timer Id on wrap.
+    if ( mNextTimerId == 0 )
+        mNextTimerId = 1;
+
+    mTimers.insertUnique( pTimer->mId, pTimer );
+    linkTimer( pTimer );
+
+    // Make sure the wheel is ticking.
+    postTickEvent();
+
+    return pTimer->mId;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::removeTimer( const U32 timerId )
+{
+    HashTable<U32, Timer*>::iterator itr = mTimers.find( timerId );
+
+    // Finish if the timer isn't active.
+    if ( itr == mTimers.end() )
+        return;
+
+    Timer* pTimer = itr->value;
+    mTimers.erase( itr );
+    freeTimer( pTimer );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::removeTimers( SimObject* pObject )
+{
+    // Gather the object timers.
+    Vector<U32> timerIds;
+    for ( HashTable<U32, Timer*>::iterator itr = mTimers.begin(); itr != mTimers.end(); ++itr )
+    {
+        if ( (SimObject*)itr->value->mObject == pObject )
+            timerIds.push_back( itr->key );
+    }
+
+    // Remove them.
+    for ( S32 n = 0; n < timerIds.size(); ++n )
+        removeTimer( timerIds[n] );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::clear( void )
+{
+    // Free all the timers.
+    for ( HashTable<U32, Timer*>::iterator itr = mTimers.begin(); itr != mTimers.end(); ++itr )
+        freeTimer( itr->value );
+
+    mTimers.clear();
+
+    // Stop ticking.
+    if ( mTickEventId != 0 )
+    {
+        Sim::cancelEvent( mTickEventId );
+        mTickEventId = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SimTimerWheel::isTimerActive( const U32 timerId ) const
+{
+    return mTimers.find( timerId ) != mTimers.end();
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::advance( const SimTime time )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SimTimerWheel_Advance);
+
+    // Finish if we're not at the next tick yet.
+    const U32 targetTick = time / mTickPeriod;
+    if ( targetTick < mNextTick )
+        return;
+
+    // Only visit each slot once however far we're advancing.
+    const U32 slotCount = mSlots.size();
+    const U32 firstTick = (targetTick - mNextTick) >= slotCount ? targetTick - slotCount + 1 : mNextTick;
+    mNextTick = targetTick + 1;
+
+    for ( U32 tick = firstTick; tick <= targetTick; ++tick )
+    {
+        // Detach the due timers from the slot.
+        // NOTE:-   Callbacks can add or remove timers so we only keep the timer Ids here.
+        mDueTimers.clear();
+        Timer* pTimer = mSlots[tick % slotCount];
+        while ( pTimer != NULL )
+        {
+            Timer* pNextTimer = pTimer->mpNext;
+
+            if ( pTimer->mDueTick <= targetTick && pTimer->mDueTime <= time )
+            {
+                unlinkTimer( pTimer );
+                mDueTimers.push_back( pTimer->mId );
+            }
+
+            pTimer = pNextTimer;
+        }
+
+        // Fire the due timers.
+        for ( S32 n = 0; n < mDueTimers.size(); ++n )
+        {
+            HashTable<U32, Timer*>::iterator itr = mTimers.find( mDueTimers[n] );
+
+            // Skip if removed by an earlier callback.
+            if ( itr == mTimers.end() )
+                continue;
+
+            pTimer = itr->value;
+
+            // Fetch the callback details as the timer may be freed.
+            SimObject* pObject = pTimer->mObject;
+            const Callback callback = pTimer->mCallback;
+            const U32 userData = pTimer->mUserData;
+
+            // Remove the timer if its object has gone or this is the last repeat.
+            if ( pObject == NULL || pObject->isDeleted() || pTimer->mRepeat == 1 )
+            {
+                mTimers.erase( itr );
+                freeTimer( pTimer );
+            }
+            else
+            {
+                // Calculate the remaining repeats.
+                if ( pTimer->mRepeat > 1 )
+                    pTimer->mRepeat--;
+
+                // Skip any periods missed rather than firing on every tick to catch up.
+                pTimer->mDueTime += pTimer->mPeriod;
+                if ( pTimer->mDueTime <= time )
+                    pTimer->mDueTime = time + pTimer->mPeriod;
+
+                // Re-file the timer before the callback in-case it removes itself.
+                linkTimer( pTimer );
+            }
+
+            // Callback.
+            if ( pObject != NULL && !pObject->isDeleted() )
+                callback( pObject, userData );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::linkTimer( Timer* pTimer )
+{
+    // Calculate the first tick at or after the due time, but never one already processed.
+    pTimer->mDueTick = getMax( (pTimer->mDueTime + mTickPeriod - 1) / mTickPeriod, mNextTick );
+
+    // Insert at the head of the slot.
+    Timer** ppSlot = &mSlots[pTimer->mDueTick % mSlots.size()];
+    pTimer->mpNext = *ppSlot;
+    pTimer->mppPrev = ppSlot;
+    if ( *ppSlot != NULL )
+        (*ppSlot)->mppPrev = &pTimer->mpNext;
+    *ppSlot = pTimer;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::unlinkTimer( Timer* pTimer )
+{
+    // Finish if not in a slot.
+    if ( pTimer->mppPrev == NULL )
+        return;
+
+    *pTimer->mppPrev = pTimer->mpNext;
+    if ( pTimer->mpNext != NULL )
+        pTimer->mpNext->mppPrev = pTimer->mppPrev;
+
+    pTimer->mpNext = NULL;
+    pTimer->mppPrev = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::freeTimer( Timer* pTimer )
+{
+    unlinkTimer( pTimer );
+    destructInPlace( pTimer );
+    mTimerAllocator.free( pTimer );
+}
+
+//-----------------------------------------------------------------------------
+
+void SimTimerWheel::postTickEvent( void )
+{
+    // Finish if already ticking.
+    if ( mTickEventId != 0 )
+        return;
+
+    // Don't tick a slot that has already been processed.
+    const U32 tick = getMax( Sim::getCurrentTime() / mTickPeriod + 1, mNextTick );
+
+    mTickEventId = Sim::postEvent( Sim::getRootGroup(), new TickEvent( this ), tick * mTickPeriod );
+}
+
+//-----------------------------------------------------------------------------
+
+namespace Sim
+{
+
+static SimTimerWheel* gTimerWheel = NULL;
+
+//-----------------------------------------------------------------------------
+
+void initTimerWheel()
+{
+   gTimerWheel = new SimTimerWheel();
+}
+
+//-----------------------------------------------------------------------------
+
+void shutdownTimerWheel()
+{
+   delete gTimerWheel;
+   gTimerWheel = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+SimTimerWheel* getTimerWheel()
+{
+   return gTimerWheel;
+}
+
+} // Sim Namespace.
@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SIM_TIMER_WHEEL_H_
+#define _SIM_TIMER_WHEEL_H_
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _DATACHUNKER_H_
+#include "memory/dataChunker.h"
+#endif
+
+#ifndef FASTDELEGATE_H
+#include "delegates/FastDelegate.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A hashed timer wheel for native periodic timers.
+///
+/// Each timer is filed in a slot by the tick it's due on and the whole wheel is
+/// driven by a single repeating sim event, so thousands of timers don't each
+/// walk the sim event queue every period.  Timers fire on the first tick at or
+/// after their due time so their resolution is the tick period.
+///
+/// A timer is removed automatically once its object has been deleted.
+class SimTimerWheel
+{
+public:
+    typedef fastdelegate::FastDelegate2<SimObject*, U32> Callback;
+
+    SimTimerWheel( const U32 tickPeriod = 32, const U32 slotCount = 256 );
+    virtual ~SimTimerWheel();
+
+    /// Add a timer that calls back every period.  A repeat count of zero repeats until removed.
+    U32 addTimer( SimObject* pObject, const Callback& callback, const U32 period, const U32 repeat = 0, const U32 userData = 0 );
+    void removeTimer( const U32 timerId );
+    void removeTimers( SimObject* pObject );
+    void clear( void );
+
+    bool isTimerActive( const U32 timerId ) const;
+    inline U32 getTimerCount( void ) const { return mTimers.size(); }
+    inline U32 getTickPeriod( void ) const { return mTickPeriod; }
+
+    /// Fire all timers due up to the specified time.  This is called by the wheel's own sim event.
+    void advance( const SimTime time );
+
+private:
+    class TickEvent;
+    friend class TickEvent;
+
+    struct Timer
+    {
+        U32                     mId;
+        SimObjectPtr<SimObject> mObject;
+        Callback                mCallback;
+        U32                     mPeriod;
+        U32                     mRepeat;
+        U32                     mUserData;
+        SimTime                 mDueTime;
+        U32                     mDueTick;
+        Timer*                  mpNext;
+        Timer**                 mppPrev;
+    };
+
+    void linkTimer( Timer* pTimer );
+    void unlinkTimer( Timer* pTimer );
+    void freeTimer( Timer* pTimer );
+    void postTickEvent( void );
+
+    U32                     mTickPeriod;
+    Vector<Timer*>          mSlots;
+    HashTable<U32, Timer*>  mTimers;
+    FreeListChunker<Timer>  mTimerAllocator;
+    Vector<U32>             mDueTimers;
+    U32                     mNextTimerId;
+    U32                     mNextTick;
+    U32                     mTickEventId;
+};
+
+#endif // _SIM_TIMER_WHEEL_H_
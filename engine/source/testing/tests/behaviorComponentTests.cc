@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _BEHAVIOR_COMPONENT_H_
+#include "component/behaviors/behaviorComponent.h"
+#endif
+
+#ifndef _BEHAVIORTEMPLATE_H_
+#include "component/behaviors/behaviorTemplate.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+static BehaviorTemplate* createRoutingTemplate( const char* pName )
+{
+    // Create a named template so its instances use the namespace of that name.
+    BehaviorTemplate* pTemplate = new BehaviorTemplate();
+    pTemplate->registerObject( pName );
+    return pTemplate;
+}
+
+//-----------------------------------------------------------------------------
+
+static const char* callRoutedMethod( BehaviorComponent* pComponent, const char* pMethodName )
+{
+    // Call the method on the behaviors as script would.
+    const char* argv[2] = { pMethodName, pComponent->getIdString() };
+    return pComponent->callOnBehaviors( 2, argv );
+}
+
+//-----------------------------------------------------------------------------
+
+static bool handlesRoutedMethod( BehaviorComponent* pComponent, const char* pMethodName )
+{
+    S32 routingId;
+    return pComponent->handlesConsoleMethod( pMethodName, &routingId );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BehaviorComponentTests, RouteCacheTest )
+{
+    // Declare the behavior methods.
+    Con::evaluate( "function BehaviorRouteTestA::routeTestMethod( %this ) { return \"A\"; }" );
+
+    // Create a component with a behavior.
+    BehaviorTemplate* pTemplate = createRoutingTemplate( "BehaviorRouteTestA" );
+    BehaviorComponent* pComponent = new BehaviorComponent();
+    ASSERT_TRUE( pComponent->registerObject() ) << "Component not registered.";
+    ASSERT_TRUE( pComponent->addBehavior( pTemplate->createInstance() ) ) << "Behavior not added.";
+    ASSERT_EQ( 0U, pComponent->getBehaviorMethodRouteCount() );
+
+    // The first lookup should cache the route.
+    ASSERT_TRUE( handlesRoutedMethod( pComponent, "routeTestMethod" ) ) << "Behavior method not routed.";
+    ASSERT_EQ( 1U, pComponent->getBehaviorMethodRouteCount() ) << "Route not cached.";
+
+    // Later lookups and calls should use the cached route.
+    ASSERT_TRUE( handlesRoutedMethod( pComponent, "routeTestMethod" ) );
+    ASSERT_STREQ( "A", callRoutedMethod( pComponent, "routeTestMethod" ) ) << "Cached route called the wrong method.";
+    ASSERT_EQ( 1U, pComponent->getBehaviorMethodRouteCount() ) << "Cached route not reused.";
+
+    // Methods no behavior handles should be cached as such.
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestMissing" ) ) << "Missing method routed.";
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestMissing" ) );
+    ASSERT_EQ( 2U, pComponent->getBehaviorMethodRouteCount() ) << "Missing route not cached.";
+
+    // Clean-up.
+    pComponent->deleteObject();
+    pTemplate->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BehaviorComponentTests, RouteInvalidationTest )
+{
+    // Declare the behavior methods.
+    Con::evaluate( "function BehaviorRouteTestB::routeTestMethod( %this ) { return \"B\"; }" );
+    Con::evaluate( "function BehaviorRouteTestC::routeTestMethod( %this ) { return \"C\"; }" );
+    Con::evaluate( "function BehaviorRouteTestParent::routeTestInherited( %this ) { return \"Parent\"; }" );
+
+    // Create a component with a behavior.
+    BehaviorTemplate* pTemplateB = createRoutingTemplate( "BehaviorRouteTestB" );
+    BehaviorTemplate* pTemplateC = createRoutingTemplate( "BehaviorRouteTestC" );
+    BehaviorComponent* pComponent = new BehaviorComponent();
+    ASSERT_TRUE( pComponent->registerObject() ) << "Component not registered.";
+    BehaviorInstance* pBehaviorB = pTemplateB->createInstance();
+    ASSERT_TRUE( pComponent->addBehavior( pBehaviorB ) ) << "Behavior not added.";
+    ASSERT_STREQ( "B", callRoutedMethod( pComponent, "routeTestMethod" ) );
+
+    // Adding a behavior should invalidate the routes so the most recent behavior handles the method.
+    BehaviorInstance* pBehaviorC = pTemplateC->createInstance();
+    ASSERT_TRUE( pComponent->addBehavior( pBehaviorC ) ) << "Behavior not added.";
+    ASSERT_EQ( 0U, pComponent->getBehaviorMethodRouteCount() ) << "Routes not invalidated when a behavior was added.";
+    ASSERT_STREQ( "C", callRoutedMethod( pComponent, "routeTestMethod" ) ) << "Stale route used after adding a behavior.";
+
+    // Removing a behavior should invalidate the routes.
+    ASSERT_TRUE( pComponent->removeBehavior( pBehaviorC, false ) ) << "Behavior not removed.";
+    ASSERT_EQ( 0U, pComponent->getBehaviorMethodRouteCount() ) << "Routes not invalidated when a behavior was removed.";
+    ASSERT_STREQ( "B", callRoutedMethod( pComponent, "routeTestMethod" ) ) << "Stale route used after removing a behavior.";
+    pBehaviorC->deleteObject();
+
+    // Adding a method handler should invalidate the cached missing route.
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestAdded" ) );
+    Con::evaluate( "function BehaviorRouteTestB::routeTestAdded( %this ) { return \"Added\"; }" );
+    ASSERT_TRUE( handlesRoutedMethod( pComponent, "routeTestAdded" ) ) << "Stale route used after adding a method.";
+    ASSERT_STREQ( "Added", callRoutedMethod( pComponent, "routeTestAdded" ) );
+
+    // Relinking the namespace should invalidate the routes.
+    Namespace* pNamespace = Namespace::find( StringTable->insert( "BehaviorRouteTestB" ) );
+    Namespace* pParentNamespace = Namespace::find( StringTable->insert( "BehaviorRouteTestParent" ) );
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestInherited" ) );
+    ASSERT_TRUE( pNamespace->classLinkTo( pParentNamespace ) ) << "Namespace not linked.";
+    ASSERT_TRUE( handlesRoutedMethod( pComponent, "routeTestInherited" ) ) << "Stale route used after linking the namespace.";
+    ASSERT_STREQ( "Parent", callRoutedMethod( pComponent, "routeTestInherited" ) );
+    ASSERT_TRUE( pNamespace->unlinkClass( pParentNamespace ) ) << "Namespace not unlinked.";
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestInherited" ) ) << "Stale route used after unlinking the namespace.";
+
+    // Deleting a behavior should invalidate the routes.
+    ASSERT_TRUE( handlesRoutedMethod( pComponent, "routeTestMethod" ) );
+    pBehaviorB->deleteObject();
+    ASSERT_EQ( 0U, pComponent->getBehaviorCount() ) << "Deleted behavior not removed.";
+    ASSERT_EQ( 0U, pComponent->getBehaviorMethodRouteCount() ) << "Routes not invalidated when a behavior was deleted.";
+    ASSERT_FALSE( handlesRoutedMethod( pComponent, "routeTestMethod" ) ) << "Stale route used after deleting a behavior.";
+
+    // Clean-up.
+    pComponent->deleteObject();
+    pTemplateB->deleteObject();
+    pTemplateC->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
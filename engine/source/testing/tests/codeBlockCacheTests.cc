@@ -0,0 +1,96 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CODEBLOCK_CACHE_H_
+#include "console/codeBlockCache.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define CODEBLOCKCACHE_UNITTEST_EVAL_COUNT      10
+
+//-----------------------------------------------------------------------------
+
+TEST( CodeBlockCacheTests, RepeatedEvaluateTest )
+{
+    CodeBlockCache::clear();
+    CodeBlockCache::resetStats();
+
+    // Evaluate the same script repeatedly.
+    Con::setIntVariable( "$CodeBlockCacheTest", 0 );
+    for ( U32 n = 0; n < CODEBLOCKCACHE_UNITTEST_EVAL_COUNT; ++n )
+        Con::evaluate( "$CodeBlockCacheTest++;" );
+
+    // The script should be compiled once and executed every time.
+    ASSERT_EQ( CODEBLOCKCACHE_UNITTEST_EVAL_COUNT, Con::getIntVariable( "$CodeBlockCacheTest" ) ) << "Cached script was not executed every time.";
+    ASSERT_EQ( 1, CodeBlockCache::getMisses() ) << "Script was compiled more than once.";
+    ASSERT_EQ( CODEBLOCKCACHE_UNITTEST_EVAL_COUNT - 1, CodeBlockCache::getHits() ) << "Cached script was not used.";
+
+    // String and float constants should survive being executed.
+    ASSERT_STREQ( "1.5 text", Con::evaluate( "return 1.5 SPC \"text\";" ) );
+    ASSERT_STREQ( "1.5 text", Con::evaluate( "return 1.5 SPC \"text\";" ) ) << "Cached script constants were lost.";
+
+    // Clean-up.
+    CodeBlockCache::clear();
+    ASSERT_EQ( 0, CodeBlockCache::getCount() ) << "Cache was not cleared.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( CodeBlockCacheTests, EvictionTest )
+{
+    const S32 capacity = CodeBlockCache::getCapacity();
+    CodeBlockCache::clear();
+    CodeBlockCache::setCapacity( 2 );
+    CodeBlockCache::resetStats();
+
+    // Fill the cache then use the first script so that the second is least recent.
+    Con::evaluate( "$CodeBlockCacheTest = 1;" );
+    Con::evaluate( "$CodeBlockCacheTest = 2;" );
+    Con::evaluate( "$CodeBlockCacheTest = 1;" );
+    Con::evaluate( "$CodeBlockCacheTest = 3;" );
+    ASSERT_EQ( 1, CodeBlockCache::getEvictions() ) << "Full cache did not evict.";
+    ASSERT_EQ( 2, CodeBlockCache::getCount() ) << "Cache exceeded its capacity.";
+
+    // The first script should still be cached and the second evicted.
+    Con::evaluate( "$CodeBlockCacheTest = 1;" );
+    ASSERT_EQ( 2, CodeBlockCache::getHits() ) << "Recently used script was evicted.";
+    Con::evaluate( "$CodeBlockCacheTest = 2;" );
+    ASSERT_EQ( 4, CodeBlockCache::getMisses() ) << "Least recently used script was not evicted.";
+
+    // Clean-up.
+    CodeBlockCache::setCapacity( capacity );
+    CodeBlockCache::clear();
+}
+
+#endif // TORQUE_SHIPPING
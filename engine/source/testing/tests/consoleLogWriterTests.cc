@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CONSOLE_LOG_WRITER_H_
+#include "console/consoleLogWriter.h"
+#endif
+
+#ifndef _FILE_STREAM_H
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define CONSOLELOGWRITER_UNITTEST_FILE          "_unitTestLog_RemoveMe.txt"
+#define CONSOLELOGWRITER_UNITTEST_LINE_COUNT    1000
+
+//-----------------------------------------------------------------------------
+
+TEST( ConsoleLogWriterTests, WriteFlushTest )
+{
+    // Start writing.
+    ASSERT_TRUE( ConsoleLogWriter::start( CONSOLELOGWRITER_UNITTEST_FILE, false ) ) << "Failed to open the log file.";
+    ConsoleLogWriter::resetStats();
+
+    // Queue the lines.
+    char lineBuffer[64];
+    for ( U32 n = 0; n < CONSOLELOGWRITER_UNITTEST_LINE_COUNT; ++n )
+    {
+        dSprintf( lineBuffer, sizeof(lineBuffer), "Line %d", n );
+        ASSERT_TRUE( ConsoleLogWriter::writeLine( lineBuffer ) ) << "Line was dropped.";
+    }
+    ASSERT_EQ( CONSOLELOGWRITER_UNITTEST_LINE_COUNT, ConsoleLogWriter::getQueuedLines() );
+    ASSERT_EQ( 0, ConsoleLogWriter::getDroppedLines() );
+
+    // Flushing should write everything whilst the writer is still running.
+    ConsoleLogWriter::flush();
+    FileStream readStream;
+    ASSERT_TRUE( readStream.open( CONSOLELOGWRITER_UNITTEST_FILE, FileStream::Read ) ) << "Failed to open the log file for read.";
+    const U32 flushedSize = readStream.getStreamSize();
+    readStream.close();
+
+    // Stop writing.
+    ConsoleLogWriter::stop();
+    ASSERT_FALSE( ConsoleLogWriter::isActive() ) << "Writer did not stop.";
+
+    // Check the lines were written in order.
+    ASSERT_TRUE( readStream.open( CONSOLELOGWRITER_UNITTEST_FILE, FileStream::Read ) ) << "Failed to open the log file for read.";
+    ASSERT_EQ( flushedSize, readStream.getStreamSize() ) << "Flush did not write everything queued.";
+
+    char readBuffer[64];
+    for ( U32 n = 0; n < CONSOLELOGWRITER_UNITTEST_LINE_COUNT; ++n )
+    {
+        dSprintf( lineBuffer, sizeof(lineBuffer), "Line %d", n );
+        readStream.readLine( (U8*)readBuffer, sizeof(readBuffer) );
+        ASSERT_STREQ( lineBuffer, readBuffer ) << "Line was written incorrectly.";
+    }
+    readStream.close();
+
+    // Clean-up.
+    ASSERT_TRUE( Platform::fileDelete( CONSOLELOGWRITER_UNITTEST_FILE ) );
+}
+
+#endif // TORQUE_SHIPPING
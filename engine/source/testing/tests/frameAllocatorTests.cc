@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define FRAMEALLOCATOR_UNITTEST_THREAD_COUNT    4
+#define FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE      1000
+
+//-----------------------------------------------------------------------------
+
+class FrameAllocatorThread : public Thread
+{
+public:
+    FrameAllocatorThread( const U8 fill ) :
+        Thread( 0, NULL, false ),
+        mFill( fill ),
+        mStartWaterMark( 1 ),
+        mGrown( false ),
+        mIntact( true ),
+        mConsolidated( false ),
+        mEndWaterMark( 1 )
+    {}
+
+    virtual void run( void* arg )
+    {
+        // A new thread starts with its own empty arena.
+        mStartWaterMark = FrameAllocator::getWaterMark();
+
+        // Allocate well past the initial arena size so the arena has to grow.
+        const U32 allocCount = (FRAME_ALLOCATOR_THREAD_ARENA_SIZE / FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE) * 4;
+        const U32 initialHighWaterMark = FrameAllocator::getHighWaterMark();
+
+        Vector<U8*> allocations;
+        for ( U32 n = 0; n < allocCount; ++n )
+        {
+            U8* pMemory = static_cast<U8*>( FrameAllocator::alloc( FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE ) );
+            dMemset( pMemory, mFill, FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE );
+            allocations.push_back( pMemory );
+
+            // Free every other allocation straight away to exercise rewinding across blocks.
+            if ( n % 2 )
+            {
+                FrameAllocatorMarker marker;
+                dMemset( marker.alloc( FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE * 3 ), 0, FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE * 3 );
+            }
+        }
+
+        mGrown = FrameAllocator::getHighWaterMark() > initialHighWaterMark;
+
+        // Every allocation should still hold what was written to it.
+        for ( S32 n = 0; n < allocations.size(); ++n )
+        {
+            for ( U32 i = 0; i < FRAMEALLOCATOR_UNITTEST_ALLOC_SIZE; ++i )
+            {
+                if ( allocations[n][i] != mFill )
+                    mIntact = false;
+            }
+        }
+
+        // Releasing everything should leave a single block big enough for the peak.
+        FrameAllocator::setWaterMark( 0 );
+        mConsolidated = FrameAllocator::getHighWaterMark() >= FrameAllocator::getPeakWaterMark();
+        mEndWaterMark = FrameAllocator::getWaterMark();
+
+        FrameAllocator::destroyThreadArena();
+    }
+
+    U8      mFill;
+    U32     mStartWaterMark;
+    bool    mGrown;
+    bool    mIntact;
+    bool    mConsolidated;
+    U32     mEndWaterMark;
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameAllocatorTests, ThreadArenaTest )
+{
+    const U32 mainWaterMark = FrameAllocator::getWaterMark();
+
+    FrameAllocatorThread* threads[FRAMEALLOCATOR_UNITTEST_THREAD_COUNT];
+    for ( U32 n = 0; n < FRAMEALLOCATOR_UNITTEST_THREAD_COUNT; ++n )
+    {
+        threads[n] = new FrameAllocatorThread( (U8)(n + 1) );
+        threads[n]->start();
+    }
+
+    for ( U32 n = 0; n < FRAMEALLOCATOR_UNITTEST_THREAD_COUNT; ++n )
+    {
+        threads[n]->join();
+
+        ASSERT_EQ( 0, threads[n]->mStartWaterMark ) << "A thread didn't start with its own arena.";
+        ASSERT_TRUE( threads[n]->mGrown ) << "A thread arena didn't grow.";
+        ASSERT_TRUE( threads[n]->mIntact ) << "Allocations from different threads overlapped.";
+        ASSERT_TRUE( threads[n]->mConsolidated ) << "A thread arena wasn't consolidated once empty.";
+        ASSERT_EQ( 0, threads[n]->mEndWaterMark );
+
+        delete threads[n];
+    }
+
+    // Other threads shouldn't touch this thread's arena.
+    ASSERT_EQ( mainWaterMark, FrameAllocator::getWaterMark() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( FrameAllocatorTests, MarkerTest )
+{
+    const U32 waterMark = FrameAllocator::getWaterMark();
+    U8* pOuter = static_cast<U8*>( FrameAllocator::alloc( 16 ) );
+    dMemset( pOuter, 0xAB, 16 );
+
+    {
+        FrameAllocatorMarker marker;
+        U8* pInner = static_cast<U8*>( marker.alloc( 64 ) );
+        dMemset( pInner, 0x11, 64 );
+    }
+
+#ifdef TORQUE_FRAME_ALLOCATOR_POISON
+    // The inner allocation should have been poisoned when the marker restored the watermark.
+    U8* pReused = static_cast<U8*>( FrameAllocator::alloc( 64 ) );
+    ASSERT_EQ( FRAME_ALLOCATOR_POISON_BYTE, pReused[0] );
+    ASSERT_EQ( FRAME_ALLOCATOR_POISON_BYTE, pReused[32] );
+#endif
+
+    // The outer allocation should be untouched.
+    for ( U32 i = 0; i < 16; ++i )
+    {
+        ASSERT_EQ( 0xAB, pOuter[i] );
+    }
+
+    FrameAllocator::setWaterMark( waterMark );
+    ASSERT_EQ( waterMark, FrameAllocator::getWaterMark() );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,387 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_JOB_SYSTEM_H_
+#include "platform/threads/jobSystem.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define JOBSYSTEM_UNITTEST_JOB_COUNT            1000
+#define JOBSYSTEM_UNITTEST_ITEM_COUNT           100000
+#define JOBSYSTEM_UNITTEST_ITEM_ITERATIONS      100
+#define JOBSYSTEM_UNITTEST_BENCHMARK_ITERATIONS 2000
+
+//-----------------------------------------------------------------------------
+
+static void incrementJob( void* pData )
+{
+    static_cast<std::atomic<U32>*>( pData )->fetch_add( 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+struct OrderedJobData
+{
+    std::atomic<U32>*   mpCompleted;
+    U32                 mRequired;
+    std::atomic<U32>*   mpViolations;
+};
+
+static void orderedJob( void* pData )
+{
+    // Every job from the dependency should have completed first.
+    OrderedJobData* pOrdered = static_cast<OrderedJobData*>( pData );
+    if ( pOrdered->mpCompleted->load() < pOrdered->mRequired )
+        pOrdered->mpViolations->fetch_add( 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+struct MainThreadJobData
+{
+    ThreadIdent         mMainThreadId;
+    std::atomic<U32>    mExecuted;
+    std::atomic<U32>    mWrongThread;
+};
+
+static void mainThreadOnlyJob( void* pData )
+{
+    MainThreadJobData* pMainThread = static_cast<MainThreadJobData*>( pData );
+    if ( !ThreadManager::isCurrentThread( pMainThread->mMainThreadId ) )
+        pMainThread->mWrongThread.fetch_add( 1 );
+
+    pMainThread->mExecuted.fetch_add( 1 );
+}
+
+struct MainThreadJobSubmitData
+{
+    MainThreadJobData*  mpMainThread;
+    JobCounter*         mpCounter;
+};
+
+static void submitMainThreadJob( void* pData )
+{
+    // Submit a main thread only job from wherever this executes.
+    MainThreadJobSubmitData* pSubmit = static_cast<MainThreadJobSubmitData*>( pData );
+    JobSystem::submit( Job( &mainThreadOnlyJob, pSubmit->mpMainThread, true ), pSubmit->mpCounter );
+}
+
+//-----------------------------------------------------------------------------
+
+class MainThreadQueueTestWork : public SimMainThreadWork
+{
+public:
+    virtual const char* execute( void ) { return "done"; }
+};
+
+struct MainThreadQueueJobData
+{
+    ThreadIdent         mMainThreadId;
+    std::atomic<U32>    mCompleted;
+    std::atomic<U32>    mBlocked;
+};
+
+static void waitOnMainThreadQueueJob( void* pData )
+{
+    MainThreadQueueJobData* pQueueData = static_cast<MainThreadQueueJobData*>( pData );
+
+    // Only a worker can block on the main thread.
+    if ( ThreadManager::isCurrentThread( pQueueData->mMainThreadId ) )
+    {
+        pQueueData->mCompleted.fetch_add( 1 );
+        return;
+    }
+
+    // Post work to the Sim main thread queue and block until the main thread executes it.
+    pQueueData->mBlocked.fetch_add( 1 );
+    MainThreadQueueTestWork* pWork = new MainThreadQueueTestWork();
+    SimMainThreadFuture future = pWork->getFuture();
+    Sim::postMainThreadWork( pWork );
+
+    if ( dStrcmp( future.waitForResult(), "done" ) == 0 )
+        pQueueData->mCompleted.fetch_add( 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+struct SquareItem
+{
+    inline void operator()( F32& item, const U32 index ) const { item = (F32)index * (F32)index; }
+};
+
+struct SumIndex
+{
+    std::atomic<U32>* mpCalls;
+    inline void operator()( const U32 index ) const { mpCalls->fetch_add( 1 ); }
+};
+
+struct IterateItem
+{
+    inline void operator()( F32& item, const U32 index ) const
+    {
+        F32 value = item;
+        for ( U32 n = 0; n < JOBSYSTEM_UNITTEST_ITEM_ITERATIONS; ++n )
+            value = mSqrt( value * value + 1.0f );
+
+        item = value;
+    }
+};
+
+struct BenchmarkItem
+{
+    inline void operator()( F32& item, const U32 index ) const
+    {
+        F32 value = item;
+        for ( U32 n = 0; n < JOBSYSTEM_UNITTEST_BENCHMARK_ITERATIONS; ++n )
+            value = mSqrt( value * value + 1.0f );
+
+        item = value;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, CounterTest )
+{
+    std::atomic<U32> executed( 0 );
+
+    Vector<Job> jobs;
+    for ( U32 n = 0; n < JOBSYSTEM_UNITTEST_JOB_COUNT; ++n )
+        jobs.push_back( Job( &incrementJob, &executed ) );
+
+    // Every job should have executed once the counter is done.
+    JobCounter counter;
+    JobSystem::submit( jobs.address(), jobs.size(), &counter );
+    JobSystem::wait( counter );
+
+    ASSERT_TRUE( counter.isDone() );
+    ASSERT_EQ( JOBSYSTEM_UNITTEST_JOB_COUNT, executed.load() );
+
+    // The counter should be reusable.
+    JobSystem::submit( jobs.address(), jobs.size(), &counter );
+    JobSystem::wait( counter );
+
+    ASSERT_EQ( JOBSYSTEM_UNITTEST_JOB_COUNT * 2, executed.load() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, DependencyTest )
+{
+    std::atomic<U32> completed( 0 );
+    std::atomic<U32> violations( 0 );
+
+    Vector<Job> jobs;
+    for ( U32 n = 0; n < JOBSYSTEM_UNITTEST_JOB_COUNT; ++n )
+        jobs.push_back( Job( &incrementJob, &completed ) );
+
+    OrderedJobData ordered;
+    ordered.mpCompleted = &completed;
+    ordered.mRequired = JOBSYSTEM_UNITTEST_JOB_COUNT;
+    ordered.mpViolations = &violations;
+
+    Vector<Job> orderedJobs;
+    for ( U32 n = 0; n < 16; ++n )
+        orderedJobs.push_back( Job( &orderedJob, &ordered ) );
+
+    // The dependent jobs shouldn't start until the first batch is done.
+    JobCounter firstCounter;
+    JobCounter secondCounter;
+    JobSystem::submit( jobs.address(), jobs.size(), &firstCounter );
+    JobSystem::submit( orderedJobs.address(), orderedJobs.size(), &secondCounter, &firstCounter );
+    JobSystem::wait( secondCounter );
+
+    ASSERT_TRUE( firstCounter.isDone() );
+    ASSERT_EQ( 0, violations.load() ) << "A job started before its dependency was done.";
+
+    // A dependency that is already done shouldn't defer anything.
+    JobSystem::submit( orderedJobs.address(), orderedJobs.size(), &secondCounter, &firstCounter );
+    JobSystem::wait( secondCounter );
+
+    ASSERT_EQ( 0, violations.load() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, ParallelForTest )
+{
+    // Every index should be visited exactly once.
+    std::atomic<U32> calls( 0 );
+    SumIndex sumIndex;
+    sumIndex.mpCalls = &calls;
+    JobSystem::parallelFor( JOBSYSTEM_UNITTEST_ITEM_COUNT, sumIndex );
+    ASSERT_EQ( JOBSYSTEM_UNITTEST_ITEM_COUNT, calls.load() );
+
+    // Every item should be written with its own index.
+    Vector<F32> items;
+    items.setSize( JOBSYSTEM_UNITTEST_ITEM_COUNT );
+    JobSystem::parallelFor( items, SquareItem(), 100 );
+
+    for ( U32 n = 0; n < JOBSYSTEM_UNITTEST_ITEM_COUNT; ++n )
+    {
+        ASSERT_EQ( (F32)n * (F32)n, items[n] ) << "Item " << n << " was not processed.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, MainThreadOnlyTest )
+{
+    MainThreadJobData mainThread;
+    mainThread.mMainThreadId = ThreadManager::getCurrentThreadId();
+    mainThread.mExecuted.store( 0 );
+    mainThread.mWrongThread.store( 0 );
+
+    // Submit main thread only jobs from jobs which may execute on workers.
+    JobCounter mainThreadCounter;
+    MainThreadJobSubmitData submit;
+    submit.mpMainThread = &mainThread;
+    submit.mpCounter = &mainThreadCounter;
+
+    Vector<Job> jobs;
+    for ( U32 n = 0; n < 64; ++n )
+        jobs.push_back( Job( &submitMainThreadJob, &submit ) );
+
+    // The main thread only jobs are counted before the submitting jobs complete.
+    JobCounter submitCounter;
+    JobSystem::submit( jobs.address(), jobs.size(), &submitCounter );
+    JobSystem::wait( submitCounter );
+    JobSystem::wait( mainThreadCounter );
+
+    ASSERT_EQ( 64, mainThread.mExecuted.load() );
+    ASSERT_EQ( 0, mainThread.mWrongThread.load() ) << "A main thread only job executed on a worker.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, MainThreadQueueWaitTest )
+{
+    // Work posted to a queue that isn't running is discarded so there would be nothing to wait on.
+    ASSERT_TRUE( Sim::isMainThreadQueueRunning() ) << "The main thread queue is not running.";
+
+    MainThreadQueueJobData queueData;
+    queueData.mMainThreadId = ThreadManager::getCurrentThreadId();
+    queueData.mCompleted.store( 0 );
+    queueData.mBlocked.store( 0 );
+
+    Vector<Job> jobs;
+    for ( U32 n = 0; n < JobSystem::getWorkerCount(); ++n )
+        jobs.push_back( Job( &waitOnMainThreadQueueJob, &queueData ) );
+
+    // Give the workers time to take the jobs and block on the main thread.
+    JobCounter counter;
+    JobSystem::submit( jobs.address(), jobs.size(), &counter );
+    Platform::sleep( 100 );
+
+    // Waiting on the main thread must execute the work the jobs are blocked on.
+    JobSystem::wait( counter );
+
+    ASSERT_EQ( (U32)jobs.size(), queueData.mCompleted.load() ) << "A job did not get its main thread result.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, ParallelMatchesSerialTest )
+{
+    Vector<F32> items;
+    items.setSize( JOBSYSTEM_UNITTEST_ITEM_COUNT / 10 );
+    for ( S32 n = 0; n < items.size(); ++n )
+        items[n] = (F32)n;
+
+    Vector<F32> serialItems = items;
+
+    // Serial.
+    IterateItem iterateItem;
+    for ( S32 n = 0; n < serialItems.size(); ++n )
+        iterateItem( serialItems[n], n );
+
+    // Parallel.
+    JobSystem::resetStats();
+    JobSystem::parallelFor( items, iterateItem );
+
+    // The work should have been split into jobs.
+    JobSystem::Stats stats;
+    JobSystem::getStats( stats );
+    ASSERT_GT( stats.mExecuted, 0 ) << "No jobs were executed.";
+    ASSERT_LE( stats.mStolen, stats.mExecuted ) << "More jobs stolen than executed.";
+    ASSERT_LE( stats.mMainThreadExecuted, stats.mExecuted ) << "More jobs executed on the main thread than executed.";
+
+    // The results should match regardless of how they were computed.
+    for ( S32 n = 0; n < items.size(); ++n )
+    {
+        ASSERT_EQ( serialItems[n], items[n] ) << "Item " << n << " differs from the serial result.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( JobSystemTests, BenchmarkTest )
+{
+    Vector<F32> items;
+    items.setSize( JOBSYSTEM_UNITTEST_ITEM_COUNT / 10 );
+    for ( S32 n = 0; n < items.size(); ++n )
+        items[n] = (F32)n;
+
+    Vector<F32> serialItems = items;
+
+    // Serial.
+    BenchmarkItem benchmarkItem;
+    const U32 serialStart = Platform::getRealMilliseconds();
+    for ( S32 n = 0; n < serialItems.size(); ++n )
+        benchmarkItem( serialItems[n], n );
+    const U32 serialTime = Platform::getRealMilliseconds() - serialStart;
+
+    // Parallel.
+    JobSystem::resetStats();
+    const U32 parallelStart = Platform::getRealMilliseconds();
+    JobSystem::parallelFor( items, benchmarkItem );
+    const U32 parallelTime = Platform::getRealMilliseconds() - parallelStart;
+
+    JobSystem::Stats stats;
+    JobSystem::getStats( stats );
+    Con::printf( "JobSystem benchmark: %d items serial %dms, parallel %dms with %d workers (%d jobs, %d stolen).",
+        items.size(), serialTime, parallelTime, stats.mWorkerCount, stats.mExecuted, stats.mStolen );
+
+    // The results should match regardless of how they were computed.
+    for ( S32 n = 0; n < items.size(); ++n )
+    {
+        ASSERT_EQ( serialItems[n], items[n] ) << "Item " << n << " differs from the serial result.";
+    }
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,225 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+#ifndef _TICKABLE_H_
+#include "platform/Tickable.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#if defined(TORQUE_OS_LINUX)
+#include "platformX86UNIX/x86UNIXEventWait.h"
+#endif
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+static std::atomic<U32> gMainLoopWakeCount( 0 );
+
+static void countMainLoopWake()
+{
+    gMainLoopWakeCount.fetch_add( 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+class MainLoopWaitTestEvent : public SimEvent
+{
+public:
+    virtual void process( SimObject* object ) {}
+};
+
+//-----------------------------------------------------------------------------
+
+class MainLoopWaitTestWork : public SimMainThreadWork
+{
+public:
+    virtual const char* execute( void ) { return NULL; }
+};
+
+//-----------------------------------------------------------------------------
+
+class MainLoopWaitTestPoster : public Thread
+{
+public:
+    MainLoopWaitTestPoster( SimObject* pObject, SimMainThreadQueue* pQueue ) :
+        Thread( 0, NULL, false ),
+        mpObject( pObject ),
+        mpQueue( pQueue ),
+        mEventId( 0 )
+    {}
+
+    virtual void run( void* arg )
+    {
+        // Post an event or some work from off the main thread.
+        if ( mpQueue == NULL )
+            mEventId = Sim::postEvent( mpObject, new MainLoopWaitTestEvent(), Sim::getCurrentTime() + 10000 );
+        else
+            mpQueue->post( new MainLoopWaitTestWork() );
+    }
+
+    SimObject* mpObject;
+    SimMainThreadQueue* mpQueue;
+    U32 mEventId;
+};
+
+//-----------------------------------------------------------------------------
+
+class MainLoopWaitTestTickable : public SimObject, public virtual Tickable
+{
+protected:
+    virtual void interpolateTick( F32 delta ) {}
+    virtual void processTick() {}
+    virtual void advanceTime( F32 timeDelta ) {}
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( MainLoopWaitTests, WakeFromOtherThreadTest )
+{
+    SimObject* pObject = new SimObject();
+    ASSERT_TRUE( pObject->registerObject() ) << "Object not registered.";
+
+    // Count the wakes.
+    Sim::MainLoopWakeFunction previousWakeFunction = Sim::getMainLoopWakeFunction();
+    Sim::setMainLoopWakeFunction( countMainLoopWake );
+    gMainLoopWakeCount = 0;
+
+    // Events posted on the main thread don't need to wake it.
+    const U32 mainThreadEventId = Sim::postEvent( pObject, new MainLoopWaitTestEvent(), Sim::getCurrentTime() + 10000 );
+    ASSERT_EQ( 0U, gMainLoopWakeCount.load() ) << "Main thread event woke the main loop.";
+    Sim::cancelEvent( mainThreadEventId );
+
+    // Events posted from another thread wake it.
+    MainLoopWaitTestPoster eventPoster( pObject, NULL );
+    eventPoster.start();
+    eventPoster.join();
+    ASSERT_EQ( 1U, gMainLoopWakeCount.load() ) << "Event from another thread didn't wake the main loop.";
+    ASSERT_TRUE( Sim::isEventPending( eventPoster.mEventId ) );
+    Sim::cancelEvent( eventPoster.mEventId );
+
+    // Main thread work posted from another thread wakes it.
+    SimMainThreadQueue queue;
+    MainLoopWaitTestPoster workPoster( NULL, &queue );
+    workPoster.start();
+    workPoster.join();
+    ASSERT_EQ( 2U, gMainLoopWakeCount.load() ) << "Work from another thread didn't wake the main loop.";
+    ASSERT_EQ( 1U, queue.process( 0 ) );
+
+    // Clean-up.
+    Sim::setMainLoopWakeFunction( previousWakeFunction );
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( MainLoopWaitTests, DeadlineTest )
+{
+    SimObject* pObject = new SimObject();
+    ASSERT_TRUE( pObject->registerObject() ) << "Object not registered.";
+
+    // The next event bounds the wait.
+    const U32 eventId = Sim::postEvent( pObject, new MainLoopWaitTestEvent(), Sim::getCurrentTime() + 500 );
+    ASSERT_LE( Sim::getTimeToNextEvent(), 500U );
+    Sim::cancelEvent( eventId );
+
+    // A processing tickable bounds the wait by a tick.
+    MainLoopWaitTestTickable* pTickable = new MainLoopWaitTestTickable();
+    pTickable->setProcessTicks( true );
+    ASSERT_LE( Tickable::getTimeToNextTick(), Tickable::smTickMs );
+    delete pTickable;
+
+    // Clean-up.
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(TORQUE_OS_LINUX)
+
+class MainLoopWaitTestSignaller : public Thread
+{
+public:
+    MainLoopWaitTestSignaller() : Thread( 0, NULL, false ) {}
+
+    virtual void run( void* arg )
+    {
+        Platform::sleep( 20 );
+        Sim::wakeMainLoop();
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( MainLoopWaitTests, EventWaitSignalTest )
+{
+    // Use any existing wait, otherwise create one for the test.
+    const bool created = !x86UNIXEventWait::isEnabled();
+    ASSERT_TRUE( x86UNIXEventWait::create() ) << "Event wait unavailable.";
+
+    // A wait ends at its deadline.
+    U32 startTime = Platform::getRealMilliseconds();
+    x86UNIXEventWaiter->wait( 20 );
+    ASSERT_GE( Platform::getRealMilliseconds() - startTime, 19U ) << "Wait ended before its deadline.";
+
+    // A signal sent before the wait ends it immediately.
+    startTime = Platform::getRealMilliseconds();
+    Sim::wakeMainLoop();
+    x86UNIXEventWaiter->wait( 5000 );
+    ASSERT_LT( Platform::getRealMilliseconds() - startTime, 1000U ) << "Earlier signal was lost.";
+
+    // A signal from another thread ends a wait in progress.
+    x86UNIXEventWaiter->resetStats();
+    MainLoopWaitTestSignaller signaller;
+    signaller.start();
+    startTime = Platform::getRealMilliseconds();
+    x86UNIXEventWaiter->wait( 5000 );
+    ASSERT_LT( Platform::getRealMilliseconds() - startTime, 1000U ) << "Signal didn't end the wait.";
+    signaller.join();
+    ASSERT_EQ( 1U, x86UNIXEventWaiter->getStats().signalWakeCount );
+
+    // Clean-up.
+    if ( created )
+        x86UNIXEventWait::destroy();
+}
+
+#endif // TORQUE_OS_LINUX
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,255 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _NATIVE_BEHAVIORINSTANCE_H_
+#include "component/behaviors/nativeBehaviorInstance.h"
+#endif
+
+#ifndef _BEHAVIORTEMPLATE_H_
+#include "component/behaviors/behaviorTemplate.h"
+#endif
+
+#ifndef _ROTATE_BEHAVIOR_H_
+#include "2d/behaviors/RotateBehavior.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define NATIVEBEHAVIOR_UNITTEST_OBJECT_COUNT    64
+#define NATIVEBEHAVIOR_UNITTEST_TICK_COUNT      10
+#define NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME    (1.0f / 60.0f)
+
+//-----------------------------------------------------------------------------
+
+/// A native behavior that records the order it is updated in.
+/// It does not override "updateBatch" so it is updated through the default batch.
+class NativeBehaviorOrderTestInstance : public NativeBehaviorInstance
+{
+    typedef NativeBehaviorInstance Parent;
+
+public:
+    static Vector<NativeBehaviorInstance*> smUpdateOrder;
+
+    virtual void onUpdate( const F32 elapsedTime ) { smUpdateOrder.push_back( this ); }
+
+    DECLARE_CONOBJECT( NativeBehaviorOrderTestInstance );
+};
+
+IMPLEMENT_CONOBJECT( NativeBehaviorOrderTestInstance );
+
+Vector<NativeBehaviorInstance*> NativeBehaviorOrderTestInstance::smUpdateOrder;
+
+//-----------------------------------------------------------------------------
+
+static BehaviorTemplate* createNativeTemplate( const char* pNativeClass )
+{
+    BehaviorTemplate* pTemplate = new BehaviorTemplate();
+    pTemplate->registerObject();
+    pTemplate->setNativeClass( pNativeClass );
+    return pTemplate;
+}
+
+//-----------------------------------------------------------------------------
+
+static void updateUnbatched( const Vector<SceneObject*>& objects, const F32 elapsedTime )
+{
+    // Update each native behavior on its own in owner order.
+    for ( S32 objectIndex = 0; objectIndex < objects.size(); ++objectIndex )
+    {
+        const Vector<NativeBehaviorInstance*>& nativeBehaviors = objects[objectIndex]->getNativeBehaviors();
+
+        for ( S32 behaviorIndex = 0; behaviorIndex < nativeBehaviors.size(); ++behaviorIndex )
+        {
+            NativeBehaviorInstance* pInstance = nativeBehaviors[behaviorIndex];
+            pInstance->updateBatch( &pInstance, 1, elapsedTime );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void updateBatched( NativeBehaviorBatch& batch, const Vector<SceneObject*>& objects, const F32 elapsedTime )
+{
+    // Queue the owners as the scene does then update the batch.
+    for ( S32 objectIndex = 0; objectIndex < objects.size(); ++objectIndex )
+    {
+        batch.queue( objects[objectIndex] );
+    }
+
+    batch.update( elapsedTime );
+}
+
+//-----------------------------------------------------------------------------
+
+static void deleteObjects( Vector<SceneObject*>& objects )
+{
+    for ( S32 index = 0; index < objects.size(); ++index )
+    {
+        objects[index]->deleteObject();
+    }
+
+    objects.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NativeBehaviorTests, BatchResultsTest )
+{
+    // Create two native templates so the batch holds more than one template.
+    BehaviorTemplate* pSlowTemplate = createNativeTemplate( "RotateBehaviorInstance" );
+    BehaviorTemplate* pFastTemplate = createNativeTemplate( "RotateBehaviorInstance" );
+    ASSERT_TRUE( pSlowTemplate->isNative() && pFastTemplate->isNative() ) << "Native templates not created.";
+
+    // Create identical owners for the unbatched and batched paths.
+    Vector<SceneObject*> unbatchedObjects;
+    Vector<SceneObject*> batchedObjects;
+    for ( U32 n = 0; n < NATIVEBEHAVIOR_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        for ( U32 pass = 0; pass < 2; ++pass )
+        {
+            SceneObject* pSceneObject = new SceneObject();
+            ASSERT_TRUE( pSceneObject->registerObject() ) << "Scene object not registered.";
+            pSceneObject->setAngle( mDegToRad( (F32)n ) );
+
+            // Give odd owners both behaviors so each owner sees a different combination.
+            RotateBehaviorInstance* pSlowBehavior = static_cast<RotateBehaviorInstance*>( pSlowTemplate->createInstance() );
+            pSlowBehavior->setAngularSpeed( 10.0f + (F32)n );
+            ASSERT_TRUE( pSceneObject->addBehavior( pSlowBehavior ) );
+
+            if ( (n & 1) != 0 )
+            {
+                RotateBehaviorInstance* pFastBehavior = static_cast<RotateBehaviorInstance*>( pFastTemplate->createInstance() );
+                pFastBehavior->setAngularSpeed( 100.0f - (F32)n );
+                ASSERT_TRUE( pSceneObject->addBehavior( pFastBehavior ) );
+            }
+
+            if ( pass == 0 )
+                unbatchedObjects.push_back( pSceneObject );
+            else
+                batchedObjects.push_back( pSceneObject );
+        }
+    }
+
+    // Update both paths for several ticks.
+    NativeBehaviorBatch batch;
+    for ( U32 tick = 0; tick < NATIVEBEHAVIOR_UNITTEST_TICK_COUNT; ++tick )
+    {
+        updateUnbatched( unbatchedObjects, NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME );
+        updateBatched( batch, batchedObjects, NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME );
+    }
+
+    // Both paths should produce the same results.
+    for ( U32 n = 0; n < NATIVEBEHAVIOR_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        ASSERT_NE( mDegToRad( (F32)n ), batchedObjects[n]->getAngle() ) << "Owner " << n << " not updated.";
+        ASSERT_FLOAT_EQ( unbatchedObjects[n]->getAngle(), batchedObjects[n]->getAngle() ) << "Owner " << n << " batched result differs.";
+    }
+
+    // Clean-up.
+    deleteObjects( unbatchedObjects );
+    deleteObjects( batchedObjects );
+    pSlowTemplate->deleteObject();
+    pFastTemplate->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NativeBehaviorTests, BatchOrderTest )
+{
+    // Create two native templates.
+    BehaviorTemplate* pFirstTemplate = createNativeTemplate( "NativeBehaviorOrderTestInstance" );
+    BehaviorTemplate* pSecondTemplate = createNativeTemplate( "NativeBehaviorOrderTestInstance" );
+    ASSERT_TRUE( pFirstTemplate->isNative() && pSecondTemplate->isNative() ) << "Native templates not created.";
+
+    // Create owners with both behaviors, adding them in alternating order.
+    Vector<SceneObject*> objects;
+    for ( U32 n = 0; n < NATIVEBEHAVIOR_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        ASSERT_TRUE( pSceneObject->registerObject() ) << "Scene object not registered.";
+
+        BehaviorInstance* pFirstBehavior = pFirstTemplate->createInstance();
+        BehaviorInstance* pSecondBehavior = pSecondTemplate->createInstance();
+        ASSERT_TRUE( pSceneObject->addBehavior( (n & 1) == 0 ? pFirstBehavior : pSecondBehavior ) );
+        ASSERT_TRUE( pSceneObject->addBehavior( (n & 1) == 0 ? pSecondBehavior : pFirstBehavior ) );
+
+        objects.push_back( pSceneObject );
+    }
+
+    // Record the unbatched order.
+    NativeBehaviorOrderTestInstance::smUpdateOrder.clear();
+    updateUnbatched( objects, NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME );
+    Vector<NativeBehaviorInstance*> unbatchedOrder = NativeBehaviorOrderTestInstance::smUpdateOrder;
+    ASSERT_EQ( (U32)NATIVEBEHAVIOR_UNITTEST_OBJECT_COUNT * 2, (U32)unbatchedOrder.size() );
+
+    // Templates are batched in the order first seen and each batch keeps the owner order
+    // so the batched order is the unbatched order grouped by template.
+    Vector<NativeBehaviorInstance*> expectedOrder;
+    BehaviorTemplate* templateOrder[2] = { pFirstTemplate, pSecondTemplate };
+    for ( U32 templateIndex = 0; templateIndex < 2; ++templateIndex )
+    {
+        for ( S32 index = 0; index < unbatchedOrder.size(); ++index )
+        {
+            if ( unbatchedOrder[index]->getTemplate() == templateOrder[templateIndex] )
+                expectedOrder.push_back( unbatchedOrder[index] );
+        }
+    }
+
+    // Record the batched order over two ticks to check the batch is cleared after each update.
+    NativeBehaviorBatch batch;
+    for ( U32 tick = 0; tick < 2; ++tick )
+    {
+        NativeBehaviorOrderTestInstance::smUpdateOrder.clear();
+        updateBatched( batch, objects, NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME );
+
+        const Vector<NativeBehaviorInstance*>& batchedOrder = NativeBehaviorOrderTestInstance::smUpdateOrder;
+        ASSERT_EQ( expectedOrder.size(), batchedOrder.size() ) << "Tick " << tick << " batch did not update each behavior once.";
+
+        for ( S32 index = 0; index < expectedOrder.size(); ++index )
+        {
+            ASSERT_EQ( expectedOrder[index], batchedOrder[index] ) << "Tick " << tick << " batched order differs at " << index << ".";
+        }
+    }
+
+    // An empty batch should update nothing.
+    NativeBehaviorOrderTestInstance::smUpdateOrder.clear();
+    batch.update( NATIVEBEHAVIOR_UNITTEST_ELAPSED_TIME );
+    ASSERT_EQ( 0U, (U32)NativeBehaviorOrderTestInstance::smUpdateOrder.size() );
+
+    // Clean-up.
+    deleteObjects( objects );
+    pFirstTemplate->deleteObject();
+    pSecondTemplate->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
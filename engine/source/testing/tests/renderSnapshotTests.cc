@@ -0,0 +1,219 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _RENDER_SNAPSHOT_H_
+#include "2d/core/RenderSnapshot.h"
+#endif
+
+#ifndef _BATCH_RENDER_H_
+#include "2d/core/BatchRender.h"
+#endif
+
+#ifndef _SCENE_PIPELINE_H_
+#include "2d/scene/ScenePipeline.h"
+#endif
+
+#ifndef _FRAMEALLOCATOR_H_
+#include "memory/frameAllocator.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define RENDERSNAPSHOT_UNITTEST_OBJECT_COUNT  16
+
+//-----------------------------------------------------------------------------
+
+static void submitUnitTestQuad( BatchRender& batchRender, const F32 offset, TextureHandle& texture )
+{
+    batchRender.SubmitQuad(
+        Vector2( offset, 0.0f ), Vector2( offset + 1.0f, 0.0f ), Vector2( offset + 1.0f, 1.0f ), Vector2( offset, 1.0f ),
+        Vector2( 0.0f, 0.0f ), Vector2( 1.0f, 0.0f ), Vector2( 1.0f, 1.0f ), Vector2( 0.0f, 1.0f ),
+        texture );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( RenderSnapshotTests, RecordTest )
+{
+    DebugStats debugStats;
+    RenderSnapshot snapshot;
+    TextureHandle texture;
+
+    BatchRender batchRender;
+    batchRender.setDebugStats( &debugStats );
+    batchRender.setRecordTarget( &snapshot );
+
+    // Sorted batches share a draw per texture.
+    submitUnitTestQuad( batchRender, 0.0f, texture );
+    submitUnitTestQuad( batchRender, 2.0f, texture );
+    batchRender.flush();
+    ASSERT_EQ( 1U, snapshot.getBatchCount() ) << "Sorted quads were not recorded as a single batch.";
+    ASSERT_EQ( 8U, snapshot.getVertexCount() );
+    ASSERT_EQ( 12U, snapshot.getIndexCount() );
+
+    // Strict order batches are recorded per flush.
+    batchRender.setStrictOrderMode( true );
+    submitUnitTestQuad( batchRender, 4.0f, texture );
+    batchRender.flush();
+    ASSERT_EQ( 2U, snapshot.getBatchCount() ) << "Strict order quads were not recorded.";
+    ASSERT_EQ( 12U, snapshot.getVertexCount() );
+    ASSERT_EQ( 18U, snapshot.getIndexCount() );
+
+    // Nothing is drawn so the snapshot only becomes valid when marked.
+    ASSERT_FALSE( snapshot.isValid() );
+    snapshot.setValid( true );
+    ASSERT_TRUE( snapshot.isValid() );
+
+    // Resetting clears the capture.
+    batchRender.setRecordTarget( NULL );
+    snapshot.reset();
+    ASSERT_FALSE( snapshot.isValid() );
+    ASSERT_EQ( 0U, snapshot.getBatchCount() );
+    ASSERT_EQ( 0U, snapshot.getVertexCount() );
+    ASSERT_EQ( 0U, snapshot.getIndexCount() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( RenderSnapshotTests, HoldTexturesTest )
+{
+    // Textures can only be created with a live texture manager.
+    if ( !TextureManager::mDGLRender || TextureManager::getManagerState() != TextureManager::Alive )
+        return;
+
+    const S32 residentCount = TextureManager::getTextureResidentCount();
+
+    DebugStats debugStats;
+    RenderSnapshot snapshot;
+
+    {
+        // Create two textures.
+        TextureHandle textureA( TextureManager::getUniqueTextureKey(), new GBitmap( 4, 4, false, GBitmap::RGBA ), TextureHandle::BitmapKeepTexture );
+        TextureHandle textureB( TextureManager::getUniqueTextureKey(), new GBitmap( 4, 4, false, GBitmap::RGBA ), TextureHandle::BitmapKeepTexture );
+        ASSERT_EQ( residentCount + 2, TextureManager::getTextureResidentCount() );
+
+        // Record a batch per texture.
+        BatchRender batchRender;
+        batchRender.setDebugStats( &debugStats );
+        batchRender.setRecordTarget( &snapshot );
+        submitUnitTestQuad( batchRender, 0.0f, textureA );
+        submitUnitTestQuad( batchRender, 2.0f, textureB );
+        submitUnitTestQuad( batchRender, 4.0f, textureA );
+        batchRender.setRecordTarget( NULL );
+        ASSERT_EQ( 2U, snapshot.getBatchCount() ) << "Quads were not batched by texture.";
+
+        // Recording does not reference the textures.
+        ASSERT_FALSE( snapshot.getTexturesHeld() );
+
+        // Reference the textures.
+        snapshot.holdTextures();
+        ASSERT_TRUE( snapshot.getTexturesHeld() );
+    }
+
+    // The snapshot keeps the textures alive after their owners release them.
+    ASSERT_EQ( residentCount + 2, TextureManager::getTextureResidentCount() ) << "Textures were freed while the snapshot referenced them.";
+
+    // Resetting releases them.
+    snapshot.reset();
+    ASSERT_EQ( residentCount, TextureManager::getTextureResidentCount() ) << "Snapshot did not release its textures.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( RenderSnapshotTests, PipelineCaptureTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Add objects to the scene.
+    for ( U32 n = 0; n < RENDERSNAPSHOT_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        ASSERT_TRUE( pSceneObject->registerObject() ) << "Object not registered.";
+        pSceneObject->setPosition( Vector2( (F32)n, 0.0f ) );
+        pScene->addToScene( pSceneObject );
+    }
+
+    // Synchronizing is harmless when the pipeline is not in use.
+    const bool pipelineActive = ScenePipeline::isActive();
+    if ( !pipelineActive )
+        ScenePipeline::synchronize();
+
+    // Note the frame arenas before the worker starts.
+    Vector<FrameAllocator::ArenaStats> arenaStats;
+    FrameAllocator::getArenaStats( arenaStats );
+    const U32 arenaCount = arenaStats.size();
+
+    // Start the pipeline.
+    ScenePipeline::acquire();
+    ASSERT_TRUE( ScenePipeline::isActive() );
+
+    // Capture the scene.
+    DebugStats debugStats;
+    SceneRenderState sceneRenderState( RectF( -10.0f, -10.0f, 40.0f, 20.0f ), Vector2::getZero(), 0.0f, MASK_ALL, MASK_ALL, Vector2::getOne(), &debugStats, pScene );
+    RenderSnapshot snapshot;
+    snapshot.reset();
+    ScenePipeline::queueCapture( pScene, sceneRenderState, &snapshot );
+
+    // Wait for the capture.
+    ScenePipeline::synchronize();
+    ASSERT_TRUE( ScenePipeline::isIdle() ) << "Synchronize returned with a capture outstanding.";
+    ASSERT_TRUE( snapshot.isValid() ) << "Capture failed.";
+    ASSERT_EQ( (U32)RENDERSNAPSHOT_UNITTEST_OBJECT_COUNT, snapshot.getRenderStats().renderPicked ) << "Capture did not query the scene.";
+    ASSERT_EQ( 0U, snapshot.getBatchCount() ) << "Objects that do not render were captured.";
+
+    // The scene can change once synchronized and captures see the change.
+    pScene->clearScene( true );
+    snapshot.reset();
+    ScenePipeline::queueCapture( pScene, sceneRenderState, &snapshot );
+    ScenePipeline::synchronize();
+    ASSERT_TRUE( snapshot.isValid() );
+    ASSERT_EQ( 0U, snapshot.getRenderStats().renderPicked );
+
+    // Stop the pipeline.
+    ScenePipeline::release();
+    ASSERT_EQ( pipelineActive, ScenePipeline::isActive() );
+
+    // A stopped worker releases its frame arena.
+    if ( !pipelineActive )
+    {
+        FrameAllocator::getArenaStats( arenaStats );
+        ASSERT_EQ( arenaCount, (U32)arenaStats.size() ) << "Pipeline worker left its frame arena.";
+    }
+
+    // Clean-up.
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
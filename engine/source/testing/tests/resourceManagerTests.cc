@@ -0,0 +1,152 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _RESMANAGER_H_
+#include "io/resource/resourceManager.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define RESOURCEMANAGER_UNITTEST_DIRECTORY      "_unitTestResources_RemoveMe"
+#define RESOURCEMANAGER_UNITTEST_FILE           "_unitTestResources_RemoveMe/file.txt"
+#define RESOURCEMANAGER_UNITTEST_OTHER_FILE     "_unitTestResources_RemoveMe/other.txt"
+#define RESOURCEMANAGER_UNITTEST_FILEMESSAGE    "Write a line of text."
+
+//-----------------------------------------------------------------------------
+
+static bool writeTestFile( const char* pFileName )
+{
+    FileStream stream;
+    if ( !stream.open( pFileName, FileStream::Write ) )
+        return false;
+
+    stream.write( dStrlen(RESOURCEMANAGER_UNITTEST_FILEMESSAGE), RESOURCEMANAGER_UNITTEST_FILEMESSAGE );
+    stream.close();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+static void deleteTestFile( const char* pFileName )
+{
+    Platform::fileDelete( pFileName );
+
+    // Remove the file from the resource dictionary.
+    ResourceManager->fileChanged( pFileName );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceManagerTests, MissingFileTest )
+{
+    char fileName[1024];
+    char otherFileName[1024];
+    Platform::makeFullPathName( RESOURCEMANAGER_UNITTEST_FILE, fileName, sizeof(fileName) );
+    Platform::makeFullPathName( RESOURCEMANAGER_UNITTEST_OTHER_FILE, otherFileName, sizeof(otherFileName) );
+
+    // Create the directory with another file in it.
+    ASSERT_TRUE( writeTestFile( otherFileName ) ) << "Failed to write the test file.";
+
+    // The file should be missing and the directory listing should answer the second lookup.
+    ASSERT_TRUE( ResourceManager->find( fileName ) == NULL ) << "Missing file was found.";
+    const U32 listingCount = ResourceManager->getListingCount();
+    const U32 listingHitCount = ResourceManager->getListingHitCount();
+    ASSERT_TRUE( ResourceManager->find( fileName ) == NULL ) << "Missing file was found.";
+    ASSERT_EQ( listingCount, ResourceManager->getListingCount() ) << "Directory was listed again.";
+    ASSERT_EQ( listingHitCount + 1, ResourceManager->getListingHitCount() ) << "Lookup was not answered by the listing.";
+
+    // Writing the file should make it visible with the correct size.
+    ASSERT_TRUE( writeTestFile( fileName ) ) << "Failed to write the test file.";
+    ResourceObject* pResourceObject = ResourceManager->find( fileName );
+    ASSERT_TRUE( pResourceObject != NULL ) << "Created file was not found.";
+    ASSERT_EQ( Platform::getFileSize( fileName ), pResourceObject->fileSize ) << "File size is incorrect.";
+
+    // Clean-up.
+    deleteTestFile( fileName );
+    deleteTestFile( otherFileName );
+    ASSERT_TRUE( ResourceManager->find( fileName ) == NULL ) << "Deleted file was found.";
+    Platform::deleteDirectory( RESOURCEMANAGER_UNITTEST_DIRECTORY );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceManagerTests, RelativePathTest )
+{
+    char fileName[1024];
+    Platform::makeFullPathName( RESOURCEMANAGER_UNITTEST_FILE, fileName, sizeof(fileName) );
+
+    // Create the file by its full path.
+    ASSERT_TRUE( writeTestFile( fileName ) ) << "Failed to write the test file.";
+
+    // Looking it up by its relative path should find the same file as the file system does.
+    ASSERT_TRUE( Platform::isFile( RESOURCEMANAGER_UNITTEST_FILE ) ) << "Test file is not relative to the current directory.";
+    ResourceObject* pResourceObject = ResourceManager->find( RESOURCEMANAGER_UNITTEST_FILE );
+    ASSERT_TRUE( pResourceObject != NULL ) << "File was not found by its relative path.";
+    ASSERT_EQ( Platform::getFileSize( RESOURCEMANAGER_UNITTEST_FILE ), pResourceObject->fileSize ) << "File size is incorrect.";
+
+    // Clean-up.
+    deleteTestFile( RESOURCEMANAGER_UNITTEST_FILE );
+    deleteTestFile( fileName );
+    Platform::deleteDirectory( RESOURCEMANAGER_UNITTEST_DIRECTORY );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ResourceManagerTests, InvalidateDirectoryTest )
+{
+    char fileName[1024];
+    char directoryName[1024];
+    Platform::makeFullPathName( RESOURCEMANAGER_UNITTEST_FILE, fileName, sizeof(fileName) );
+    Platform::makeFullPathName( RESOURCEMANAGER_UNITTEST_DIRECTORY, directoryName, sizeof(directoryName) );
+
+    // Cache the listing without the file.
+    ASSERT_TRUE( Platform::createPath( fileName ) ) << "Failed to create the test directory.";
+    ASSERT_TRUE( ResourceManager->find( fileName ) == NULL ) << "Missing file was found.";
+
+    // Create the file without going through a file stream so the listing is stale.
+    File file;
+    ASSERT_EQ( File::Ok, file.open( fileName, File::Write ) ) << "Failed to open the test file.";
+    file.write( dStrlen(RESOURCEMANAGER_UNITTEST_FILEMESSAGE), RESOURCEMANAGER_UNITTEST_FILEMESSAGE );
+    file.close();
+    ASSERT_TRUE( ResourceManager->find( fileName ) == NULL ) << "Stale listing was not used.";
+
+    // Forgetting the directory should find the file.
+    ResourceManager->invalidateFileCache( directoryName );
+    ASSERT_TRUE( ResourceManager->find( fileName ) != NULL ) << "File was not found after invalidating its directory.";
+
+    // Clean-up.
+    deleteTestFile( fileName );
+    Platform::deleteDirectory( directoryName );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENEBULKADD_UNITTEST_OBJECT_COUNT  512
+#define SCENEBULKADD_UNITTEST_GRID_WIDTH    32
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneBulkAddTests, BulkAddRemoveTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create objects on a grid with every eighth one disabled.
+    typeSceneObjectVector sceneObjects;
+    U32 enabledCount = 0;
+    for ( U32 n = 0; n < SCENEBULKADD_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        ASSERT_TRUE( pSceneObject->registerObject() ) << "Object not registered.";
+        pSceneObject->setPosition( Vector2( (F32)(n % SCENEBULKADD_UNITTEST_GRID_WIDTH) * 2.0f, (F32)(n / SCENEBULKADD_UNITTEST_GRID_WIDTH) * 2.0f ) );
+        pSceneObject->createCircleCollisionShape( 0.5f );
+
+        if ( n % 8 == 0 )
+            pSceneObject->setEnabled( false );
+        else
+            enabledCount++;
+
+        sceneObjects.push_back( pSceneObject );
+    }
+
+    // Add them through the bulk path.
+    ASSERT_EQ( (U32)SCENEBULKADD_UNITTEST_OBJECT_COUNT, pScene->addToScene( sceneObjects ) );
+    ASSERT_EQ( (U32)SCENEBULKADD_UNITTEST_OBJECT_COUNT, pScene->getSceneObjectCount() );
+    ASSERT_FALSE( pScene->getWorldQuery()->getIsBulkAdding() ) << "Bulk add was left open.";
+
+    // Every object should have a world proxy and a body that is active only if the object is enabled.
+    for ( U32 n = 0; n < SCENEBULKADD_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = sceneObjects[n];
+        ASSERT_EQ( pScene, pSceneObject->getScene() );
+        ASSERT_GE( pSceneObject->getWorldProxy(), 0 ) << "Object " << n << " has no world proxy.";
+        ASSERT_NE( (b2Body*)NULL, pSceneObject->getBody() );
+        ASSERT_EQ( pSceneObject->isEnabled(), pSceneObject->getBody()->IsActive() ) << "Object " << n << " body activation is wrong.";
+    }
+
+    // Only the active bodies should have broad-phase proxies.
+    ASSERT_EQ( (S32)enabledCount, pScene->getWorld()->GetProxyCount() );
+
+    // Query everything through the world proxies.
+    WorldQueryFilter queryFilter( MASK_ALL, MASK_ALL, false, false, false, false );
+    WorldQuery* pWorldQuery = pScene->getWorldQuery( true );
+    pWorldQuery->setQueryFilter( queryFilter );
+    b2AABB worldAABB;
+    worldAABB.lowerBound.Set( -10.0f, -10.0f );
+    worldAABB.upperBound.Set( 100.0f, 100.0f );
+    ASSERT_EQ( (U32)SCENEBULKADD_UNITTEST_OBJECT_COUNT, pWorldQuery->aabbQueryAABB( worldAABB ) ) << "World proxies were not all built.";
+
+    // Query a single grid cell.
+    pWorldQuery = pScene->getWorldQuery( true );
+    b2AABB cellAABB;
+    cellAABB.lowerBound.Set( 3.9f, 3.9f );
+    cellAABB.upperBound.Set( 4.1f, 4.1f );
+    ASSERT_EQ( 1U, pWorldQuery->aabbQueryAABB( cellAABB ) ) << "World proxy bounds are wrong.";
+
+    // Query the collision shapes which only exist for active bodies.
+    pWorldQuery = pScene->getWorldQuery( true );
+    ASSERT_EQ( enabledCount, pWorldQuery->collisionQueryAABB( worldAABB ) ) << "Broad-phase proxies were not all built.";
+
+    // The world should still step.
+    pScene->getWorld()->Step( 1.0f / 60.0f, 4, 4 );
+
+    // Remove half the objects through the bulk path.
+    typeSceneObjectVector removeObjects;
+    for ( U32 n = 0; n < SCENEBULKADD_UNITTEST_OBJECT_COUNT; n += 2 )
+        removeObjects.push_back( sceneObjects[n] );
+
+    ASSERT_EQ( (U32)removeObjects.size(), pScene->removeFromScene( removeObjects ) );
+    ASSERT_EQ( (U32)(SCENEBULKADD_UNITTEST_OBJECT_COUNT - removeObjects.size()), pScene->getSceneObjectCount() );
+
+    pWorldQuery = pScene->getWorldQuery( true );
+    ASSERT_EQ( (U32)(SCENEBULKADD_UNITTEST_OBJECT_COUNT - removeObjects.size()), pWorldQuery->aabbQueryAABB( worldAABB ) );
+
+    // Add them back one at a time alongside the bulk-built proxies.
+    for ( U32 n = 0; n < (U32)removeObjects.size(); ++n )
+        pScene->addToScene( removeObjects[n] );
+
+    pWorldQuery = pScene->getWorldQuery( true );
+    ASSERT_EQ( (U32)SCENEBULKADD_UNITTEST_OBJECT_COUNT, pWorldQuery->aabbQueryAABB( worldAABB ) );
+
+    // Clean-up.
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,200 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_OBJECT_POOL_H_
+#include "2d/scene/SceneObjectPool.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS          256
+#define SCENEOBJECTPOOL_UNITTEST_CHURN_ITERATIONS       20
+#define SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS      1000
+#define SCENEOBJECTPOOL_UNITTEST_BENCHMARK_ITERATIONS   50
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneObjectPoolTests, AcquireReleaseTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a template.
+    SceneObject* pTemplate = new SceneObject();
+    ASSERT_TRUE( pTemplate->registerObject() ) << "Template not registered.";
+    pTemplate->setLifetime( 2.0f );
+
+    // Acquire an object.
+    SceneObject* pSceneObject = pScene->acquireObject( pTemplate );
+    ASSERT_NE( (SceneObject*)NULL, pSceneObject ) << "Object not acquired.";
+    ASSERT_EQ( pScene, pSceneObject->getScene() ) << "Object not added to the scene.";
+    ASSERT_TRUE( pSceneObject->isPooled() ) << "Object not flagged as pooled.";
+    ASSERT_FLOAT_EQ( 2.0f, pSceneObject->getLifetime() ) << "Object state not copied from the template.";
+
+    // Move the object and release it with a safe-delete.
+    pSceneObject->setPosition( Vector2( 10.0f, 20.0f ) );
+    pSceneObject->safeDelete();
+    ASSERT_TRUE( pSceneObject->isPoolIdle() ) << "Object not released to the pool.";
+    ASSERT_FALSE( pSceneObject->isEnabled() ) << "Released object is still enabled.";
+    ASSERT_FALSE( pSceneObject->isBeingDeleted() ) << "Released object is being deleted.";
+
+    // Acquire again which should reuse the same object.
+    SceneObject* pReusedObject = pScene->acquireObject( pTemplate );
+    ASSERT_EQ( pSceneObject, pReusedObject ) << "Idle object not reused.";
+    ASSERT_TRUE( pReusedObject->isEnabled() ) << "Reused object not enabled.";
+    ASSERT_TRUE( pReusedObject->getPosition() == pTemplate->getPosition() ) << "Reused object state not reset.";
+
+    // Check the pool statistics.
+    SceneObjectPool* pObjectPool = pScene->findObjectPool( pTemplate );
+    ASSERT_NE( (SceneObjectPool*)NULL, pObjectPool ) << "Object pool not found.";
+    ASSERT_EQ( 1U, pObjectPool->getCreatedCount() );
+    ASSERT_EQ( 2U, pObjectPool->getAcquiredCount() );
+    ASSERT_EQ( 1U, pObjectPool->getReusedCount() );
+
+    // Clean-up.
+    pScene->deleteObject();
+    pTemplate->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneObjectPoolTests, ChurnTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a template with a collision shape.
+    SceneObject* pTemplate = new SceneObject();
+    ASSERT_TRUE( pTemplate->registerObject() ) << "Template not registered.";
+    pTemplate->createCircleCollisionShape( 0.5f );
+
+    SceneObject* objects[SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS];
+
+    // Repeatedly acquire and release a batch of objects.
+    for ( U32 iteration = 0; iteration < SCENEOBJECTPOOL_UNITTEST_CHURN_ITERATIONS; ++iteration )
+    {
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS; ++n )
+        {
+            objects[n] = pScene->acquireObject( pTemplate );
+            ASSERT_NE( (SceneObject*)NULL, objects[n] ) << "Object not acquired.";
+            ASSERT_EQ( 1U, objects[n]->getCollisionShapeCount() ) << "Object collision shapes not reset from the template.";
+        }
+
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS; ++n )
+            objects[n]->safeDelete();
+
+        pScene->processDeleteRequests( true );
+
+        // Released objects should stay in the scene, idle and disabled.
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS; ++n )
+        {
+            ASSERT_TRUE( objects[n]->isPoolIdle() ) << "Object not released to the pool.";
+            ASSERT_FALSE( objects[n]->isEnabled() ) << "Released object is still enabled.";
+        }
+        ASSERT_EQ( (U32)SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS, pScene->getSceneObjectCount() ) << "Pooled objects were removed from the scene.";
+    }
+
+    // Only the first iteration should have created objects.
+    SceneObjectPool* pObjectPool = pScene->findObjectPool( pTemplate );
+    ASSERT_NE( (SceneObjectPool*)NULL, pObjectPool ) << "Object pool not found.";
+    ASSERT_EQ( (U32)SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS, pObjectPool->getCreatedCount() ) << "Pool created too many objects.";
+    ASSERT_EQ( (U32)(SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS * SCENEOBJECTPOOL_UNITTEST_CHURN_ITERATIONS), pObjectPool->getAcquiredCount() );
+    ASSERT_EQ( pObjectPool->getAcquiredCount() - pObjectPool->getCreatedCount(), pObjectPool->getReusedCount() ) << "Idle objects not reused.";
+    ASSERT_EQ( (U32)SCENEOBJECTPOOL_UNITTEST_CHURN_OBJECTS, pObjectPool->getIdleCount() ) << "Pool did not retain released objects.";
+
+    // Clean-up.
+    pScene->deleteObject();
+    pTemplate->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneObjectPoolTests, ChurnBenchmarkTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a template with a collision shape.
+    SceneObject* pTemplate = new SceneObject();
+    ASSERT_TRUE( pTemplate->registerObject() ) << "Template not registered.";
+    pTemplate->createCircleCollisionShape( 0.5f );
+
+    Vector<SceneObject*> objects;
+    objects.setSize( SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS );
+
+    // Churn without pooling.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 iteration = 0; iteration < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_ITERATIONS; ++iteration )
+    {
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS; ++n )
+        {
+            objects[n] = static_cast<SceneObject*>( pTemplate->clone( true ) );
+            pScene->addToScene( objects[n] );
+        }
+
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS; ++n )
+            objects[n]->safeDelete();
+
+        pScene->processDeleteRequests( true );
+    }
+    const U32 unpooledTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( 0U, pScene->getSceneObjectCount() ) << "Unpooled objects were not deleted.";
+
+    // Churn with pooling.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 iteration = 0; iteration < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_ITERATIONS; ++iteration )
+    {
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS; ++n )
+            objects[n] = pScene->acquireObject( pTemplate );
+
+        for ( U32 n = 0; n < SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS; ++n )
+            objects[n]->safeDelete();
+
+        pScene->processDeleteRequests( true );
+    }
+    const U32 pooledTime = Platform::getRealMilliseconds() - startTime;
+
+    // Both should have churned the same objects but only the first pooled iteration should have created any.
+    SceneObjectPool* pObjectPool = pScene->findObjectPool( pTemplate );
+    ASSERT_NE( (SceneObjectPool*)NULL, pObjectPool ) << "Object pool not found.";
+    ASSERT_EQ( (U32)SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS, pObjectPool->getCreatedCount() ) << "Pool created too many objects.";
+    ASSERT_EQ( (U32)(SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS * SCENEOBJECTPOOL_UNITTEST_BENCHMARK_ITERATIONS), pObjectPool->getAcquiredCount() );
+
+    Con::printf( "SceneObjectPool churn of %d objects x %d iterations: unpooled %dms, pooled %dms.",
+        SCENEOBJECTPOOL_UNITTEST_BENCHMARK_OBJECTS, SCENEOBJECTPOOL_UNITTEST_BENCHMARK_ITERATIONS, unpooledTime, pooledTime );
+
+    // Clean-up.
+    pScene->deleteObject();
+    pTemplate->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
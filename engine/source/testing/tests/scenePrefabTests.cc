@@ -0,0 +1,217 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_PREFAB_H_
+#include "2d/scene/ScenePrefab.h"
+#endif
+
+#ifndef _ROTATE_BEHAVIOR_H_
+#include "2d/behaviors/RotateBehavior.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENEPREFAB_UNITTEST_STAMP_COUNT    64
+
+//-----------------------------------------------------------------------------
+
+TEST( ScenePrefabTests, StampFieldsTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a template with plain fields, fields with setters, a dynamic field and collision shapes.
+    SceneObject* pTemplate = new SceneObject();
+    ASSERT_TRUE( pTemplate->registerObject() ) << "Template not registered.";
+    pTemplate->setLifetime( 3.0f );
+    pTemplate->setSize( Vector2( 2.0f, 3.0f ) );
+    pTemplate->setSceneLayer( 5 );
+    pTemplate->setBodyType( b2_staticBody );
+    pTemplate->setCollisionGroupMask( BIT(3) );
+    pTemplate->setVisible( false );
+    pTemplate->setBlendColor( ColorF( 0.25f, 0.5f, 0.75f, 1.0f ) );
+    pTemplate->setPosition( Vector2( 7.0f, 8.0f ) );
+    pTemplate->setDataField( StringTable->insert( "health" ), NULL, "42" );
+    pTemplate->createCircleCollisionShape( 0.5f );
+    pTemplate->createPolygonBoxCollisionShape( 1.0f, 2.0f );
+
+    // Compile the prefab.
+    ScenePrefab* pPrefab = new ScenePrefab();
+    ASSERT_TRUE( pPrefab->registerObject() ) << "Prefab not registered.";
+    ASSERT_TRUE( pPrefab->compile( pTemplate ) ) << "Prefab not compiled.";
+    ASSERT_TRUE( pPrefab->isCompiled() );
+    ASSERT_GT( pPrefab->getCompiledFieldCount(), 0U ) << "No fields compiled.";
+    ASSERT_EQ( 1U, pPrefab->getCompiledDynamicFieldCount() ) << "Dynamic field not compiled.";
+    ASSERT_EQ( 2U, pPrefab->getCompiledCollisionShapeCount() ) << "Collision shapes not compiled.";
+
+    // The template should no longer be needed.
+    pTemplate->deleteObject();
+
+    // Stamp the instances at requested positions.
+    Vector2 positions[SCENEPREFAB_UNITTEST_STAMP_COUNT];
+    for ( U32 n = 0; n < SCENEPREFAB_UNITTEST_STAMP_COUNT; ++n )
+        positions[n].Set( (F32)n * 2.0f, (F32)n * -1.0f );
+
+    typeSceneObjectVector objects;
+    ASSERT_EQ( (U32)SCENEPREFAB_UNITTEST_STAMP_COUNT, pPrefab->stamp( pScene, SCENEPREFAB_UNITTEST_STAMP_COUNT, objects, positions ) ) << "Instances not stamped.";
+    ASSERT_EQ( SCENEPREFAB_UNITTEST_STAMP_COUNT, objects.size() );
+    ASSERT_EQ( (U32)SCENEPREFAB_UNITTEST_STAMP_COUNT, pScene->getSceneObjectCount() ) << "Instances not added to the scene.";
+
+    // Check each instance.
+    for ( U32 n = 0; n < SCENEPREFAB_UNITTEST_STAMP_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = objects[n];
+
+        // Scene membership and position.
+        ASSERT_TRUE( pSceneObject->isProperlyAdded() ) << "Instance " << n << " not registered.";
+        ASSERT_EQ( pScene, pSceneObject->getScene() ) << "Instance " << n << " not in the scene.";
+        ASSERT_NE( (b2Body*)NULL, pSceneObject->getBody() ) << "Instance " << n << " has no body.";
+        ASSERT_TRUE( pSceneObject->getPosition() == positions[n] ) << "Instance " << n << " not at its requested position.";
+
+        // Fields.
+        ASSERT_FLOAT_EQ( 3.0f, pSceneObject->getLifetime() );
+        ASSERT_TRUE( pSceneObject->getSize() == Vector2( 2.0f, 3.0f ) );
+        ASSERT_EQ( 5U, pSceneObject->getSceneLayer() );
+        ASSERT_EQ( b2_staticBody, pSceneObject->getBodyType() );
+        ASSERT_EQ( (U32)BIT(3), pSceneObject->getCollisionGroupMask() );
+        ASSERT_FALSE( pSceneObject->getVisible() );
+        ASSERT_TRUE( pSceneObject->getBlendColor() == ColorF( 0.25f, 0.5f, 0.75f, 1.0f ) );
+        ASSERT_STREQ( "42", pSceneObject->getDataField( StringTable->insert( "health" ), NULL ) ) << "Dynamic field not stamped.";
+
+        // Collision shapes.
+        ASSERT_EQ( 2U, pSceneObject->getCollisionShapeCount() ) << "Collision shapes not stamped.";
+        ASSERT_EQ( b2Shape::e_circle, pSceneObject->getCollisionShapeType( 0 ) );
+        ASSERT_FLOAT_EQ( 0.5f, pSceneObject->getCircleCollisionShapeRadius( 0 ) );
+        ASSERT_EQ( b2Shape::e_polygon, pSceneObject->getCollisionShapeType( 1 ) );
+        ASSERT_EQ( 4U, pSceneObject->getPolygonCollisionShapePointCount( 1 ) );
+    }
+
+    // Stamping without positions should use the template position.
+    typeSceneObjectVector moreObjects;
+    ASSERT_EQ( 1U, pPrefab->stamp( pScene, 1, moreObjects ) );
+    ASSERT_TRUE( moreObjects[0]->getPosition() == Vector2( 7.0f, 8.0f ) ) << "Template position not stamped.";
+    ASSERT_EQ( (U32)SCENEPREFAB_UNITTEST_STAMP_COUNT + 1, pScene->getSceneObjectCount() );
+
+    // Clean-up.
+    pScene->deleteObject();
+    pPrefab->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScenePrefabTests, StampBehaviorsTest )
+{
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a native behavior template.
+    BehaviorTemplate* pNativeTemplate = new BehaviorTemplate();
+    ASSERT_TRUE( pNativeTemplate->registerObject() ) << "Native behavior template not registered.";
+    ASSERT_TRUE( pNativeTemplate->setNativeClass( "RotateBehaviorInstance" ) ) << "Native class not set.";
+
+    // Create script behavior templates with an output and an input.
+    BehaviorTemplate* pOutputTemplate = new BehaviorTemplate();
+    ASSERT_TRUE( pOutputTemplate->registerObject() ) << "Output behavior template not registered.";
+    pOutputTemplate->addBehaviorOutput( "fired", "Fired", "" );
+
+    BehaviorTemplate* pInputTemplate = new BehaviorTemplate();
+    ASSERT_TRUE( pInputTemplate->registerObject() ) << "Input behavior template not registered.";
+    pInputTemplate->addBehaviorInput( "trigger", "Trigger", "" );
+
+    // Create a template with the behaviors.
+    SceneObject* pTemplate = new SceneObject();
+    ASSERT_TRUE( pTemplate->registerObject() ) << "Template not registered.";
+
+    RotateBehaviorInstance* pRotateBehavior = dynamic_cast<RotateBehaviorInstance*>( pNativeTemplate->createInstance() );
+    ASSERT_NE( (RotateBehaviorInstance*)NULL, pRotateBehavior ) << "Native behavior not created.";
+    pRotateBehavior->setAngularSpeed( 90.0f );
+    ASSERT_TRUE( pTemplate->addBehavior( pRotateBehavior ) );
+
+    BehaviorInstance* pOutputBehavior = pOutputTemplate->createInstance();
+    pOutputBehavior->setDataField( StringTable->insert( "speed" ), NULL, "5" );
+    ASSERT_TRUE( pTemplate->addBehavior( pOutputBehavior ) );
+
+    BehaviorInstance* pInputBehavior = pInputTemplate->createInstance();
+    ASSERT_TRUE( pTemplate->addBehavior( pInputBehavior ) );
+
+    StringTableEntry outputName = StringTable->insert( "fired" );
+    StringTableEntry inputName = StringTable->insert( "trigger" );
+    ASSERT_TRUE( pTemplate->connect( pOutputBehavior, pInputBehavior, outputName, inputName ) ) << "Template behaviors not connected.";
+
+    // Compile the prefab.
+    ScenePrefab* pPrefab = new ScenePrefab();
+    ASSERT_TRUE( pPrefab->registerObject() ) << "Prefab not registered.";
+    ASSERT_TRUE( pPrefab->compile( pTemplate ) ) << "Prefab not compiled.";
+    ASSERT_EQ( 3U, pPrefab->getCompiledBehaviorCount() ) << "Behaviors not compiled.";
+
+    // Changing the template afterwards should not affect the prefab.
+    pRotateBehavior->setAngularSpeed( 10.0f );
+
+    // Stamp the instances.
+    typeSceneObjectVector objects;
+    ASSERT_EQ( (U32)SCENEPREFAB_UNITTEST_STAMP_COUNT, pPrefab->stamp( pScene, SCENEPREFAB_UNITTEST_STAMP_COUNT, objects ) ) << "Instances not stamped.";
+
+    // Each instance should have its own copies of the behaviors in the same order.
+    for ( U32 n = 0; n < SCENEPREFAB_UNITTEST_STAMP_COUNT; ++n )
+    {
+        SceneObject* pSceneObject = objects[n];
+        ASSERT_EQ( pScene, pSceneObject->getScene() ) << "Instance " << n << " not in the scene.";
+        ASSERT_EQ( 3U, pSceneObject->getBehaviorCount() ) << "Instance " << n << " behaviors not stamped.";
+
+        // The native behavior should have its typed field.
+        RotateBehaviorInstance* pStampedRotate = dynamic_cast<RotateBehaviorInstance*>( pSceneObject->getBehavior( 0U ) );
+        ASSERT_NE( (RotateBehaviorInstance*)NULL, pStampedRotate ) << "Native behavior not stamped.";
+        ASSERT_NE( pRotateBehavior, pStampedRotate ) << "Behavior shared with the template.";
+        ASSERT_EQ( pNativeTemplate, pStampedRotate->getTemplate() );
+        ASSERT_EQ( pSceneObject, pStampedRotate->getBehaviorOwner() );
+        ASSERT_FLOAT_EQ( 90.0f, pStampedRotate->getAngularSpeed() ) << "Native behavior field not stamped.";
+        ASSERT_EQ( 1U, (U32)pSceneObject->getNativeBehaviors().size() ) << "Native behavior not tracked.";
+
+        // The script behaviors should have their dynamic fields and connection.
+        BehaviorInstance* pStampedOutput = pSceneObject->getBehavior( 1U );
+        BehaviorInstance* pStampedInput = pSceneObject->getBehavior( 2U );
+        ASSERT_EQ( pOutputTemplate, pStampedOutput->getTemplate() );
+        ASSERT_EQ( pInputTemplate, pStampedInput->getTemplate() );
+        ASSERT_STREQ( "5", pStampedOutput->getDataField( StringTable->insert( "speed" ), NULL ) ) << "Behavior field not stamped.";
+        ASSERT_EQ( 1U, pSceneObject->getBehaviorConnectionCount( pStampedOutput, outputName ) ) << "Behavior connection not stamped.";
+        ASSERT_EQ( pStampedInput, pSceneObject->getBehaviorConnection( pStampedOutput, outputName, 0 )->mInputInstance );
+    }
+
+    // Clean-up.
+    pScene->deleteObject();
+    pPrefab->deleteObject();
+    pTemplate->deleteObject();
+    pNativeTemplate->deleteObject();
+    pOutputTemplate->deleteObject();
+    pInputTemplate->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_STREAMER_H_
+#include "2d/scene/SceneStreamer.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENESTREAMER_UNITTEST_PATH             "_unitTestChunks_RemoveMe"
+#define SCENESTREAMER_UNITTEST_CHUNK_SIZE       16.0f
+#define SCENESTREAMER_UNITTEST_CHUNK_OBJECTS    8
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneStreamerTests, LoadUnloadTest )
+{
+    char pathBuffer[1024];
+
+    // Create a scene.
+    Scene* pScene = new Scene();
+    ASSERT_TRUE( pScene->registerObject() ) << "Scene not registered.";
+
+    // Create a streamer.
+    SceneStreamer* pStreamer = new SceneStreamer();
+    ASSERT_TRUE( pStreamer->registerObject() ) << "Streamer not registered.";
+    Platform::makeFullPathName( SCENESTREAMER_UNITTEST_PATH "/chunk_%d_%d.baml", pathBuffer, sizeof(pathBuffer) );
+    pStreamer->setDataField( StringTable->insert( "ChunkPath" ), NULL, pathBuffer );
+    pStreamer->setDataField( StringTable->insert( "ChunkSize" ), NULL, "16 16" );
+
+    // Fill two chunks side by side.
+    for ( U32 n = 0; n < SCENESTREAMER_UNITTEST_CHUNK_OBJECTS * 2; ++n )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        ASSERT_TRUE( pSceneObject->registerObject() ) << "Object not registered.";
+        const F32 chunkOffset = n < SCENESTREAMER_UNITTEST_CHUNK_OBJECTS ? 0.0f : SCENESTREAMER_UNITTEST_CHUNK_SIZE;
+        pSceneObject->setPosition( Vector2( chunkOffset + 1.0f + (F32)(n % SCENESTREAMER_UNITTEST_CHUNK_OBJECTS), 1.0f ) );
+        pScene->addToScene( pSceneObject );
+    }
+
+    // Write the chunks and empty the scene.
+    ASSERT_EQ( 2U, pStreamer->writeChunks( pScene ) ) << "Chunks were not written.";
+    pScene->clearScene( true );
+    ASSERT_EQ( 0U, pScene->getSceneObjectCount() );
+
+    // Load the first chunk.
+    pStreamer->setScene( pScene );
+    ASSERT_TRUE( pStreamer->loadChunk( 0, 0 ) ) << "Chunk was not loaded.";
+    ASSERT_EQ( (U32)SCENESTREAMER_UNITTEST_CHUNK_OBJECTS, pScene->getSceneObjectCount() );
+    ASSERT_TRUE( pStreamer->findChunk( 0, 0 ) != NULL );
+    ASSERT_EQ( SceneStreamer::ChunkLoaded, pStreamer->findChunk( 0, 0 )->mState );
+    ASSERT_EQ( 1U, pStreamer->getChunkCount( SceneStreamer::ChunkLoaded ) );
+    ASSERT_GT( pStreamer->getResidentSize(), 0U );
+
+    // The loaded objects should have world proxies.
+    for ( U32 n = 0; n < pScene->getSceneObjectCount(); ++n )
+        ASSERT_GE( pScene->getSceneObjects()[n]->getWorldProxy(), 0 ) << "Loaded object has no world proxy.";
+
+    // Load the second chunk.
+    ASSERT_TRUE( pStreamer->loadChunk( 1, 0 ) ) << "Chunk was not loaded.";
+    ASSERT_EQ( (U32)SCENESTREAMER_UNITTEST_CHUNK_OBJECTS * 2, pScene->getSceneObjectCount() );
+
+    // A missing chunk fails but is remembered.
+    ASSERT_FALSE( pStreamer->loadChunk( 5, 5 ) );
+    ASSERT_EQ( SceneStreamer::ChunkMissing, pStreamer->findChunk( 5, 5 )->mState );
+
+    // Unloading deletes the objects and frees the chunk.
+    ASSERT_TRUE( pStreamer->unloadChunk( 0, 0 ) ) << "Chunk was not unloaded.";
+    ASSERT_EQ( (U32)SCENESTREAMER_UNITTEST_CHUNK_OBJECTS, pScene->getSceneObjectCount() );
+    ASSERT_TRUE( pStreamer->findChunk( 0, 0 ) == NULL ) << "Unloaded chunk was not freed.";
+    ASSERT_FALSE( pStreamer->unloadChunk( 0, 0 ) );
+    ASSERT_EQ( 1U, pStreamer->getTotalUnloads() );
+
+    // Reloading reads the chunk again.
+    ASSERT_TRUE( pStreamer->loadChunk( 0, 0 ) ) << "Chunk was not reloaded.";
+    ASSERT_EQ( (U32)SCENESTREAMER_UNITTEST_CHUNK_OBJECTS * 2, pScene->getSceneObjectCount() );
+    ASSERT_EQ( 3U, pStreamer->getTotalLoads() );
+
+    // Unloading everything frees all but the missing chunk.
+    pStreamer->unloadAllChunks();
+    ASSERT_EQ( 0U, pScene->getSceneObjectCount() );
+    ASSERT_EQ( 0U, pStreamer->getResidentSize() );
+    ASSERT_TRUE( pStreamer->findChunk( 0, 0 ) == NULL );
+    ASSERT_TRUE( pStreamer->findChunk( 1, 0 ) == NULL );
+    ASSERT_TRUE( pStreamer->findChunk( 5, 5 ) != NULL );
+
+    // Stream the first chunk in around a focus point.
+    pStreamer->setDataField( StringTable->insert( "LoadDistance" ), NULL, "1" );
+    pStreamer->setDataField( StringTable->insert( "UnloadDistance" ), NULL, "2" );
+    pStreamer->addFocusPoint( Vector2( 8.0f, 8.0f ) );
+    for ( U32 n = 0; n < 200 && pStreamer->getChunkCount( SceneStreamer::ChunkLoaded ) == 0; ++n )
+    {
+        pStreamer->updateStreaming();
+        Platform::sleep( 5 );
+    }
+    ASSERT_EQ( 1U, pStreamer->getChunkCount( SceneStreamer::ChunkLoaded ) ) << "Chunk was not streamed in.";
+    ASSERT_EQ( (U32)SCENESTREAMER_UNITTEST_CHUNK_OBJECTS, pScene->getSceneObjectCount() );
+
+    // Moving the focus away streams it out and frees it.
+    pStreamer->setFocusPoint( 0, Vector2( -100.0f, -100.0f ) );
+    pStreamer->updateStreaming();
+    ASSERT_EQ( 0U, pScene->getSceneObjectCount() );
+    ASSERT_TRUE( pStreamer->findChunk( 0, 0 ) == NULL ) << "Streamed out chunk was not freed.";
+
+    // Clean-up.
+    pStreamer->deleteObject();
+    pScene->deleteObject();
+    Platform::makeFullPathName( SCENESTREAMER_UNITTEST_PATH, pathBuffer, sizeof(pathBuffer) );
+    ASSERT_TRUE( Platform::deleteDirectory( pathBuffer ) );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCRIPT_BATCH_COMPILER_H_
+#include "console/scriptBatchCompiler.h"
+#endif
+
+#ifndef _FILE_STREAM_H
+#include "io/fileStream.h"
+#endif
+
+#include "console/compiler.h"
+#include "string/stringTable.h"
+
+//-----------------------------------------------------------------------------
+
+#define SCRIPTBATCHCOMPILER_UNITTEST_PATH           "_unitTestScripts_RemoveMe"
+#define SCRIPTBATCHCOMPILER_UNITTEST_SCRIPT_COUNT   16
+
+//-----------------------------------------------------------------------------
+
+static bool readFileContents( const char* pFileName, Vector<U8>& contents )
+{
+    FileStream stream;
+    if ( !stream.open( pFileName, FileStream::Read ) )
+        return false;
+
+    contents.setSize( stream.getStreamSize() );
+    const bool result = contents.size() == 0 || stream.read( contents.size(), contents.address() );
+    stream.close();
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScriptBatchCompilerTests, MatchesSerialCompileTest )
+{
+    char pathBuffer[1024];
+    char scriptBuffer[1024];
+    char compiledBuffer[1024];
+
+    Vector<StringTableEntry> scriptFiles;
+    Vector< Vector<U8> > serialContents;
+    serialContents.setSize( SCRIPTBATCHCOMPILER_UNITTEST_SCRIPT_COUNT );
+
+    // Write the scripts and compile each one on its own.
+    for ( U32 n = 0; n < SCRIPTBATCHCOMPILER_UNITTEST_SCRIPT_COUNT; ++n )
+    {
+        dSprintf( scriptBuffer, sizeof(scriptBuffer), SCRIPTBATCHCOMPILER_UNITTEST_PATH "/script%d.cs", n );
+        Platform::makeFullPathName( scriptBuffer, pathBuffer, sizeof(pathBuffer) );
+        ASSERT_TRUE( Platform::createPath( pathBuffer ) );
+
+        dSprintf( scriptBuffer, sizeof(scriptBuffer),
+            "function batchTest%d(%%a, %%b)\n"
+            "{\n"
+            "   for ( %%i = 0; %%i < %d; %%i++ )\n"
+            "      %%a = %%a * %d.5 + %%b @ \"text%d\";\n"
+            "   return %%a SPC $batchTest::value[%d];\n"
+            "}\n"
+            "$batchTest::result%d = batchTest%d(%d, \"%d\");\n",
+            n, n, n, n, n, n, n, n, n );
+
+        FileStream writeStream;
+        ASSERT_TRUE( writeStream.open( pathBuffer, FileStream::Write ) ) << "Failed to write the script.";
+        writeStream.write( dStrlen(scriptBuffer), scriptBuffer );
+        writeStream.close();
+
+        const StringTableEntry scriptFile = StringTable->insert( pathBuffer );
+        scriptFiles.push_back( scriptFile );
+
+        CodeBlock::getCompiledFileName( scriptFile, compiledBuffer, sizeof(compiledBuffer) );
+        CodeBlock* pCodeBlock = new CodeBlock();
+        ASSERT_TRUE( pCodeBlock->compile( compiledBuffer, scriptFile, scriptBuffer ) ) << "Failed to compile the script.";
+        delete pCodeBlock;
+
+        ASSERT_TRUE( readFileContents( compiledBuffer, serialContents[n] ) ) << "Failed to read the compiled script.";
+        ASSERT_TRUE( Platform::fileDelete( compiledBuffer ) );
+    }
+
+    // Compile them all at once.
+    ScriptBatchCompiler::Stats stats;
+    ASSERT_TRUE( ScriptBatchCompiler::compileFiles( scriptFiles, 4, stats ) ) << "Batch compile failed.";
+    ASSERT_EQ( (U32)SCRIPTBATCHCOMPILER_UNITTEST_SCRIPT_COUNT, stats.scriptCount );
+    ASSERT_EQ( 0, stats.failedCount );
+    ASSERT_EQ( 4, stats.workerCount );
+
+    // The output should be identical.
+    for ( U32 n = 0; n < SCRIPTBATCHCOMPILER_UNITTEST_SCRIPT_COUNT; ++n )
+    {
+        CodeBlock::getCompiledFileName( scriptFiles[n], compiledBuffer, sizeof(compiledBuffer) );
+
+        Vector<U8> batchContents;
+        ASSERT_TRUE( readFileContents( compiledBuffer, batchContents ) ) << "Failed to read the batch compiled script.";
+        ASSERT_EQ( serialContents[n].size(), batchContents.size() ) << "Batch compiled script differs in size.";
+        ASSERT_EQ( 0, dMemcmp( serialContents[n].address(), batchContents.address(), batchContents.size() ) ) << "Batch compiled script differs.";
+    }
+
+    // Clean-up.
+    Platform::makeFullPathName( SCRIPTBATCHCOMPILER_UNITTEST_PATH, pathBuffer, sizeof(pathBuffer) );
+    ASSERT_TRUE( Platform::deleteDirectory( pathBuffer ) );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScriptBatchCompilerTests, SyntaxErrorTest )
+{
+    char pathBuffer[1024];
+    Platform::makeFullPathName( SCRIPTBATCHCOMPILER_UNITTEST_PATH "/broken.cs", pathBuffer, sizeof(pathBuffer) );
+    ASSERT_TRUE( Platform::createPath( pathBuffer ) );
+
+    const char* pScript = "function broken( { return; }\n";
+    FileStream writeStream;
+    ASSERT_TRUE( writeStream.open( pathBuffer, FileStream::Write ) ) << "Failed to write the script.";
+    writeStream.write( dStrlen(pScript), pScript );
+    writeStream.close();
+
+    // A script that does not parse fails without stopping the batch.
+    Vector<StringTableEntry> scriptFiles;
+    scriptFiles.push_back( StringTable->insert( pathBuffer ) );
+
+    ScriptBatchCompiler::Stats stats;
+    ASSERT_FALSE( ScriptBatchCompiler::compileFiles( scriptFiles, 2, stats ) );
+    ASSERT_EQ( 1, stats.failedCount );
+
+    // Clean-up.
+    Platform::makeFullPathName( SCRIPTBATCHCOMPILER_UNITTEST_PATH, pathBuffer, sizeof(pathBuffer) );
+    ASSERT_TRUE( Platform::deleteDirectory( pathBuffer ) );
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SHAPE_VECTOR_H_
+#include "2d/sceneobject/ShapeVector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SHAPEVECTOR_UNITTEST_AREA_TOLERANCE     0.0001f
+
+//-----------------------------------------------------------------------------
+
+static Vector<Vector2> createPolygon( const F32* pCoordinates, const U32 vertexCount, const bool reverse = false )
+{
+    Vector<Vector2> polygon;
+    for ( U32 n = 0; n < vertexCount; ++n )
+    {
+        const U32 index = reverse ? vertexCount - 1 - n : n;
+        polygon.push_back( Vector2( pCoordinates[index*2], pCoordinates[index*2+1] ) );
+    }
+
+    return polygon;
+}
+
+//-----------------------------------------------------------------------------
+
+static F32 getSignedArea( const Vector2& a, const Vector2& b, const Vector2& c )
+{
+    return ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5f;
+}
+
+//-----------------------------------------------------------------------------
+
+static F32 getPolygonArea( const Vector<Vector2>& polygon )
+{
+    F32 area = 0.0f;
+    for ( S32 n = 0, previous = polygon.size()-1; n < polygon.size(); previous = n++ )
+        area += polygon[previous].x * polygon[n].y - polygon[n].x * polygon[previous].y;
+
+    return area * 0.5f;
+}
+
+//-----------------------------------------------------------------------------
+
+static bool isPointInPolygon( const Vector2& point, const Vector<Vector2>& polygon )
+{
+    bool inside = false;
+    for ( S32 n = 0, previous = polygon.size()-1; n < polygon.size(); previous = n++ )
+    {
+        const Vector2& a = polygon[n];
+        const Vector2& b = polygon[previous];
+        if ( (a.y > point.y) != (b.y > point.y) && point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x )
+            inside = !inside;
+    }
+
+    return inside;
+}
+
+//-----------------------------------------------------------------------------
+
+static void checkTriangulation( const Vector<Vector2>& polygon )
+{
+    Vector<Vector2> triangles;
+    ShapeVector::triangulatePolygon( polygon, triangles );
+
+    // Dropping collinear vertices may produce fewer triangles than a simple polygon has.
+    ASSERT_EQ( 0, triangles.size() % 3 ) << "Incomplete triangle produced.";
+    ASSERT_GT( triangles.size(), 0 ) << "No triangles produced.";
+    ASSERT_LE( triangles.size(), (polygon.size() - 2) * 3 ) << "Too many triangles produced.";
+
+    // Every triangle should have the winding of the polygon and lie within it.
+    const F32 polygonArea = getPolygonArea( polygon );
+    F32 trianglesArea = 0.0f;
+    for ( S32 n = 0; n < triangles.size(); n += 3 )
+    {
+        const F32 triangleArea = getSignedArea( triangles[n], triangles[n+1], triangles[n+2] );
+        ASSERT_GT( triangleArea * polygonArea, 0.0f ) << "Triangle " << n/3 << " is degenerate or has the wrong winding.";
+
+        const Vector2 centroid( (triangles[n].x + triangles[n+1].x + triangles[n+2].x) / 3.0f, (triangles[n].y + triangles[n+1].y + triangles[n+2].y) / 3.0f );
+        ASSERT_TRUE( isPointInPolygon( centroid, polygon ) ) << "Triangle " << n/3 << " lies outside the polygon.";
+
+        trianglesArea += triangleArea;
+    }
+
+    // The triangles should cover the polygon exactly.
+    ASSERT_NEAR( polygonArea, trianglesArea, SHAPEVECTOR_UNITTEST_AREA_TOLERANCE ) << "Triangles do not cover the polygon.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ShapeVectorTests, ConvexTriangulationTest )
+{
+    const F32 square[] = { 0.0f, 0.0f,  2.0f, 0.0f,  2.0f, 2.0f,  0.0f, 2.0f };
+
+    checkTriangulation( createPolygon( square, 4 ) );
+    checkTriangulation( createPolygon( square, 4, true ) );
+
+    // Too few vertices should produce nothing.
+    Vector<Vector2> triangles;
+    ShapeVector::triangulatePolygon( createPolygon( square, 2 ), triangles );
+    ASSERT_EQ( 0, triangles.size() ) << "Triangles produced without an area.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ShapeVectorTests, ConcaveTriangulationTest )
+{
+    // An arrow head whose notch is a reflex vertex.
+    const F32 arrow[] = { 0.0f, 0.0f,  2.0f, 1.0f,  4.0f, 0.0f,  2.0f, 4.0f };
+    checkTriangulation( createPolygon( arrow, 4 ) );
+    checkTriangulation( createPolygon( arrow, 4, true ) );
+
+    // A comb with several reflex vertices.
+    const F32 comb[] = { 0.0f, 0.0f,  5.0f, 0.0f,  5.0f, 3.0f,  4.0f, 3.0f,  4.0f, 1.0f,  3.0f, 1.0f,  3.0f, 3.0f,  2.0f, 3.0f,  2.0f, 1.0f,  1.0f, 1.0f,  1.0f, 3.0f,  0.0f, 3.0f };
+    checkTriangulation( createPolygon( comb, 12 ) );
+    checkTriangulation( createPolygon( comb, 12, true ) );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ShapeVectorTests, CollinearTriangulationTest )
+{
+    // A square with extra vertices along two of its edges.
+    const F32 square[] = { 0.0f, 0.0f,  1.0f, 0.0f,  2.0f, 0.0f,  2.0f, 2.0f,  0.0f, 2.0f,  0.0f, 1.0f };
+    checkTriangulation( createPolygon( square, 6 ) );
+    checkTriangulation( createPolygon( square, 6, true ) );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ShapeVectorTests, SelfIntersectingTriangulationTest )
+{
+    // A bow-tie has no consistent winding so only termination and a bounded output are expected.
+    const F32 bowTie[] = { 0.0f, 0.0f,  2.0f, 2.0f,  2.0f, 0.0f,  0.0f, 2.0f };
+    Vector<Vector2> triangles;
+    ShapeVector::triangulatePolygon( createPolygon( bowTie, 4 ), triangles );
+    ASSERT_EQ( 0, triangles.size() % 3 ) << "Incomplete triangle produced.";
+    ASSERT_LE( triangles.size(), (4 - 2) * 3 ) << "Too many triangles produced.";
+
+    // A pentagram crosses itself five times.
+    const F32 pentagram[] = { 0.0f, 3.0f,  1.76f, -2.43f,  -2.85f, 0.93f,  2.85f, 0.93f,  -1.76f, -2.43f };
+    ShapeVector::triangulatePolygon( createPolygon( pentagram, 5 ), triangles );
+    ASSERT_EQ( 0, triangles.size() % 3 ) << "Incomplete triangle produced.";
+    ASSERT_LE( triangles.size(), (5 - 2) * 3 ) << "Too many triangles produced.";
+}
+
+#endif // TORQUE_SHIPPING
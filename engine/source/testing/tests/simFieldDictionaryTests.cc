@@ -0,0 +1,244 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT      16
+#define SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT     10000
+#define SIMFIELDDICTIONARY_UNITTEST_ITERATIONS      20
+
+//-----------------------------------------------------------------------------
+
+static StringTableEntry getTestFieldName( const U32 index )
+{
+    char nameBuffer[32];
+    dSprintf( nameBuffer, sizeof(nameBuffer), "testField%d", index );
+    return StringTable->insert( nameBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimFieldDictionaryTests, TextAndNumericTest )
+{
+    SimFieldDictionary dictionary;
+    StringTableEntry healthField = StringTable->insert( "health" );
+    F64 floatValue;
+    S32 intValue;
+
+    // Text values are parsed on demand.
+    dictionary.setFieldValue( healthField, "12.5" );
+    ASSERT_TRUE( dictionary.getFieldFloat( healthField, floatValue ) ) << "Field not found.";
+    ASSERT_DOUBLE_EQ( 12.5, floatValue );
+    ASSERT_TRUE( dictionary.getFieldInt( healthField, intValue ) ) << "Field not found.";
+    ASSERT_EQ( 12, intValue );
+    ASSERT_STREQ( "12.5", dictionary.getFieldValue( healthField ) );
+
+    // Numeric values are formatted on demand.
+    dictionary.setFieldFloat( healthField, 0.25 );
+    ASSERT_STREQ( "0.25", dictionary.getFieldValue( healthField ) );
+    dictionary.setFieldInt( healthField, -3 );
+    ASSERT_TRUE( dictionary.getFieldFloat( healthField, floatValue ) ) << "Field not found.";
+    ASSERT_DOUBLE_EQ( -3.0, floatValue );
+    ASSERT_STREQ( "-3", dictionary.getFieldValue( healthField ) );
+
+    // An empty value removes the field.
+    dictionary.setFieldValue( healthField, "" );
+    ASSERT_EQ( 0U, dictionary.getFieldCount() );
+    ASSERT_EQ( (const char*)NULL, dictionary.getFieldValue( healthField ) );
+    ASSERT_FALSE( dictionary.getFieldFloat( healthField, floatValue ) ) << "Removed field found.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimFieldDictionaryTests, GrowAndRemoveTest )
+{
+    SimFieldDictionary dictionary;
+    const U32 fieldCount = SimFieldDictionary::InlineEntryCount * 8;
+
+    // Add enough fields to move beyond the inline entries.
+    for ( U32 index = 0; index < fieldCount; ++index )
+        dictionary.setFieldInt( getTestFieldName( index ), (S32)index );
+
+    ASSERT_EQ( fieldCount, dictionary.getFieldCount() );
+
+    // Remove the odd fields.
+    for ( U32 index = 1; index < fieldCount; index += 2 )
+        dictionary.setFieldValue( getTestFieldName( index ), "" );
+
+    ASSERT_EQ( fieldCount / 2, dictionary.getFieldCount() );
+
+    // Check the remaining fields.
+    for ( U32 index = 0; index < fieldCount; ++index )
+    {
+        S32 value;
+        const bool found = dictionary.getFieldInt( getTestFieldName( index ), value );
+        ASSERT_EQ( (index & 1) == 0, found ) << "Unexpected field presence.";
+        if ( found )
+        {
+            ASSERT_EQ( (S32)index, value );
+        }
+    }
+
+    // Iterate the remaining fields.
+    U32 iteratedCount = 0;
+    for ( SimFieldDictionaryIterator itr( &dictionary ); *itr; ++itr )
+    {
+        ASSERT_NE( (char*)NULL, (*itr)->value ) << "Iterated field has no text.";
+        iteratedCount++;
+    }
+    ASSERT_EQ( fieldCount / 2, iteratedCount );
+
+    // Copy the fields.
+    SimFieldDictionary copyDictionary;
+    copyDictionary.assignFrom( &dictionary );
+    ASSERT_EQ( fieldCount / 2, copyDictionary.getFieldCount() );
+    ASSERT_STREQ( "2", copyDictionary.getFieldValue( getTestFieldName( 2 ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimFieldDictionaryTests, MemoryUsageTest )
+{
+    // Entries are no larger than a name, a text value and a number.
+    ASSERT_LE( sizeof(SimFieldDictionary::Entry), sizeof(StringTableEntry) + sizeof(char*) + sizeof(F64) );
+
+    // The typical field count fits in the inline entries with the text held at its exact size.
+    SimFieldDictionary dictionary;
+    for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+        dictionary.setFieldValue( getTestFieldName( index ), "100" );
+
+    ASSERT_LE( (U32)SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT, (U32)SimFieldDictionary::InlineEntryCount );
+    const U32 textUsage = sizeof(SimFieldDictionary) + SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT * (sizeof(SimFieldDictionary::Entry) + 4);
+    ASSERT_EQ( textUsage, dictionary.getMemoryUsage() ) << "Unexpected memory usage for text fields.";
+
+    // Shorter text reuses the existing buffers.
+    for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+        dictionary.setFieldValue( getTestFieldName( index ), "7" );
+
+    ASSERT_STREQ( "7", dictionary.getFieldValue( getTestFieldName( 0 ) ) );
+
+    // Numeric fields only allocate text when it is requested.
+    SimFieldDictionary numericDictionary;
+    for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+        numericDictionary.setFieldFloat( getTestFieldName( index ), (F64)index + 0.5 );
+
+    const U32 numericUsage = sizeof(SimFieldDictionary) + SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT * sizeof(SimFieldDictionary::Entry);
+    ASSERT_EQ( numericUsage, numericDictionary.getMemoryUsage() ) << "Numeric fields allocated text.";
+    ASSERT_STREQ( "3.5", numericDictionary.getFieldValue( getTestFieldName( 3 ) ) );
+    ASSERT_EQ( numericUsage + 4, numericDictionary.getMemoryUsage() );
+
+    // Text keeps its numeric conversion alongside.
+    F64 floatValue;
+    S32 intValue;
+    ASSERT_TRUE( numericDictionary.getFieldFloat( getTestFieldName( 3 ), floatValue ) );
+    ASSERT_DOUBLE_EQ( 3.5, floatValue );
+    ASSERT_TRUE( numericDictionary.getFieldInt( getTestFieldName( 3 ), intValue ) );
+    ASSERT_EQ( 3, intValue );
+    numericDictionary.setFieldInt( getTestFieldName( 3 ), 2147483647 );
+    ASSERT_STREQ( "2147483647", numericDictionary.getFieldValue( getTestFieldName( 3 ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimFieldDictionaryTests, BenchmarkTest )
+{
+    // Fetch the field names.
+    StringTableEntry fieldNames[SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT];
+    for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+        fieldNames[index] = getTestFieldName( index );
+
+    // Create the dictionaries with typical text fields.
+    Vector<SimFieldDictionary*> dictionaries;
+    dictionaries.setSize( SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT );
+    U32 memoryUsage = 0;
+    for ( U32 n = 0; n < SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT; ++n )
+    {
+        SimFieldDictionary* pDictionary = new SimFieldDictionary();
+        for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+            pDictionary->setFieldValue( fieldNames[index], "100" );
+
+        memoryUsage += pDictionary->getMemoryUsage();
+        dictionaries[n] = pDictionary;
+    }
+
+    // Text set/get.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 iteration = 0; iteration < SIMFIELDDICTIONARY_UNITTEST_ITERATIONS; ++iteration )
+    {
+        for ( U32 n = 0; n < SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT; ++n )
+        {
+            SimFieldDictionary* pDictionary = dictionaries[n];
+            for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+            {
+                char valueBuffer[32];
+                dSprintf( valueBuffer, sizeof(valueBuffer), "%d", dAtoi( pDictionary->getFieldValue( fieldNames[index] ) ) + 1 );
+                pDictionary->setFieldValue( fieldNames[index], valueBuffer );
+            }
+        }
+    }
+    const U32 textTime = Platform::getRealMilliseconds() - startTime;
+
+    // Numeric set/get.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 iteration = 0; iteration < SIMFIELDDICTIONARY_UNITTEST_ITERATIONS; ++iteration )
+    {
+        for ( U32 n = 0; n < SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT; ++n )
+        {
+            SimFieldDictionary* pDictionary = dictionaries[n];
+            for ( U32 index = 0; index < SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT; ++index )
+            {
+                F64 value = 0.0;
+                pDictionary->getFieldFloat( fieldNames[index], value );
+                pDictionary->setFieldFloat( fieldNames[index], value + 1.0 );
+            }
+        }
+    }
+    const U32 numericTime = Platform::getRealMilliseconds() - startTime;
+
+    // Check the final value.
+    const U32 expectedValue = 100 + (SIMFIELDDICTIONARY_UNITTEST_ITERATIONS * 2);
+    S32 finalValue;
+    ASSERT_TRUE( dictionaries[0]->getFieldInt( fieldNames[0], finalValue ) ) << "Field not found.";
+    ASSERT_EQ( (S32)expectedValue, finalValue );
+
+    Con::printf( "SimFieldDictionary with %d fields: %d bytes per object.",
+        SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT, memoryUsage / SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT );
+    Con::printf( "SimFieldDictionary %d objects x %d fields x %d iterations: text get/set %dms, numeric get/set %dms.",
+        SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT, SIMFIELDDICTIONARY_UNITTEST_FIELDCOUNT, SIMFIELDDICTIONARY_UNITTEST_ITERATIONS, textTime, numericTime );
+
+    // Clean-up.
+    for ( U32 n = 0; n < SIMFIELDDICTIONARY_UNITTEST_OBJECTCOUNT; ++n )
+        delete dictionaries[n];
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIM_MAIN_THREAD_QUEUE_H_
+#include "sim/simMainThreadQueue.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+#define MAINTHREADQUEUE_UNITTEST_PRODUCER_COUNT     4
+#define MAINTHREADQUEUE_UNITTEST_WORK_COUNT         10000
+
+//-----------------------------------------------------------------------------
+
+class CountingWork : public SimMainThreadWork
+{
+public:
+    CountingWork( U32* pLastSequence, const U32 sequence, bool* pOrdered ) :
+        mpLastSequence( pLastSequence ),
+        mSequence( sequence ),
+        mpOrdered( pOrdered )
+    {}
+
+    virtual const char* execute( void )
+    {
+        // Work from one producer should arrive in the order it was posted.
+        if ( mSequence != *mpLastSequence + 1 )
+            *mpOrdered = false;
+
+        *mpLastSequence = mSequence;
+
+        dSprintf( mResult, sizeof(mResult), "%d", mSequence );
+        return mResult;
+    }
+
+private:
+    U32* mpLastSequence;
+    U32 mSequence;
+    bool* mpOrdered;
+    char mResult[16];
+};
+
+//-----------------------------------------------------------------------------
+
+class MainThreadQueueProducer : public Thread
+{
+public:
+    MainThreadQueueProducer( SimMainThreadQueue* pQueue, bool* pOrdered ) :
+        Thread( 0, NULL, false ),
+        mpQueue( pQueue ),
+        mLastSequence( 0 ),
+        mpOrdered( pOrdered )
+    {}
+
+    virtual void run( void* arg )
+    {
+        for ( U32 n = 1; n <= MAINTHREADQUEUE_UNITTEST_WORK_COUNT; ++n )
+        {
+            CountingWork* pWork = new CountingWork( &mLastSequence, n, mpOrdered );
+
+            // Keep a future for the last piece of work.
+            if ( n == MAINTHREADQUEUE_UNITTEST_WORK_COUNT )
+                mFuture = pWork->getFuture();
+
+            mpQueue->post( pWork );
+        }
+    }
+
+    SimMainThreadQueue* mpQueue;
+    U32 mLastSequence;
+    bool* mpOrdered;
+    SimMainThreadFuture mFuture;
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( SimMainThreadQueueTests, MultipleProducerTest )
+{
+    SimMainThreadQueue queue;
+    bool ordered = true;
+
+    // Start the producers.
+    MainThreadQueueProducer* producers[MAINTHREADQUEUE_UNITTEST_PRODUCER_COUNT];
+    for ( U32 n = 0; n < MAINTHREADQUEUE_UNITTEST_PRODUCER_COUNT; ++n )
+    {
+        producers[n] = new MainThreadQueueProducer( &queue, &ordered );
+        producers[n]->start();
+    }
+
+    // Process while the producers are posting.
+    U32 processedCount = 0;
+    while ( processedCount < MAINTHREADQUEUE_UNITTEST_PRODUCER_COUNT * MAINTHREADQUEUE_UNITTEST_WORK_COUNT )
+    {
+        const U32 count = queue.process( 1 );
+        if ( count == 0 )
+            Platform::sleep( 0 );
+
+        processedCount += count;
+    }
+
+    // Check every producer's work was executed.
+    for ( U32 n = 0; n < MAINTHREADQUEUE_UNITTEST_PRODUCER_COUNT; ++n )
+    {
+        producers[n]->join();
+
+        ASSERT_EQ( MAINTHREADQUEUE_UNITTEST_WORK_COUNT, producers[n]->mLastSequence ) << "Work was lost.";
+        ASSERT_TRUE( producers[n]->mFuture.isReady() );
+        ASSERT_EQ( MAINTHREADQUEUE_UNITTEST_WORK_COUNT, (U32)dAtoi( producers[n]->mFuture.getResult() ) );
+
+        delete producers[n];
+    }
+
+    ASSERT_TRUE( ordered ) << "Work from a producer executed out of order.";
+    ASSERT_EQ( 0, queue.getPendingCount() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimMainThreadQueueTests, FutureTest )
+{
+    SimMainThreadQueue queue;
+    U32 lastSequence = 0;
+    bool ordered = true;
+
+    // A future should only be ready once its work has executed.
+    CountingWork* pWork = new CountingWork( &lastSequence, 1, &ordered );
+    SimMainThreadFuture future = pWork->getFuture();
+    queue.post( pWork );
+    ASSERT_FALSE( future.isReady() );
+    ASSERT_TRUE( future.getResult() == NULL );
+
+    ASSERT_EQ( 1, queue.process( 0 ) );
+    ASSERT_TRUE( future.isReady() );
+    ASSERT_STREQ( "1", future.getResult() );
+
+    // The result belongs to the future so a copy should outlive the work.
+    SimMainThreadFuture copy = future;
+    ASSERT_STREQ( "1", copy.waitForResult() );
+
+    // Cancelled work should complete its future with an empty result.
+    pWork = new CountingWork( &lastSequence, 2, &ordered );
+    future = pWork->getFuture();
+    queue.post( pWork );
+    queue.cancelAll();
+    ASSERT_TRUE( future.isReady() );
+    ASSERT_STREQ( "", future.getResult() );
+    ASSERT_EQ( 1, lastSequence ) << "Cancelled work was executed.";
+}
+
+//-----------------------------------------------------------------------------
+
+class ThreadedExecuteThread : public Thread
+{
+public:
+    ThreadedExecuteThread() :
+        Thread( 0, NULL, false ),
+        mIsMainThread( true ),
+        mDone( false )
+    {
+        mResult[0] = 0;
+    }
+
+    virtual void run( void* arg )
+    {
+        mIsMainThread = Con::isMainThread();
+
+        const char* argv[] = { "strlen", "hello" };
+        dStrncpy( mResult, Con::execute( 2, argv ), sizeof(mResult) );
+        mResult[sizeof(mResult)-1] = 0;
+
+        mDone.store( true );
+    }
+
+    bool mIsMainThread;
+    char mResult[16];
+    std::atomic<bool> mDone;
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( SimMainThreadQueueTests, ThreadedExecuteTest )
+{
+    ASSERT_TRUE( Con::isMainThread() ) << "Tests are not running on the main thread.";
+
+    // Execute a script function from another thread.
+    ThreadedExecuteThread* pThread = new ThreadedExecuteThread();
+    pThread->start();
+
+    // The call should be handed to the main thread.
+    while ( !pThread->mDone.load() )
+    {
+        if ( Sim::processMainThreadQueue( 1 ) == 0 )
+            Platform::sleep( 0 );
+    }
+    pThread->join();
+
+    ASSERT_FALSE( pThread->mIsMainThread ) << "Other thread was reported as the main thread.";
+    ASSERT_STREQ( "5", pThread->mResult ) << "Threaded execute returned the wrong result.";
+
+    delete pThread;
+}
+
+#endif // TORQUE_SHIPPING
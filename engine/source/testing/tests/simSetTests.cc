@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMSET_UNITTEST_OBJECT_COUNT            16
+#define SIMSET_UNITTEST_MASS_OBJECT_COUNT       100000
+#define SIMSET_UNITTEST_MASS_DELETE_STRIDE      20
+
+//-----------------------------------------------------------------------------
+
+static SimSet* createTestSet( SimObject** pObjects, const U32 objectCount )
+{
+    // Create a set.
+    SimSet* pSet = new SimSet();
+    pSet->registerObject();
+
+    // Add the objects.
+    for ( U32 n = 0; n < objectCount; ++n )
+    {
+        pObjects[n] = new SimObject();
+        pObjects[n]->registerObject();
+        pSet->addObject( pObjects[n] );
+    }
+
+    return pSet;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, OrderedRemovalTest )
+{
+    SimObject* objects[SIMSET_UNITTEST_OBJECT_COUNT];
+    SimSet* pSet = createTestSet( objects, SIMSET_UNITTEST_OBJECT_COUNT );
+
+    // Adding a member again should be ignored.
+    pSet->addObject( objects[0] );
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT, pSet->size() ) << "Member added twice.";
+
+    // Remove and delete members.
+    pSet->removeObject( objects[3] );
+    objects[7]->deleteObject();
+    ASSERT_FALSE( pSet->isMember( objects[3] ) ) << "Removed object is still a member.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT - 2, pSet->size() );
+
+    // The remaining members should keep their order.
+    S32 index = 0;
+    for ( U32 n = 0; n < SIMSET_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        if ( n == 3 || n == 7 )
+            continue;
+
+        ASSERT_EQ( objects[n], pSet->at( index++ ) ) << "Member order not preserved.";
+        ASSERT_TRUE( pSet->isMember( objects[n] ) ) << "Member not found.";
+    }
+
+    // Removing from the front should still find the members.
+    for ( U32 n = 0; n < SIMSET_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        if ( n == 7 )
+            continue;
+
+        objects[n]->deleteObject();
+    }
+    ASSERT_EQ( 0, pSet->size() ) << "Deleted objects are still members.";
+
+    // Clean-up.
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, UnorderedRemovalTest )
+{
+    SimObject* objects[SIMSET_UNITTEST_OBJECT_COUNT];
+    SimSet* pSet = createTestSet( objects, SIMSET_UNITTEST_OBJECT_COUNT );
+    pSet->setOrdered( false );
+
+    // Removing should move the last member into the empty place.
+    pSet->removeObject( objects[2] );
+    ASSERT_EQ( objects[SIMSET_UNITTEST_OBJECT_COUNT - 1], pSet->at( 2 ) ) << "Last member not moved.";
+
+    // The moved member should still be found.
+    pSet->removeObject( objects[SIMSET_UNITTEST_OBJECT_COUNT - 1] );
+    ASSERT_FALSE( pSet->isMember( objects[SIMSET_UNITTEST_OBJECT_COUNT - 1] ) ) << "Moved member not removed.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT - 2, pSet->size() );
+
+    // Clean-up.
+    objects[2]->deleteObject();
+    objects[SIMSET_UNITTEST_OBJECT_COUNT - 1]->deleteObject();
+    pSet->deleteObjects();
+    ASSERT_EQ( 0, pSet->size() ) << "Objects not deleted.";
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, IterationRemovalTest )
+{
+    SimObject* objects[SIMSET_UNITTEST_OBJECT_COUNT];
+    SimSet* pSet = createTestSet( objects, SIMSET_UNITTEST_OBJECT_COUNT );
+
+    // Remove every other member whilst iterating.
+    S32 visited = 0;
+    for ( S32 n = 0; n < pSet->size(); ++n )
+    {
+        SimObject* pObject = pSet->at( n );
+        ASSERT_NE( (SimObject*)NULL, pObject ) << "Removed member visible during iteration.";
+        visited++;
+
+        // Remove the next member so that the iteration carries on past it.
+        if ( n + 1 < pSet->size() )
+            pSet->at( n + 1 )->deleteObject();
+    }
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT / 2, visited ) << "Iteration did not see every remaining member.";
+
+    // The remaining members should be in order with no empty entries.
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT / 2, pSet->size() ) << "Members not removed.";
+    ASSERT_EQ( objects[0], pSet->first() );
+    ASSERT_EQ( objects[SIMSET_UNITTEST_OBJECT_COUNT - 2], pSet->last() );
+    S32 index = 0;
+    for ( SimSet::iterator itr = pSet->begin(); itr != pSet->end(); ++itr )
+    {
+        ASSERT_EQ( objects[index * 2], *itr ) << "Member order not preserved.";
+        ASSERT_EQ( objects[index * 2], pSet->getTamlChild( index ) );
+        index++;
+    }
+
+    // Deleting every member from their methods should visit each of them once.
+    pSet->callOnChildren( "delete", 0, NULL );
+    ASSERT_TRUE( pSet->empty() ) << "Members not deleted by their methods.";
+
+    // Clean-up.
+    pSet->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, GroupRemovalTest )
+{
+    // Create a group.
+    SimGroup* pGroup = new SimGroup();
+    pGroup->registerObject();
+
+    SimObject* objects[SIMSET_UNITTEST_OBJECT_COUNT];
+    for ( U32 n = 0; n < SIMSET_UNITTEST_OBJECT_COUNT; ++n )
+    {
+        objects[n] = new SimObject();
+        objects[n]->registerObject();
+        pGroup->addObject( objects[n] );
+    }
+
+    // Delete members out of order.
+    objects[0]->deleteObject();
+    objects[5]->deleteObject();
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT - 2, pGroup->size() );
+    ASSERT_EQ( objects[6], pGroup->at( 4 ) ) << "Member order not preserved.";
+
+    // Move a member to another group.
+    SimGroup* pOtherGroup = new SimGroup();
+    pOtherGroup->registerObject();
+    pOtherGroup->addObject( objects[9] );
+    ASSERT_FALSE( pGroup->isMember( objects[9] ) ) << "Moved member still in the old group.";
+    ASSERT_TRUE( pOtherGroup->isMember( objects[9] ) ) << "Moved member not in the new group.";
+    ASSERT_EQ( SIMSET_UNITTEST_OBJECT_COUNT - 3, pGroup->size() );
+
+    // Clean-up.
+    pGroup->deleteObject();
+    pOtherGroup->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimSetTests, MassRemovalTest )
+{
+    const U32 deleteCount = SIMSET_UNITTEST_MASS_OBJECT_COUNT / SIMSET_UNITTEST_MASS_DELETE_STRIDE;
+
+    // Create the objects.
+    Vector<SimObject*> objects;
+    objects.setSize( SIMSET_UNITTEST_MASS_OBJECT_COUNT );
+    for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; ++n )
+    {
+        objects[n] = new SimObject();
+        objects[n]->registerObject();
+    }
+
+    // Time the baseline removal which searched the object list and erased the entry.
+    Vector<SimObject*> baselineList = objects;
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; n += SIMSET_UNITTEST_MASS_DELETE_STRIDE )
+    {
+        Vector<SimObject*>::iterator itr = ::find( baselineList.begin(), baselineList.end(), objects[n] );
+        if ( itr != baselineList.end() )
+            baselineList.erase( itr );
+    }
+    const U32 baselineTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( SIMSET_UNITTEST_MASS_OBJECT_COUNT - deleteCount, (U32)baselineList.size() );
+
+    // Time the removal from a large set in each removal mode.
+    U32 modeTimes[2];
+    for ( U32 mode = 0; mode < 2; ++mode )
+    {
+        const bool ordered = mode == 0;
+
+        SimSet* pSet = new SimSet();
+        pSet->registerObject();
+        pSet->setOrdered( ordered );
+
+        for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; ++n )
+            pSet->addObject( objects[n] );
+
+        // Remove a spread of the objects.
+        startTime = Platform::getRealMilliseconds();
+        for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; n += SIMSET_UNITTEST_MASS_DELETE_STRIDE )
+            pSet->removeObject( objects[n] );
+        modeTimes[mode] = Platform::getRealMilliseconds() - startTime;
+
+        ASSERT_EQ( SIMSET_UNITTEST_MASS_OBJECT_COUNT - deleteCount, (U32)pSet->size() ) << "Objects not removed.";
+
+        // Every remaining object should still be a member.
+        for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; ++n )
+        {
+            const bool removed = (n % SIMSET_UNITTEST_MASS_DELETE_STRIDE) == 0;
+            ASSERT_EQ( !removed, pSet->isMember( objects[n] ) ) << "Unexpected membership after mass removal.";
+        }
+
+        // Ordered sets should keep the remaining objects in order.
+        if ( ordered )
+        {
+            for ( U32 index = 0; index < (U32)baselineList.size(); ++index )
+            {
+                ASSERT_EQ( baselineList[index], pSet->at( index ) ) << "Member order not preserved.";
+            }
+        }
+
+        // Removal after mass removal should still find the members.
+        pSet->removeObject( objects[1] );
+        ASSERT_FALSE( pSet->isMember( objects[1] ) ) << "Member not removed after mass removal.";
+
+        // Clean-up.
+        pSet->clear();
+        ASSERT_TRUE( pSet->empty() ) << "Objects not removed.";
+        pSet->deleteObject();
+    }
+
+    Con::printf( "SimSet removing %d of %d objects: baseline %dms, ordered %dms, unordered %dms.",
+        deleteCount, SIMSET_UNITTEST_MASS_OBJECT_COUNT, baselineTime, modeTimes[0], modeTimes[1] );
+
+    // Deleting the members of a set should remove them all.
+    SimSet* pSet = new SimSet();
+    pSet->registerObject();
+    for ( U32 n = 0; n < SIMSET_UNITTEST_MASS_OBJECT_COUNT; ++n )
+        pSet->addObject( objects[n] );
+
+    pSet->deleteObjects();
+    ASSERT_TRUE( pSet->empty() ) << "Objects not deleted.";
+    pSet->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
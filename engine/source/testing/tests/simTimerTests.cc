@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SIM_CALLBACK_EVENT_H_
+#include "sim/simCallbackEvent.h"
+#endif
+
+#ifndef _SIM_TIMER_WHEEL_H_
+#include "sim/simTimerWheel.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SIMTIMER_UNITTEST_TICK_PERIOD       10
+#define SIMTIMER_UNITTEST_TIMER_COUNT       1000
+
+//-----------------------------------------------------------------------------
+
+class SimTimerCounter
+{
+public:
+    SimTimerCounter() : mCount( 0 ), mLastValue( 0 ) {}
+
+    void onEvent( SimObject* pObject, const U32& payload ) { mCount++; mLastValue = payload; }
+    void onTimer( SimObject* pObject, U32 userData ) { mCount++; mLastValue = userData; }
+
+    U32 mCount;
+    U32 mLastValue;
+};
+
+//-----------------------------------------------------------------------------
+
+static void advanceToTickBoundary( void )
+{
+    Sim::advanceToTime( (Sim::getCurrentTime() / SIMTIMER_UNITTEST_TICK_PERIOD + 1) * SIMTIMER_UNITTEST_TICK_PERIOD );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimTimerTests, CallbackEventRepostTest )
+{
+    SimObject* pObject = new SimObject();
+    pObject->registerObject();
+
+    // Post an event that repeats three times.
+    SimTimerCounter counter;
+    SimCallbackEvent<U32>* pEvent = new SimCallbackEvent<U32>( fastdelegate::MakeDelegate( &counter, &SimTimerCounter::onEvent ), 42 );
+    pEvent->setRepeat( 10, 3 );
+    const U32 eventId = Sim::postEvent( pObject, pEvent, Sim::getCurrentTime() + 10 );
+
+    // The event should keep its Id while repeating.
+    Sim::advanceTime( 25 );
+    ASSERT_EQ( 2, counter.mCount );
+    ASSERT_EQ( 42, counter.mLastValue );
+    ASSERT_TRUE( Sim::isEventPending( eventId ) ) << "Repeating event lost its Id.";
+
+    Sim::advanceTime( 100 );
+    ASSERT_EQ( 3, counter.mCount ) << "Event did not stop repeating.";
+    ASSERT_FALSE( Sim::isEventPending( eventId ) );
+
+    // Cancelling an endless repeat should stop it.
+    pEvent = new SimCallbackEvent<U32>( fastdelegate::MakeDelegate( &counter, &SimTimerCounter::onEvent ), 7 );
+    pEvent->setRepeat( 10 );
+    const U32 endlessId = Sim::postEvent( pObject, pEvent, Sim::getCurrentTime() + 10 );
+    Sim::advanceTime( 50 );
+    ASSERT_EQ( 8, counter.mCount );
+    Sim::cancelEvent( endlessId );
+    Sim::advanceTime( 50 );
+    ASSERT_EQ( 8, counter.mCount ) << "Cancelled event still repeating.";
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimTimerTests, TimerWheelTest )
+{
+    SimTimerWheel timerWheel( SIMTIMER_UNITTEST_TICK_PERIOD );
+    SimTimerCounter counter;
+    const SimTimerWheel::Callback callback = fastdelegate::MakeDelegate( &counter, &SimTimerCounter::onTimer );
+
+    SimObject* pObject = new SimObject();
+    pObject->registerObject();
+
+    advanceToTickBoundary();
+
+    // Add a repeating timer and one that fires twice.
+    const U32 timerId = timerWheel.addTimer( pObject, callback, 20, 0, 5 );
+    timerWheel.addTimer( pObject, callback, 30, 2, 6 );
+    ASSERT_EQ( 2, timerWheel.getTimerCount() );
+
+    Sim::advanceTime( 100 );
+    ASSERT_EQ( 5 + 2, counter.mCount );
+    ASSERT_EQ( 1, timerWheel.getTimerCount() ) << "Timer did not stop repeating.";
+    ASSERT_TRUE( timerWheel.isTimerActive( timerId ) );
+
+    // Removing the timer should stop it.
+    timerWheel.removeTimer( timerId );
+    Sim::advanceTime( 100 );
+    ASSERT_EQ( 5 + 2, counter.mCount ) << "Removed timer still firing.";
+    ASSERT_EQ( 0, timerWheel.getTimerCount() );
+
+    // Deleting the object should remove its timer.
+    timerWheel.addTimer( pObject, callback, 10 );
+    pObject->deleteObject();
+    Sim::advanceTime( 100 );
+    ASSERT_EQ( 5 + 2, counter.mCount ) << "Timer fired on a deleted object.";
+    ASSERT_EQ( 0, timerWheel.getTimerCount() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SimTimerTests, TimerWheelMassTest )
+{
+    SimTimerWheel timerWheel( SIMTIMER_UNITTEST_TICK_PERIOD );
+    SimTimerCounter counter;
+    const SimTimerWheel::Callback callback = fastdelegate::MakeDelegate( &counter, &SimTimerCounter::onTimer );
+
+    SimObject* pObject = new SimObject();
+    pObject->registerObject();
+
+    advanceToTickBoundary();
+
+    // Add timers with a spread of periods.
+    U32 expectedCount = 0;
+    for ( U32 n = 0; n < SIMTIMER_UNITTEST_TIMER_COUNT; ++n )
+    {
+        const U32 period = SIMTIMER_UNITTEST_TICK_PERIOD * (1 + n % 50);
+        timerWheel.addTimer( pObject, callback, period );
+        expectedCount += 5000 / period;
+    }
+
+    // Timers landing on the same slot in different rounds must only fire when due.
+    Sim::advanceTime( 5000 );
+    ASSERT_EQ( expectedCount, counter.mCount );
+
+    timerWheel.removeTimers( pObject );
+    ASSERT_EQ( 0, timerWheel.getTimerCount() );
+
+    pObject->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// Parallel precompilation of scripts to DSO files.
+//
+// Run as:
+//   Torque2D main.compileScripts.cs -dedicated [-jobs count] [path ...]
+//
+// Each path is a path expression such as "^MyModule/*.cs" and defaults to every script under
+// "modules".  All matching scripts are compiled in one batch using one worker thread per
+// processor unless "-jobs" says otherwise.
+
+// Set log mode.
+setLogMode(2);
+
+// Controls whether the execution or script files or compiled DSOs are echoed to the console or not.
+setScriptExecEcho( false );
+
+// Controls whether all script execution is traced (echoed) to the console or not.
+trace( false );
+
+// Compile defaults.
+$CompileScripts::Jobs = 0;
+$CompileScripts::Paths = "";
+
+// Parse the command line.
+for ( $i = 1; $i < $GameProject::argc; $i++ )
+{
+    %arg = $GameProject::argv[$i];
+    %hasValue = $i + 1 < $GameProject::argc;
+
+    if ( %arg $= "-jobs" && %hasValue )
+    {
+        $i++;
+        $CompileScripts::Jobs = $GameProject::argv[$i];
+    }
+    else if ( %arg $= "-dedicated" )
+    {
+        // Handled by the engine.
+    }
+    else
+    {
+        $CompileScripts::Paths = $CompileScripts::Paths $= "" ? %arg : $CompileScripts::Paths TAB %arg;
+    }
+}
+
+if ( $CompileScripts::Paths $= "" )
+    $CompileScripts::Paths = "./modules/*.cs" TAB "./modules/*.gui";
+
+// Compile the scripts.
+%result = compileScripts( $CompileScripts::Paths, $CompileScripts::Jobs );
+
+echo( "Compiled" SPC getWord( %result, 1 ) SPC "scripts with" SPC getWord( %result, 2 ) SPC "workers in" SPC getWord( %result, 4 ) @ "ms (parsing" SPC getWord( %result, 3 ) @ "ms)." );
+
+if ( getWord( %result, 0 ) > 0 )
+    error( getWord( %result, 0 ) SPC "scripts failed to compile." );
+
+// Finish!
+quit();
@@ -0,0 +1,410 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// Headless scene benchmarks.
+//
+// Run with "make benchmark" from "engine/compilers/Make" or directly as:
+//   Torque2D_BENCHMARK main.runBenchmarks.cs -dedicated [-ticks count] [-report file] [-norender] [-gltrace file]
+//
+// Each scenario builds its own scene, advances it a fixed number of ticks and records the timings.
+// Unless "-norender" is used, each tick also renders the scene through the null GL backend so that
+// the render path is measured without a window.  "-gltrace" writes every GL call to a file.
+// All results are written as a JSON report for regression tracking.
+
+// Set log mode.
+setLogMode(2);
+
+// Controls whether the execution or script files or compiled DSOs are echoed to the console or not.
+// Being able to turn this off means far less spam in the console during typical development.
+setScriptExecEcho( false );
+
+// Controls whether all script execution is traced (echoed) to the console or not.
+trace( false );
+
+// Benchmark defaults.
+$Benchmark::Ticks = 600;
+$Benchmark::Report = "./benchmark.json";
+$Benchmark::Render = true;
+$Benchmark::RenderArea = "-50 -40 50 40";
+$Benchmark::GLTrace = "";
+
+// Parse the command line.
+for ( $i = 1; $i < $GameProject::argc; $i++ )
+{
+    %arg = $GameProject::argv[$i];
+    %hasValue = $i + 1 < $GameProject::argc;
+
+    if ( %arg $= "-ticks" && %hasValue )
+    {
+        $i++;
+        $Benchmark::Ticks = $GameProject::argv[$i];
+    }
+    else if ( %arg $= "-report" && %hasValue )
+    {
+        $i++;
+        $Benchmark::Report = $GameProject::argv[$i];
+    }
+    else if ( %arg $= "-norender" )
+    {
+        $Benchmark::Render = false;
+    }
+    else if ( %arg $= "-gltrace" && %hasValue )
+    {
+        $i++;
+        $Benchmark::GLTrace = $GameProject::argv[$i];
+    }
+}
+
+// Rendering needs the null GL backend to stand in for a real context.
+if ( $Benchmark::Render && !isFunction( "setNullGLEnabled" ) )
+{
+    warn( "Null GL backend unavailable on this platform; rendering disabled." );
+    $Benchmark::Render = false;
+}
+
+if ( $Benchmark::Render )
+{
+    setNullGLEnabled( true );
+
+    if ( $Benchmark::GLTrace !$= "" )
+        startNullGLTrace( $Benchmark::GLTrace );
+}
+
+// Load the shared assets used by the scenarios.
+ModuleDatabase.scanModules( "./modules" );
+ModuleDatabase.LoadExplicit( "ToyAssets" );
+
+// Use repeatable random numbers.
+setRandomSeed( 1 );
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::createScene( %this )
+{
+    %scene = new Scene();
+    %scene.setGravity( 0, -9.8 );
+    return %scene;
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::run( %this, %name )
+{
+    // Build the scenario.
+    %scene = %this.createScene();
+    %this.call( "build" @ %name, %scene );
+
+    // Run it.
+    if ( $Benchmark::Render )
+    {
+        resetNullGLStats();
+        runSceneBenchmark( %name, %scene, $Benchmark::Ticks, $Benchmark::RenderArea );
+        echo( "Benchmark" SPC %name @ ": GL calls, draw calls, vertices, state changes, texture binds =" SPC getNullGLStats() );
+    }
+    else
+    {
+        runSceneBenchmark( %name, %scene, $Benchmark::Ticks );
+    }
+
+    // Tear it down.
+    %scene.delete();
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildSprites( %this, %scene )
+{
+    // Moving and spinning sprites without collision shapes.
+    for ( %i = 0; %i < 4000; %i++ )
+    {
+        %object = new Sprite();
+        %object.setBodyType( kinematic );
+        %object.setPosition( getRandom( -50, 50 ), getRandom( -40, 40 ) );
+        %object.setSize( 1, 1 );
+        %object.Image = "ToyAssets:Blank";
+        %object.setLinearVelocity( getRandom( -5, 5 ), getRandom( -5, 5 ) );
+        %object.setAngularVelocity( getRandom( -180, 180 ) );
+        %scene.add( %object );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildParticles( %this, %scene )
+{
+    // A particle effect with a single continuous emitter.
+    %effect = new ParticleAsset();
+    %effect.AssetName = "BenchmarkParticles";
+
+    %emitter = %effect.createEmitter();
+    %emitter.EmitterName = "BenchmarkEmitter";
+    %emitter.Image = "ToyAssets:Particles1";
+    %emitter.RandomImageFrame = true;
+    %emitter.selectField( "Lifetime" );
+    %emitter.addDataKey( 0, 2 );
+    %emitter.selectField( "Quantity" );
+    %emitter.addDataKey( 0, 250 );
+    %emitter.selectField( "Speed" );
+    %emitter.addDataKey( 0, 5 );
+    %emitter.selectField( "EmissionArc" );
+    %emitter.addDataKey( 0, 360 );
+    %emitter.deselectField();
+
+    %assetId = AssetDatabase.addPrivateAsset( %effect );
+
+    // Many players of the effect.
+    for ( %i = 0; %i < 40; %i++ )
+    {
+        %object = new ParticlePlayer();
+        %object.BodyType = static;
+        %object.Particle = %assetId;
+        %object.setPosition( getRandom( -40, 40 ), getRandom( -30, 30 ) );
+        %scene.add( %object );
+        %object.play();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildPhysicsPile( %this, %scene )
+{
+    // The ground.
+    %ground = new Sprite();
+    %ground.setBodyType( static );
+    %ground.createEdgeCollisionShape( -40, -30, 40, -30 );
+    %ground.createEdgeCollisionShape( -40, -30, -40, 30 );
+    %ground.createEdgeCollisionShape( 40, -30, 40, 30 );
+    %scene.add( %ground );
+
+    // A pile of boxes and balls falling onto it.
+    for ( %i = 0; %i < 1500; %i++ )
+    {
+        %object = new Sprite();
+        %object.setBodyType( dynamic );
+        %object.setPosition( getRandom( -35, 35 ), getRandom( -25, 100 ) );
+        %object.setSize( 1, 1 );
+        %object.Image = "ToyAssets:Blank";
+
+        if ( %i % 2 )
+            %object.createPolygonBoxCollisionShape( 1, 1 );
+        else
+            %object.createCircleCollisionShape( 0.5 );
+
+        %scene.add( %object );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildScriptAI( %this, %scene )
+{
+    // Agents that steer in script every tick and pick new targets on a schedule.
+    for ( %i = 0; %i < 500; %i++ )
+    {
+        %object = new Sprite() { class = "BenchmarkAgent"; };
+        %object.setBodyType( kinematic );
+        %object.setPosition( getRandom( -40, 40 ), getRandom( -30, 30 ) );
+        %object.setSize( 1, 1 );
+        %object.Image = "ToyAssets:Blank";
+        %object.setUpdateCallback( true );
+        %scene.add( %object );
+        %object.think();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildScrollers( %this, %scene )
+{
+    // Layered full-screen scrollers.
+    for ( %i = 0; %i < 16; %i++ )
+    {
+        %object = new Scroller();
+        %object.Size = "100 80";
+        %object.SceneLayer = 31 - %i;
+        %object.Image = "ToyAssets:Blank";
+        %object.RepeatX = 8;
+        %object.RepeatY = 8;
+        %object.ScrollX = getRandom( -10, 10 );
+        %object.ScrollY = getRandom( -10, 10 );
+        %scene.add( %object );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::createDriver( %this, %scene, %class )
+{
+    // A scene object that does the scenario work in its update callback each tick.
+    %driver = new SceneObject() { class = %class; };
+    %driver.setBodyType( static );
+    %driver.setUpdateCallback( true );
+    %scene.add( %driver );
+    return %driver;
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildPoolChurn( %this, %scene )
+{
+    // Short-lived pooled sprites acquired every tick and returned to the pool when their lifetime expires.
+    %template = new Sprite();
+    %template.setBodyType( kinematic );
+    %template.setSize( 1, 1 );
+    %template.Image = "ToyAssets:Blank";
+    %template.Lifetime = 0.5;
+
+    %driver = %this.createDriver( %scene, "BenchmarkPoolDriver" );
+    %driver.template = %template;
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildFieldDictionary( %this, %scene )
+{
+    // Objects that read and write many dynamic fields every tick.
+    for ( %i = 0; %i < 200; %i++ )
+    {
+        %object = %this.createDriver( %scene, "BenchmarkFieldDriver" );
+
+        for ( %field = 0; %field < 16; %field++ )
+            %object.value[%field] = %field;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function Benchmark::buildSimSetRemoval( %this, %scene )
+{
+    // A large set whose members are deleted and replaced every tick.
+    %set = new SimSet();
+    for ( %i = 0; %i < 20000; %i++ )
+        %set.add( new ScriptObject() );
+
+    %driver = %this.createDriver( %scene, "BenchmarkSetDriver" );
+    %driver.set = %set;
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkPoolDriver::onUpdate( %this )
+{
+    // Acquire a burst of objects.
+    %scene = %this.getScene();
+    for ( %i = 0; %i < 50; %i++ )
+    {
+        %object = %scene.acquireObject( %this.template );
+        %object.setPosition( getRandom( -50, 50 ), getRandom( -40, 40 ) );
+        %object.setLinearVelocity( getRandom( -5, 5 ), getRandom( -5, 5 ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkPoolDriver::onRemove( %this )
+{
+    if ( isObject( %this.template ) )
+        %this.template.delete();
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkFieldDriver::onUpdate( %this )
+{
+    // Read and write each dynamic field.
+    for ( %field = 0; %field < 16; %field++ )
+        %this.value[%field] = %this.value[%field] + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkSetDriver::onUpdate( %this )
+{
+    // Delete random members, which removes them from the set, then replace them.
+    for ( %i = 0; %i < 100; %i++ )
+    {
+        %this.set.getObject( getRandom( 0, %this.set.getCount() - 1 ) ).delete();
+        %this.set.add( new ScriptObject() );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkSetDriver::onRemove( %this )
+{
+    if ( !isObject( %this.set ) )
+        return;
+
+    %this.set.deleteObjects();
+    %this.set.delete();
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkAgent::think( %this )
+{
+    // Pick a new target.
+    %this.target = getRandom( -40, 40 ) SPC getRandom( -30, 30 );
+    %this.schedule( 250 + getRandom( 0, 250 ), "think" );
+}
+
+//-----------------------------------------------------------------------------
+
+function BenchmarkAgent::onUpdate( %this )
+{
+    // Steer towards the target.
+    %delta = Vector2Sub( %this.target, %this.getPosition() );
+    %distance = Vector2Length( %delta );
+
+    if ( %distance < 0.5 )
+    {
+        %this.setLinearVelocity( 0, 0 );
+        return;
+    }
+
+    %this.setLinearVelocity( Vector2Scale( %delta, 5 / %distance ) );
+    %this.setAngle( mRadToDeg( mAtan( %delta ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+// Run all the scenarios.
+new ScriptObject( Benchmark );
+Benchmark.run( "Sprites" );
+Benchmark.run( "Particles" );
+Benchmark.run( "PhysicsPile" );
+Benchmark.run( "ScriptAI" );
+Benchmark.run( "Scrollers" );
+Benchmark.run( "PoolChurn" );
+Benchmark.run( "FieldDictionary" );
+Benchmark.run( "SimSetRemoval" );
+
+// Write the report.
+writeSceneBenchmarkReport( $Benchmark::Report );
+
+// Release the null GL backend.
+if ( $Benchmark::Render )
+    setNullGLEnabled( false );
+
+// Finish!
+quit();